@@ -0,0 +1,56 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures performance of RegExp matching on patterns that spend most of
+// their time skipping over input characters.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+int matchCount = 0;
+
+class RegExpMatch extends BenchmarkBase {
+  final RegExp re;
+  final String subject;
+  final int expectedMatches;
+
+  RegExpMatch(String name, String pattern, this.subject, this.expectedMatches)
+    : re = RegExp(pattern),
+      super('RegExpMatch.$name');
+
+  @override
+  void run() {
+    int count = 0;
+    for (final _ in re.allMatches(subject)) {
+      count++;
+    }
+    if (count != expectedMatches) {
+      throw StateError('Expected $expectedMatches matches, got $count');
+    }
+    matchCount += count;
+  }
+}
+
+String repeat(String s, int times) => s * times;
+
+void main() {
+  // A line of comma separated fields.
+  final csv = repeat('${repeat('x', 60)},', 200);
+  // Long runs of characters before the character searched for.
+  final text = repeat('${repeat('lorem ipsum ', 20)}x', 50);
+  final hex = repeat('${repeat('0123456789abcdef', 8)}g', 50);
+  final benchmarks = [
+    // Skips until a single character.
+    RegExpMatch('SkipUntilChar', '[^,]*,', csv, 200),
+    RegExpMatch('LazyDotStar', 'm.*?x', text, 50),
+    // Skips until one of two characters.
+    RegExpMatch('SkipUntilCharOrChar', 'l[^xy]*[xy]', text, 50),
+    // Skips over a character class.
+    RegExpMatch('SkipUntilBitInTable', '[0-9a-f]+g', hex, 50),
+    RegExpMatch('SkipUntilGtOrNotBitInTable', '[^0-9a-f]', hex, 50),
+  ];
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+  }
+  if (matchCount == 0) throw StateError('No matches');
+}
@@ -16,19 +16,38 @@
 namespace dart {
 namespace bin {
 
-static EventHandler* event_handler = nullptr;
+bool EventHandler::use_io_uring_ = false;
+intptr_t EventHandler::thread_count_ = 1;
+
+static EventHandler** event_handlers = nullptr;
+static intptr_t event_handler_count = 0;
 static Monitor* shutdown_monitor = nullptr;
 
+void EventHandler::set_thread_count(intptr_t thread_count) {
+  thread_count_ = Utils::Minimum(Utils::Maximum(thread_count, intptr_t{1}),
+                                 kMaxThreadCount);
+}
+
 void EventHandler::Start() {
   FileSystemWatcher::InitOnce();
 
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
 
-  ASSERT(event_handler == nullptr);
+  ASSERT(event_handlers == nullptr);
   shutdown_monitor = new Monitor();
-  event_handler = new EventHandler();
-  event_handler->delegate_.Start(event_handler);
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  event_handler_count = thread_count_;
+#else
+  // The other implementations are built around a single delegate (e.g. the
+  // completion port on Windows).
+  event_handler_count = 1;
+#endif
+  event_handlers = new EventHandler*[event_handler_count];
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    event_handlers[i] = new EventHandler();
+    event_handlers[i]->delegate_.Start(event_handlers[i]);
+  }
 
   if (!SocketBase::Initialize()) {
     FATAL("Failed to initialize sockets");
@@ -41,22 +60,27 @@ void EventHandler::NotifyShutdownDone() {
 }
 
 void EventHandler::Stop() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return;
   }
 
-  // Wait until it has stopped.
-  {
+  // Wait until all of them have stopped.
+  for (intptr_t i = 0; i < event_handler_count; i++) {
     MonitorLocker ml(shutdown_monitor);
 
     // Signal to event handler that we want it to stop.
-    event_handler->delegate_.Shutdown();
+    event_handlers[i]->delegate_.Shutdown();
     ml.Wait(Monitor::kNoTimeout);
   }
+  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
 
   // Cleanup
-  delete event_handler;
-  event_handler = nullptr;
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    delete event_handlers[i];
+  }
+  delete[] event_handlers;
+  event_handlers = nullptr;
+  event_handler_count = 0;
   delete shutdown_monitor;
   shutdown_monitor = nullptr;
 
@@ -67,14 +91,35 @@ void EventHandler::Stop() {
 }
 
 EventHandlerImplementation* EventHandler::delegate() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return nullptr;
   }
-  return &event_handler->delegate_;
+  ASSERT(event_handler_count == 1);
+  return &event_handlers[0]->delegate_;
+}
+
+// Sockets are assigned to an event handler thread by the fd they were created
+// with (see Socket::event_handler_key), which does not change when the thread
+// owning the socket closes it. All commands for a descriptor, including a
+// listening socket shared by several isolates (each with its own Socket for
+// the same fd), are therefore handled in order by the same thread, and a
+// reused fd number ends up on the thread which closed its previous owner.
+// Timers are assigned by port.
+EventHandler* EventHandler::ForDescriptor(intptr_t id, Dart_Port port) {
+  if (event_handler_count == 1) {
+    return event_handlers[0];
+  }
+  intptr_t key;
+  if (id == kTimerId) {
+    key = static_cast<intptr_t>(port);
+  } else {
+    key = reinterpret_cast<Socket*>(id)->event_handler_key();
+  }
+  return event_handlers[Utils::WordHash(key) % event_handler_count];
 }
 
 void EventHandler::SendFromNative(intptr_t id, Dart_Port port, int64_t data) {
-  event_handler->SendData(id, port, data);
+  ForDescriptor(id, port)->SendData(id, port, data);
 }
 
 /*
@@ -103,7 +148,7 @@ void FUNCTION_NAME(EventHandler_SendData)(Dart_NativeArguments args) {
     id = reinterpret_cast<intptr_t>(socket);
   }
   int64_t data = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
-  event_handler->SendData(id, dart_port, data);
+  EventHandler::ForDescriptor(id, dart_port)->SendData(id, dart_port, data);
 }
 
 void FUNCTION_NAME(EventHandler_TimerMillisecondClock)(
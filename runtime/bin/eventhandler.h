@@ -632,14 +632,45 @@ class EventHandler {
    */
   static void Stop();
 
+  /**
+   * The delegate of the event handler. Only valid if a single event handler
+   * thread is running, which is always the case outside of Linux.
+   */
   static EventHandlerImplementation* delegate();
 
+  /**
+   * Returns the event handler responsible for the socket [id] (a Socket*),
+   * or for the timer of [port] if [id] is kTimerId.
+   */
+  static EventHandler* ForDescriptor(intptr_t id, Dart_Port port);
+
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  /**
+   * The number of event handler threads. Descriptors are sharded across them
+   * by the fd they were created with. Only honored on Linux. Must be set
+   * before Start.
+   */
+  static intptr_t thread_count() { return thread_count_; }
+  static void set_thread_count(intptr_t thread_count);
+  static constexpr intptr_t kMaxThreadCount = 64;
+
+  /**
+   * Whether to use the io_uring backend instead of epoll. Only honored on
+   * Linux, and only if the kernel supports it. Must be set before Start.
+   */
+  static bool use_io_uring() { return use_io_uring_; }
+  static void set_use_io_uring(bool use_io_uring) {
+    use_io_uring_ = use_io_uring;
+  }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static bool use_io_uring_;
+  static intptr_t thread_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
@@ -70,8 +70,25 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
+// Layout of the io_uring user data: descriptor polls use
+// `(serial << 32) | fd` with a 31-bit serial, everything else has the top bit
+// set. The serial lets us discard completions of requests that were cancelled
+// after their descriptor was closed and the fd number reused.
+static constexpr uint64_t kIOUringTagBit = static_cast<uint64_t>(1) << 63;
+static constexpr uint64_t kIOUringInterruptUserData = kIOUringTagBit | 1;
+static constexpr uint64_t kIOUringIgnoredUserData = kIOUringTagBit | 2;
+static constexpr uint64_t kIOUringTimerTag =
+    kIOUringTagBit | (static_cast<uint64_t>(1) << 62);
+static constexpr uint32_t kIOUringSerialMask = 0x7fffffff;
+static constexpr uint32_t kIOUringEntries = 256;
+
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+    : socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      epoll_fd_(-1),
+      timer_fd_(-1),
+      io_uring_(nullptr),
+      io_uring_serial_(0),
+      io_uring_timer_(0) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe2(interrupt_fds_, O_CLOEXEC));
   if (result != 0) {
@@ -81,6 +98,9 @@ EventHandlerImplementation::EventHandlerImplementation()
     FATAL("Failed to set pipe fd non blocking\n");
   }
   shutdown_ = false;
+  if (EventHandler::use_io_uring() && InitializeIOUring()) {
+    return;
+  }
   // The initial size passed to epoll_create is ignore on newer (>=
   // 2.6.8) Linux versions
   epoll_fd_ = NO_RETRY_EXPECTED(epoll_create1(O_CLOEXEC));
@@ -119,14 +139,22 @@ static void DeleteDescriptorInfo(void* info) {
 
 EventHandlerImplementation::~EventHandlerImplementation() {
   socket_map_.Clear(DeleteDescriptorInfo);
-  close(epoll_fd_);
-  close(timer_fd_);
+  if (io_uring_ != nullptr) {
+    delete io_uring_;
+  } else {
+    close(epoll_fd_);
+    close(timer_fd_);
+  }
   close(interrupt_fds_[0]);
   close(interrupt_fds_[1]);
 }
 
 void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
                                                      DescriptorInfo* di) {
+  if (io_uring_ != nullptr) {
+    UpdateIOUringInstance(old_mask, di);
+    return;
+  }
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
@@ -185,7 +213,7 @@ void EventHandlerImplementation::WakeupHandler(intptr_t id,
   }
 }
 
-void EventHandlerImplementation::HandleInterruptFd() {
+bool EventHandlerImplementation::HandleInterruptFd() {
   const intptr_t MAX_MESSAGES = kInterruptMessageSize;
   InterruptMessage msg[MAX_MESSAGES];
   ssize_t bytes = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
@@ -272,9 +300,14 @@ void EventHandlerImplementation::HandleInterruptFd() {
       }
     }
   }
+  return bytes == MAX_MESSAGES * kInterruptMessageSize;
 }
 
 void EventHandlerImplementation::UpdateTimerFd() {
+  if (io_uring_ != nullptr) {
+    UpdateIOUringTimer();
+    return;
+  }
   struct itimerspec it;
   memset(&it, 0, sizeof(it));
   if (timeout_queue_.HasTimeout()) {
@@ -340,6 +373,21 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
   return event_mask;
 }
 
+void EventHandlerImplementation::HandleDescriptorEvents(DescriptorInfo* di,
+                                                        intptr_t events) {
+  const intptr_t old_mask = di->Mask();
+  const intptr_t event_mask = GetPollEvents(events, di);
+  if ((event_mask & (1 << kErrorEvent)) != 0) {
+    di->NotifyAllDartPorts(event_mask);
+    UpdateEpollInstance(old_mask, di);
+  } else if (event_mask != 0) {
+    Dart_Port port = di->NextNotifyDartPort(event_mask);
+    ASSERT(port != 0);
+    UpdateEpollInstance(old_mask, di);
+    DartUtils::PostInt32(port, event_mask);
+  }
+}
+
 void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
                                               int size) {
   bool interrupt_seen = false;
@@ -356,19 +404,9 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
       }
       UpdateTimerFd();
     } else {
-      DescriptorInfo* di =
-          reinterpret_cast<DescriptorInfo*>(events[i].data.ptr);
-      const intptr_t old_mask = di->Mask();
-      const intptr_t event_mask = GetPollEvents(events[i].events, di);
-      if ((event_mask & (1 << kErrorEvent)) != 0) {
-        di->NotifyAllDartPorts(event_mask);
-        UpdateEpollInstance(old_mask, di);
-      } else if (event_mask != 0) {
-        Dart_Port port = di->NextNotifyDartPort(event_mask);
-        ASSERT(port != 0);
-        UpdateEpollInstance(old_mask, di);
-        DartUtils::PostInt32(port, event_mask);
-      }
+      HandleDescriptorEvents(
+          reinterpret_cast<DescriptorInfo*>(events[i].data.ptr),
+          events[i].events);
     }
   }
   if (interrupt_seen) {
@@ -386,6 +424,9 @@ void EventHandlerImplementation::Poll(uword args) {
   EventHandlerImplementation* handler_impl = &handler->delegate_;
   ASSERT(handler_impl != nullptr);
 
+  if (handler_impl->io_uring_ != nullptr) {
+    handler_impl->PollIOUring();
+  }
   while (!handler_impl->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
         epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
@@ -398,10 +439,163 @@ void EventHandlerImplementation::Poll(uword args) {
       handler_impl->HandleEvents(events, result);
     }
   }
-  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+  // Sockets may still be owned by the other event handler threads, so
+  // EventHandler::Stop checks that all of them were released.
   handler->NotifyShutdownDone();
 }
 
+bool EventHandlerImplementation::InitializeIOUring() {
+  io_uring_ = IOUring::Create(kIOUringEntries);
+  if (io_uring_ == nullptr) {
+    // Fall back to epoll.
+    return false;
+  }
+  ArmIOUringInterrupt();
+  return true;
+}
+
+uint32_t EventHandlerImplementation::NextIOUringSerial() {
+  io_uring_serial_ = (io_uring_serial_ + 1) & kIOUringSerialMask;
+  if (io_uring_serial_ == 0) {
+    io_uring_serial_ = 1;
+  }
+  return io_uring_serial_;
+}
+
+void EventHandlerImplementation::ArmIOUringInterrupt() {
+  // Oneshot, so that messages left in the pipe are reported again once the
+  // request is re-armed.
+  io_uring_->PollAdd(interrupt_fds_[0], EPOLLIN, /*multishot=*/false,
+                     kIOUringInterruptUserData);
+}
+
+void EventHandlerImplementation::ArmIOUringPoll(DescriptorInfo* di) {
+  DisarmIOUringPoll(di);
+  uint32_t events = EPOLLRDHUP | di->GetPollEvents();
+  // Mirror the epoll registration: connected sockets are edge triggered,
+  // which a multishot request with EPOLLET provides. Listening sockets are
+  // level triggered, which a oneshot request that is re-armed after every
+  // completion provides.
+  const bool multishot = !di->IsListeningSocket();
+  if (multishot) {
+    events |= EPOLLET;
+  }
+  const uint64_t user_data =
+      (static_cast<uint64_t>(NextIOUringSerial()) << 32) |
+      static_cast<uint32_t>(di->fd());
+  io_uring_->PollAdd(di->fd(), events, multishot, user_data);
+  di->set_io_uring_user_data(user_data);
+}
+
+void EventHandlerImplementation::DisarmIOUringPoll(DescriptorInfo* di) {
+  if (di->io_uring_user_data() != 0) {
+    io_uring_->PollRemove(di->io_uring_user_data(), kIOUringIgnoredUserData);
+    di->set_io_uring_user_data(0);
+  }
+}
+
+void EventHandlerImplementation::UpdateIOUringInstance(intptr_t old_mask,
+                                                       DescriptorInfo* di) {
+  // Nothing reaches the kernel here: requests are queued and submitted
+  // together with the next wait in PollIOUring.
+  intptr_t new_mask = di->Mask();
+  if (new_mask == 0) {
+    DisarmIOUringPoll(di);
+  } else if ((old_mask != new_mask) || (di->io_uring_user_data() == 0)) {
+    ASSERT((old_mask == 0) || (old_mask == new_mask) ||
+           !di->IsListeningSocket());
+    ArmIOUringPoll(di);
+  }
+}
+
+void EventHandlerImplementation::UpdateIOUringTimer() {
+  if (io_uring_timer_ != 0) {
+    io_uring_->TimeoutRemove(io_uring_timer_, kIOUringIgnoredUserData);
+    io_uring_timer_ = 0;
+  }
+  if (timeout_queue_.HasTimeout()) {
+    io_uring_timer_ = kIOUringTimerTag | NextIOUringSerial();
+    io_uring_->Timeout(timeout_queue_.CurrentTimeout(), io_uring_timer_);
+  }
+}
+
+void EventHandlerImplementation::HandleIOUringCompletion(
+    const IOUring::Completion& completion) {
+  if (completion.user_data == kIOUringIgnoredUserData) {
+    return;
+  }
+  if ((completion.user_data & kIOUringTimerTag) == kIOUringTimerTag) {
+    // Cancelled timers complete with -ECANCELED and are no longer current.
+    if ((completion.user_data != io_uring_timer_) ||
+        (completion.res != -ETIME)) {
+      return;
+    }
+    io_uring_timer_ = 0;
+    if (timeout_queue_.HasTimeout()) {
+      DartUtils::PostNull(timeout_queue_.CurrentPort());
+      timeout_queue_.RemoveCurrent();
+    }
+    UpdateIOUringTimer();
+    return;
+  }
+
+  const intptr_t fd = static_cast<int32_t>(completion.user_data & 0xffffffff);
+  SimpleHashMap::Entry* entry = socket_map_.Lookup(
+      GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), false);
+  DescriptorInfo* di = (entry != nullptr)
+                           ? reinterpret_cast<DescriptorInfo*>(entry->value)
+                           : nullptr;
+  if ((di == nullptr) || (di->io_uring_user_data() != completion.user_data)) {
+    // The request was cancelled, possibly because the descriptor was closed.
+    return;
+  }
+  if (!completion.HasMore()) {
+    di->set_io_uring_user_data(0);
+  }
+  if (completion.res < 0) {
+    // The kernel refused to poll the descriptor. As with a failing
+    // EPOLL_CTL_ADD, report it as closed so dart will handle it accordingly.
+    if (!completion.HasMore()) {
+      di->NotifyAllDartPorts(1 << kCloseEvent);
+    }
+    return;
+  }
+  HandleDescriptorEvents(di, completion.res);
+  // Re-arm oneshot requests and multishot requests which the kernel has
+  // terminated. Descriptors which do not support polling complete
+  // immediately, but every completion consumes a token, so this cannot spin.
+  if ((di->io_uring_user_data() == 0) && (di->Mask() != 0)) {
+    ArmIOUringPoll(di);
+  }
+}
+
+void EventHandlerImplementation::PollIOUring() {
+  while (!shutdown_) {
+    // Submits all interest changes queued while handling the previous batch
+    // together with the wait for the next one.
+    intptr_t result = io_uring_->SubmitAndWait(1);
+    if ((result < 0) && (errno != EBUSY) && (errno != EAGAIN)) {
+      perror("Poll failed");
+    }
+    bool interrupt_seen = false;
+    io_uring_->ForEachCompletion([&](const IOUring::Completion& completion) {
+      if (completion.user_data == kIOUringInterruptUserData) {
+        interrupt_seen = true;
+      } else {
+        HandleIOUringCompletion(completion);
+      }
+    });
+    if (interrupt_seen) {
+      // Handle after socket events, so we avoid closing a socket before we
+      // handle the current events. The interrupt request is oneshot, so
+      // drain the pipe before re-arming it.
+      while (HandleInterruptFd()) {
+      }
+      ArmIOUringInterrupt();
+    }
+  }
+}
+
 void EventHandlerImplementation::Start(EventHandler* handler) {
   Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
                 reinterpret_cast<uword>(handler));
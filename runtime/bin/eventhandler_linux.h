@@ -17,6 +17,8 @@
 #include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
 
+#include "bin/io_uring_linux.h"
+
 namespace dart {
 namespace bin {
 
@@ -33,7 +35,16 @@ class DescriptorInfo : public DescriptorInfoBase {
     fd_ = -1;
   }
 
+  // Identifies the active io_uring poll request for this descriptor, or 0 if
+  // there is none. Only used by the io_uring backend.
+  uint64_t io_uring_user_data() const { return io_uring_user_data_; }
+  void set_io_uring_user_data(uint64_t user_data) {
+    io_uring_user_data_ = user_data;
+  }
+
  private:
+  uint64_t io_uring_user_data_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfo);
 };
 
@@ -62,6 +73,8 @@ class EventHandlerImplementation {
   EventHandlerImplementation();
   ~EventHandlerImplementation();
 
+  // Brings the kernel side registration of [di] in sync with its current
+  // mask. Dispatches to the epoll or io_uring backend.
   void UpdateEpollInstance(intptr_t old_mask, DescriptorInfo* di);
 
   // Gets the socket data structure for a given file
@@ -71,12 +84,29 @@ class EventHandlerImplementation {
   void Start(EventHandler* handler);
   void Shutdown();
 
+  // Whether this handler polls with io_uring rather than epoll. False if
+  // io_uring was requested but is not available.
+  bool UsesIOUring() const { return io_uring_ != nullptr; }
+
  private:
   void HandleEvents(struct epoll_event* events, int size);
   static void Poll(uword args);
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
-  void HandleInterruptFd();
+  // Returns true if the interrupt pipe may still contain messages.
+  bool HandleInterruptFd();
   void UpdateTimerFd();
+  void HandleDescriptorEvents(DescriptorInfo* di, intptr_t events);
+
+  // io_uring backend.
+  bool InitializeIOUring();
+  void PollIOUring();
+  void HandleIOUringCompletion(const IOUring::Completion& completion);
+  void UpdateIOUringInstance(intptr_t old_mask, DescriptorInfo* di);
+  void ArmIOUringPoll(DescriptorInfo* di);
+  void DisarmIOUringPoll(DescriptorInfo* di);
+  void ArmIOUringInterrupt();
+  void UpdateIOUringTimer();
+  uint32_t NextIOUringSerial();
   void SetPort(intptr_t fd, Dart_Port dart_port, intptr_t mask);
   intptr_t GetPollEvents(intptr_t events, DescriptorInfo* di);
   static void* GetHashmapKeyFromFd(intptr_t fd);
@@ -88,6 +118,11 @@ class EventHandlerImplementation {
   int interrupt_fds_[2];
   int epoll_fd_;
   int timer_fd_;
+  // Non-null if the io_uring backend is in use, in which case [epoll_fd_] and
+  // [timer_fd_] are not created.
+  IOUring* io_uring_;
+  uint32_t io_uring_serial_;
+  uint64_t io_uring_timer_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
@@ -3,7 +3,18 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/eventhandler.h"
+
+#if defined(DART_HOST_OS_LINUX)
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+#endif
+
+#include "bin/lockers.h"
+#include "bin/socket.h"
+#include "bin/utils.h"
+#include "include/dart_native_api.h"
 #include "platform/assert.h"
+#include "platform/growable_array.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -79,5 +90,257 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
   list.Remove(4242);
 }
 
+#if defined(DART_HOST_OS_LINUX)
+
+// Restarts the event handler threads with the given configuration, and
+// restores the default one when it goes out of scope.
+class EventHandlerConfigScope : public ValueObject {
+ public:
+  EventHandlerConfigScope(intptr_t thread_count, bool use_io_uring) {
+    EventHandler::Stop();
+    EventHandler::set_thread_count(thread_count);
+    EventHandler::set_use_io_uring(use_io_uring);
+    EventHandler::Start();
+  }
+
+  ~EventHandlerConfigScope() {
+    EventHandler::Stop();
+    EventHandler::set_thread_count(1);
+    EventHandler::set_use_io_uring(false);
+    EventHandler::Start();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(EventHandlerConfigScope);
+};
+
+// Records the messages the event handler posts to native ports.
+class EventLog {
+ public:
+  // Posted for an expired timer.
+  static constexpr int64_t kTimerEvent = -1;
+  // Returned if nothing is posted in time.
+  static constexpr int64_t kNoEvent = -2;
+
+  EventLog() {
+    ASSERT(current_ == nullptr);
+    current_ = this;
+  }
+
+  ~EventLog() {
+    for (intptr_t i = 0; i < ports_.length(); i++) {
+      Dart_CloseNativePort(ports_[i]);
+    }
+    current_ = nullptr;
+  }
+
+  Dart_Port NewPort() {
+    Dart_Port port = Dart_NewNativePort("EventLog", &HandleMessage,
+                                        /*handle_concurrently=*/false);
+    EXPECT(port != ILLEGAL_PORT);
+    ports_.Add(port);
+    return port;
+  }
+
+  // Waits for the next message posted to [port] and returns it.
+  int64_t Next(Dart_Port port) {
+    const int64_t deadline = TimerUtils::GetCurrentMonotonicMillis() + 10000;
+    MonitorLocker ml(&monitor_);
+    while (true) {
+      for (intptr_t i = 0; i < events_.length(); i++) {
+        if (events_[i].port == port) {
+          const int64_t value = events_[i].value;
+          events_.RemoveAt(i);
+          return value;
+        }
+      }
+      const int64_t now = TimerUtils::GetCurrentMonotonicMillis();
+      if (now >= deadline) {
+        return kNoEvent;
+      }
+      ml.Wait(deadline - now);
+    }
+  }
+
+ private:
+  struct Event {
+    Dart_Port port;
+    int64_t value;
+  };
+
+  static void HandleMessage(Dart_Port port, Dart_CObject* message) {
+    EventLog* log = current_;
+    MonitorLocker ml(&log->monitor_);
+    if (message->type == Dart_CObject_kInt32) {
+      log->events_.Add({port, message->value.as_int32});
+    } else {
+      EXPECT_EQ(Dart_CObject_kNull, message->type);
+      log->events_.Add({port, kTimerEvent});
+    }
+    ml.NotifyAll();
+  }
+
+  static EventLog* current_;
+
+  Monitor monitor_;
+  MallocGrowableArray<Event> events_;
+  MallocGrowableArray<Dart_Port> ports_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventLog);
+};
+
+EventLog* EventLog::current_ = nullptr;
+
+// Sends a command for [socket] to its event handler, which releases the
+// reference it is given.
+static void SendSocketCommand(Socket* socket, Dart_Port port, int64_t data) {
+  socket->Retain();
+  EventHandler::SendFromNative(reinterpret_cast<intptr_t>(socket), port,
+                               data);
+}
+
+static void SetEventMask(Socket* socket, Dart_Port port, intptr_t events) {
+  SendSocketCommand(socket, port, (1 << kSetEventMaskCommand) | events);
+}
+
+static bool HasEvent(int64_t value, intptr_t event) {
+  return value >= 0 && (value & (1 << event)) != 0;
+}
+
+// Goes through the events of a connected socket: readable, writable, closed
+// by the peer and finally destroyed by a close command.
+static void TestSocketEvents(EventLog* log) {
+  int fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          0, fds));
+  Socket* socket = new Socket(fds[0]);
+  const Dart_Port port = log->NewPort();
+
+  SetEventMask(socket, port, 1 << kInEvent);
+  const char byte = 42;
+  EXPECT_EQ(1, write(fds[1], &byte, 1));
+  EXPECT(HasEvent(log->Next(port), kInEvent));
+
+  char buffer;
+  EXPECT_EQ(1, read(fds[0], &buffer, 1));
+  EXPECT_EQ(byte, buffer);
+  SetEventMask(socket, port, 1 << kOutEvent);
+  EXPECT(HasEvent(log->Next(port), kOutEvent));
+
+  SetEventMask(socket, port, 1 << kInEvent);
+  close(fds[1]);
+  EXPECT(HasEvent(log->Next(port), kCloseEvent));
+
+  SendSocketCommand(socket, port, 1 << kCloseCommand);
+  EXPECT(HasEvent(log->Next(port), kDestroyedEvent));
+  EXPECT_EQ(-1, socket->fd());
+  socket->Release();
+}
+
+static void TestTimerEvents(EventLog* log) {
+  const Dart_Port early = log->NewPort();
+  const Dart_Port late = log->NewPort();
+  const int64_t now = TimerUtils::GetCurrentMonotonicMillis();
+  EventHandler::SendFromNative(kTimerId, late, now + 20);
+  EventHandler::SendFromNative(kTimerId, early, now + 10);
+  EXPECT_EQ(EventLog::kTimerEvent, log->Next(early));
+  EXPECT_EQ(EventLog::kTimerEvent, log->Next(late));
+}
+
+// Sockets and timers spread over several event handler threads get their
+// events posted by the thread they were assigned to.
+static void TestShardedEvents(EventLog* log) {
+  const intptr_t kSocketCount = 16;
+  Socket* sockets[kSocketCount];
+  int peers[kSocketCount];
+  Dart_Port ports[kSocketCount];
+  EventHandler* handlers[kSocketCount];
+  intptr_t distinct_handlers = 0;
+  for (intptr_t i = 0; i < kSocketCount; i++) {
+    int fds[2];
+    EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                            0, fds));
+    sockets[i] = new Socket(fds[0]);
+    peers[i] = fds[1];
+    ports[i] = log->NewPort();
+    handlers[i] = EventHandler::ForDescriptor(
+        reinterpret_cast<intptr_t>(sockets[i]), ports[i]);
+    bool seen = false;
+    for (intptr_t j = 0; j < i; j++) {
+      seen = seen || handlers[j] == handlers[i];
+    }
+    if (!seen) distinct_handlers++;
+    SetEventMask(sockets[i], ports[i], 1 << kInEvent);
+  }
+  EXPECT(distinct_handlers > 1);
+
+  for (intptr_t i = 0; i < kSocketCount; i++) {
+    const char byte = i;
+    EXPECT_EQ(1, write(peers[i], &byte, 1));
+  }
+  for (intptr_t i = 0; i < kSocketCount; i++) {
+    EXPECT(HasEvent(log->Next(ports[i]), kInEvent));
+  }
+
+  for (intptr_t i = 0; i < kSocketCount; i++) {
+    SendSocketCommand(sockets[i], ports[i], 1 << kCloseCommand);
+    EXPECT(HasEvent(log->Next(ports[i]), kDestroyedEvent));
+    // Closing the socket does not move it to another thread.
+    const intptr_t id = reinterpret_cast<intptr_t>(sockets[i]);
+    EXPECT(handlers[i] == EventHandler::ForDescriptor(id, ports[i]));
+    close(peers[i]);
+    sockets[i]->Release();
+  }
+
+  const int64_t now = TimerUtils::GetCurrentMonotonicMillis();
+  for (intptr_t i = 0; i < kSocketCount; i++) {
+    EventHandler::SendFromNative(kTimerId, ports[i], now + kSocketCount - i);
+  }
+  for (intptr_t i = 0; i < kSocketCount; i++) {
+    EXPECT_EQ(EventLog::kTimerEvent, log->Next(ports[i]));
+  }
+}
+
+#endif  // defined(DART_HOST_OS_LINUX)
+
 }  // namespace bin
+
+#if defined(DART_HOST_OS_LINUX)
+
+TEST_CASE(EventHandler_EpollEvents) {
+  bin::EventHandlerConfigScope config(/*thread_count=*/1,
+                                      /*use_io_uring=*/false);
+  bin::EventLog log;
+  bin::TestSocketEvents(&log);
+  bin::TestTimerEvents(&log);
+}
+
+TEST_CASE(EventHandler_IOUringEvents) {
+  // The event handler quietly falls back to epoll, so probe for io_uring
+  // support separately to tell a missing kernel feature from a broken backend.
+  bin::IOUring* probe = bin::IOUring::Create(/*entries=*/8);
+  if (probe == nullptr) {
+    OS::PrintErr("Skipping EventHandler_IOUringEvents: io_uring is not "
+                 "available\n");
+    return;
+  }
+  delete probe;
+
+  bin::EventHandlerConfigScope config(/*thread_count=*/1,
+                                      /*use_io_uring=*/true);
+  EXPECT(bin::EventHandler::delegate()->UsesIOUring());
+  bin::EventLog log;
+  bin::TestSocketEvents(&log);
+  bin::TestTimerEvents(&log);
+}
+
+TEST_CASE(EventHandler_ShardedEvents) {
+  bin::EventHandlerConfigScope config(/*thread_count=*/4,
+                                      /*use_io_uring=*/false);
+  bin::EventLog log;
+  bin::TestShardedEvents(&log);
+}
+
+#endif  // defined(DART_HOST_OS_LINUX)
+
 }  // namespace dart
@@ -0,0 +1,334 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+
+#include "bin/eventhandler.h"
+#include "bin/io_uring_linux.h"
+
+#include <errno.h>          // NOLINT
+#include <string.h>         // NOLINT
+#include <sys/eventfd.h>    // NOLINT
+#include <sys/mman.h>       // NOLINT
+#include <sys/syscall.h>    // NOLINT
+#include <unistd.h>         // NOLINT
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>  // NOLINT
+#define DART_HAS_IO_URING 1
+#endif
+
+#include "bin/fdutils.h"
+#include "platform/signal_blocker.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+#if defined(DART_HAS_IO_URING) && defined(__NR_io_uring_setup) &&              \
+    defined(__NR_io_uring_enter)
+
+// Older kernel headers do not know about multishot poll (Linux 5.13).
+#if !defined(IORING_POLL_ADD_MULTI)
+#define IORING_POLL_ADD_MULTI (1U << 0)
+#endif
+#if !defined(IORING_CQE_F_MORE)
+#define IORING_CQE_F_MORE (1U << 1)
+#endif
+
+static int IOUringSetup(uint32_t entries, struct io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int IOUringEnter(int ring_fd,
+                        uint32_t to_submit,
+                        uint32_t min_complete,
+                        uint32_t flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+bool IOUring::Completion::HasMore() const {
+  return (flags & IORING_CQE_F_MORE) != 0;
+}
+
+IOUring::IOUring(int ring_fd, uint32_t sq_entries, uint32_t cq_entries)
+    : ring_fd_(ring_fd), sq_entries_(sq_entries), cq_entries_(cq_entries) {}
+
+IOUring::~IOUring() {
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (ring_ != nullptr) {
+    munmap(ring_, ring_size_);
+  }
+  // Closing the ring cancels all requests which are still in flight.
+  close(ring_fd_);
+}
+
+IOUring* IOUring::Create(uint32_t entries) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const int ring_fd = IOUringSetup(entries, &params);
+  if (ring_fd < 0) {
+    // ENOSYS on kernels without io_uring, EPERM if it has been disabled via
+    // the kernel.io_uring_disabled sysctl or by a seccomp filter.
+    return nullptr;
+  }
+  // We rely on a single mapping for both rings (Linux 5.4) and on the kernel
+  // never dropping completions when the completion queue overflows
+  // (Linux 5.5).
+  const uint32_t kRequiredFeatures =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    close(ring_fd);
+    return nullptr;
+  }
+  IOUring* ring = new IOUring(ring_fd, params.sq_entries, params.cq_entries);
+  if (!ring->Map(&params) || !ring->ProbeMultishotPoll()) {
+    delete ring;
+    return nullptr;
+  }
+  return ring;
+}
+
+bool IOUring::Map(const void* params_ptr) {
+  const struct io_uring_params* params =
+      reinterpret_cast<const struct io_uring_params*>(params_ptr);
+  ring_size_ = Utils::Maximum(
+      static_cast<size_t>(params->sq_off.array) +
+          sq_entries_ * sizeof(uint32_t),
+      static_cast<size_t>(params->cq_off.cqes) +
+          cq_entries_ * sizeof(struct io_uring_cqe));
+  void* ring = mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (ring == MAP_FAILED) {
+    return false;
+  }
+  ring_ = ring;
+  sqes_size_ = sq_entries_ * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return false;
+  }
+  sqes_ = sqes;
+
+  uint8_t* base = reinterpret_cast<uint8_t*>(ring_);
+  sq_head_ = reinterpret_cast<uint32_t*>(base + params->sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(base + params->sq_off.tail);
+  sq_mask_ = *reinterpret_cast<uint32_t*>(base + params->sq_off.ring_mask);
+  cq_head_ = reinterpret_cast<uint32_t*>(base + params->cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(base + params->cq_off.tail);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(base + params->cq_off.ring_mask);
+  cqes_ = base + params->cq_off.cqes;
+
+  // Submission queue entries are always used in order, so the indirection
+  // array is set up as an identity mapping once.
+  uint32_t* array = reinterpret_cast<uint32_t*>(base + params->sq_off.array);
+  for (uint32_t i = 0; i < sq_entries_; i++) {
+    array[i] = i;
+  }
+  sqe_tail_ = *sq_tail_;
+  return true;
+}
+
+// Multishot poll requests are silently treated as invalid by kernels older
+// than 5.13, and there is no feature bit for them. Arm one on an eventfd which
+// is already readable and check that the kernel keeps it active.
+bool IOUring::ProbeMultishotPoll() {
+  const int probe_fd = NO_RETRY_EXPECTED(eventfd(1, EFD_CLOEXEC));
+  if (probe_fd < 0) {
+    return false;
+  }
+  const uint64_t kProbeUserData = 1;
+  const uint64_t kProbeRemoveUserData = 2;
+  PollAdd(probe_fd, EPOLLIN, /*multishot=*/true, kProbeUserData);
+  bool supported = false;
+  intptr_t outstanding = 1;
+  if (SubmitAndWait(1) >= 0) {
+    ForEachCompletion([&](const Completion& completion) {
+      if (completion.user_data == kProbeUserData) {
+        supported = completion.res > 0 && completion.HasMore();
+        if (!completion.HasMore()) {
+          outstanding--;
+        }
+      }
+    });
+  }
+  if (outstanding > 0) {
+    // Tear the probe down again, so it does not show up as a completion of
+    // the event handler.
+    PollRemove(kProbeUserData, kProbeRemoveUserData);
+    outstanding++;
+    while (outstanding > 0 && SubmitAndWait(1) >= 0) {
+      ForEachCompletion([&](const Completion& completion) {
+        if (completion.user_data == kProbeRemoveUserData ||
+            !completion.HasMore()) {
+          outstanding--;
+        }
+      });
+    }
+  }
+  close(probe_fd);
+  return supported && (outstanding == 0);
+}
+
+void* IOUring::NextSqe() {
+  if (sqe_tail_ - LoadAcquire(sq_head_) == sq_entries_) {
+    // The submission queue is full. Hand the queued entries to the kernel
+    // without waiting for completions.
+    if (SubmitAndWait(0) < 0 || sqe_tail_ - LoadAcquire(sq_head_) ==
+                                    sq_entries_) {
+      FATAL("io_uring submission queue overflow: %s", strerror(errno));
+    }
+  }
+  struct io_uring_sqe* sqe =
+      &reinterpret_cast<struct io_uring_sqe*>(sqes_)[sqe_tail_ & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe_tail_++;
+  return sqe;
+}
+
+void IOUring::PollAdd(intptr_t fd,
+                      uint32_t events,
+                      bool multishot,
+                      uint64_t user_data) {
+  struct io_uring_sqe* sqe = reinterpret_cast<struct io_uring_sqe*>(NextSqe());
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = static_cast<int32_t>(fd);
+  // The 32-bit event mask is stored in native (little endian) order.
+  sqe->poll32_events = events;
+  sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+  sqe->user_data = user_data;
+}
+
+void IOUring::PollRemove(uint64_t target, uint64_t user_data) {
+  struct io_uring_sqe* sqe = reinterpret_cast<struct io_uring_sqe*>(NextSqe());
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = target;
+  sqe->user_data = user_data;
+}
+
+void IOUring::Timeout(int64_t millis, uint64_t user_data) {
+  struct io_uring_sqe* sqe = reinterpret_cast<struct io_uring_sqe*>(NextSqe());
+  timeout_spec_.tv_sec = millis / 1000;
+  timeout_spec_.tv_nsec = (millis % 1000) * 1000000;
+  static_assert(sizeof(timeout_spec_) == sizeof(struct __kernel_timespec),
+                "timeout_spec_ must match the kernel layout");
+  sqe->opcode = IORING_OP_TIMEOUT;
+  sqe->fd = -1;
+  sqe->addr = reinterpret_cast<uint64_t>(&timeout_spec_);
+  sqe->len = 1;
+  // A completion count of 0 makes this a pure timer.
+  sqe->off = 0;
+  sqe->timeout_flags = IORING_TIMEOUT_ABS;
+  sqe->user_data = user_data;
+}
+
+void IOUring::TimeoutRemove(uint64_t target, uint64_t user_data) {
+  struct io_uring_sqe* sqe = reinterpret_cast<struct io_uring_sqe*>(NextSqe());
+  sqe->opcode = IORING_OP_TIMEOUT_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = target;
+  sqe->user_data = user_data;
+}
+
+intptr_t IOUring::Enter(uint32_t to_submit, uint32_t wait_nr) {
+  const uint32_t flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+  return TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+      IOUringEnter(ring_fd_, to_submit, wait_nr, flags));
+}
+
+intptr_t IOUring::SubmitAndWait(uint32_t wait_nr) {
+  StoreRelease(sq_tail_, sqe_tail_);
+  const uint32_t to_submit = sqe_tail_ - LoadAcquire(sq_head_);
+  return Enter(to_submit, wait_nr);
+}
+
+IOUring::Completion IOUring::CompletionAt(uint32_t index) const {
+  const struct io_uring_cqe* cqe =
+      &reinterpret_cast<const struct io_uring_cqe*>(cqes_)[index & cq_mask_];
+  Completion completion;
+  completion.user_data = cqe->user_data;
+  completion.res = cqe->res;
+  completion.flags = cqe->flags;
+  return completion;
+}
+
+#else  // defined(DART_HAS_IO_URING) && ...
+
+// The headers we build against do not know about io_uring: always fall back
+// to epoll.
+
+bool IOUring::Completion::HasMore() const {
+  return false;
+}
+
+IOUring::IOUring(int ring_fd, uint32_t sq_entries, uint32_t cq_entries)
+    : ring_fd_(ring_fd), sq_entries_(sq_entries), cq_entries_(cq_entries) {}
+
+IOUring::~IOUring() {}
+
+IOUring* IOUring::Create(uint32_t entries) {
+  return nullptr;
+}
+
+bool IOUring::Map(const void* params) {
+  UNREACHABLE();
+  return false;
+}
+
+bool IOUring::ProbeMultishotPoll() {
+  UNREACHABLE();
+  return false;
+}
+
+void* IOUring::NextSqe() {
+  UNREACHABLE();
+  return nullptr;
+}
+
+void IOUring::PollAdd(intptr_t fd,
+                      uint32_t events,
+                      bool multishot,
+                      uint64_t user_data) {
+  UNREACHABLE();
+}
+
+void IOUring::PollRemove(uint64_t target, uint64_t user_data) {
+  UNREACHABLE();
+}
+
+void IOUring::Timeout(int64_t millis, uint64_t user_data) {
+  UNREACHABLE();
+}
+
+void IOUring::TimeoutRemove(uint64_t target, uint64_t user_data) {
+  UNREACHABLE();
+}
+
+intptr_t IOUring::Enter(uint32_t to_submit, uint32_t wait_nr) {
+  UNREACHABLE();
+  return -1;
+}
+
+intptr_t IOUring::SubmitAndWait(uint32_t wait_nr) {
+  UNREACHABLE();
+  return -1;
+}
+
+IOUring::Completion IOUring::CompletionAt(uint32_t index) const {
+  UNREACHABLE();
+  return Completion();
+}
+
+#endif  // defined(DART_HAS_IO_URING) && ...
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
@@ -0,0 +1,141 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_IO_URING_LINUX_H_
+#define RUNTIME_BIN_IO_URING_LINUX_H_
+
+#if !defined(RUNTIME_BIN_EVENTHANDLER_LINUX_H_)
+#error Do not include io_uring_linux.h directly; use eventhandler.h instead.
+#endif
+
+#include "platform/globals.h"
+
+namespace dart {
+namespace bin {
+
+// A minimal wrapper around the raw io_uring system calls which is used by the
+// Linux event handler to batch interest registration and timer updates into
+// a single io_uring_enter(2) call per poll iteration.
+//
+// Submission queue entries are only handed to the kernel when [SubmitAndWait]
+// is called (or when the submission queue runs full), so a burst of interest
+// changes produced while handling one batch of completions costs exactly one
+// system call.
+//
+// This class is not thread safe. It is only used from the event handler
+// thread.
+class IOUring {
+ public:
+  struct Completion {
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+
+    // Whether the request which produced this completion is still active
+    // (i.e. this is an intermediate completion of a multishot request).
+    bool HasMore() const;
+  };
+
+  ~IOUring();
+
+  // Creates a new ring with room for [entries] submissions. Returns nullptr
+  // if io_uring is not available (old kernel, seccomp filters, disabled via
+  // sysctl) or if the kernel lacks multishot poll support.
+  static IOUring* Create(uint32_t entries);
+
+  // Queues a poll request for [fd]. [events] is an epoll(7) style event mask.
+  // If [multishot] is true the request stays armed after producing a
+  // completion.
+  void PollAdd(intptr_t fd, uint32_t events, bool multishot, uint64_t user_data);
+
+  // Queues the cancellation of the poll request identified by [target]. The
+  // cancelled request completes with -ECANCELED, the cancellation itself
+  // completes with [user_data].
+  void PollRemove(uint64_t target, uint64_t user_data);
+
+  // Queues a timer which fires at the absolute CLOCK_MONOTONIC time
+  // [millis]. The timer completes with -ETIME when it fires.
+  void Timeout(int64_t millis, uint64_t user_data);
+
+  // Queues the cancellation of the timer identified by [target].
+  void TimeoutRemove(uint64_t target, uint64_t user_data);
+
+  // Hands all queued requests to the kernel and blocks until at least
+  // [wait_nr] completions are available. Returns -1 and sets errno on
+  // failure.
+  intptr_t SubmitAndWait(uint32_t wait_nr);
+
+  // Invokes [callback] on every available completion and marks them as
+  // consumed. [callback] may queue new requests. Returns the number of
+  // completions visited.
+  template <typename F>
+  intptr_t ForEachCompletion(F callback) {
+    uint32_t head = *cq_head_;
+    const uint32_t tail = LoadAcquire(cq_tail_);
+    intptr_t count = 0;
+    while (head != tail) {
+      callback(CompletionAt(head));
+      head++;
+      count++;
+    }
+    StoreRelease(cq_head_, head);
+    return count;
+  }
+
+ private:
+  IOUring(int ring_fd, uint32_t sq_entries, uint32_t cq_entries);
+
+  bool Map(const void* params);
+  bool ProbeMultishotPoll();
+
+  // Returns a cleared submission queue entry, flushing the queue to the
+  // kernel first if it is full.
+  void* NextSqe();
+  intptr_t Enter(uint32_t to_submit, uint32_t wait_nr);
+  Completion CompletionAt(uint32_t index) const;
+
+  static uint32_t LoadAcquire(const uint32_t* ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+  }
+  static void StoreRelease(uint32_t* ptr, uint32_t value) {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+  }
+
+  const int ring_fd_;
+  const uint32_t sq_entries_;
+  const uint32_t cq_entries_;
+
+  // Mappings shared with the kernel.
+  void* ring_ = nullptr;
+  size_t ring_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  const void* cqes_ = nullptr;
+
+  // Local copy of the submission tail. Entries between the kernel visible
+  // tail and this one have been filled in but not yet published.
+  uint32_t sqe_tail_ = 0;
+
+  // Backing store for the deadlines of queued but not yet submitted timers.
+  // The kernel copies the value when the request is submitted, so only the
+  // latest deadline needs to be kept.
+  struct {
+    int64_t tv_sec;
+    long long tv_nsec;  // NOLINT
+  } timeout_spec_;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUring);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_IO_URING_LINUX_H_
@@ -10,6 +10,7 @@
 
 #include "bin/common_options.h"
 #include "bin/error_exit.h"
+#include "bin/eventhandler.h"
 #include "bin/file_system_watcher.h"
 #if defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/io_service_no_ssl.h"
@@ -41,6 +42,21 @@ static const char* const kSnapshotKindNames[] = {
 
 SnapshotKind Options::gen_snapshot_kind_ = kNone;
 
+DEFINE_STRING_OPTION_CB(event_handler_threads, {
+  // Out of range values are clamped by strtol and rejected below.
+  char* end = nullptr;
+  const intptr_t count = strtol(value, &end, 10);
+  if ((*end != '\0') || (count <= 0) ||
+      (count > EventHandler::kMaxThreadCount)) {
+    Syslog::PrintErr(
+        "Invalid value for event_handler_threads: '%s'\n"
+        "Use --event_handler_threads=<n> with 1 <= n <= %" Pd "\n",
+        value, EventHandler::kMaxThreadCount);
+    return false;
+  }
+  EventHandler::set_thread_count(count);
+});
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 DFE* Options::dfe_ = nullptr;
 
@@ -173,6 +189,7 @@ bool Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  EventHandler::set_use_io_uring(Options::use_io_uring());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
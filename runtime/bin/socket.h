@@ -51,6 +51,11 @@ class Socket : public ReferenceCounted<Socket> {
 
   intptr_t fd() const { return fd_; }
 
+  // The fd the socket was created with. Unlike fd() it does not change when
+  // the socket is closed, so it can be read from any thread. The event
+  // handler uses it to pick the thread responsible for the socket.
+  intptr_t event_handler_key() const { return event_handler_key_; }
+
   // Close fd and may need to decrement the count of handle by calling
   // release().
   void CloseFd();
@@ -125,6 +130,7 @@ class Socket : public ReferenceCounted<Socket> {
   static bool short_socket_write_;
 
   intptr_t fd_;
+  const intptr_t event_handler_key_;
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
@@ -68,6 +68,11 @@ DART_EXPORT void DartEngine_SetMessageScheduler(
   Engine::instance()->SetMessageScheduler(scheduler, isolate);
 }
 
+DART_EXPORT void DartEngine_SetMessageBatchSize(intptr_t batch_size,
+                                                Dart_Isolate isolate) {
+  Engine::instance()->SetMessageBatchSize(batch_size, isolate);
+}
+
 DART_EXPORT void DartEngine_HandleMessage(Dart_Isolate isolate) {
   Engine::instance()->HandleMessage(isolate);
 }
@@ -4,6 +4,7 @@
 
 #include "engine/engine.h"
 #include <errno.h>
+#include <algorithm>
 #include <memory>
 #include "bin/dartutils.h"
 #include "include/dart_api.h"
@@ -265,24 +266,70 @@ void Engine::Shutdown() {
 }
 
 void Engine::HandleMessage(Dart_Isolate isolate) {
-  LockIsolate(isolate);
+  std::shared_ptr<Engine::IsolateData> isolate_data = DataForIsolate(isolate);
+  if (isolate_data->batch_size <= 1) {
+    isolate_data->mutex.Lock();
+    HandleMessagesLocked(isolate, 1);
+    isolate_data->mutex.Unlock();
+    return;
+  }
+
+  while (true) {
+    // Notifications are also sent for OOB messages, which Dart_HandleMessage
+    // handles before normal ones, so this might be more than the number of
+    // messages left. Dart_HandleMessage does nothing if there are none.
+    const intptr_t batch = std::min(isolate_data->pending_messages.load(),
+                                    isolate_data->batch_size);
+
+    isolate_data->mutex.Lock();
+    if (!is_running_) {
+      // The isolate was shut down while we waited for it.
+      isolate_data->mutex.Unlock();
+      return;
+    }
+    HandleMessagesLocked(isolate, std::max<intptr_t>(batch, 1));
+    isolate_data->mutex.Unlock();
+
+    if (batch == 0 ||
+        isolate_data->pending_messages.fetch_sub(batch) <= batch) {
+      return;
+    }
+
+    // Messages were posted after the batch started, or did not fit into it.
+    // Their notifications did not call the scheduler, so do it now.
+    if (engine_lifecycle_.TryLock()) {
+      DartEngine_MessageScheduler scheduler = SchedulerFor(isolate_data.get());
+      if (is_running_ && scheduler.schedule_callback != nullptr) {
+        scheduler.schedule_callback(isolate, scheduler.context);
+      }
+      engine_lifecycle_.Unlock();
+      return;
+    }
+    // The lock is held by Shutdown, or by a NotifyMessage call which might be
+    // waiting for us to return. Keep handling messages here instead.
+  }
+}
+
+void Engine::HandleMessagesLocked(Dart_Isolate isolate, intptr_t count) {
   Dart_EnterIsolate(isolate);
   Dart_EnterScope();
 
-  Dart_Handle handle_result = Dart_HandleMessage();
+  // Dart_HandleMessage drains the microtasks queue after each message.
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_Handle handle_result = Dart_HandleMessage();
 
-  if (Dart_IsError(handle_result)) {
-    if (handle_message_error_callback_ != nullptr) {
-      handle_message_error_callback_(handle_result, isolate);
-    } else {
-      Syslog::PrintErr("Error handling isolate message: %s",
-                       Dart_GetError(handle_result));
+    if (Dart_IsError(handle_result)) {
+      if (handle_message_error_callback_ != nullptr) {
+        handle_message_error_callback_(handle_result, isolate);
+      } else {
+        Syslog::PrintErr("Error handling isolate message: %s",
+                         Dart_GetError(handle_result));
+      }
     }
   }
 
   Dart_ExitScope();
   Dart_ExitIsolate();
-  UnlockIsolate(isolate);
 }
 
 Dart_Handle Engine::DrainMicrotasksQueue() {
@@ -334,19 +381,29 @@ void Engine::NotifyMessage(Dart_Isolate isolate) {
     return;
   }
 
-  DartEngine_MessageScheduler scheduler = DataForIsolate(isolate)->scheduler;
-
-  if (scheduler.schedule_callback == nullptr) {
-    scheduler = default_scheduler_;
-  }
+  std::shared_ptr<Engine::IsolateData> isolate_data = DataForIsolate(isolate);
+  DartEngine_MessageScheduler scheduler = SchedulerFor(isolate_data.get());
   if (scheduler.schedule_callback == nullptr) {
     engine_lifecycle_.Unlock();
     return;
   }
-  scheduler.schedule_callback(isolate, scheduler.context);
+  // In batched mode, only the first notification schedules a call to
+  // HandleMessage, which handles the messages of the later ones as well.
+  if (isolate_data->batch_size <= 1 ||
+      isolate_data->pending_messages.fetch_add(1) == 0) {
+    scheduler.schedule_callback(isolate, scheduler.context);
+  }
   engine_lifecycle_.Unlock();
 }
 
+DartEngine_MessageScheduler Engine::SchedulerFor(IsolateData* isolate_data) {
+  DartEngine_MessageScheduler scheduler = isolate_data->scheduler;
+  if (scheduler.schedule_callback == nullptr) {
+    scheduler = default_scheduler_;
+  }
+  return scheduler;
+}
+
 void Engine::SetHandleMessageErrorCallback(
     DartEngine_HandleMessageErrorCallback callback) {
   handle_message_error_callback_ = callback;
@@ -361,5 +418,9 @@ void Engine::SetMessageScheduler(DartEngine_MessageScheduler scheduler,
   DataForIsolate(isolate)->scheduler = scheduler;
 }
 
+void Engine::SetMessageBatchSize(intptr_t batch_size, Dart_Isolate isolate) {
+  DataForIsolate(isolate)->batch_size = batch_size;
+}
+
 }  // namespace engine
 }  // namespace dart
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_ENGINE_ENGINE_H_
 #define RUNTIME_ENGINE_ENGINE_H_
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -51,6 +52,9 @@ class Engine {
   void NotifyMessage(Dart_Isolate isolate);
 
   // Calls Dart_HandleMessage, managing an isolate lock and Dart scope.
+  //
+  // In batched mode calls it for up to the batch size of pending messages,
+  // and schedules another call if messages are left.
   void HandleMessage(Dart_Isolate isolate);
 
   // Drains the microtasks queue, requires an active isolate.
@@ -72,6 +76,10 @@ class Engine {
   void SetMessageScheduler(DartEngine_MessageScheduler scheduler,
                            Dart_Isolate isolate);
 
+  // Sets the maximum number of messages handled by one HandleMessage call for
+  // a given isolate. Batch sizes above 1 also coalesce notifications.
+  void SetMessageBatchSize(intptr_t batch_size, Dart_Isolate isolate);
+
   // Initializes embedder and partially initializes Dart VM.
   //
   // Full initialization happens only when the user starts the first isolate, as
@@ -97,6 +105,11 @@ class Engine {
     Mutex mutex;
     Dart_PersistentHandle isolate_library;
     Dart_PersistentHandle drain_microtasks_function_name;
+    intptr_t batch_size = 1;
+    // In batched mode, the number of notifications since the last
+    // HandleMessage call. The scheduler is only called when it becomes
+    // non-zero.
+    std::atomic<intptr_t> pending_messages = {0};
   };
 
   // Set to false once shutdown starts.
@@ -139,6 +152,13 @@ class Engine {
 
   // Helper function to get an element from isolate_data_.
   std::shared_ptr<IsolateData> DataForIsolate(Dart_Isolate isolate);
+
+  // Returns isolate-specific message scheduler, or the default one.
+  DartEngine_MessageScheduler SchedulerFor(IsolateData* isolate_data);
+
+  // Enters the isolate and calls Dart_HandleMessage [count] times. Requires
+  // the isolate lock to be held.
+  void HandleMessagesLocked(Dart_Isolate isolate, intptr_t count);
 };
 
 }  // namespace engine
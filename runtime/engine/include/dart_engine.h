@@ -124,6 +124,10 @@ DART_EXPORT Dart_Handle DartEngine_DrainMicrotasksQueue();
 
 /**
  * Handles a single message for an isolate.
+ *
+ * If batched message handling is enabled for the isolate (see
+ * \ref DartEngine_SetMessageBatchSize), handles up to the batch size of
+ * pending messages instead, entering the isolate only once.
  */
 DART_EXPORT void DartEngine_HandleMessage(Dart_Isolate isolate);
 
@@ -164,6 +168,25 @@ DART_EXPORT void DartEngine_SetMessageScheduler(
     DartEngine_MessageScheduler scheduler,
     Dart_Isolate isolate);
 
+/**
+ * Enables batched message handling for isolate.
+ *
+ * By default the message scheduler is called for every message, and every
+ * call to \ref DartEngine_HandleMessage handles one message. With a batch
+ * size greater than 1, the message scheduler is only called if no call to
+ * \ref DartEngine_HandleMessage is pending yet, and that call handles up to
+ * batch_size messages. If more messages are left afterwards, the message
+ * scheduler is called again.
+ *
+ * Should be called before the isolate receives messages.
+ *
+ * \param batch_size Maximum number of messages handled at once, 1 disables
+ *    batching.
+ * \param isolate The isolate to handle messages for.
+ */
+DART_EXPORT void DartEngine_SetMessageBatchSize(intptr_t batch_size,
+                                                Dart_Isolate isolate);
+
 /**
  * Loads \ref DartEngine_SnapshotData from file
  *
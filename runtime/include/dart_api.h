@@ -1510,6 +1510,19 @@ DART_EXPORT void Dart_SetMessageNotifyCallback(
  */
 DART_EXPORT Dart_MessageNotifyCallback Dart_GetMessageNotifyCallback(void);
 
+/**
+ * Marks the current isolate as latency-critical.
+ *
+ * When the isolate is scheduled on a VM-managed thread pool (see
+ * Dart_RunLoopAsync), handling of its messages is scheduled ahead of all
+ * other tasks waiting for a thread of the pool, such as the messages of other
+ * isolates which used up their time slice (see `--message-slice-micros` and
+ * `--message-slice-messages`).
+ *
+ * \param latency_critical Whether the current isolate is latency-critical.
+ */
+DART_EXPORT void Dart_SetLatencyCritical(bool latency_critical);
+
 /**
  * The VM's default message handler supports pausing an isolate before it
  * processes the first message and right after the it processes the isolate's
@@ -57,7 +57,9 @@ typedef void (*Dart_NativeMessageHandler_DL)(Dart_Port_DL dest_port_id,
   F(Dart_NewNativePort, Dart_Port_DL,                                          \
     (const char* name, Dart_NativeMessageHandler_DL handler,                   \
      bool handle_concurrently))                                                \
-  F(Dart_CloseNativePort, bool, (Dart_Port_DL native_port_id))
+  F(Dart_CloseNativePort, bool, (Dart_Port_DL native_port_id))                 \
+  F(Dart_PostCObjectBatch, bool,                                               \
+    (Dart_Port_DL port_id, intptr_t num_messages, Dart_CObject * *messages))
 
 // dart_api.h symbols can only be called on Dart threads.
 #define DART_API_DL_SYMBOLS(F)                                                 \
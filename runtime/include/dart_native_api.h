@@ -128,6 +128,27 @@ typedef struct _Dart_CObject {
  */
 DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
 
+/**
+ * Posts a batch of messages on some port, as if by calling Dart_PostCObject
+ * for each of them in order, but looking up the port and waking up the
+ * receiver only once.
+ *
+ * Either all messages are enqueued, or none is. If false is returned, because
+ * a message could not be serialized or the port is not active any longer,
+ * ownership of external typed data in all messages remains with the caller.
+ *
+ * The messages are received in the order they appear in 'messages'.
+ *
+ * \param port_id The destination port.
+ * \param num_messages The number of messages in 'messages'.
+ * \param messages The messages to send.
+ *
+ * \return True if the messages were posted.
+ */
+DART_EXPORT bool Dart_PostCObjectBatch(Dart_Port port_id,
+                                       intptr_t num_messages,
+                                       Dart_CObject** messages);
+
 /**
  * Posts a message on some port. The message will contain the integer 'message'.
  *
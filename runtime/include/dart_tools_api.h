@@ -530,6 +530,121 @@ Dart_IsolateGroupHeapNewCapacityMetric(Dart_IsolateGroup group);  // Byte
 DART_EXPORT int64_t
 Dart_IsolateGroupHeapNewExternalMetric(Dart_IsolateGroup group);  // Byte
 
+/**
+ * The kind of a garbage collection recorded in Dart_GCStats.
+ */
+typedef enum {
+  Dart_GCKind_Scavenge = 0,
+  Dart_GCKind_Evacuate = 1,
+  Dart_GCKind_StartConcurrentMark = 2,
+  Dart_GCKind_MarkSweep = 3,
+  Dart_GCKind_MarkCompact = 4,
+} Dart_GCKind;
+
+/**
+ * The reason of a garbage collection recorded in Dart_GCStats.
+ */
+typedef enum {
+  Dart_GCReason_NewSpace = 0,
+  Dart_GCReason_StoreBuffer = 1,
+  Dart_GCReason_Promotion = 2,
+  Dart_GCReason_OldSpace = 3,
+  Dart_GCReason_Finalize = 4,
+  Dart_GCReason_Full = 5,
+  Dart_GCReason_External = 6,
+  Dart_GCReason_Idle = 7,
+  Dart_GCReason_Destroyed = 8,
+  Dart_GCReason_Debugging = 9,
+  Dart_GCReason_CatchUp = 10,
+} Dart_GCReason;
+
+/**
+ * Statistics of a single garbage collection. All sizes are in bytes and all
+ * times are in microseconds, using the same clock as Dart_TimelineGetMicros.
+ */
+typedef struct {
+  /* Increases by one for every collection of the isolate group, starting
+   * at 1. */
+  int64_t sequence;
+  int32_t kind;   /* Dart_GCKind */
+  int32_t reason; /* Dart_GCReason */
+  int64_t start_micros;
+  int64_t end_micros;
+
+  /* Time spent in the stop-the-world parts of the old space phases. Zero
+   * for scavenges. Sweeping done concurrently after the pause is not
+   * included. */
+  int64_t mark_micros;
+  int64_t sweep_micros;
+  int64_t compact_micros;
+
+  int64_t new_used_before;
+  int64_t new_used_after;
+  int64_t new_capacity_after;
+  int64_t new_external_after;
+  int64_t old_used_before;
+  int64_t old_used_after;
+  int64_t old_capacity_after;
+  int64_t old_external_after;
+
+  /* For scavenges, the size of the objects that were old enough to be
+   * promoted and the size of those that survived and were promoted. */
+  int64_t promotion_candidates;
+  int64_t promoted;
+
+  /* The old space growth policy after the collection: the usage that
+   * triggers a stop-the-world collection, the start of concurrent marking
+   * and an idle collection, and the number of pages the heap may grow by
+   * before reaching the threshold. Thresholds that are not in use are set
+   * to a very large value. */
+  int64_t old_hard_threshold;
+  int64_t old_soft_threshold;
+  int64_t old_idle_threshold;
+  int64_t old_growth_in_pages;
+} Dart_GCStats;
+
+/**
+ * Copies the statistics of the most recent garbage collections of an
+ * isolate group, oldest first.
+ *
+ * Only collections with a sequence number greater than `after_sequence` are
+ * copied, so passing the last sequence number seen by a previous call
+ * returns only the new collections. The VM keeps a bounded number of
+ * collections: a gap in the sequence numbers means some were dropped.
+ *
+ * This function does not allocate or take locks and may be called on any
+ * thread, without a current isolate, while the isolate group is alive.
+ *
+ * \param group The isolate group.
+ * \param after_sequence Sequence number after which to start copying.
+ * \param stats Array receiving the statistics.
+ * \param length Length of the `stats` array.
+ *
+ * \return The number of entries written to `stats`.
+ */
+DART_EXPORT intptr_t Dart_IsolateGroupGCStats(Dart_IsolateGroup group,
+                                              int64_t after_sequence,
+                                              Dart_GCStats* stats,
+                                              intptr_t length);
+
+#define DART_GC_PAUSE_HISTOGRAM_BUCKETS (32)
+
+/**
+ * Copies the histogram of garbage collection pause times of an isolate group
+ * since it was created.
+ *
+ * Bucket 0 counts pauses shorter than 1 microsecond and bucket i counts
+ * pauses of at least 2^(i-1) and less than 2^i microseconds. The last bucket
+ * also counts all longer pauses.
+ *
+ * Like Dart_IsolateGroupGCStats, this may be called on any thread.
+ *
+ * \param group The isolate group.
+ * \param buckets Array of DART_GC_PAUSE_HISTOGRAM_BUCKETS counts.
+ */
+DART_EXPORT void Dart_IsolateGroupGCPauseHistogram(Dart_IsolateGroup group,
+                                                   int64_t* buckets);
+
 /*
  * ========
  * UserTags
@@ -127,6 +127,46 @@ DEFINE_NATIVE_ENTRY(SendPort_sendInternal_, 0, 2) {
   return Object::null();
 }
 
+// Owns the messages of a batch until they are posted, so they are freed if
+// writing a later message throws.
+class MessageBatchScope : public StackResource {
+ public:
+  explicit MessageBatchScope(Thread* thread) : StackResource(thread) {}
+
+  MessageQueue* messages() { return &messages_; }
+
+ private:
+  MessageQueue messages_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageBatchScope);
+};
+
+DEFINE_NATIVE_ENTRY(SendPort_sendAllInternal_, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(SendPort, port, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Array, messages, arguments->NativeArgAt(1));
+
+  const Dart_Port destination_port_id = port.Id();
+  IsolateGroup* group = thread->isolate_group();
+  const bool same_group = InSameGroup(group, port);
+#if defined(DEBUG)
+  if (same_group) {
+    ASSERT(PortMap::IsReceiverInThisIsolateGroupOrClosed(destination_port_id,
+                                                         group));
+  }
+#endif
+
+  MessageBatchScope batch(thread);
+  Instance& obj = Instance::Handle(zone);
+  for (intptr_t i = 0, n = messages.Length(); i < n; i++) {
+    obj ^= messages.At(i);
+    batch.messages()->Enqueue(WriteMessage(same_group, obj, destination_port_id,
+                                           Message::kNormalPriority),
+                              /*before_events=*/false);
+  }
+  PortMap::PostMessages(destination_port_id, batch.messages());
+  return Object::null();
+}
+
 class UntaggedObjectPtrSetTraits {
  public:
   static bool ReportStats() { return false; }
@@ -806,6 +846,11 @@ DEFINE_NATIVE_ENTRY(Isolate_pinToCurrentThread, 0, 0) {
   return Bool::True().ptr();
 }
 
+DEFINE_NATIVE_ENTRY(Isolate_freeze, 0, 1) {
+  GET_NATIVE_ARGUMENT(Instance, value, arguments->NativeArgAt(0));
+  return CopyDeeplyImmutableObjectGraph(value);
+}
+
 // TODO(http://dartbug.com/47777): Add support for Finalizers.
 DEFINE_NATIVE_ENTRY(Isolate_exit_, 0, 2) {
   if (isolate == nullptr) {
@@ -854,6 +899,7 @@ DEFINE_NATIVE_ENTRY(Isolate_exit_, 0, 2) {
     isolate->bequeath(std::unique_ptr<Bequest>(new Bequest(handle, port.Id())));
   }
 
+  isolate->set_has_exited();
   Thread::Current()->StartUnwindError();
   const String& msg =
       String::Handle(String::New("isolate terminated by Isolate.exit"));
@@ -1152,11 +1198,19 @@ class SpawnIsolateTask : public ThreadPool::Task {
     char* error = nullptr;
 
     auto group = state_->isolate_group();
-    Isolate* isolate = CreateWithinExistingIsolateGroup(group, name, &error);
-    parent_isolate_->DecrementSpawnCount();
-    parent_isolate_ = nullptr;
+    Isolate* isolate = group->TakeIdleIsolate();
+    if (isolate != nullptr) {
+      Dart_EnterIsolate(Api::CastIsolate(isolate));
+      isolate->set_name(name);
+      Run(isolate);
+      RefillIdleIsolates(group);
+      return;
+    }
 
+    isolate = CreateWithinExistingIsolateGroup(group, name, &error);
     if (isolate == nullptr) {
+      parent_isolate_->DecrementSpawnCount();
+      parent_isolate_ = nullptr;
       FailedSpawn(error, /*has_current_isolate=*/false);
       free(error);
       return;
@@ -1165,6 +1219,8 @@ class SpawnIsolateTask : public ThreadPool::Task {
     void* child_isolate_data = nullptr;
     const bool success = initialize_callback(&child_isolate_data, &error);
     if (!success) {
+      parent_isolate_->DecrementSpawnCount();
+      parent_isolate_ = nullptr;
       FailedSpawn(error);
       Dart_ShutdownIsolate();
       free(error);
@@ -1173,9 +1229,22 @@ class SpawnIsolateTask : public ThreadPool::Task {
 
     isolate->set_init_callback_data(child_isolate_data);
     Run(isolate);
+    RefillIdleIsolates(group);
   }
 
  private:
+  // Tops up the group's pool of idle isolates (see --isolate-pool-size) once
+  // the child is running, so later spawns don't have to wait for the embedder
+  // to create and initialize an isolate.
+  //
+  // The parent's spawn count is only released afterwards: it keeps the group
+  // alive while we add isolates to it.
+  void RefillIdleIsolates(IsolateGroup* group) {
+    group->FillIdleIsolates();
+    parent_isolate_->DecrementSpawnCount();
+    parent_isolate_ = nullptr;
+  }
+
   void Run(Isolate* child) {
     if (!EnsureIsRunnable(child)) {
       Dart_ShutdownIsolate();
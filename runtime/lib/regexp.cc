@@ -71,6 +71,12 @@ DEFINE_NATIVE_ENTRY(RegExp_factory, 0, 5) {
     regexp ^= table.InsertNewOrGet(lookup_symbol_key);
     thread->isolate_group()->object_store()->set_regexp_table(table.Release());
   }
+  if (RegExpStatics::IsAtom(compileData, flags)) {
+    // Plain strings are matched without compiling the pattern, so initialize
+    // what compilation would otherwise set. Atoms have no captures.
+    regexp.set_num_bracket_expressions<std::memory_order_release>(0);
+    regexp.set_is_atom(true);
+  }
 
   ASSERT(regexp.flags() == flags);
   return regexp.ptr();
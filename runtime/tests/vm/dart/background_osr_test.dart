@@ -0,0 +1,62 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that loops keep running while their OSR code is compiled in the
+// background and switch to it once it is ready.
+//
+// VMOptions=--optimization-counter-threshold=100 --background-osr --background-osr-poll-interval=10
+// VMOptions=--optimization-counter-threshold=100 --background-osr --background-osr-poll-interval=10 --stress-test-background-compilation
+// VMOptions=--optimization-counter-threshold=100 --no-background-osr
+
+import 'package:expect/expect.dart';
+
+int sum(int n) {
+  int result = 0;
+  for (int i = 0; i < n; i++) {
+    result += i;
+  }
+  return result;
+}
+
+int nested(int n) {
+  int result = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      result += i + j;
+    }
+  }
+  return result;
+}
+
+double mixed(int n) {
+  num result = 0;
+  for (int i = 0; i < n; i++) {
+    // Changes the type feedback while the OSR code is being compiled.
+    result += i < n ~/ 2 ? i : i.toDouble();
+  }
+  return result.toDouble();
+}
+
+int deoptimizing(List<Object> values) {
+  int result = 0;
+  for (int i = 0; i < values.length; i++) {
+    // The OSR code only saw lists, so it deoptimizes on the first string.
+    result += (values[i] as dynamic).length as int;
+  }
+  return result;
+}
+
+main() {
+  for (int n in [10, 1000, 1000000]) {
+    Expect.equals(n * (n - 1) ~/ 2, sum(n));
+  }
+  Expect.equals(2000 * 2000 * 1999, nested(2000));
+  Expect.equals(1999999 * 1000000.0, mixed(2000000));
+  final values = <Object>[
+    for (int i = 0; i < 100000; i++) [i],
+    for (int i = 0; i < 100000; i++) "ab",
+    for (int i = 0; i < 100000; i++) [i, i],
+  ];
+  Expect.equals(500000, deoptimizing(values));
+}
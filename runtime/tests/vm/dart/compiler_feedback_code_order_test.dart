@@ -0,0 +1,113 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Checks that the feedback of a JIT training run (--write-compiler-feedback-to)
+// orders the code in an AOT snapshot: the code of hot functions comes first,
+// and the code of functions which never ran comes last.
+
+import "dart:convert";
+import "dart:io";
+
+import 'package:expect/config.dart';
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const program = r'''
+@pragma('vm:never-inline')
+int hot(int x) => x % 7 == 0 ? x ~/ 7 : x + 1;
+
+@pragma('vm:never-inline')
+int warm(int x) => x * 2;
+
+@pragma('vm:never-inline')
+int cold(int x) => x * 3;
+
+main(List<String> args) {
+  int total = 0;
+  for (int i = 0; i < 100000; i++) {
+    total += hot(i);
+  }
+  total += warm(total);
+  if (args.contains('cold')) {
+    total += cold(total);
+  }
+  print(total);
+}
+''';
+
+main(List<String> args) async {
+  if (!isVmAotConfiguration) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('compiler_feedback_code_order', (String tempDir) async {
+    final script = path.join(tempDir, 'order.dart');
+    final jitDill = path.join(tempDir, 'order_jit.dill');
+    final aotDill = path.join(tempDir, 'order_aot.dill');
+    final feedback = path.join(tempDir, 'order.feedback');
+    final sizes = path.join(tempDir, 'sizes.json');
+    File(script).writeAsStringSync(program);
+
+    await run(genKernel, <String>[
+      '--platform=$platformDill',
+      '-o',
+      jitDill,
+      script,
+    ]);
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      aotDill,
+      script,
+    ]);
+
+    // Training run.
+    await run(dart, <String>[
+      '--optimization-counter-threshold=100',
+      '--write-compiler-feedback-to=$feedback',
+      jitDill,
+    ]);
+
+    // The instruction sizes are listed in the order of the code in the
+    // snapshot.
+    final elfFile = path.join(tempDir, 'order.so');
+    await run(genSnapshot, <String>[
+      if (Platform.isMacOS) ...[
+        '--snapshot-kind=app-aot-macho-dylib',
+        '--macho=$elfFile',
+      ] else ...[
+        '--snapshot-kind=app-aot-elf',
+        '--elf=$elfFile',
+      ],
+      '--read-compiler-feedback-from=$feedback',
+      '--print-instructions-sizes-to=$sizes',
+      aotDill,
+    ]);
+
+    final entries = jsonDecode(File(sizes).readAsStringSync()) as List;
+    int indexOf(String name) {
+      final index = entries.indexWhere(
+        (e) =>
+            e['n'] == name &&
+            e['l'] is String &&
+            (e['l'] as String).endsWith('order.dart'),
+      );
+      Expect.notEquals(-1, index, 'No code for $name');
+      return index;
+    }
+
+    final hot = indexOf('hot');
+    final warm = indexOf('warm');
+    final cold = indexOf('cold');
+    Expect.isTrue(hot < warm, 'hot ($hot) should precede warm ($warm)');
+    Expect.isTrue(warm < cold, 'warm ($warm) should precede cold ($cold)');
+  });
+}
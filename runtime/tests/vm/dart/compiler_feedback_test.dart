@@ -0,0 +1,134 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Checks that the feedback of a JIT training run (--write-compiler-feedback-to)
+// can guide AOT compilation (--read-compiler-feedback-from).
+
+import "dart:io";
+
+import 'package:expect/config.dart';
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const program = r'''
+abstract class Shape {
+  int area();
+}
+
+class Square implements Shape {
+  final int side;
+  Square(this.side);
+  int area() => side * side;
+}
+
+class Rect implements Shape {
+  final int width;
+  final int height;
+  Rect(this.width, this.height);
+  int area() => width * height;
+}
+
+class Triangle implements Shape {
+  final int base;
+  final int height;
+  Triangle(this.base, this.height);
+  int area() => base * height ~/ 2;
+}
+
+int sum(List<Shape> shapes) {
+  int result = 0;
+  for (final shape in shapes) {
+    if (shape is Triangle) {
+      result -= shape.area();
+    } else {
+      result += shape.area();
+    }
+  }
+  return result;
+}
+
+main() {
+  final shapes = <Shape>[
+    for (int i = 0; i < 1000; i++) i % 3 == 0 ? Square(i) : Rect(i, 2),
+    Triangle(4, 5),
+  ];
+  int total = 0;
+  for (int i = 0; i < 100; i++) {
+    total += sum(shapes);
+  }
+  print(total);
+}
+''';
+
+main(List<String> args) async {
+  if (!isVmAotConfiguration) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('compiler_feedback', (String tempDir) async {
+    final script = path.join(tempDir, 'shapes.dart');
+    final jitDill = path.join(tempDir, 'shapes_jit.dill');
+    final aotDill = path.join(tempDir, 'shapes_aot.dill');
+    final feedback = path.join(tempDir, 'shapes.feedback');
+    File(script).writeAsStringSync(program);
+
+    await run(genKernel, <String>[
+      '--platform=$platformDill',
+      '-o',
+      jitDill,
+      script,
+    ]);
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      aotDill,
+      script,
+    ]);
+
+    // Training run.
+    final expected = await runOutput(dart, <String>[
+      '--optimization-counter-threshold=100',
+      '--write-compiler-feedback-to=$feedback',
+      jitDill,
+    ]);
+
+    final records = File(feedback).readAsLinesSync();
+    Expect.isTrue(
+      records.any((r) => r.startsWith('function\t') && r.contains('\tsum\t')),
+    );
+    Expect.isTrue(records.any((r) => r.startsWith('edges\t')));
+    Expect.isTrue(
+      records.any(
+        (r) =>
+            r.startsWith('call\t') &&
+            r.contains('\tarea\t') &&
+            r.contains('\tSquare\t'),
+      ),
+    );
+
+    // The training run guides AOT compilation, which must not change what
+    // the program does.
+    final elfFile = path.join(tempDir, 'shapes.so');
+    await run(genSnapshot, <String>[
+      if (Platform.isMacOS) ...[
+        '--snapshot-kind=app-aot-macho-dylib',
+        '--macho=$elfFile',
+      ] else ...[
+        '--snapshot-kind=app-aot-elf',
+        '--elf=$elfFile',
+      ],
+      '--read-compiler-feedback-from=$feedback',
+      aotDill,
+    ]);
+    final actual = await runOutput(dartPrecompiledRuntime, <String>[elfFile]);
+    Expect.listEquals(expected, actual);
+  });
+}
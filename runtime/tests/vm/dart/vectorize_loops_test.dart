@@ -0,0 +1,153 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=50 --no-background-compilation
+// VMOptions=--optimization-counter-threshold=50 --no-background-compilation --no-vectorize-loops
+
+// Checks that loops over typed data compute the same results when they are
+// vectorized, including for the elements left over by the vectorized loop.
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+@pragma('vm:never-inline')
+Float64List scale(List<double> input, int start, int end, double k) {
+  final a = Float64List(input.length);
+  final b = Float64List(input.length);
+  for (int i = 0; i < input.length; i++) {
+    a[i] = input[i];
+  }
+  for (int i = start & 7; i < end; i++) {
+    b[i] = a[i] * k + 1.0;
+  }
+  return b;
+}
+
+@pragma('vm:never-inline')
+Float64List negateSqrt(List<double> input) {
+  final a = Float64List(input.length);
+  for (int i = 0; i < input.length; i++) {
+    a[i] = input[i];
+  }
+  for (int i = 0; i < a.length; i++) {
+    a[i] = sqrt(a[i] * a[i]) / 2.0;
+  }
+  final b = Float64List(input.length);
+  for (int i = 0; i < b.length; i++) {
+    b[i] = -b[i] - a[i];
+  }
+  return b;
+}
+
+@pragma('vm:never-inline')
+Uint32List mix(List<int> x, List<int> y, int mask) {
+  final a = Int32List(x.length);
+  final b = Uint32List(y.length);
+  final c = Uint32List(x.length);
+  for (int i = 0; i < x.length; i++) {
+    a[i] = x[i];
+    b[i] = y[i];
+  }
+  for (int i = 0; i < c.length; i++) {
+    c[i] = ((a[i] + b[i]) ^ mask) - (b[i] & 0xffff) + 0x100000000;
+  }
+  return c;
+}
+
+@pragma('vm:never-inline')
+int sum32(List<int> x) {
+  final a = Uint32List(x.length);
+  for (int i = 0; i < x.length; i++) {
+    a[i] = x[i];
+  }
+  int sum = 0;
+  for (int i = 0; i < a.length; i++) {
+    sum = (sum + a[i]) & 0xffffffff;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int checksum16(List<int> x, int seed) {
+  final a = Int32List(x.length);
+  for (int i = 0; i < x.length; i++) {
+    a[i] = x[i];
+  }
+  int hash = seed & 0xffff;
+  for (int i = 0; i < a.length; i++) {
+    hash = (hash ^ (a[i] + 1)) & 0xffff;
+  }
+  return hash;
+}
+
+void testScale() {
+  for (int length = 0; length < 20; length++) {
+    final input = List<double>.generate(length, (i) => i * 1.5 - 7);
+    for (int start = 0; start < 4; start++) {
+      for (int end = start; end <= length; end++) {
+        final b = scale(input, start, end, 3.0);
+        for (int i = 0; i < length; i++) {
+          final inRange = i >= start && i < end;
+          Expect.equals(inRange ? input[i] * 3.0 + 1.0 : 0.0, b[i]);
+        }
+      }
+    }
+    // The loop goes past the end of the arrays.
+    Expect.throws<RangeError>(() => scale(input, 0, length + 3, 2.0));
+  }
+  final nan = scale([double.nan, 1.0, double.infinity], 0, 3, -0.0);
+  Expect.isTrue(nan[0].isNaN);
+  Expect.equals(1.0, nan[1]);
+  Expect.isTrue(nan[2].isNaN);
+}
+
+void testNegateSqrt() {
+  for (int length = 0; length < 20; length++) {
+    final input = List<double>.generate(length, (i) => i * 0.25 - 2);
+    final b = negateSqrt(input);
+    for (int i = 0; i < length; i++) {
+      Expect.equals(-input[i].abs() / 2.0, b[i]);
+    }
+  }
+}
+
+void testMix() {
+  const values = <int>[0, 1, -1, 0x7fffffff, -0x80000000, 0x12345678, 42];
+  for (int length = 0; length < 20; length++) {
+    final x = List<int>.generate(length, (i) => values[i % values.length]);
+    final y = List<int>.generate(length, (i) => 0xffffffff - i * 0x1010101);
+    final c = mix(x, y, 0x55aa55aa);
+    for (int i = 0; i < length; i++) {
+      final a = x[i].toSigned(32);
+      final b = y[i].toUnsigned(32);
+      final expected = ((a + b) ^ 0x55aa55aa) - (b & 0xffff);
+      Expect.equals(expected.toUnsigned(32), c[i]);
+    }
+  }
+}
+
+void testReductions() {
+  for (int length = 0; length < 20; length++) {
+    final x = List<int>.generate(length, (i) => 0xfffffff0 - i * 0x3000001);
+    int sum = 0;
+    int hash = 0x1234;
+    for (int i = 0; i < length; i++) {
+      sum += x[i].toUnsigned(32);
+      hash ^= x[i].toSigned(32) + 1;
+    }
+    Expect.equals(sum.toUnsigned(32), sum32(x));
+    Expect.equals(hash & 0xffff, checksum16(x, 0x1234));
+  }
+}
+
+main() {
+  for (int i = 0; i < 100; i++) {
+    testScale();
+    testNegateSqrt();
+    testMix();
+    testReductions();
+  }
+}
@@ -2678,6 +2678,7 @@ class CodeSerializationCluster : public SerializationCluster {
     CodePtr code;
     intptr_t not_discarded;  // 1 if this code was not discarded and
                              // 0 otherwise.
+    intptr_t hotness;        // See ObjectStore::code_hotness.
     intptr_t instructions_id;
   };
 
@@ -2692,10 +2693,19 @@ class CodeSerializationCluster : public SerializationCluster {
   // there is no way to identify which specific Code object (out of those
   // which point to the specific instructions range) actually corresponds
   // to a particular frame.
+  //
+  // If a training run provided feedback, the code of hot functions is placed
+  // around the boundary between the two groups, hottest closest to it, so
+  // that all of it is contiguous and shares as few pages as possible. The
+  // code of functions which never ran ends up at the far ends, away from it.
   static int CompareCodeOrderInfo(CodeOrderInfo const* a,
                                   CodeOrderInfo const* b) {
     if (a->not_discarded < b->not_discarded) return -1;
     if (a->not_discarded > b->not_discarded) return 1;
+    if (a->hotness != b->hotness) {
+      const bool hottest_first = a->not_discarded == 1;
+      return ((a->hotness > b->hotness) == hottest_first) ? -1 : 1;
+    }
     if (a->instructions_id < b->instructions_id) return -1;
     if (a->instructions_id > b->instructions_id) return 1;
     return 0;
@@ -2704,6 +2714,7 @@ class CodeSerializationCluster : public SerializationCluster {
   static void Insert(Serializer* s,
                      GrowableArray<CodeOrderInfo>* order_list,
                      IntMap<intptr_t>* order_map,
+                     const IntMap<intptr_t>* hotness,
                      CodePtr code) {
     InstructionsPtr instr = code->untag()->instructions_;
     intptr_t key = static_cast<intptr_t>(instr);
@@ -2722,14 +2733,22 @@ class CodeSerializationCluster : public SerializationCluster {
     info.code = code;
     info.instructions_id = instructions_id;
     info.not_discarded = Code::IsDiscarded(code) ? 0 : 1;
+    info.hotness = 0;
+    if (hotness != nullptr) {
+      const intptr_t owner = static_cast<intptr_t>(
+          WeakSerializationReference::Unwrap(code->untag()->owner()));
+      info.hotness = hotness->Lookup(owner);
+    }
     order_list->Add(info);
   }
 
-  static void Sort(Serializer* s, GrowableArray<CodePtr>* codes) {
+  static void Sort(Serializer* s,
+                   GrowableArray<CodePtr>* codes,
+                   const IntMap<intptr_t>* hotness = nullptr) {
     GrowableArray<CodeOrderInfo> order_list;
     IntMap<intptr_t> order_map;
     for (intptr_t i = 0; i < codes->length(); i++) {
-      Insert(s, &order_list, &order_map, (*codes)[i]);
+      Insert(s, &order_list, &order_map, hotness, (*codes)[i]);
     }
     order_list.Sort(CompareCodeOrderInfo);
     ASSERT(order_list.length() == codes->length());
@@ -2738,11 +2757,13 @@ class CodeSerializationCluster : public SerializationCluster {
     }
   }
 
-  static void Sort(Serializer* s, GrowableArray<Code*>* codes) {
+  static void Sort(Serializer* s,
+                   GrowableArray<Code*>* codes,
+                   const IntMap<intptr_t>* hotness = nullptr) {
     GrowableArray<CodeOrderInfo> order_list;
     IntMap<intptr_t> order_map;
     for (intptr_t i = 0; i < codes->length(); i++) {
-      Insert(s, &order_list, &order_map, (*codes)[i]->ptr());
+      Insert(s, &order_list, &order_map, hotness, (*codes)[i]->ptr());
     }
     order_list.Sort(CompareCodeOrderInfo);
     ASSERT(order_list.length() == codes->length());
@@ -6451,6 +6472,7 @@ class RegExpSerializationCluster : public SerializationCluster {
       s->Write<int32_t>(regexp->untag()->num_one_byte_registers_);
       s->Write<int32_t>(regexp->untag()->num_two_byte_registers_);
       s->Write<uint32_t>(regexp->untag()->flags_);
+      s->Write<bool>(regexp->untag()->is_atom_);
     }
   }
 
@@ -6483,6 +6505,10 @@ class RegExpDeserializationCluster : public DeserializationCluster {
       regexp->untag()->num_one_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->num_two_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->flags_ = d.Read<uint32_t>();
+      regexp->untag()->usage_counter_ = 0;
+      regexp->untag()->native_code_failures_ = 0;
+      regexp->untag()->experimental_support_ = 0;
+      regexp->untag()->is_atom_ = d.Read<bool>();
     }
   }
 };
@@ -8459,6 +8485,20 @@ void Serializer::PrepareInstructions(
     const CompressedStackMaps& canonical_stack_map_entries) {
   if (!Snapshot::IncludesCode(kind())) return;
 
+  // The precompiler records the hotness of functions in a training run as
+  // pairs of function and hotness (see Precompiler::RecordCodeHotness).
+  IntMap<intptr_t> hotness_map;
+  IntMap<intptr_t>* hotness = nullptr;
+  const auto& code_hotness =
+      Array::Handle(zone(), isolate_group()->object_store()->code_hotness());
+  if ((kind() == Snapshot::kFullAOT) && !code_hotness.IsNull()) {
+    hotness = &hotness_map;
+    for (intptr_t i = 0; i < code_hotness.Length(); i += 2) {
+      hotness->Insert(static_cast<intptr_t>(code_hotness.At(i)),
+                      Smi::Value(Smi::RawCast(code_hotness.At(i + 1))));
+    }
+  }
+
   // Code objects that have identical/duplicate instructions must be adjacent in
   // the order that Code objects are written because the encoding of the
   // reference from the Code to the Instructions assumes monotonically
@@ -8466,14 +8506,14 @@ void Serializer::PrepareInstructions(
   // that allows for mapping return addresses back to Code objects depends on
   // this sorting.
   if (code_cluster_ != nullptr) {
-    CodeSerializationCluster::Sort(this, code_cluster_->objects());
+    CodeSerializationCluster::Sort(this, code_cluster_->objects(), hotness);
   }
   if ((loading_units_ != nullptr) &&
       (current_loading_unit_id_ == LoadingUnit::kRootId)) {
     for (intptr_t i = LoadingUnit::kRootId + 1; i < loading_units_->length();
          i++) {
       auto unit_objects = loading_units_->At(i)->deferred_objects();
-      CodeSerializationCluster::Sort(this, unit_objects);
+      CodeSerializationCluster::Sort(this, unit_objects, hotness);
       ASSERT(unit_objects->length() == 0 || code_cluster_ != nullptr);
       for (intptr_t j = 0; j < unit_objects->length(); j++) {
         code_cluster_->deferred_objects()->Add(unit_objects->At(j)->ptr());
@@ -20,8 +20,10 @@
 #include "vm/app_snapshot.h"
 #include "vm/dart_api_impl.h"
 #include "vm/datastream.h"
+#include "vm/lockers.h"
 #include "vm/message_snapshot.h"
 #include "vm/stack_frame.h"
+#include "vm/thread_pool.h"
 #include "vm/timer.h"
 
 using dart::bin::File;
@@ -466,6 +468,53 @@ BENCHMARK(EnterExitIsolate) {
   benchmark->set_score(elapsed_time);
 }
 
+class DispatchTask : public ThreadPool::Task {
+ public:
+  DispatchTask(ThreadPool* pool, Monitor* sync, intptr_t depth, intptr_t* done)
+      : pool_(pool), sync_(sync), depth_(depth), done_(done) {}
+
+  virtual void Run() {
+    // Fan out into a binary tree of tasks, so most of them are scheduled by
+    // workers of the pool itself.
+    if (depth_ > 0) {
+      pool_->Run<DispatchTask>(pool_, sync_, depth_ - 1, done_);
+      pool_->Run<DispatchTask>(pool_, sync_, depth_ - 1, done_);
+    }
+    MonitorLocker ml(sync_);
+    (*done_)++;
+    ml.Notify();
+  }
+
+ private:
+  ThreadPool* pool_;
+  Monitor* sync_;
+  intptr_t depth_;
+  intptr_t* done_;
+};
+
+//
+// Measure the throughput of scheduling and running small thread pool tasks.
+//
+BENCHMARK(ThreadPoolDispatch) {
+  const intptr_t kDepth = 16;
+  const intptr_t kTaskCount = (static_cast<intptr_t>(1) << (kDepth + 1)) - 1;
+  ThreadPool pool;
+  Monitor sync;
+  intptr_t done = 0;
+  Timer timer;
+  timer.Start();
+  pool.Run<DispatchTask>(&pool, &sync, kDepth, &done);
+  {
+    MonitorLocker ml(&sync);
+    while (done < kTaskCount) {
+      ml.Wait();
+    }
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
 BENCHMARK(SerializeNull) {
   TransitionNativeToVM transition(thread);
   StackZone zone(thread);
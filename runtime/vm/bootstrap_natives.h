@@ -63,6 +63,7 @@ namespace dart {
   V(SendPort_get_id, 1)                                                        \
   V(SendPort_get_hashcode, 1)                                                  \
   V(SendPort_sendInternal_, 2)                                                 \
+  V(SendPort_sendAllInternal_, 2)                                              \
   V(Smi_bitNegate, 1)                                                          \
   V(Smi_bitLength, 1)                                                          \
   V(SuspendState_instantiateClosureWithFutureTypeArgument, 2)                  \
@@ -253,6 +254,7 @@ namespace dart {
   V(Int32x4_select, 3)                                                         \
   V(Isolate_create_, 1)                                                        \
   V(Isolate_exit_, 2)                                                          \
+  V(Isolate_freeze, 1)                                                         \
   V(Isolate_getCurrentRootUriStr, 0)                                           \
   V(Isolate_getDebugName, 1)                                                   \
   V(Isolate_getPortAndCapabilitiesOfCurrentIsolate, 0)                         \
@@ -395,19 +395,43 @@ class ClassTable : public MallocAllocated {
     classes_.At<kUnboxedFieldBitmapIndex>(cid) = map;
   }
 
+  // Generated code leaves the inline allocation path for a class whenever any
+  // bit of its allocation state is set. Pretenured classes are then allocated
+  // directly in old space, traced ones in the runtime.
+  bool ShouldPretenure(intptr_t cid) const {
+    return !IsTopLevelCid(cid) &&
+           ((classes_.At<kAllocationStateIndex>(cid) & kPretenureBit) != 0);
+  }
+
+  void SetPretenure(intptr_t cid, bool pretenure) {
+    auto& slot = classes_.At<kAllocationStateIndex>(cid);
+    if (pretenure) {
+      slot |= kPretenureBit;
+    } else {
+      slot &= ~kPretenureBit;
+    }
+  }
+
+  void UpdateCachedAllocationTracingStateTablePointer() {
+    cached_allocation_tracing_state_table_.store(
+        classes_.GetColumn<kAllocationStateIndex>());
+  }
+
 #if !defined(PRODUCT)
   bool ShouldTraceAllocationFor(intptr_t cid) {
     return !IsTopLevelCid(cid) &&
-           (classes_.At<kAllocationTracingStateIndex>(cid) != kTracingDisabled);
+           ((classes_.At<kAllocationStateIndex>(cid) &
+             (kTraceAllocationBit | kCollectInstancesBit)) != 0);
   }
 
   void SetTraceAllocationFor(intptr_t cid, bool trace) {
-    classes_.At<kAllocationTracingStateIndex>(cid) =
-        trace ? kTraceAllocationBit : kTracingDisabled;
+    auto& slot = classes_.At<kAllocationStateIndex>(cid);
+    slot = (slot & kPretenureBit) |
+           (trace ? kTraceAllocationBit : kTracingDisabled);
   }
 
   void SetCollectInstancesFor(intptr_t cid, bool trace) {
-    auto& slot = classes_.At<kAllocationTracingStateIndex>(cid);
+    auto& slot = classes_.At<kAllocationStateIndex>(cid);
     if (trace) {
       slot |= kCollectInstancesBit;
     } else {
@@ -416,16 +440,9 @@ class ClassTable : public MallocAllocated {
   }
 
   bool CollectInstancesFor(intptr_t cid) {
-    auto& slot = classes_.At<kAllocationTracingStateIndex>(cid);
+    auto& slot = classes_.At<kAllocationStateIndex>(cid);
     return (slot & kCollectInstancesBit) != 0;
   }
-
-  void UpdateCachedAllocationTracingStateTablePointer() {
-    cached_allocation_tracing_state_table_.store(
-        classes_.GetColumn<kAllocationTracingStateIndex>());
-  }
-#else
-  void UpdateCachedAllocationTracingStateTablePointer() {}
 #endif  // !defined(PRODUCT)
 
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
@@ -472,7 +489,6 @@ class ClassTable : public MallocAllocated {
   void PrintObjectLayout(const char* filename);
 #endif
 
-#ifndef PRODUCT
   // Describes layout of heap stats for code generation. See offset_extractor.cc
   struct ArrayTraits {
     static intptr_t elements_start_offset() { return 0; }
@@ -485,6 +501,7 @@ class ClassTable : public MallocAllocated {
     return OFFSET_OF(ClassTable, cached_allocation_tracing_state_table_);
   }
 
+#ifndef PRODUCT
   void AllocationProfilePrintJSON(JSONStream* stream, bool internal);
 
   void PrintToJSONObject(JSONObject* object);
@@ -552,16 +569,13 @@ class ClassTable : public MallocAllocated {
 
   // Unfortunately std::tuple used by CidIndexedTable does not have a stable
   // layout so we can't refer to its elements from generated code.
-  NOT_IN_PRODUCT(AcqRelAtomic<uint8_t*> cached_allocation_tracing_state_table_ =
-                     {nullptr});
+  AcqRelAtomic<uint8_t*> cached_allocation_tracing_state_table_ = {nullptr};
 
   enum {
     kClassIndex = 0,
     kSizeIndex,
     kUnboxedFieldBitmapIndex,
-#if !defined(PRODUCT)
-    kAllocationTracingStateIndex,
-#endif
+    kAllocationStateIndex,
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
     kClassNameIndex,
 #endif
@@ -580,20 +594,24 @@ class ClassTable : public MallocAllocated {
                   ClassPtr,
                   uint32_t,
                   UnboxedFieldBitmap,
+                  uint8_t,
                   const char*>
       classes_;
 #else
-  CidIndexedTable<ClassIdTagType, ClassPtr, uint32_t, UnboxedFieldBitmap>
+  CidIndexedTable<ClassIdTagType,
+                  ClassPtr,
+                  uint32_t,
+                  UnboxedFieldBitmap,
+                  uint8_t>
       classes_;
 #endif
 
-#ifndef PRODUCT
   enum {
     kTracingDisabled = 0,
     kTraceAllocationBit = (1 << 0),
     kCollectInstancesBit = (1 << 1),
+    kPretenureBit = (1 << 2),
   };
-#endif  // !PRODUCT
 
   CidIndexedTable<classid_t, ClassPtr> top_level_classes_;
 };
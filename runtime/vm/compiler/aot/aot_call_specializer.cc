@@ -15,6 +15,7 @@
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/cha.h"
+#include "vm/compiler/compiler_feedback.h"
 #include "vm/compiler/compiler_state.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/jit/compiler.h"
@@ -968,6 +969,21 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
     }
   }
 
+  // Check for the receivers the call saw in a JIT training run. The checks
+  // are not complete, other receivers take the megamorphic path.
+  if (targets.is_empty() && (precompiler_ != nullptr) &&
+      (precompiler_->feedback() != nullptr)) {
+    const CallTargets* feedback_targets = precompiler_->feedback()->TargetsFor(
+        instr, FLAG_max_polymorphic_checks);
+    if (feedback_targets != nullptr) {
+      PolymorphicInstanceCallInstr* call =
+          PolymorphicInstanceCallInstr::FromCall(Z, instr, *feedback_targets,
+                                                 /* complete = */ false);
+      instr->ReplaceWith(call, current_iterator());
+      return;
+    }
+  }
+
   // More than one target. Generate generic polymorphic call without
   // deoptimization.
   if (targets.length() > 0) {
@@ -16,6 +16,7 @@
 #include "vm/compiler/aot/precompiler_tracer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
+#include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/constant_propagator.h"
 #include "vm/compiler/backend/flow_graph.h"
@@ -27,6 +28,7 @@
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
 #include "vm/compiler/cha.h"
+#include "vm/compiler/compiler_feedback.h"
 #include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/compiler_state.h"
 #include "vm/compiler/compiler_timings.h"
@@ -95,6 +97,7 @@ DECLARE_FLAG(int, inlining_caller_size_threshold);
 DECLARE_FLAG(int, inlining_constant_arguments_max_size_threshold);
 DECLARE_FLAG(int, inlining_constant_arguments_min_size_threshold);
 DECLARE_FLAG(bool, print_instruction_stats);
+DECLARE_FLAG(charp, read_compiler_feedback_from);
 
 Precompiler* Precompiler::singleton_ = nullptr;
 
@@ -477,6 +480,13 @@ void Precompiler::DoCompileAll() {
 
       ClassFinalizer::SortClasses();
 
+      // Class ids in the feedback are resolved by name, after classes got
+      // their final ids.
+      if (FLAG_read_compiler_feedback_from != nullptr) {
+        feedback_ =
+            CompilerFeedback::Read(T, FLAG_read_compiler_feedback_from);
+      }
+
       // Collects type usage information which allows us to decide when/how to
       // optimize runtime type tests.
       TypeUsageInfo type_usage_info(T);
@@ -618,6 +628,12 @@ void Precompiler::DoCompileAll() {
       DropLibraries();
     }
 
+    // Functions are found by name in the feedback, so this has to happen
+    // before obfuscation renames them.
+    if (feedback_ != nullptr) {
+      RecordCodeHotness();
+    }
+
     {
       PRECOMPILER_TIMER_SCOPE(this, Obfuscate);
       Obfuscate();
@@ -645,6 +661,7 @@ void Precompiler::DoCompileAll() {
       retained_reasons_writer_ = nullptr;
     }
 
+    feedback_ = nullptr;
     zone_ = nullptr;
   }
 
@@ -2140,6 +2157,41 @@ void Precompiler::ReplaceFunctionStaticCallEntries() {
   ProgramVisitor::WalkProgram(Z, IG, &visitor);
 }
 
+// Records the hotness of the retained functions in the training run, which
+// the serializer uses to order their code (see CodeSerializationCluster).
+void Precompiler::RecordCodeHotness() {
+  class HotnessVisitor : public FunctionVisitor {
+   public:
+    HotnessVisitor(Zone* zone, const CompilerFeedback* feedback)
+        : feedback_(feedback),
+          entries_(
+              GrowableObjectArray::Handle(zone, GrowableObjectArray::New())),
+          hotness_(Smi::Handle(zone)) {}
+
+    void VisitFunction(const Function& function) {
+      if (!function.HasCode()) return;
+      const intptr_t hotness = feedback_->Hotness(function);
+      if (hotness == 0) return;
+      hotness_ = Smi::New(hotness);
+      entries_.Add(function);
+      entries_.Add(hotness_);
+    }
+
+    const GrowableObjectArray& entries() const { return entries_; }
+
+   private:
+    const CompilerFeedback* const feedback_;
+    const GrowableObjectArray& entries_;
+    Smi& hotness_;
+  };
+
+  HANDLESCOPE(T);
+  HotnessVisitor visitor(Z, feedback_);
+  ProgramVisitor::WalkProgram(Z, IG, &visitor);
+  IG->object_store()->set_code_hotness(
+      Array::Handle(Z, Array::MakeFixedLength(visitor.entries())));
+}
+
 void Precompiler::DropFunctions() {
   HANDLESCOPE(T);
   Library& lib = Library::Handle(Z);
@@ -3615,6 +3667,10 @@ bool PrecompileParsedFunctionHelper::Compile() {
     ASSERT(flow_graph != nullptr);
   }
 
+  if (flow_graph->should_reorder_blocks()) {
+    BlockScheduler::AssignEdgeWeights(flow_graph);
+  }
+
   flow_graph->PopulateWithICData(function);
 
   {
@@ -22,6 +22,7 @@ namespace dart {
 
 // Forward declarations.
 class Class;
+class CompilerFeedback;
 class Error;
 class Field;
 class Function;
@@ -279,6 +280,9 @@ class Precompiler : public ValueObject {
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
 
+  // Feedback of a JIT training run, or nullptr if there is none.
+  CompilerFeedback* feedback() const { return feedback_; }
+
  private:
   static Precompiler* singleton_;
 
@@ -351,6 +355,7 @@ class Precompiler : public ValueObject {
   void DropLibraryEntries();
   void DropClasses();
   void DropLibraries();
+  void RecordCodeHotness();
   void DiscardCodeObjects();
   void PruneDictionaries();
 
@@ -412,6 +417,7 @@ class Precompiler : public ValueObject {
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
+  CompilerFeedback* feedback_ = nullptr;
   bool is_tracing_ = false;
 };
 
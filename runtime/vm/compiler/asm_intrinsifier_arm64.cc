@@ -1721,7 +1721,7 @@ static void TryAllocateString(Assembler* assembler,
   __ CompareImmediate(length_reg, target::ToRawSmi(max_elements), kObjectBytes);
   __ b(failure, HI);
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, failure, R0));
+  __ MaybeTraceAllocation(cid, failure, R0);
   __ mov(R6, length_reg);  // Save the length register.
   if (cid == kOneByteStringCid) {
     // Untag length.
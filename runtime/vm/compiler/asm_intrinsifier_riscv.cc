@@ -1759,7 +1759,7 @@ static void TryAllocateString(Assembler* assembler,
   __ CompareImmediate(length_reg, target::ToRawSmi(max_elements));
   __ BranchIf(UNSIGNED_GREATER, failure);
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, failure, TMP));
+  __ MaybeTraceAllocation(cid, failure, TMP);
   __ mv(T0, length_reg);  // Save the length register.
   if (cid == kOneByteStringCid) {
     // Untag length.
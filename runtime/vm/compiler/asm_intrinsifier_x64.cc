@@ -1614,7 +1614,7 @@ static void TryAllocateString(Assembler* assembler,
   __ OBJ(cmp)(length_reg, Immediate(target::ToRawSmi(max_elements)));
   __ j(ABOVE, failure);
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, failure));
+  __ MaybeTraceAllocation(cid, failure);
   if (length_reg != RDI) {
     __ movq(RDI, length_reg);
   }
@@ -3566,8 +3566,8 @@ void Assembler::FinalizeHashForSize(intptr_t bit_size,
   LoadImmediate(hash, 1, ZERO);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(Register stats_addr_reg, Label* trace) {
+  if (!ChecksAllocationState()) return;
   ASSERT(stats_addr_reg != kNoRegister);
   ASSERT(stats_addr_reg != TMP);
   ldrb(TMP, Address(stats_addr_reg, 0));
@@ -3592,6 +3592,7 @@ void Assembler::MaybeTraceAllocation(Register cid,
 }
 
 void Assembler::LoadAllocationTracingStateAddress(Register dest, Register cid) {
+  if (!ChecksAllocationState()) return;
   ASSERT(dest != kNoRegister);
   ASSERT(dest != TMP);
 
@@ -3605,6 +3606,7 @@ void Assembler::LoadAllocationTracingStateAddress(Register dest, Register cid) {
 }
 
 void Assembler::LoadAllocationTracingStateAddress(Register dest, intptr_t cid) {
+  if (!ChecksAllocationState()) return;
   ASSERT(dest != kNoRegister);
   ASSERT(dest != TMP);
   ASSERT(cid > 0);
@@ -3617,7 +3619,6 @@ void Assembler::LoadAllocationTracingStateAddress(Register dest, intptr_t cid) {
   AddImmediate(dest,
                target::ClassTable::AllocationTracingStateSlotOffsetFor(cid));
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -3649,8 +3650,8 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(LoadAllocationTracingStateAddress(temp_reg, cid));
-    NOT_IN_PRODUCT(MaybeTraceAllocation(temp_reg, failure));
+    LoadAllocationTracingStateAddress(temp_reg, cid);
+    MaybeTraceAllocation(temp_reg, failure);
 
     // Successfully allocated the object, now update top to point to
     // next object start and store the class in the class field of object.
@@ -3675,7 +3676,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
                                  Register temp2) {
   if (UseInlineAllocation() &&
       target::Heap::IsAllocatableInNewSpace(instance_size)) {
-    NOT_IN_PRODUCT(LoadAllocationTracingStateAddress(temp1, cid));
+    LoadAllocationTracingStateAddress(temp1, cid);
     // Potential new object start.
     ldr(instance, Address(THR, target::Thread::top_offset()));
     AddImmediateSetFlags(end_address, instance, instance_size);
@@ -3692,7 +3693,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(temp1, failure));
+    MaybeTraceAllocation(temp1, failure);
 
     // Successfully allocated the object(s), now update top to point to
     // next object start and initialize the object.
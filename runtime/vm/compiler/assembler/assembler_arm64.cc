@@ -2011,11 +2011,11 @@ void Assembler::FinalizeHashForSize(intptr_t bit_size,
   cinc(hash, hash, ZERO);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(intptr_t cid,
                                      Label* trace,
                                      Register temp_reg,
                                      JumpDistance distance) {
+  if (!ChecksAllocationState(cid)) return;
   ASSERT(cid > 0);
 
   LoadIsolateGroup(temp_reg);
@@ -2033,6 +2033,7 @@ void Assembler::MaybeTraceAllocation(Register cid,
                                      Label* trace,
                                      Register temp_reg,
                                      JumpDistance distance) {
+  if (!ChecksAllocationState()) return;
   ASSERT(temp_reg != cid);
   LoadIsolateGroup(temp_reg);
   ldr(temp_reg, Address(temp_reg, target::IsolateGroup::class_table_offset()));
@@ -2045,7 +2046,6 @@ void Assembler::MaybeTraceAllocation(Register cid,
                  kUnsignedByte);
   cbnz(trace, temp_reg);
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -2064,7 +2064,7 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp_reg));
+    MaybeTraceAllocation(cid, failure, temp_reg);
     RELEASE_ASSERT((target::Thread::top_offset() + target::kWordSize) ==
                    target::Thread::end_offset());
     ldp(instance_reg, temp_reg,
@@ -2106,7 +2106,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp1));
+    MaybeTraceAllocation(cid, failure, temp1);
     // Potential new object start.
     ldr(instance, Address(THR, target::Thread::top_offset()));
     AddImmediateSetFlags(end_address, instance, instance_size);
@@ -24,6 +24,7 @@ DEFINE_FLAG(bool,
 #if defined(TARGET_ARCH_ARM)
 DEFINE_FLAG(bool, use_far_branches, false, "Enable far branches for ARM.");
 #endif
+DECLARE_FLAG(bool, pretenuring);
 
 namespace compiler {
 
@@ -632,6 +633,15 @@ bool AssemblerBase::EmittingComments() {
          FLAG_disassemble_stubs;
 }
 
+bool AssemblerBase::ChecksAllocationState(intptr_t cid) {
+#if defined(PRODUCT)
+  return FLAG_pretenuring &&
+         ((cid == kIllegalCid) || PretenuringPolicy::CanPretenure(cid));
+#else
+  return true;
+#endif
+}
+
 void AssemblerBase::Stop(const char* message) {
   Comment("Stop: %s", message);
   Breakpoint();
@@ -628,6 +628,14 @@ class AssemblerBase : public StackResource {
   void Comment(const char* format, ...) PRINTF_ATTRIBUTE(2, 3);
   static bool EmittingComments();
 
+  // Whether inline allocations of `cid` check the allocation state of the
+  // class (see MaybeTraceAllocation). Pass kIllegalCid if the class is only
+  // known at run time. Classes can only be traced in non-product builds, so
+  // product builds only check it for classes which may be pretenured, and only
+  // when generating code with --pretenuring. Snapshots record that flag (see
+  // Dart::FeaturesString), so the VM does not run code which ignores it.
+  static bool ChecksAllocationState(intptr_t cid = kIllegalCid);
+
   virtual void Breakpoint() = 0;
 
   virtual void StoreStoreFence() = 0;
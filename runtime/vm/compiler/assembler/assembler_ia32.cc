@@ -2773,11 +2773,11 @@ void Assembler::MoveMemoryToMemory(Address dst, Address src, Register tmp) {
   movl(dst, tmp);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(intptr_t cid,
                                      Label* trace,
                                      Register temp_reg,
                                      JumpDistance distance) {
+  if (!ChecksAllocationState(cid)) return;
   ASSERT(cid > 0);
   Address state_address(kNoRegister, 0);
 
@@ -2794,7 +2794,6 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
   // the allocation stub.
   j(NOT_ZERO, trace, distance);
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -2811,7 +2810,7 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp_reg, distance));
+    MaybeTraceAllocation(cid, failure, temp_reg, distance);
     movl(instance_reg, Address(THR, target::Thread::top_offset()));
     addl(instance_reg, Immediate(instance_size));
     // instance_reg: potential next object start.
@@ -2844,7 +2843,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp_reg, distance));
+    MaybeTraceAllocation(cid, failure, temp_reg, distance);
     movl(instance, Address(THR, target::Thread::top_offset()));
     movl(end_address, instance);
 
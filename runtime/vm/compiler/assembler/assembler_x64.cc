@@ -2501,11 +2501,11 @@ void Assembler::FinalizeHashForSize(intptr_t bit_size,
   Bind(&done);
 }
 
-#ifndef PRODUCT
 void Assembler::MaybeTraceAllocation(Register cid,
                                      Label* trace,
                                      Register temp_reg,
                                      JumpDistance distance) {
+  if (!ChecksAllocationState()) return;
   if (temp_reg == kNoRegister) {
     temp_reg = TMP;
   }
@@ -2528,6 +2528,7 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
                                      Label* trace,
                                      Register temp_reg,
                                      JumpDistance distance) {
+  if (!ChecksAllocationState(cid)) return;
   ASSERT(cid > 0);
 
   if (temp_reg == kNoRegister) {
@@ -2545,7 +2546,6 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
   // the allocation stub.
   j(NOT_ZERO, trace, distance);
 }
-#endif  // !PRODUCT
 
 void Assembler::TryAllocateObject(intptr_t cid,
                                   intptr_t instance_size,
@@ -2562,7 +2562,7 @@ void Assembler::TryAllocateObject(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp_reg, distance));
+    MaybeTraceAllocation(cid, failure, temp_reg, distance);
     movq(instance_reg, Address(THR, target::Thread::top_offset()));
     addq(instance_reg, Immediate(instance_size));
     // instance_reg: potential next object start.
@@ -2594,7 +2594,7 @@ void Assembler::TryAllocateArray(intptr_t cid,
     // If this allocation is traced, program will jump to failure path
     // (i.e. the allocation stub) which will allocate the object and trace the
     // allocation call site.
-    NOT_IN_PRODUCT(MaybeTraceAllocation(cid, failure, temp, distance));
+    MaybeTraceAllocation(cid, failure, temp, distance);
     movq(instance, Address(THR, target::Thread::top_offset()));
     movq(end_address, instance);
 
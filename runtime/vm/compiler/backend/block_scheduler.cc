@@ -9,6 +9,11 @@
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/jit/compiler.h"
 
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/precompiler.h"
+#include "vm/compiler/compiler_feedback.h"
+#endif  // defined(DART_PRECOMPILER)
+
 namespace dart {
 
 static intptr_t GetEdgeCount(const Array& edge_counters, intptr_t edge_id) {
@@ -50,23 +55,39 @@ void BlockScheduler::AssignEdgeWeights(FlowGraph* flow_graph) {
   if (!FLAG_reorder_basic_blocks) {
     return;
   }
-  if (CompilerState::Current().is_aot()) {
-    return;
-  }
 
   const Function& function = flow_graph->parsed_function().function();
-  const Array& ic_data_array =
-      Array::Handle(flow_graph->zone(), function.ic_data_array());
-  if (ic_data_array.IsNull()) {
-    DEBUG_ASSERT(IsolateGroup::Current()->HasAttemptedReload() ||
-                 function.ForceOptimize());
-    return;
-  }
   Array& edge_counters = Array::Handle();
-  edge_counters ^=
-      ic_data_array.At(Function::ICDataArrayIndices::kEdgeCounters);
-  if (edge_counters.IsNull()) {
+  if (CompilerState::Current().is_aot()) {
+#if defined(DART_PRECOMPILER)
+    // Use the block counts of a JIT training run, if there was one. They
+    // only apply if the graph has the same shape as the unoptimized graph
+    // which collected them.
+    auto precompiler = Precompiler::Instance();
+    if ((precompiler == nullptr) || (precompiler->feedback() == nullptr)) {
+      return;
+    }
+    edge_counters = precompiler->feedback()->EdgeCounters(function);
+    if (edge_counters.IsNull() ||
+        (edge_counters.Length() != flow_graph->preorder().length())) {
+      return;
+    }
+#else
     return;
+#endif  // defined(DART_PRECOMPILER)
+  } else {
+    const Array& ic_data_array =
+        Array::Handle(flow_graph->zone(), function.ic_data_array());
+    if (ic_data_array.IsNull()) {
+      DEBUG_ASSERT(IsolateGroup::Current()->HasAttemptedReload() ||
+                   function.ForceOptimize());
+      return;
+    }
+    edge_counters ^=
+        ic_data_array.At(Function::ICDataArrayIndices::kEdgeCounters);
+    if (edge_counters.IsNull()) {
+      return;
+    }
   }
 
   auto graph_entry = flow_graph->graph_entry();
@@ -247,6 +268,10 @@ void BlockScheduler::ReorderBlocksJIT(FlowGraph* flow_graph) {
 // - Blocks which belong to the same loop are kept together (where possible)
 // and not interspersed with other blocks.
 //
+// If a JIT training run provided edge weights, the more frequent successor
+// of a branch outside of loops is placed first so that it falls through,
+// and a successor which never ran while its sibling did is considered cold.
+//
 namespace {
 class AOTBlockScheduler {
  public:
@@ -255,7 +280,8 @@ class AOTBlockScheduler {
         block_count_(flow_graph->reverse_postorder().length()),
         marks_(block_count_),
         postorder_(block_count_),
-        cold_postorder_(10) {
+        cold_postorder_(10),
+        has_profile_(flow_graph->graph_entry()->entry_count() > 0) {
     marks_.FillWith(0, 0, block_count_);
   }
 
@@ -307,6 +333,11 @@ class AOTBlockScheduler {
               PushBlock(succ0);
               PushBlock(succ1);
             }
+          } else if (successor_count == 2 && has_profile_ &&
+                     last->SuccessorAt(0)->IsTargetEntry() &&
+                     last->SuccessorAt(1)->IsTargetEntry()) {
+            PushByWeight(last->SuccessorAt(0)->AsTargetEntry(),
+                         last->SuccessorAt(1)->AsTargetEntry());
           } else {
             for (intptr_t i = 0; i < successor_count; i++) {
               PushBlock(last->SuccessorAt(i));
@@ -371,6 +402,25 @@ class AOTBlockScheduler {
     }
   }
 
+  // Push the less frequent successor last, so that it is visited first and
+  // ends up after the more frequent one.
+  void PushByWeight(TargetEntryInstr* succ0, TargetEntryInstr* succ1) {
+    const double weight0 = succ0->edge_weight();
+    const double weight1 = succ1->edge_weight();
+    if (weight0 >= weight1) {
+      PushBlock(succ0);
+      PushBlock(succ1);
+    } else {
+      PushBlock(succ1);
+      PushBlock(succ0);
+    }
+    if (weight0 == 0.0 && weight1 > 0.0) {
+      MarksOf(succ0) |= kColdMark;
+    } else if (weight1 == 0.0 && weight0 > 0.0) {
+      MarksOf(succ1) |= kColdMark;
+    }
+  }
+
   FlowGraph* const flow_graph_;
   const intptr_t block_count_;
 
@@ -382,6 +432,9 @@ class AOTBlockScheduler {
 
   GrowableArray<BlockEntryInstr*> postorder_;
   GrowableArray<BlockEntryInstr*> cold_postorder_;
+
+  // Whether edge weights were assigned from a training run.
+  const bool has_profile_;
 };
 }  // namespace
 
@@ -8749,6 +8749,30 @@ SimdOpInstr* SimdOpInstr::CreateFromFactoryCall(Zone* zone,
   return op;
 }
 
+SimdOpInstr* SimdOpInstr::CreateSplat(Zone* zone,
+                                      intptr_t cid,
+                                      Definition* value,
+                                      intptr_t deopt_id) {
+  switch (cid) {
+    case kFloat32x4Cid:
+      return new (zone)
+          SimdOpInstr(kFloat32x4Splat, new (zone) Value(value), deopt_id);
+    case kFloat64x2Cid:
+      return new (zone)
+          SimdOpInstr(kFloat64x2Splat, new (zone) Value(value), deopt_id);
+    case kInt32x4Cid: {
+      auto op = new (zone) SimdOpInstr(kInt32x4FromInts, deopt_id);
+      for (intptr_t i = 0; i < 4; i++) {
+        op->SetInputAt(i, new (zone) Value(value));
+      }
+      return op;
+    }
+  }
+
+  UNREACHABLE();
+  return nullptr;
+}
+
 SimdOpInstr::Kind SimdOpInstr::KindForOperator(intptr_t cid, Token::Kind op) {
   switch (cid) {
     case kFloat32x4Cid:
@@ -11290,6 +11290,18 @@ class SimdOpInstr : public Definition {
     return new SimdOpInstr(kind, left, right, deopt_id);
   }
 
+  // Create a unary SimdOp instr.
+  static SimdOpInstr* Create(Kind kind, Value* value, intptr_t deopt_id) {
+    return new SimdOpInstr(kind, value, deopt_id);
+  }
+
+  // Create a SimdOp which sets all lanes of a value of the given SIMD cid
+  // to [value].
+  static SimdOpInstr* CreateSplat(Zone* zone,
+                                  intptr_t cid,
+                                  Definition* value,
+                                  intptr_t deopt_id);
+
   // Create a binary SimdOp instr.
   static SimdOpInstr* Create(MethodRecognizer::Kind kind,
                              Value* left,
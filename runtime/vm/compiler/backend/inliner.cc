@@ -12,6 +12,7 @@
 #include "vm/compiler/backend/flow_graph_compiler.h"
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/type_propagator.h"
+#include "vm/compiler/compiler_feedback.h"
 #include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/compiler_timings.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
@@ -1609,6 +1610,13 @@ class CallSiteInliner : public ValueObject {
  private:
   friend class PolymorphicInliner;
 
+  // Whether a JIT training run found [target] hot enough to optimize it.
+  bool IsHotInTrainingRun(const Function& target) const {
+    auto precompiler = inliner_->precompiler_;
+    return (precompiler != nullptr) && (precompiler->feedback() != nullptr) &&
+           precompiler->feedback()->IsHot(target);
+  }
+
   static bool Contains(const GrowableArray<intptr_t>& a, intptr_t deopt_id) {
     for (intptr_t i = 0; i < a.length(); i++) {
       if (a[i] == deopt_id) return true;
@@ -1747,11 +1755,13 @@ class CallSiteInliner : public ValueObject {
       // Under AOT, calls outside loops may pass our regular heuristics due
       // to a relatively high ratio. So, unless we are optimizing solely for
       // speed, such call sites are subject to subsequent stricter heuristic
-      // to limit code size increase.
+      // to limit code size increase. Targets which were hot in a training
+      // run are exempt.
       bool stricter_heuristic = CompilerState::Current().is_aot() &&
                                 FLAG_optimization_level <= 2 &&
                                 !inliner_->AlwaysInline(target) &&
-                                call_info[call_idx].nesting_depth == 0;
+                                call_info[call_idx].nesting_depth == 0 &&
+                                !IsHotInTrainingRun(target);
       if (TryInlining(call->function(), call->argument_names(), &call_data,
                       stricter_heuristic)) {
         InlineCall(&call_data);
@@ -0,0 +1,860 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/class_id.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/hash_map.h"
+#include "vm/log.h"
+#include "vm/os.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            vectorize_loops,
+            true,
+            "Vectorize simple loops over typed data using Simd128 values.");
+DEFINE_FLAG(bool,
+            trace_loop_vectorizer,
+            false,
+            "Print loops rewritten by the loop vectorizer.");
+
+// Quick access to the current zone.
+#define Z (flow_graph_->zone())
+
+// What a definition of the loop body turns into in the vectorized loop.
+enum class Role {
+  // Not defined in the loop body.
+  kNone,
+  // The loop index itself, e.g. a bounds check or a box of it.
+  kIndex,
+  // The increment of the loop index.
+  kNext,
+  // A value computed lane by lane by a vector operation.
+  kLane,
+  // A reduction phi, or one of the operations updating it.
+  kReduction,
+};
+
+// A value accumulated over the iterations of the loop (see
+// CountedLoop::AnalyzeReduction).
+struct Reduction {
+  PhiInstr* phi;
+  BinaryIntegerOpInstr* op;
+  // The input of [op] which is not [phi].
+  Value* operand;
+  // Value of the phi before the loop.
+  Definition* initial;
+  // The mask applied after [op], 2^k - 1.
+  int64_t bits;
+  // The lanes the vectorized loop accumulates the operands in.
+  PhiInstr* accumulator;
+};
+
+// An innermost loop of the form
+//
+//   pre_header:
+//     goto header
+//   header:
+//     i <- phi(i0, next)
+//     s <- phi(s0, m)  // Any number of reductions.
+//     CheckStackOverflow
+//     if (i < n) goto body else goto exit
+//   body:
+//     ...
+//     next <- i + 1
+//     goto header
+//
+// which the vectorizer can rewrite.
+class CountedLoop : public ZoneObject {
+ public:
+  CountedLoop(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph),
+        loop_(loop),
+        header_(loop->header()->AsJoinEntry()),
+        lengths_(Z, 2),
+        reductions_(Z, 1),
+        roles_(),
+        vectors_(),
+        splats_() {}
+
+  // Whether the loop has the form above and each of its iterations can be
+  // computed by one lane of vector operations.
+  bool CanVectorize();
+
+  // Inserts the vectorized loop between the pre-header and the header, so
+  // that the original loop handles the remaining iterations.
+  void Vectorize();
+
+  const char* ToCString() const;
+
+ private:
+  typedef RawPointerKeyValueTrait<Definition, Role> RoleKV;
+  typedef RawPointerKeyValueTrait<Definition, Definition*> DefinitionKV;
+
+  bool AnalyzeHeader();
+  bool AnalyzeReduction(PhiInstr* phi);
+  bool AnalyzeBody();
+  bool AnalyzeInstruction(Instruction* instr);
+
+  // Whether [value] is the loop index.
+  bool IsIndex(Value* value) const {
+    Definition* def = value->definition();
+    return (def == index_) || (roles_.LookupValue(def) == Role::kIndex);
+  }
+
+  // Whether [value] is defined in the loop.
+  bool IsDefinedInLoop(Value* value) const {
+    Definition* def = value->definition();
+    return (def == index_) || (roles_.LookupValue(def) != Role::kNone);
+  }
+
+  // Whether [value] can be an input of a vector operation: either it is
+  // itself computed lane by lane, or it is loop invariant.
+  bool IsLaneOperand(Value* value) const {
+    Definition* def = value->definition();
+    if (def == index_) return false;
+    const Role role = roles_.LookupValue(def);
+    return (role == Role::kNone) || (role == Role::kLane);
+  }
+
+  bool IsVectorizableAccess(Value* array,
+                            Value* index,
+                            intptr_t class_id,
+                            intptr_t index_scale);
+
+  // Sets the SIMD cid all vector operations of the loop use, returning false
+  // if the loop already uses another one.
+  bool UseVectorCid(intptr_t cid) {
+    if (vector_cid_ == kIllegalCid) {
+      vector_cid_ = cid;
+    }
+    return vector_cid_ == cid;
+  }
+
+  intptr_t lanes() const { return (vector_cid_ == kFloat64x2Cid) ? 2 : 4; }
+
+  intptr_t vector_array_cid() const {
+    return (vector_cid_ == kFloat64x2Cid) ? kTypedDataFloat64x2ArrayCid
+                                          : kTypedDataInt32x4ArrayCid;
+  }
+
+  Definition* EmitInPreHeader(Definition* def);
+  Definition* Splat(Definition* def);
+  Value* VectorOf(Value* value);
+  Instruction* VectorInstruction(Instruction* instr, PhiInstr* vector_index);
+  Definition* CombineLanes(Instruction** cursor, const Reduction& reduction);
+
+  FlowGraph* flow_graph_;
+  LoopInfo* loop_;
+  JoinEntryInstr* header_;
+  BlockEntryInstr* pre_header_ = nullptr;
+  TargetEntryInstr* body_ = nullptr;
+  PhiInstr* index_ = nullptr;
+  Definition* initial_ = nullptr;
+  Definition* limit_ = nullptr;
+  BinaryIntegerOpInstr* next_ = nullptr;
+  CheckStackOverflowInstr* check_ = nullptr;
+  BranchInstr* branch_ = nullptr;
+  // Lengths of the bounds checks of the loop body.
+  GrowableArray<Definition*> lengths_;
+  GrowableArray<Reduction> reductions_;
+  // kFloat64x2Cid or kInt32x4Cid.
+  intptr_t vector_cid_ = kIllegalCid;
+  bool has_store_ = false;
+
+  DirectChainedHashMap<RoleKV> roles_;
+  // Vector definitions of the definitions of the loop body.
+  DirectChainedHashMap<DefinitionKV> vectors_;
+  // Splats of loop invariant definitions.
+  DirectChainedHashMap<DefinitionKV> splats_;
+};
+
+bool CountedLoop::CanVectorize() {
+  if (header_ == nullptr || loop_->back_edges().length() != 1 ||
+      header_->PredecessorCount() != 2 ||
+      loop_->IsBackEdge(header_->PredecessorAt(0))) {
+    return false;
+  }
+  intptr_t block_count = 0;
+  for (BitVector::Iterator it(loop_->blocks()); !it.Done(); it.Advance()) {
+    block_count++;
+  }
+  if (block_count != 2) {
+    return false;
+  }
+  pre_header_ = header_->PredecessorAt(0);
+  if (!pre_header_->last_instruction()->IsGoto()) {
+    return false;
+  }
+  return AnalyzeHeader() && AnalyzeBody();
+}
+
+bool CountedLoop::AnalyzeHeader() {
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (auto check = instr->AsCheckStackOverflow()) {
+      if (check_ != nullptr) return false;
+      check_ = check;
+    } else if (auto branch = instr->AsBranch()) {
+      branch_ = branch;
+    } else {
+      return false;
+    }
+  }
+  if (branch_ == nullptr) {
+    return false;
+  }
+  auto compare = branch_->condition()->AsRelationalOp();
+  if (compare == nullptr || compare->kind() != Token::kLT) {
+    return false;
+  }
+  index_ = compare->left()->definition()->AsPhi();
+  if (index_ == nullptr || index_->block() != header_) {
+    return false;
+  }
+  const Representation rep = index_->representation();
+  if (rep != kUnboxedInt64 &&
+      !(rep == kTagged && index_->Type()->ToCid() == kSmiCid)) {
+    return false;
+  }
+  if (compare->right()->definition() == index_ ||
+      !(compare->input_representation() == kUnboxedInt64 ||
+        (compare->input_representation() == kTagged &&
+         compare->right()->Type()->ToCid() == kSmiCid))) {
+    return false;
+  }
+  limit_ = compare->right()->definition();
+
+  body_ = branch_->true_successor();
+  if (!loop_->Contains(body_) || loop_->back_edges()[0] != body_) {
+    return false;
+  }
+
+  // The vectorized loop starts with the same index, and accesses elements
+  // without bounds checks, so the index must not start out negative.
+  Value* initial = index_->InputAt(0);
+  initial_ = initial->definition();
+  if (initial->BindsToSmiConstant()
+          ? (initial->BoundSmiConstant() < 0)
+          : !RangeUtils::IsPositive(initial_->range())) {
+    return false;
+  }
+
+  next_ = index_->InputAt(1)->definition()->AsBinaryIntegerOp();
+  if ((next_ == nullptr) || (next_->op_kind() != Token::kADD) ||
+      (next_->left()->definition() != index_) ||
+      !next_->right()->BindsToSmiConstant() ||
+      (next_->right()->BoundSmiConstant() != 1)) {
+    return false;
+  }
+
+  // Any other value carried from one iteration to the next must be a
+  // reduction, otherwise the vectorized loop would not compute it.
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    if (phi != index_ && !AnalyzeReduction(phi)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A reduction has the form
+//
+//   s <- phi(s0, m)
+//   ...
+//   t <- s op x
+//   m <- t & mask
+//
+// where op is +, &, | or ^ and mask is 2^k - 1 for some k <= 32, as in a
+// checksum. The low k bits of the result only depend on the low 32 bits
+// of the operands, so each lane of the vectorized loop can accumulate a
+// part of them, and the lanes are combined when the vectorized loop ends.
+bool CountedLoop::AnalyzeReduction(PhiInstr* phi) {
+  // There is no scalar value of the reduction in the vectorized loop which
+  // a deoptimization or a catch block could continue with.
+  if (!CompilerState::Current().is_aot() || header_->InsideTryBlock()) {
+    return false;
+  }
+  const Representation rep = phi->representation();
+  if (rep != kUnboxedInt64 && rep != kUnboxedInt32 && rep != kUnboxedUint32) {
+    return false;
+  }
+
+  auto mask = phi->InputAt(1)->definition()->AsBinaryIntegerOp();
+  if (mask == nullptr || mask->op_kind() != Token::kBIT_AND ||
+      mask->representation() != rep) {
+    return false;
+  }
+  Value* masked = mask->left();
+  Value* mask_value = mask->right();
+  if (!mask_value->BindsToConstant()) {
+    std::swap(masked, mask_value);
+  }
+  if (!mask_value->BindsToConstant() ||
+      !mask_value->BoundConstant().IsInteger()) {
+    return false;
+  }
+  const int64_t bits = Integer::Cast(mask_value->BoundConstant()).Value();
+  if (bits <= 0 || bits > kMaxUint32 || !Utils::IsPowerOfTwo(bits + 1)) {
+    return false;
+  }
+  // The mask is applied to the initial value when the lanes are combined,
+  // which must not change it if the loop does not run at all.
+  Value* initial = phi->InputAt(0);
+  if (initial->BindsToSmiConstant()
+          ? (initial->BoundSmiConstant() < 0 ||
+             initial->BoundSmiConstant() > bits)
+          : !RangeUtils::IsWithin(initial->definition()->range(), 0, bits)) {
+    return false;
+  }
+
+  auto op = masked->definition()->AsBinaryIntegerOp();
+  if (op == nullptr || op->representation() != rep || op->CanDeoptimize()) {
+    return false;
+  }
+  switch (op->op_kind()) {
+    case Token::kADD:
+    case Token::kBIT_AND:
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+      break;
+    default:
+      return false;
+  }
+  Value* operand = op->right();
+  if (op->left()->definition() != phi) {
+    operand = op->left();
+    if (op->right()->definition() != phi) {
+      return false;
+    }
+  }
+  if (operand->definition() == phi) {
+    return false;
+  }
+
+  // The partial values are not available in the vectorized loop, so only
+  // the original loop's exit can use the reduction.
+  if (!op->HasOnlyInputUse(masked) || !mask->HasOnlyInputUse(phi->InputAt(1))) {
+    return false;
+  }
+  for (Value::Iterator it(phi->input_use_list()); !it.Done(); it.Advance()) {
+    Instruction* user = it.Current()->instruction();
+    if (user != op && loop_->Contains(user->GetBlock())) {
+      return false;
+    }
+  }
+
+  roles_.Insert({phi, Role::kReduction});
+  roles_.Insert({op, Role::kReduction});
+  roles_.Insert({mask, Role::kReduction});
+  reductions_.Add({phi, op, operand, initial->definition(), bits, nullptr});
+  return true;
+}
+
+bool CountedLoop::AnalyzeBody() {
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (instr == body_->last_instruction()) {
+      // The body is the only back edge, so it ends in a goto to the header.
+      if (!instr->IsGoto()) return false;
+      ASSERT(instr->AsGoto()->successor() == header_);
+      break;
+    }
+    if (!AnalyzeInstruction(instr)) {
+      return false;
+    }
+  }
+  return (has_store_ || !reductions_.is_empty()) &&
+         (roles_.LookupValue(next_) == Role::kNext);
+}
+
+bool CountedLoop::AnalyzeInstruction(Instruction* instr) {
+  if (instr->IsCheckStackOverflow()) {
+    return true;
+  }
+
+  if (instr == next_) {
+    roles_.Insert({next_, Role::kNext});
+    return true;
+  }
+
+  if (instr->IsDefinition() &&
+      (roles_.LookupValue(instr->AsDefinition()) == Role::kReduction)) {
+    // The mask is applied when the lanes are combined.
+    for (const Reduction& reduction : reductions_) {
+      if (instr == reduction.op) {
+        return UseVectorCid(kInt32x4Cid) &&
+               IsLaneOperand(reduction.operand);
+      }
+    }
+    return true;
+  }
+
+  if (auto check = instr->AsCheckBoundBase()) {
+    // The vectorized loop stops before the first index which fails the check
+    // and leaves that index to the original loop.
+    if (!IsIndex(check->index()) || IsDefinedInLoop(check->length())) {
+      return false;
+    }
+    Definition* length = check->length()->definition();
+    if (length != limit_ && !lengths_.Contains(length)) {
+      lengths_.Add(length);
+    }
+    roles_.Insert({check, Role::kIndex});
+    return true;
+  }
+
+  if (auto box = instr->AsBoxInteger()) {
+    if (!IsIndex(box->value())) return false;
+    roles_.Insert({box, Role::kIndex});
+    return true;
+  }
+
+  if (auto unbox = instr->AsUnboxInteger()) {
+    if (!IsIndex(unbox->value())) return false;
+    roles_.Insert({unbox, Role::kIndex});
+    return true;
+  }
+
+  if (auto load = instr->AsLoadIndexed()) {
+    if (!IsVectorizableAccess(load->array(), load->index(), load->class_id(),
+                              load->index_scale())) {
+      return false;
+    }
+    roles_.Insert({load, Role::kLane});
+    return true;
+  }
+
+  if (auto store = instr->AsStoreIndexed()) {
+    if (!IsVectorizableAccess(store->array(), store->index(),
+                              store->class_id(), store->index_scale()) ||
+        !IsLaneOperand(store->value())) {
+      return false;
+    }
+    has_store_ = true;
+    return true;
+  }
+
+  if (auto op = instr->AsBinaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kADD:
+      case Token::kSUB:
+      case Token::kMUL:
+      case Token::kDIV:
+        break;
+      default:
+        return false;
+    }
+    if (op->representation() != kUnboxedDouble ||
+        !UseVectorCid(kFloat64x2Cid) || !IsLaneOperand(op->left()) ||
+        !IsLaneOperand(op->right())) {
+      return false;
+    }
+    roles_.Insert({op, Role::kLane});
+    return true;
+  }
+
+  if (auto op = instr->AsUnaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kNEGATE:
+      case Token::kSQRT:
+      case Token::kSQUARE:
+        break;
+      default:
+        return false;
+    }
+    if (op->representation() != kUnboxedDouble ||
+        !UseVectorCid(kFloat64x2Cid) || !IsLaneOperand(op->value())) {
+      return false;
+    }
+    roles_.Insert({op, Role::kLane});
+    return true;
+  }
+
+  // Lanes hold the low 32 bits of integer values, which is all that is
+  // stored into the arrays, so only operations whose low 32 bits depend
+  // only on the low 32 bits of their inputs are vectorized.
+  if (instr->IsBinaryInt64Op() || instr->IsBinaryInt32Op() ||
+      instr->IsBinaryUint32Op()) {
+    auto op = instr->AsBinaryIntegerOp();
+    switch (op->op_kind()) {
+      case Token::kADD:
+      case Token::kSUB:
+      case Token::kBIT_AND:
+      case Token::kBIT_OR:
+      case Token::kBIT_XOR:
+        break;
+      default:
+        return false;
+    }
+    if (op->CanDeoptimize() || !UseVectorCid(kInt32x4Cid) ||
+        !IsLaneOperand(op->left()) || !IsLaneOperand(op->right())) {
+      return false;
+    }
+    roles_.Insert({op, Role::kLane});
+    return true;
+  }
+
+  if (auto conv = instr->AsIntConverter()) {
+    if (conv->from() == kUntagged || conv->to() == kUntagged ||
+        !UseVectorCid(kInt32x4Cid) || !IsLaneOperand(conv->value())) {
+      return false;
+    }
+    roles_.Insert({conv, Role::kLane});
+    return true;
+  }
+
+  return false;
+}
+
+bool CountedLoop::IsVectorizableAccess(Value* array,
+                                       Value* index,
+                                       intptr_t class_id,
+                                       intptr_t index_scale) {
+  if (!IsIndex(index) || IsDefinedInLoop(array) ||
+      array->definition()->representation() != kTagged) {
+    return false;
+  }
+  // Two distinct internal typed data objects never overlap, so accesses to
+  // different arrays at the same index do not depend on each other.
+  if (array->Type()->ToCid() != class_id) {
+    return false;
+  }
+  switch (class_id) {
+    case kTypedDataFloat64ArrayCid:
+      return (index_scale == kDoubleSize) && UseVectorCid(kFloat64x2Cid);
+    case kTypedDataInt32ArrayCid:
+    case kTypedDataUint32ArrayCid:
+      return (index_scale == kInt32Size) && UseVectorCid(kInt32x4Cid);
+    default:
+      return false;
+  }
+}
+
+Definition* CountedLoop::EmitInPreHeader(Definition* def) {
+  flow_graph_->InsertBefore(pre_header_->last_instruction(), def, nullptr,
+                            FlowGraph::kValue);
+  return def;
+}
+
+Definition* CountedLoop::Splat(Definition* def) {
+  Definition* splat = splats_.LookupValue(def);
+  if (splat != nullptr) {
+    return splat;
+  }
+  Definition* lane = def;
+  if (vector_cid_ == kInt32x4Cid) {
+    if (auto constant = def->AsConstant()) {
+      const int32_t value = static_cast<int32_t>(
+          Integer::Cast(constant->value()).Value());
+      lane = flow_graph_->GetConstant(
+          Integer::ZoneHandle(Z, Integer::NewCanonical(value)), kUnboxedInt32);
+    } else if (def->representation() != kUnboxedInt32) {
+      const Representation from = (def->representation() == kUnboxedUint32)
+                                      ? kUnboxedUint32
+                                      : kUnboxedInt64;
+      lane = EmitInPreHeader(new (Z) IntConverterInstr(
+          from, kUnboxedInt32, new (Z) Value(def)));
+    }
+  }
+  splat = EmitInPreHeader(
+      SimdOpInstr::CreateSplat(Z, vector_cid_, lane, DeoptId::kNone));
+  splats_.Insert({def, splat});
+  return splat;
+}
+
+Value* CountedLoop::VectorOf(Value* value) {
+  Definition* def = value->definition();
+  Definition* vector = vectors_.LookupValue(def);
+  if (vector == nullptr) {
+    ASSERT(!IsDefinedInLoop(value));
+    vector = Splat(def);
+  }
+  return new (Z) Value(vector);
+}
+
+Instruction* CountedLoop::VectorInstruction(Instruction* instr,
+                                            PhiInstr* vector_index) {
+  if (auto load = instr->AsLoadIndexed()) {
+    return new (Z) LoadIndexedInstr(
+        load->array()->CopyWithType(Z), new (Z) Value(vector_index),
+        /*index_unboxed=*/true, load->index_scale(), vector_array_cid(),
+        kAlignedAccess, DeoptId::kNone, load->source());
+  }
+  if (auto store = instr->AsStoreIndexed()) {
+    return new (Z) StoreIndexedInstr(
+        store->array()->CopyWithType(Z), new (Z) Value(vector_index),
+        VectorOf(store->value()), kNoStoreBarrier, /*index_unboxed=*/true,
+        store->index_scale(), vector_array_cid(), kAlignedAccess,
+        DeoptId::kNone, store->source());
+  }
+  if (auto op = instr->AsBinaryDoubleOp()) {
+    return SimdOpInstr::Create(
+        SimdOpInstr::KindForOperator(kFloat64x2Cid, op->op_kind()),
+        VectorOf(op->left()), VectorOf(op->right()), DeoptId::kNone);
+  }
+  if (auto op = instr->AsUnaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kNEGATE:
+        return SimdOpInstr::Create(SimdOpInstr::kFloat64x2Negate,
+                                   VectorOf(op->value()), DeoptId::kNone);
+      case Token::kSQRT:
+        return SimdOpInstr::Create(SimdOpInstr::kFloat64x2Sqrt,
+                                   VectorOf(op->value()), DeoptId::kNone);
+      case Token::kSQUARE:
+        return SimdOpInstr::Create(SimdOpInstr::kFloat64x2Mul,
+                                   VectorOf(op->value()),
+                                   VectorOf(op->value()), DeoptId::kNone);
+      default:
+        UNREACHABLE();
+    }
+  }
+  for (const Reduction& reduction : reductions_) {
+    if (instr == reduction.op) {
+      return SimdOpInstr::Create(
+          SimdOpInstr::KindForOperator(kInt32x4Cid, reduction.op->op_kind()),
+          new (Z) Value(reduction.accumulator), VectorOf(reduction.operand),
+          DeoptId::kNone);
+    }
+  }
+  if (instr->IsDefinition() &&
+      (roles_.LookupValue(instr->AsDefinition()) == Role::kLane)) {
+    if (auto op = instr->AsBinaryIntegerOp()) {
+      return SimdOpInstr::Create(
+          SimdOpInstr::KindForOperator(kInt32x4Cid, op->op_kind()),
+          VectorOf(op->left()), VectorOf(op->right()), DeoptId::kNone);
+    }
+    if (auto conv = instr->AsIntConverter()) {
+      // Conversions between integer representations keep the low 32 bits.
+      vectors_.Insert({conv, VectorOf(conv->value())->definition()});
+      return nullptr;
+    }
+  }
+  // Bounds checks, stack overflow checks, the index computations and the
+  // masks of reductions are not needed by the vectorized loop.
+  return nullptr;
+}
+
+// Emits (s0 op <the lanes of the accumulator combined with op>) & mask,
+// which is the value of the reduction after the iterations of the
+// vectorized loop.
+Definition* CountedLoop::CombineLanes(Instruction** cursor,
+                                      const Reduction& reduction) {
+  auto emit = [&](Definition* def) {
+    *cursor = flow_graph_->AppendTo(*cursor, def, nullptr, FlowGraph::kValue);
+    return def;
+  };
+  const Token::Kind op_kind = reduction.op->op_kind();
+  const Representation rep = reduction.phi->representation();
+
+  // The lanes are sign extended, which does not change their low 32 bits.
+  Definition* result = nullptr;
+  for (auto kind :
+       {SimdOpInstr::kInt32x4GetX, SimdOpInstr::kInt32x4GetY,
+        SimdOpInstr::kInt32x4GetZ, SimdOpInstr::kInt32x4GetW}) {
+    Definition* lane = emit(SimdOpInstr::Create(
+        kind, new (Z) Value(reduction.accumulator), DeoptId::kNone));
+    lane = emit(new (Z) IntConverterInstr(kUnboxedInt32, kUnboxedInt64,
+                                          new (Z) Value(lane)));
+    result = (result == nullptr)
+                 ? lane
+                 : emit(BinaryIntegerOpInstr::Make(
+                       kUnboxedInt64, op_kind, new (Z) Value(result),
+                       new (Z) Value(lane), DeoptId::kNone));
+  }
+
+  Definition* initial = reduction.initial;
+  if (rep != kUnboxedInt64) {
+    initial = emit(new (Z) IntConverterInstr(rep, kUnboxedInt64,
+                                             new (Z) Value(initial)));
+  }
+  result = emit(BinaryIntegerOpInstr::Make(kUnboxedInt64, op_kind,
+                                           new (Z) Value(initial),
+                                           new (Z) Value(result),
+                                           DeoptId::kNone));
+  ConstantInstr* bits = flow_graph_->GetConstant(
+      Integer::ZoneHandle(Z, Integer::NewCanonical(reduction.bits)),
+      kUnboxedInt64);
+  result = emit(BinaryIntegerOpInstr::Make(
+      kUnboxedInt64, Token::kBIT_AND, new (Z) Value(result),
+      new (Z) Value(bits), DeoptId::kNone));
+  if (rep != kUnboxedInt64) {
+    result = emit(new (Z) IntConverterInstr(kUnboxedInt64, rep,
+                                            new (Z) Value(result)));
+  }
+  return result;
+}
+
+void CountedLoop::Vectorize() {
+  // last = max(min(n, lengths...), 0) - lanes, which does not overflow.
+  Definition* limit = limit_;
+  for (Definition* length : lengths_) {
+    limit = EmitInPreHeader(new (Z) MathMinMaxInstr(
+        MethodRecognizer::kMathMin, new (Z) Value(limit),
+        new (Z) Value(length), DeoptId::kNone, kUnboxedInt64));
+  }
+  limit = EmitInPreHeader(new (Z) MathMinMaxInstr(
+      MethodRecognizer::kMathMax, new (Z) Value(limit),
+      new (Z) Value(flow_graph_->GetConstant(Object::smi_zero(),
+                                             kUnboxedInt64)),
+      DeoptId::kNone, kUnboxedInt64));
+  ConstantInstr* lanes = flow_graph_->GetConstant(
+      Smi::ZoneHandle(Z, Smi::New(this->lanes())), kUnboxedInt64);
+  Definition* last = EmitInPreHeader(BinaryIntegerOpInstr::Make(
+      kUnboxedInt64, Token::kSUB, new (Z) Value(limit), new (Z) Value(lanes),
+      DeoptId::kNone));
+
+  const intptr_t try_index = header_->try_index();
+  auto vector_header = new (Z) JoinEntryInstr(flow_graph_->allocate_block_id(),
+                                              try_index, DeoptId::kNone);
+  auto vector_body = new (Z) TargetEntryInstr(flow_graph_->allocate_block_id(),
+                                              try_index, DeoptId::kNone);
+  auto vector_exit = new (Z) TargetEntryInstr(flow_graph_->allocate_block_id(),
+                                              try_index, DeoptId::kNone);
+
+  // vector_header:
+  //   vi <- phi(i0, vi + lanes)
+  //   CheckStackOverflow
+  //   if (vi <= last) goto vector_body else goto vector_exit
+  PhiInstr* vector_index = flow_graph_->AddPhi(vector_header, initial_,
+                                               initial_);
+  vector_index->set_representation(kUnboxedInt64);
+  // The lanes of a reduction start out with the identity of its operation.
+  for (Reduction& reduction : reductions_) {
+    const intptr_t identity =
+        (reduction.op->op_kind() == Token::kBIT_AND) ? -1 : 0;
+    Definition* lanes = Splat(flow_graph_->GetConstant(
+        Smi::ZoneHandle(Z, Smi::New(identity))));
+    reduction.accumulator = flow_graph_->AddPhi(vector_header, lanes, lanes);
+    reduction.accumulator->set_representation(kUnboxedInt32x4);
+  }
+  Instruction* cursor = vector_header;
+  if (check_ != nullptr) {
+    // Deoptimizing at the check resumes the original loop at index vi.
+    auto check = new (Z) CheckStackOverflowInstr(
+        check_->source(), check_->stack_depth(), check_->loop_depth(),
+        check_->deopt_id(), CheckStackOverflowInstr::kOsrAndPreemption);
+    cursor = flow_graph_->AppendTo(cursor, check, check_->env(),
+                                   FlowGraph::kEffect);
+    for (Environment::DeepIterator it(check->env()); !it.Done();
+         it.Advance()) {
+      Definition* def = it.CurrentValue()->definition();
+      if (def == index_) {
+        it.CurrentValue()->BindToEnvironment(vector_index);
+      }
+      // Only AOT code outside of try blocks has reductions, and nothing
+      // reads the environment of its checks.
+      for (const Reduction& reduction : reductions_) {
+        if (def == reduction.phi) {
+          it.CurrentValue()->BindToEnvironment(reduction.initial);
+        }
+      }
+    }
+  }
+  auto branch = new (Z) BranchInstr(
+      new (Z) RelationalOpInstr(branch_->source(), Token::kLTE,
+                                new (Z) Value(vector_index),
+                                new (Z) Value(last), kUnboxedInt64,
+                                DeoptId::kNone),
+      DeoptId::kNone);
+  flow_graph_->AppendTo(cursor, branch, nullptr, FlowGraph::kEffect);
+  vector_header->set_last_instruction(branch);
+  *branch->true_successor_address() = vector_body;
+  *branch->false_successor_address() = vector_exit;
+
+  // vector_body:
+  //   <vector operations at vi>
+  //   goto vector_header
+  cursor = vector_body;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* vector = VectorInstruction(it.Current(), vector_index);
+    if (vector == nullptr) continue;
+    if (vector->IsDefinition()) {
+      cursor = flow_graph_->AppendTo(cursor, vector, nullptr,
+                                     FlowGraph::kValue);
+      vectors_.Insert({it.Current()->AsDefinition(), vector->AsDefinition()});
+    } else {
+      cursor = flow_graph_->AppendTo(cursor, vector, nullptr,
+                                     FlowGraph::kEffect);
+    }
+  }
+  Definition* next = BinaryIntegerOpInstr::Make(
+      kUnboxedInt64, Token::kADD, new (Z) Value(vector_index),
+      new (Z) Value(lanes), DeoptId::kNone);
+  cursor = flow_graph_->AppendTo(cursor, next, nullptr, FlowGraph::kValue);
+  vector_index->InputAt(1)->BindTo(next);
+  for (const Reduction& reduction : reductions_) {
+    reduction.accumulator->InputAt(1)->BindTo(
+        vectors_.LookupValue(reduction.op));
+  }
+  auto back_edge = new (Z) GotoInstr(vector_header, DeoptId::kNone);
+  flow_graph_->AppendTo(cursor, back_edge, nullptr, FlowGraph::kEffect);
+  vector_body->set_last_instruction(back_edge);
+
+  // vector_exit:
+  //   s0' <- <lanes of the reductions combined>
+  //   goto header
+  cursor = vector_exit;
+  for (const Reduction& reduction : reductions_) {
+    reduction.phi->InputAt(0)->BindTo(CombineLanes(&cursor, reduction));
+  }
+  auto exit = new (Z) GotoInstr(header_, DeoptId::kNone);
+  flow_graph_->AppendTo(cursor, exit, nullptr, FlowGraph::kEffect);
+  vector_exit->set_last_instruction(exit);
+
+  // The original loop continues with the index the vectorized loop ends at.
+  pre_header_->last_instruction()->AsGoto()->set_successor(vector_header);
+  index_->InputAt(0)->BindTo(vector_index);
+}
+
+const char* CountedLoop::ToCString() const {
+  return OS::SCreate(Z, "B%" Pd " with %" Pd " x %s lanes",
+                     header_->block_id(), lanes(),
+                     (vector_cid_ == kFloat64x2Cid) ? "double" : "int32");
+}
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {
+#if defined(TARGET_ARCH_IS_64_BIT)
+  if (!FLAG_vectorize_loops || !FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+
+  // Find all loops first: vectorizing changes the loop hierarchy.
+  const ZoneGrowableArray<BlockEntryInstr*>& loop_headers =
+      flow_graph->GetLoopHierarchy().headers();
+  GrowableArray<CountedLoop*> loops;
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    auto loop = new (flow_graph->zone())
+        CountedLoop(flow_graph, loop_headers[i]->loop_info());
+    if (loop->CanVectorize()) {
+      loops.Add(loop);
+    }
+  }
+  if (loops.is_empty()) {
+    return;
+  }
+
+  for (CountedLoop* loop : loops) {
+    if (FLAG_trace_loop_vectorizer) {
+      THR_Print("Vectorizing loop %s in %s\n", loop->ToCString(),
+                flow_graph->function().ToFullyQualifiedCString());
+    }
+    loop->Vectorize();
+  }
+
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+#endif  // defined(TARGET_ARCH_IS_64_BIT)
+}
+
+}  // namespace dart
@@ -0,0 +1,48 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Rewrites innermost counted loops over typed data to process several
+// elements per iteration with Simd128 operations. The original loop is kept
+// as the epilogue which handles the remaining elements:
+//
+//   for (i = i0; i < n; i++) c[i] = a[i] * k + b[i];
+//
+// becomes
+//
+//   last = max(min(n, <lengths checked in the loop>), 0) - lanes;
+//   for (; i <= last; i += lanes) c[i:lanes] = a[i:lanes] * [k, k] + ...;
+//   for (; i < n; i++) c[i] = a[i] * k + b[i];
+//
+// Only loops whose every lane computes exactly what the scalar loop computes
+// are vectorized: Float64List elements with +, -, *, /, negation, squaring
+// and square root as Float64x2, and Int32List or Uint32List elements with
+// +, -, &, | and ^ as Int32x4 (which wrap to the 32 bits stored into the
+// array). All arrays must be internal typed data, so that two of them
+// either are the same object or do not overlap, and every access must use
+// the loop index.
+//
+// In AOT code, integers accumulated with +, &, | or ^ and masked to at most
+// 32 bits, as in `sum = (sum + a[i]) & 0xffffffff`, are accumulated in the
+// lanes of an Int32x4 which are combined after the vectorized loop.
+class LoopVectorizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
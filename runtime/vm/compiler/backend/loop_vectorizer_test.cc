@@ -0,0 +1,205 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER) && defined(TARGET_ARCH_IS_64_BIT)
+
+struct VectorInstructions {
+  intptr_t loads = 0;
+  intptr_t stores = 0;
+  intptr_t simd_ops = 0;
+};
+
+// Compiles [function_name] of [script] with the AOT pipeline and counts the
+// instructions which operate on Simd128 values.
+static VectorInstructions CompileAndCount(const char* script,
+                                          const char* function_name) {
+  const auto& root_library = Library::Handle(LoadTestScript(script));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, function_name));
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  VectorInstructions result;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current();
+      if (auto load = instr->AsLoadIndexed()) {
+        if (load->class_id() == kTypedDataFloat64x2ArrayCid ||
+            load->class_id() == kTypedDataInt32x4ArrayCid) {
+          result.loads++;
+        }
+      } else if (auto store = instr->AsStoreIndexed()) {
+        if (store->class_id() == kTypedDataFloat64x2ArrayCid ||
+            store->class_id() == kTypedDataInt32x4ArrayCid) {
+          result.stores++;
+        }
+      } else if (instr->IsSimdOp()) {
+        result.simd_ops++;
+      }
+    }
+  }
+  return result;
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_Float64List) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      Float64List foo(int n, double k) {
+        final a = Float64List(n);
+        final b = Float64List(n);
+        for (int i = 0; i < n; i++) {
+          b[i] = a[i] * k + 1.0;
+        }
+        return b;
+      }
+  )";
+
+  const auto counts = CompileAndCount(kScript, "foo");
+  EXPECT_EQ(1, counts.loads);
+  EXPECT_EQ(1, counts.stores);
+  // The multiplication and the addition, besides the splats of k and 1.0.
+  EXPECT(counts.simd_ops >= 2);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_Int32List) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      Uint32List foo(int n) {
+        final a = Int32List(n);
+        final b = Uint32List(n);
+        final c = Uint32List(n);
+        for (int i = 0; i < n; i++) {
+          c[i] = (a[i] + b[i]) ^ 0x55;
+        }
+        return c;
+      }
+  )";
+
+  const auto counts = CompileAndCount(kScript, "foo");
+  EXPECT_EQ(2, counts.loads);
+  EXPECT_EQ(1, counts.stores);
+  EXPECT(counts.simd_ops >= 2);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_Reduction) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+
+  const char* kScript = R"(
+      import 'dart:typed_data';
+
+      int sum(int n) {
+        final a = Uint32List(n);
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+          sum = (sum + a[i]) & 0xffffffff;
+        }
+        return sum;
+      }
+
+      int checksum(int n) {
+        final a = Int32List(n);
+        int hash = 0;
+        for (int i = 0; i < n; i++) {
+          hash = (hash ^ (a[i] + 1)) & 0xffff;
+        }
+        return hash;
+      }
+  )";
+
+  auto counts = CompileAndCount(kScript, "sum");
+  EXPECT_EQ(1, counts.loads);
+  EXPECT_EQ(0, counts.stores);
+  // The splat of 0, the addition and the getters of the four lanes.
+  EXPECT(counts.simd_ops >= 6);
+
+  counts = CompileAndCount(kScript, "checksum");
+  EXPECT_EQ(1, counts.loads);
+  // The splats of 0 and 1, the addition, the xor and the lane getters.
+  EXPECT(counts.simd_ops >= 8);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_Unsupported) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+
+  // A reduction, which would add the elements in another order.
+  const char* kSum = R"(
+      import 'dart:typed_data';
+
+      double foo(int n) {
+        final a = Float64List(n);
+        double sum = 0.0;
+        for (int i = 0; i < n; i++) {
+          sum += a[i];
+        }
+        return sum;
+      }
+  )";
+  EXPECT_EQ(0, CompileAndCount(kSum, "foo").loads);
+
+  // An integer sum which needs more than 32 bits.
+  const char* kIntSum = R"(
+      import 'dart:typed_data';
+
+      int foo(int n) {
+        final a = Int32List(n);
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+          sum += a[i];
+        }
+        return sum;
+      }
+  )";
+  EXPECT_EQ(0, CompileAndCount(kIntSum, "foo").loads);
+
+  // Accesses to another element than the one at the loop index.
+  const char* kShift = R"(
+      import 'dart:typed_data';
+
+      Float64List foo(int n) {
+        final a = Float64List(n + 1);
+        for (int i = 0; i < n; i++) {
+          a[i] = a[i + 1];
+        }
+        return a;
+      }
+  )";
+  EXPECT_EQ(0, CompileAndCount(kShift, "foo").loads);
+
+  // Elements without a vector representation.
+  const char* kBytes = R"(
+      import 'dart:typed_data';
+
+      Uint8List foo(int n) {
+        final a = Uint8List(n);
+        for (int i = 0; i < n; i++) {
+          a[i] = a[i] + 1;
+        }
+        return a;
+      }
+  )";
+  EXPECT_EQ(0, CompileAndCount(kBytes, "foo").stores);
+}
+
+#endif  // defined(DART_PRECOMPILER) && defined(TARGET_ARCH_IS_64_BIT)
+
+}  // namespace dart
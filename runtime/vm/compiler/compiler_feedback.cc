@@ -0,0 +1,387 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/compiler_feedback.h"
+
+#include "platform/text_buffer.h"
+#include "vm/class_table.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/program_visitor.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            write_compiler_feedback_to,
+            nullptr,
+            "Write type feedback and block counts which can guide AOT "
+            "compilation to the given file when an isolate shuts down.");
+DEFINE_FLAG(charp,
+            read_compiler_feedback_from,
+            nullptr,
+            "Guide AOT compilation with the feedback written by "
+            "--write-compiler-feedback-to.");
+
+static const char* LibraryUrl(Zone* zone, const Class& cls) {
+  const auto& lib = Library::Handle(zone, cls.library());
+  if (lib.IsNull()) {
+    return "";
+  }
+  return String::Handle(zone, lib.url()).ToCString();
+}
+
+static const char* ClassKey(Zone* zone, const Class& cls) {
+  return OS::SCreate(zone, "%s\t%s", LibraryUrl(zone, cls),
+                     cls.ScrubbedNameCString());
+}
+
+static const char* FunctionKey(Zone* zone, const Function& function) {
+  const auto& cls = Class::Handle(zone, function.Owner());
+  return OS::SCreate(zone, "%s\t%s", LibraryUrl(zone, cls),
+                     function.QualifiedScrubbedNameCString());
+}
+
+namespace {
+
+class FeedbackWriter : public FunctionVisitor {
+ public:
+  FeedbackWriter(Zone* zone, ClassTable* class_table, BaseTextBuffer* buffer)
+      : zone_(zone),
+        class_table_(class_table),
+        buffer_(buffer),
+        ic_data_array_(Array::Handle(zone)),
+        edge_counters_(Array::Handle(zone)),
+        ic_data_(ICData::Handle(zone)),
+        selector_(String::Handle(zone)),
+        cls_(Class::Handle(zone)) {}
+
+  void VisitFunction(const Function& function) {
+    ic_data_array_ = function.ic_data_array();
+    if (ic_data_array_.IsNull()) {
+      // Never ran unoptimized code.
+      return;
+    }
+    const char* key = FunctionKey(zone_, function);
+
+    edge_counters_ ^=
+        ic_data_array_.At(Function::ICDataArrayIndices::kEdgeCounters);
+    intptr_t max_count = 0;
+    if (!edge_counters_.IsNull()) {
+      buffer_->Printf("edges\t%s\t", key);
+      for (intptr_t i = 0; i < edge_counters_.Length(); i++) {
+        const intptr_t count = Smi::Value(Smi::RawCast(edge_counters_.At(i)));
+        max_count = Utils::Maximum(max_count, count);
+        buffer_->Printf(i == 0 ? "%" Pd : " %" Pd, count);
+      }
+      buffer_->AddString("\n");
+    }
+    buffer_->Printf("function\t%s\t%" Pd "\t%d\n", key, max_count,
+                    function.HasOptimizedCode() ? 1 : 0);
+
+    for (intptr_t i = Function::ICDataArrayIndices::kFirstICData;
+         i < ic_data_array_.Length(); i++) {
+      ic_data_ ^= ic_data_array_.At(i);
+      // Megamorphic calls keep the receivers they saw before switching to a
+      // MegamorphicCache, which are still a sample of the hottest ones.
+      if (ic_data_.rebind_rule() != ICData::kInstance) continue;
+      selector_ = ic_data_.target_name();
+      for (intptr_t j = 0, n = ic_data_.NumberOfChecks(); j < n; j++) {
+        const intptr_t count = ic_data_.GetCountAt(j);
+        if (count <= 0) continue;
+        cls_ = class_table_->At(ic_data_.GetReceiverClassIdAt(j));
+        buffer_->Printf("call\t%s\t%s\t%s\t%" Pd "\n", key,
+                        selector_.ToCString(), ClassKey(zone_, cls_), count);
+      }
+    }
+  }
+
+ private:
+  Zone* const zone_;
+  ClassTable* const class_table_;
+  BaseTextBuffer* const buffer_;
+  Array& ic_data_array_;
+  Array& edge_counters_;
+  ICData& ic_data_;
+  String& selector_;
+  Class& cls_;
+};
+
+}  // namespace
+
+void CompilerFeedback::Write(Thread* thread, const char* filename) {
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return;
+  }
+
+  auto isolate_group = thread->isolate_group();
+  TextBuffer buffer(64 * KB);
+  {
+    SafepointReadRwLocker ml(thread, isolate_group->program_lock());
+    FeedbackWriter writer(thread->zone(), isolate_group->class_table(),
+                          &buffer);
+    ProgramVisitor::WalkProgram(thread->zone(), isolate_group, &writer);
+  }
+
+  void* file = file_open(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write compiler feedback: %s\n", filename);
+    return;
+  }
+  file_write(buffer.buffer(), buffer.length(), file);
+  file_close(file);
+}
+
+CompilerFeedback::CompilerFeedback(Zone* zone)
+    : zone_(zone),
+      class_ids_(zone),
+      function_indices_(zone),
+      functions_(zone, 1024),
+      call_indices_(zone),
+      calls_(zone, 1024) {}
+
+CompilerFeedback* CompilerFeedback::Read(Thread* thread,
+                                         const char* filename) {
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return nullptr;
+  }
+
+  void* file = file_open(filename, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read compiler feedback: %s\n", filename);
+    return nullptr;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = -1;
+  file_read(&data, &length, file);
+  file_close(file);
+  if ((data == nullptr) || (length < 0)) {
+    OS::PrintErr("warning: Failed to read compiler feedback: %s\n", filename);
+    return nullptr;
+  }
+
+  Zone* zone = thread->zone();
+  char* contents = zone->Alloc<char>(length + 1);
+  memmove(contents, data, length);
+  contents[length] = '\0';
+  free(data);
+
+  auto feedback = new (zone) CompilerFeedback(zone);
+  feedback->AddClasses(thread->isolate_group()->class_table());
+  feedback->Parse(contents, length);
+  return feedback;
+}
+
+void CompilerFeedback::AddClasses(ClassTable* class_table) {
+  auto& cls = Class::Handle(zone_);
+  for (intptr_t cid = kIllegalCid + 1; cid < class_table->NumCids(); cid++) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    cls = class_table->At(cid);
+    class_ids_.Insert({ClassKey(zone_, cls), cid});
+  }
+}
+
+void CompilerFeedback::Parse(char* contents, intptr_t length) {
+  char* const end = contents + length;
+  char* line = contents;
+  while (line < end) {
+    char* next = static_cast<char*>(memchr(line, '\n', end - line));
+    if (next == nullptr) {
+      next = end;
+    }
+    *next = '\0';
+    ParseLine(line);
+    line = next + 1;
+  }
+
+  // Hottest receivers first.
+  for (auto receivers : calls_) {
+    receivers->Sort([](const ReceiverCount* a, const ReceiverCount* b) {
+      return (a->count < b->count) ? 1 : ((a->count > b->count) ? -1 : 0);
+    });
+  }
+}
+
+void CompilerFeedback::ParseLine(char* line) {
+  const intptr_t kMaxFields = 7;
+  const char* fields[kMaxFields];
+  intptr_t num_fields = 0;
+  fields[num_fields++] = line;
+  for (char* p = line; *p != '\0'; p++) {
+    if (*p == '\t') {
+      if (num_fields == kMaxFields) return;
+      *p = '\0';
+      fields[num_fields++] = p + 1;
+    }
+  }
+
+  int64_t value = 0;
+  if ((num_fields == 5) && (strcmp(fields[0], "function") == 0)) {
+    const char* key = OS::SCreate(zone_, "%s\t%s", fields[1], fields[2]);
+    auto info = InfoFor(key);
+    info->optimized = (strcmp(fields[4], "1") == 0);
+    if (OS::StringToInt64(fields[3], &value)) {
+      info->max_count = value;
+    }
+  } else if ((num_fields == 4) && (strcmp(fields[0], "edges") == 0)) {
+    const char* key = OS::SCreate(zone_, "%s\t%s", fields[1], fields[2]);
+    auto counts = new (zone_) ZoneGrowableArray<intptr_t>(zone_, 16);
+    const char* p = fields[3];
+    while (*p != '\0') {
+      char* count_end = nullptr;
+      counts->Add(strtoll(p, &count_end, 10));
+      if (count_end == p) return;
+      p = count_end;
+      while (*p == ' ') p++;
+    }
+    InfoFor(key)->edge_counts = counts;
+  } else if ((num_fields == 7) && (strcmp(fields[0], "call") == 0) &&
+             OS::StringToInt64(fields[6], &value)) {
+    const char* class_key = OS::SCreate(zone_, "%s\t%s", fields[4], fields[5]);
+    const intptr_t cid = class_ids_.LookupValue(class_key);
+    if (cid == CStringIntMapKeyValueTrait::kNoValue) {
+      // The class is not part of this program.
+      return;
+    }
+    const char* key =
+        OS::SCreate(zone_, "%s\t%s\t%s", fields[1], fields[2], fields[3]);
+    AddReceiverCount(key, cid, value);
+  }
+}
+
+CompilerFeedback::FunctionInfo* CompilerFeedback::InfoFor(const char* key) {
+  intptr_t index = function_indices_.LookupValue(key);
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    index = functions_.length();
+    functions_.Add(new (zone_) FunctionInfo());
+    function_indices_.Insert({key, index});
+  }
+  return functions_[index];
+}
+
+CompilerFeedback::FunctionInfo* CompilerFeedback::LookupInfo(
+    const Function& function) const {
+  Zone* zone = Thread::Current()->zone();
+  const intptr_t index =
+      function_indices_.LookupValue(FunctionKey(zone, function));
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    return nullptr;
+  }
+  return functions_[index];
+}
+
+void CompilerFeedback::AddReceiverCount(const char* key,
+                                        intptr_t cid,
+                                        int64_t count) {
+  intptr_t index = call_indices_.LookupValue(key);
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    index = calls_.length();
+    calls_.Add(new (zone_) ZoneGrowableArray<ReceiverCount>(zone_, 2));
+    call_indices_.Insert({key, index});
+  }
+  auto receivers = calls_[index];
+  // Call sites with the same selector, and calls which also check the class
+  // of their argument, report the same receiver more than once.
+  for (auto& receiver : *receivers) {
+    if (receiver.cid == cid) {
+      receiver.count += count;
+      return;
+    }
+  }
+  receivers->Add({cid, count});
+}
+
+bool CompilerFeedback::IsHot(const Function& function) const {
+  FunctionInfo* info = LookupInfo(function);
+  return (info != nullptr) && info->optimized;
+}
+
+intptr_t CompilerFeedback::Hotness(const Function& function) const {
+  FunctionInfo* info = LookupInfo(function);
+  if (info == nullptr) {
+    // Other kinds of functions, e.g. implicit accessors, can run without
+    // leaving any feedback.
+    return function.IsRegularFunction() ? kNeverRan : 0;
+  }
+  if (!info->optimized) {
+    return 0;
+  }
+  // Optimized functions rank above the ones which were not optimized.
+  return Utils::Maximum<intptr_t>(info->max_count, 1);
+}
+
+ArrayPtr CompilerFeedback::EdgeCounters(const Function& function) const {
+  FunctionInfo* info = LookupInfo(function);
+  if ((info == nullptr) || (info->edge_counts == nullptr)) {
+    return Array::null();
+  }
+  const auto counts = info->edge_counts;
+  const auto& edge_counters =
+      Array::Handle(Array::New(counts->length(), Heap::kOld));
+  for (intptr_t i = 0; i < counts->length(); i++) {
+    edge_counters.SetAt(
+        i, Smi::Handle(Smi::New(Utils::Minimum<intptr_t>(
+               counts->At(i), Smi::kMaxValue))));
+  }
+  return edge_counters.ptr();
+}
+
+const CallTargets* CompilerFeedback::TargetsFor(InstanceCallInstr* call,
+                                                intptr_t max_targets) const {
+  if (!call->HasICData()) {
+    return nullptr;
+  }
+  Zone* zone = Thread::Current()->zone();
+  // Calls inlined from other functions keep the ICData of their function.
+  const auto& owner = Function::Handle(zone, call->ic_data()->Owner());
+  if (owner.IsNull()) {
+    return nullptr;
+  }
+  const char* key = OS::SCreate(zone, "%s\t%s", FunctionKey(zone, owner),
+                                call->function_name().ToCString());
+  const intptr_t index = call_indices_.LookupValue(key);
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    return nullptr;
+  }
+
+  const auto& args_desc = Array::Handle(zone, call->GetArgumentsDescriptor());
+  const auto& ic_data = ICData::Handle(
+      zone, ICData::New(owner, call->function_name(), args_desc,
+                        DeoptId::kNone, /*num_args_tested=*/1,
+                        ICData::kOptimized));
+  auto class_table = IsolateGroup::Current()->class_table();
+  auto& cls = Class::Handle(zone);
+  auto& target = Function::Handle(zone);
+  intptr_t num_targets = 0;
+  for (const auto& receiver : *calls_[index]) {
+    if (num_targets == max_targets) break;
+    cls = class_table->At(receiver.cid);
+    if (!cls.is_finalized() || cls.is_abstract()) continue;
+    target = call->ResolveForReceiverClass(cls);
+    if (target.IsNull()) continue;
+    ic_data.AddReceiverCheck(
+        receiver.cid, target,
+        Utils::Minimum<int64_t>(receiver.count, Smi::kMaxValue));
+    num_targets++;
+  }
+  if (num_targets == 0) {
+    return nullptr;
+  }
+  return CallTargets::Create(zone, ic_data);
+}
+
+}  // namespace dart
@@ -0,0 +1,101 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_COMPILER_FEEDBACK_H_
+#define RUNTIME_VM_COMPILER_COMPILER_FEEDBACK_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/tagged_pointer.h"
+
+namespace dart {
+
+class CallTargets;
+class ClassTable;
+class Function;
+class InstanceCallInstr;
+class Thread;
+class Zone;
+
+// Profile collected by a JIT training run which guides AOT compilation.
+//
+// The JIT writes the feedback of an isolate group when one of its isolates
+// shuts down (--write-compiler-feedback-to), and gen_snapshot reads it back
+// (--read-compiler-feedback-from) both to compile and to order the code in
+// the snapshot. The file has one record per line, with tab separated fields:
+//
+//   function <library> <function> <max block count> <optimized>
+//   edges <library> <function> <space separated block counts>
+//   call <library> <function> <selector> <library> <class> <count>
+//
+// Functions and classes are identified by library URL and scrubbed name, so
+// that the feedback still applies when the program is compiled again. Call
+// sites in the same function share the receiver histogram of their selector.
+class CompilerFeedback : public ZoneObject {
+ public:
+  static void Write(Thread* thread, const char* filename);
+
+  // Returns nullptr if the file cannot be read.
+  static CompilerFeedback* Read(Thread* thread, const char* filename);
+
+  // Whether the training run optimized [function].
+  bool IsHot(const Function& function) const;
+
+  // Execution count of the most frequent block of [function] in the training
+  // run if it optimized [function], kNeverRan if [function] is a regular
+  // function which never ran, and 0 otherwise.
+  intptr_t Hotness(const Function& function) const;
+  static constexpr intptr_t kNeverRan = -1;
+
+  // Block counts of [function] in the training run, indexed by preorder
+  // number of its unoptimized flow graph, or null if it never ran.
+  ArrayPtr EdgeCounters(const Function& function) const;
+
+  // Targets of the receiver classes seen at [call] in the training run,
+  // at most [max_targets] of them, or nullptr if there are none.
+  const CallTargets* TargetsFor(InstanceCallInstr* call,
+                                intptr_t max_targets) const;
+
+ private:
+  struct FunctionInfo : public ZoneObject {
+    bool optimized = false;
+    intptr_t max_count = 0;
+    ZoneGrowableArray<intptr_t>* edge_counts = nullptr;
+  };
+
+  struct ReceiverCount {
+    intptr_t cid;
+    int64_t count;
+  };
+
+  explicit CompilerFeedback(Zone* zone);
+
+  void AddClasses(ClassTable* class_table);
+  void Parse(char* contents, intptr_t length);
+  void ParseLine(char* line);
+  FunctionInfo* InfoFor(const char* key);
+  FunctionInfo* LookupInfo(const Function& function) const;
+  void AddReceiverCount(const char* key, intptr_t cid, int64_t count);
+
+  Zone* zone_;
+  // Class ids by "<library>\t<class>".
+  CStringIntMap class_ids_;
+  // Indices into [functions_] by "<library>\t<function>".
+  CStringIntMap function_indices_;
+  GrowableArray<FunctionInfo*> functions_;
+  // Indices into [calls_] by "<library>\t<function>\t<selector>".
+  CStringIntMap call_indices_;
+  GrowableArray<ZoneGrowableArray<ReceiverCount>*> calls_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilerFeedback);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_COMPILER_FEEDBACK_H_
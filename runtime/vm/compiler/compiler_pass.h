@@ -52,6 +52,7 @@ namespace dart {
   V(TryOptimizePatterns)                                                       \
   V(TypePropagation)                                                           \
   V(UseTableDispatch)                                                          \
+  V(VectorizeLoops)                                                            \
   V(EliminateWriteBarriers)                                                    \
   V(TestILSerialization)                                                       \
   V(LoweringAfterCodeMotionDisabled)                                           \
@@ -83,6 +83,11 @@ DEFINE_FLAG(bool,
             false,
             "Trace only optimizing compiler operations.");
 DEFINE_FLAG(bool, trace_bailout, false, "Print bailout from ssa compiler.");
+DEFINE_FLAG(int,
+            background_compiler_tasks,
+            1,
+            "Maximum number of functions an isolate group compiles in the "
+            "background at the same time.");
 
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
 
@@ -334,10 +339,9 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
     if (code_is_valid && Compiler::CanOptimizeFunction(thread(), function)) {
       if (osr_id() == Compiler::kNoOSRDeoptId) {
         function.InstallOptimizedCode(code);
-      } else {
-        // OSR is not compiled in background.
-        ASSERT(!Compiler::IsBackgroundCompilation());
       }
+      // OSR code is not installed: the caller enters it from the frame which
+      // requested it (see HandleOSRRequest).
       ASSERT(code.owner() == function.ptr());
     } else {
       code = Code::null();
@@ -888,15 +892,22 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
       deopt_id, Object::background_compilation_error());
 }
 
-// C-heap allocated background compilation queue element.
+// C-heap allocated background compilation queue element. OSR elements keep
+// their code once compiled.
 class QueueElement {
  public:
-  explicit QueueElement(const Function& function)
-      : next_(nullptr), function_(function.ptr()) {}
+  explicit QueueElement(const Function& function,
+                        intptr_t osr_id = Compiler::kNoOSRDeoptId)
+      : next_(nullptr),
+        function_(function.ptr()),
+        code_(Code::null()),
+        osr_id_(osr_id),
+        enqueue_micros_(OS::GetCurrentMonotonicMicros()) {}
 
   virtual ~QueueElement() {
     next_ = nullptr;
     function_ = Function::null();
+    code_ = Code::null();
   }
 
   FunctionPtr Function() const { return function_; }
@@ -909,15 +920,26 @@ class QueueElement {
     return reinterpret_cast<ObjectPtr*>(&function_);
   }
 
+  CodePtr code() const { return code_; }
+  void set_code(CodePtr code) { code_ = code; }
+  ObjectPtr* code_untag() { return reinterpret_cast<ObjectPtr*>(&code_); }
+
+  intptr_t osr_id() const { return osr_id_; }
+  int64_t enqueue_micros() const { return enqueue_micros_; }
+
  private:
   QueueElement* next_;
   FunctionPtr function_;
+  CodePtr code_;
+  intptr_t osr_id_;
+  int64_t enqueue_micros_;
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// It implements a FIFO queue, using Peek, Add, Remove operations, and
+// RemoveHottest to take the function which is invoked most often.
 class BackgroundCompilationQueue {
  public:
   BackgroundCompilationQueue() : first_(nullptr), last_(nullptr) {}
@@ -928,12 +950,21 @@ class BackgroundCompilationQueue {
     QueueElement* p = first_;
     while (p != nullptr) {
       visitor->VisitPointer(p->function_untag());
+      visitor->VisitPointer(p->code_untag());
       p = p->next();
     }
   }
 
   bool IsEmpty() const { return first_ == nullptr; }
 
+  intptr_t Length() const {
+    intptr_t length = 0;
+    for (QueueElement* p = first_; p != nullptr; p = p->next()) {
+      length++;
+    }
+    return length;
+  }
+
   void Add(QueueElement* value) {
     ASSERT(value != nullptr);
     ASSERT(value->next() == nullptr);
@@ -969,15 +1000,63 @@ class BackgroundCompilationQueue {
     return result;
   }
 
-  bool ContainsObj(const Object& obj) const {
+  // Removes [value], which must be in the queue.
+  void Remove(QueueElement* value) {
+    QueueElement* prev = nullptr;
+    QueueElement* p = first_;
+    while (p != value) {
+      ASSERT(p != nullptr);
+      prev = p;
+      p = p->next();
+    }
+    if (prev == nullptr) {
+      first_ = value->next();
+    } else {
+      prev->set_next(value->next());
+    }
+    if (last_ == value) {
+      last_ = prev;
+    }
+    value->set_next(nullptr);
+  }
+
+  // Removes the function with the most invocations (and loop iterations) per
+  // microsecond since it was enqueued. Functions keep counting while queued,
+  // starting from INT32_MIN (see OptimizeInvokedFunction). Ties are broken in
+  // FIFO order.
+  QueueElement* RemoveHottest(int64_t now_micros, Function* function) {
+    ASSERT(first_ != nullptr);
+    QueueElement* hottest = nullptr;
+    double hottest_rate = -1.0;
+    for (QueueElement* p = first_; p != nullptr; p = p->next()) {
+      *function = p->Function();
+      const int64_t counter = function->usage_counter();
+      const int64_t count = counter < 0 ? counter - kMinInt32 : counter;
+      const double rate =
+          static_cast<double>(count) / (now_micros - p->enqueue_micros() + 1);
+      if (rate > hottest_rate) {
+        hottest = p;
+        hottest_rate = rate;
+      }
+    }
+    Remove(hottest);
+    return hottest;
+  }
+
+  QueueElement* Find(const Object& obj, intptr_t osr_id) const {
     QueueElement* p = first_;
     while (p != nullptr) {
-      if (p->function() == obj.ptr()) {
-        return true;
+      if (p->function() == obj.ptr() && p->osr_id() == osr_id) {
+        return p;
       }
       p = p->next();
     }
-    return false;
+    return nullptr;
+  }
+
+  bool ContainsObj(const Object& obj,
+                   intptr_t osr_id = Compiler::kNoOSRDeoptId) const {
+    return Find(obj, osr_id) != nullptr;
   }
 
   void Clear() {
@@ -1013,13 +1092,17 @@ BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
     : isolate_group_(isolate_group),
       monitor_(),
       function_queue_(new BackgroundCompilationQueue()),
+      in_progress_queue_(new BackgroundCompilationQueue()),
+      osr_code_queue_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
+      num_tasks_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
 BackgroundCompiler::~BackgroundCompiler() {
   delete function_queue_;
+  delete in_progress_queue_;
+  delete osr_code_queue_;
 }
 
 void BackgroundCompiler::Run() {
@@ -1034,19 +1117,49 @@ void BackgroundCompiler::Run() {
     {
       SafepointMonitorLocker ml(&monitor_);
       if (running_ && !function_queue()->IsEmpty()) {
-        element = function_queue()->Remove();
+        const int64_t now_micros = OS::GetCurrentMonotonicMicros();
+        element = function_queue()->RemoveHottest(now_micros, &function);
+        in_progress_queue_->Add(element);
         function ^= element->function();
+#if !defined(PRODUCT)
+        // Shows the time spent in the queue on this worker's timeline track,
+        // right before the compilation itself.
+        TimelineStream* stream = Timeline::GetCompilerStream();
+        TimelineEvent* event = stream->StartEvent();
+        if (event != nullptr) {
+          event->Duration("BackgroundCompilationQueueWait",
+                          element->enqueue_micros(), now_micros);
+          event->SetNumArguments(1);
+          event->CopyArgument(0, "function", function.ToQualifiedCString());
+          event->Complete();
+        }
+#endif  // !defined(PRODUCT)
       }
     }
     if (element != nullptr) {
+      const intptr_t osr_id = element->osr_id();
+      const Object& result = Object::Handle(
+          zone, Compiler::CompileOptimizedFunction(thread, function, osr_id));
+      {
+        SafepointMonitorLocker ml(&monitor_);
+        // Stop clears the queues only after all tasks are done.
+        in_progress_queue_->Remove(element);
+        // Keep OSR code until the loop which requested it polls again.
+        if ((osr_id != Compiler::kNoOSRDeoptId) && running_ &&
+            result.IsCode()) {
+          element->set_code(Code::Cast(result).ptr());
+          osr_code_queue_->Add(element);
+          element = nullptr;
+        }
+      }
       delete element;
-      Compiler::CompileOptimizedFunction(thread, function,
-                                         Compiler::kNoOSRDeoptId);
 
       // If an optimizable method is not optimized, put it back on
       // the background queue (unless it was passed to foreground).
-      if ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
-          FLAG_stress_test_background_compilation) {
+      // Failed OSR compilations are enqueued again by the next OSR request.
+      if ((osr_id == Compiler::kNoOSRDeoptId) &&
+          ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
+           FLAG_stress_test_background_compilation)) {
         if (Compiler::CanOptimizeFunction(thread, function)) {
           SafepointMonitorLocker ml(&monitor_);
           if (running_) {
@@ -1064,49 +1177,103 @@ void BackgroundCompiler::Run() {
         Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       // Successfully scheduled a new task.
     } else {
-      // Background compiler done. This notification must happen after the
-      // thread leaves to group to avoid a shutdown race with the thread
-      // registry.
-      running_ = false;
-      done_ = true;
-      ml.NotifyAll();
+      // This task is done. This notification must happen after the thread
+      // leaves to group to avoid a shutdown race with the thread registry.
+      if (--num_tasks_ == 0) {
+        running_ = false;
+        ml.NotifyAll();
+      }
     }
   }
 }
 
-bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
+bool BackgroundCompiler::EnqueueCompilation(const Function& function,
+                                            intptr_t osr_id) {
   Thread* thread = Thread::Current();
   ASSERT(thread->IsDartMutatorThread());
   ASSERT(thread->CanAcquireSafepointLocks());
 
   SafepointMonitorLocker ml(&monitor_);
   if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
+  if (!running_ && num_tasks_ == 0) {
     running_ = true;
-    done_ = false;
     // If we ever wanted to run the BG compiler on the
     // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
     // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
     // notification would not work anymore.
     if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       running_ = false;
-      done_ = true;
       return false;
     }
+    num_tasks_++;
   }
 
   ASSERT(running_);
-  if (function_queue()->ContainsObj(function)) {
+  // Code whose assumptions were invalidated in the meantime is never entered.
+  DropOsrCodeLocked(Function::null());
+  if (function_queue()->ContainsObj(function, osr_id) ||
+      in_progress_queue_->ContainsObj(function, osr_id) ||
+      osr_code_queue_->ContainsObj(function, osr_id)) {
     return true;
   }
-  QueueElement* elem = new QueueElement(function);
+  QueueElement* elem = new QueueElement(function, osr_id);
   function_queue()->Add(elem);
+  // Start another task if all running ones are busy compiling.
+  if ((num_tasks_ < FLAG_background_compiler_tasks) &&
+      (in_progress_queue_->Length() >= num_tasks_) &&
+      Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    num_tasks_++;
+  }
   ml.NotifyAll();
   return true;
 }
 
+CodePtr BackgroundCompiler::TakeOsrCode(const Function& function,
+                                        intptr_t osr_id) {
+  Thread* thread = Thread::Current();
+  ASSERT(thread->IsDartMutatorThread());
+  ASSERT(thread->CanAcquireSafepointLocks());
+
+  SafepointMonitorLocker ml(&monitor_);
+  DropOsrCodeLocked(Function::null());
+  QueueElement* elem = osr_code_queue_->Find(function, osr_id);
+  if (elem == nullptr) {
+    return Code::null();
+  }
+  osr_code_queue_->Remove(elem);
+  const CodePtr code = elem->code();
+  delete elem;
+  return code;
+}
+
+void BackgroundCompiler::DropOsrCode(const Function& function) {
+  Thread* thread = Thread::Current();
+  ASSERT(thread->IsDartMutatorThread());
+  ASSERT(thread->CanAcquireSafepointLocks());
+
+  SafepointMonitorLocker ml(&monitor_);
+  DropOsrCodeLocked(function.ptr());
+}
+
+void BackgroundCompiler::DropOsrCodeLocked(FunctionPtr function) {
+  // Code is disabled while mutators are stopped, which can't take [monitor_]
+  // as a background compiler task might hold it while being stopped. So
+  // disabled code is only dropped the next time the queues are used.
+  QueueElement* p = osr_code_queue_->Peek();
+  while (p != nullptr) {
+    QueueElement* next = p->next();
+    if ((p->function() == function) || Code::IsDisabled(p->code())) {
+      osr_code_queue_->Remove(p);
+      delete p;
+    }
+    p = next;
+  }
+}
+
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
+  in_progress_queue_->VisitObjectPointers(visitor);
+  osr_code_queue_->VisitObjectPointers(visitor);
 }
 
 void BackgroundCompiler::Stop() {
@@ -1122,9 +1289,12 @@ void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  while (num_tasks_ > 0) {
     locker->Wait();
   }
+  ASSERT(in_progress_queue_->IsEmpty());
+  // OSR code may be stale after e.g. a reload.
+  osr_code_queue_->Clear();
 }
 
 void BackgroundCompiler::Enable() {
@@ -1146,7 +1316,7 @@ void BackgroundCompiler::Disable() {
 
   SafepointMonitorLocker ml(&monitor_);
   disabled_depth_++;
-  if (done_) return;
+  if (num_tasks_ == 0) return;
   StopLocked(thread, &ml);
 }
 
@@ -1192,11 +1362,22 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
   UNREACHABLE();
 }
 
-bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
+bool BackgroundCompiler::EnqueueCompilation(const Function& function,
+                                            intptr_t osr_id) {
   UNREACHABLE();
   return false;
 }
 
+CodePtr BackgroundCompiler::TakeOsrCode(const Function& function,
+                                        intptr_t osr_id) {
+  UNREACHABLE();
+  return Code::null();
+}
+
+void BackgroundCompiler::DropOsrCode(const Function& function) {
+  UNREACHABLE();
+}
+
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   UNREACHABLE();
 }
@@ -82,10 +82,12 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
-// No OSR compilation in the background compiler.
+// Class to run optimizing compilation in background threads.
+// Current implementation: up to --background-compiler-tasks tasks per isolate
+// group, each compiling the hottest queued function next. They die with the
+// owning isolate group.
+// OSR compilations are not installed on the function: their code is kept by
+// the background compiler until the mutator polls for it (see TakeOsrCode).
 class BackgroundCompiler {
  public:
   explicit BackgroundCompiler(IsolateGroup* isolate_group);
@@ -95,10 +97,20 @@ class BackgroundCompiler {
     isolate_group->background_compiler()->Stop();
   }
 
-  // Enqueues a function to be compiled in the background.
+  // Enqueues a function to be compiled in the background. If [osr_id] is
+  // given, compiles an OSR entry at that deopt id instead.
   //
   // Return `true` if successful.
-  bool EnqueueCompilation(const Function& function);
+  bool EnqueueCompilation(const Function& function,
+                          intptr_t osr_id = Compiler::kNoOSRDeoptId);
+
+  // Returns the OSR code compiled in the background for [function] at
+  // [osr_id] and forgets about it, or null if it is not ready (yet).
+  CodePtr TakeOsrCode(const Function& function, intptr_t osr_id);
+
+  // Forgets the OSR code compiled in the background for [function], e.g.
+  // because it was deoptimized and its feedback has changed since.
+  void DropOsrCode(const Function& function);
 
   void VisitPointers(ObjectPointerVisitor* visitor);
 
@@ -114,14 +126,21 @@ class BackgroundCompiler {
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return num_tasks_ > 0; }
+  // Removes the OSR code of [function] (if not null) and all disabled OSR code
+  // from [osr_code_queue_].
+  void DropOsrCodeLocked(FunctionPtr function);
 
   IsolateGroup* isolate_group_;
 
-  Monitor monitor_;  // Controls access to the queue and running state.
+  Monitor monitor_;  // Controls access to the queues and running state.
   BackgroundCompilationQueue* function_queue_;
-  bool running_;  // While true, will try to read queue and compile.
-  bool done_;     // True if the thread is done.
+  // Functions currently being compiled by one of the tasks.
+  BackgroundCompilationQueue* in_progress_queue_;
+  // OSR compilations which finished but were not taken by the mutator yet.
+  BackgroundCompilationQueue* osr_code_queue_;
+  bool running_;        // While true, will try to read queue and compile.
+  intptr_t num_tasks_;  // Number of tasks which are not done yet.
   int16_t disabled_depth_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
@@ -793,7 +793,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -1617,7 +1617,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -2428,7 +2428,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -3254,7 +3254,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -4074,7 +4074,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -4896,7 +4896,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -5709,7 +5709,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -6534,7 +6534,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -6580,6 +6580,9 @@ static constexpr dart::compiler::target::word
     SuspendState_frame_capacity_offset = 0x4;
 static constexpr dart::compiler::target::word Array_elements_start_offset = 0xc;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word Closure_element_size = 0x4;
@@ -6793,6 +6796,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x28;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x68;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word Closure_function_offset = 0xc;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -7338,7 +7343,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -7385,6 +7390,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Array_element_size = 0x8;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x20;
 static constexpr dart::compiler::target::word Closure_element_size = 0x8;
@@ -7604,6 +7612,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x50;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0xb4;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_function_offset = 0x18;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x10;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -8154,7 +8164,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -8200,6 +8210,9 @@ static constexpr dart::compiler::target::word
     SuspendState_frame_capacity_offset = 0x4;
 static constexpr dart::compiler::target::word Array_elements_start_offset = 0xc;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word Closure_element_size = 0x4;
@@ -8413,6 +8426,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x28;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x68;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word Closure_function_offset = 0xc;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -8957,7 +8972,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -9004,6 +9019,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Array_element_size = 0x8;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x20;
 static constexpr dart::compiler::target::word Closure_element_size = 0x8;
@@ -9223,6 +9241,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x50;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0xb4;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_function_offset = 0x18;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x10;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -9775,7 +9795,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -9822,6 +9842,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Closure_element_size = 0x4;
@@ -10038,6 +10061,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x2c;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x6c;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_function_offset = 0x14;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x10;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -10587,7 +10612,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -10634,6 +10659,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Closure_element_size = 0x4;
@@ -10850,6 +10878,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x2c;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x6c;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_function_offset = 0x14;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x10;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -11401,7 +11431,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -11447,6 +11477,9 @@ static constexpr dart::compiler::target::word
     SuspendState_frame_capacity_offset = 0x4;
 static constexpr dart::compiler::target::word Array_elements_start_offset = 0xc;
 static constexpr dart::compiler::target::word Array_element_size = 0x4;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word Closure_element_size = 0x4;
@@ -11660,6 +11693,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x28;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0x68;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word Closure_function_offset = 0xc;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -12206,7 +12241,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -12253,6 +12288,9 @@ static constexpr dart::compiler::target::word
 static constexpr dart::compiler::target::word Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word Array_element_size = 0x8;
+static constexpr dart::compiler::target::word ClassTable_elements_start_offset =
+    0x0;
+static constexpr dart::compiler::target::word ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word Closure_elements_start_offset =
     0x20;
 static constexpr dart::compiler::target::word Closure_element_size = 0x8;
@@ -12472,6 +12510,8 @@ static constexpr dart::compiler::target::word Class_num_type_arguments_offset =
 static constexpr dart::compiler::target::word Class_super_type_offset = 0x50;
 static constexpr dart::compiler::target::word
     Class_host_type_arguments_field_offset_in_words_offset = 0xb4;
+static constexpr dart::compiler::target::word
+    ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word Closure_function_offset = 0x18;
 static constexpr dart::compiler::target::word Closure_hash_offset = 0x10;
 static constexpr dart::compiler::target::word Closure_length_and_flags_offset =
@@ -13023,7 +13063,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -13918,7 +13958,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -14828,7 +14868,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -15746,7 +15786,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -16658,7 +16698,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -17572,7 +17612,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -18478,7 +18518,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -19389,7 +19429,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -19440,6 +19480,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0xc;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word
     AOT_Closure_elements_start_offset = 0x14;
 static constexpr dart::compiler::target::word AOT_Closure_element_size = 0x4;
@@ -19676,6 +19719,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x28;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x4c;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word AOT_Closure_function_offset =
     0x10;
 static constexpr dart::compiler::target::word AOT_Closure_hash_offset = 0xc;
@@ -20285,7 +20330,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x10;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -20336,6 +20381,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x8;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word
     AOT_Closure_elements_start_offset = 0x28;
 static constexpr dart::compiler::target::word AOT_Closure_element_size = 0x8;
@@ -20576,6 +20624,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x50;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x88;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_function_offset =
     0x20;
 static constexpr dart::compiler::target::word AOT_Closure_hash_offset = 0x18;
@@ -21186,7 +21236,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -21243,6 +21293,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x8;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word
     AOT_Closure_elements_start_offset = 0x28;
 static constexpr dart::compiler::target::word AOT_Closure_element_size = 0x8;
@@ -21483,6 +21536,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x50;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x88;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_function_offset =
     0x20;
 static constexpr dart::compiler::target::word AOT_Closure_hash_offset = 0x18;
@@ -22095,7 +22150,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -22146,6 +22201,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word
     AOT_Closure_elements_start_offset = 0x20;
 static constexpr dart::compiler::target::word AOT_Closure_element_size = 0x4;
@@ -22386,6 +22444,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x2c;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x50;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_function_offset =
     0x1c;
 static constexpr dart::compiler::target::word AOT_Closure_hash_offset = 0x18;
@@ -22998,7 +23058,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -23049,6 +23109,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x10;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word
     AOT_Closure_elements_start_offset = 0x20;
 static constexpr dart::compiler::target::word AOT_Closure_element_size = 0x4;
@@ -23289,6 +23352,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x2c;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x50;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_function_offset =
     0x1c;
 static constexpr dart::compiler::target::word AOT_Closure_hash_offset = 0x18;
@@ -23903,7 +23968,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -23954,6 +24019,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0xc;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x4;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word
     AOT_Closure_elements_start_offset = 0x14;
 static constexpr dart::compiler::target::word AOT_Closure_element_size = 0x4;
@@ -24190,6 +24258,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x28;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x4c;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x4;
 static constexpr dart::compiler::target::word AOT_Closure_function_offset =
     0x10;
 static constexpr dart::compiler::target::word AOT_Closure_hash_offset = 0xc;
@@ -24800,7 +24870,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x10;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x4c;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -24851,6 +24921,9 @@ static constexpr dart::compiler::target::word AOT_Closure_entry_point_offset =
 static constexpr dart::compiler::target::word AOT_Array_elements_start_offset =
     0x18;
 static constexpr dart::compiler::target::word AOT_Array_element_size = 0x8;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_elements_start_offset = 0x0;
+static constexpr dart::compiler::target::word AOT_ClassTable_element_size = 0x1;
 static constexpr dart::compiler::target::word
     AOT_Closure_elements_start_offset = 0x28;
 static constexpr dart::compiler::target::word AOT_Closure_element_size = 0x8;
@@ -25091,6 +25164,8 @@ static constexpr dart::compiler::target::word AOT_Class_super_type_offset =
     0x50;
 static constexpr dart::compiler::target::word
     AOT_Class_host_type_arguments_field_offset_in_words_offset = 0x88;
+static constexpr dart::compiler::target::word
+    AOT_ClassTable_allocation_tracing_state_table_offset = 0x8;
 static constexpr dart::compiler::target::word AOT_Closure_function_offset =
     0x20;
 static constexpr dart::compiler::target::word AOT_Closure_hash_offset = 0x18;
@@ -25702,7 +25777,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x90;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -59,7 +59,7 @@
 #define COMMON_OFFSETS_LIST(FIELD, ARRAY, SIZEOF, ARRAY_SIZEOF,                \
                             PAYLOAD_SIZEOF, RANGE, CONSTANT, ENUM)             \
   ARRAY(Array, element_offset)                                                 \
-  NOT_IN_PRODUCT(ARRAY(ClassTable, AllocationTracingStateSlotOffsetFor))       \
+  ARRAY(ClassTable, AllocationTracingStateSlotOffsetFor)                       \
   ARRAY(Closure, element_offset)                                               \
   ARRAY(Code, element_offset)                                                  \
   ARRAY(Context, variable_offset)                                              \
@@ -190,7 +190,7 @@
   FIELD(Class, num_type_arguments_offset)                                      \
   FIELD(Class, super_type_offset)                                              \
   FIELD(Class, host_type_arguments_field_offset_in_words_offset)               \
-  NOT_IN_PRODUCT(FIELD(ClassTable, allocation_tracing_state_table_offset))     \
+  FIELD(ClassTable, allocation_tracing_state_table_offset)                     \
   FIELD(Closure, function_offset)                                              \
   FIELD(Closure, hash_offset)                                                  \
   FIELD(Closure, length_and_flags_offset)                                      \
@@ -1415,7 +1415,7 @@ void StubCodeCompiler::GenerateAllocateRecordStub() {
     Label slow_case;
 
     // Check for allocation tracing.
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kRecordCid, &slow_case, temp_reg));
+    __ MaybeTraceAllocation(kRecordCid, &slow_case, temp_reg);
 
     // Extract number of fields from the shape.
     __ AndImmediate(
@@ -1940,8 +1940,7 @@ static void GenerateAllocateSuspendState(Assembler* assembler,
   }
 
   // Check for allocation tracing.
-  NOT_IN_PRODUCT(
-      __ MaybeTraceAllocation(kSuspendStateCid, slow_case, temp_reg));
+  __ MaybeTraceAllocation(kSuspendStateCid, slow_case, temp_reg);
 
   // Compute the rounded instance size.
   const intptr_t fixed_size_plus_alignment_padding =
@@ -1015,7 +1015,7 @@ void StubCodeCompiler::GenerateAllocateArrayStub() {
     __ b(&slow_case, HI);
 
     const intptr_t cid = kArrayCid;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &slow_case, R4));
+    __ MaybeTraceAllocation(cid, &slow_case, R4);
 
     const intptr_t fixed_size_plus_alignment_padding =
         target::Array::header_size() +
@@ -1454,7 +1454,7 @@ static void GenerateAllocateContext(Assembler* assembler, Label* slow_case) {
   ASSERT(kSmiTagShift == 1);
   __ bic(R2, R2, Operand(target::ObjectAlignment::kObjectAlignment - 1));
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case, R8));
+  __ MaybeTraceAllocation(kContextCid, slow_case, R8);
   // Now allocate the object.
   // R1: number of context variables.
   // R2: object size.
@@ -1848,15 +1848,13 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
   {
     Label slow_case;
 
-#if !defined(PRODUCT)
-    {
+    if (Assembler::ChecksAllocationState()) {
       const Register kTraceAllocationTempReg = R8;
       const Register kCidRegister = R9;
       __ ExtractClassIdFromTags(kCidRegister, AllocateObjectABI::kTagsReg);
       __ MaybeTraceAllocation(kCidRegister, &slow_case,
                               kTraceAllocationTempReg);
     }
-#endif
 
     const Register kNewTopReg = R8;
 
@@ -3409,7 +3407,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
 
   if (UseInlineAllocation()) {
     Label call_runtime;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime, R2));
+    __ MaybeTraceAllocation(cid, &call_runtime, R2);
     __ mov(R2, Operand(AllocateTypedDataArrayABI::kLengthReg));
     /* Check that length is a positive Smi. */
     /* R2: requested array length argument. */
@@ -61,6 +61,30 @@ void StubCodeCompiler::EnsureIsNewOrRemembered() {
   __ Bind(&done);
 }
 
+// Allocates an instance of a pretenured class in old space with a leaf
+// runtime call, see DLRT_AllocatePretenured. Leaves the instance, or 0 if it
+// has to be allocated by the runtime, in AllocateObjectABI::kResultReg.
+// Preserves all other registers.
+static void GenerateAllocatePretenured(Assembler* assembler,
+                                       Register cid_reg,
+                                       Register size_reg) {
+  __ Push(AllocateObjectABI::kResultReg);  // Space for the result.
+  __ PushPair(size_reg, cid_reg);
+  {
+    LeafRuntimeScope rt(assembler, /*frame_size=*/0,
+                        /*preserve_registers=*/true);
+    // The values pushed above are right above the saved frame pointer and
+    // return address.
+    __ ldr(R0, Address(FP, 3 * target::kWordSize));
+    __ ldr(R1, Address(FP, 2 * target::kWordSize));
+    __ mov(R2, THR);
+    rt.Call(kAllocatePretenuredRuntimeEntry, /*argument_count=*/3);
+    __ str(R0, Address(FP, 4 * target::kWordSize));
+  }
+  __ Drop(2);
+  __ Pop(AllocateObjectABI::kResultReg);
+}
+
 // In TSAN mode the runtime will throw an exception using an intermediary
 // longjmp() call to unwind the C frames in a way that TSAN can understand.
 //
@@ -1802,7 +1826,7 @@ static void GenerateAllocateContextSpaceStub(Assembler* assembler,
   ASSERT(kSmiTagShift == 1);
   __ andi(R2, R2, Immediate(~(target::ObjectAlignment::kObjectAlignment - 1)));
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case, R4));
+  __ MaybeTraceAllocation(kContextCid, slow_case, R4);
   // Now allocate the object.
   // R1: number of context variables.
   // R2: object size.
@@ -2219,17 +2243,15 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
   const Register kTagsReg = AllocateObjectABI::kTagsReg;
 
   {
-    Label slow_case;
+    Label slow_case, allocation_state_set, initialized;
+    const Register kCidRegister = R9;
 
-#if !defined(PRODUCT)
-    {
+    if (Assembler::ChecksAllocationState()) {
       const Register kTraceAllocationTempReg = R8;
-      const Register kCidRegister = R9;
       __ ExtractClassIdFromTags(kCidRegister, AllocateObjectABI::kTagsReg);
-      __ MaybeTraceAllocation(kCidRegister, &slow_case,
+      __ MaybeTraceAllocation(kCidRegister, &allocation_state_set,
                               kTraceAllocationTempReg);
     }
-#endif
 
     const Register kNewTopReg = R3;
 
@@ -2286,6 +2308,7 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
     __ AddImmediate(AllocateObjectABI::kResultReg,
                     AllocateObjectABI::kResultReg, kHeapObjectTag);
 
+    __ Bind(&initialized);
     if (is_cls_parameterized) {
       Label not_parameterized_case;
 
@@ -2316,6 +2339,14 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
     InvokeAllocationProbePoint(assembler);
     __ ret();
 
+    if (Assembler::ChecksAllocationState()) {
+      const Register kInstanceSizeReg = R4;
+      __ Bind(&allocation_state_set);
+      __ ExtractInstanceSizeFromTags(kInstanceSizeReg, kTagsReg);
+      GenerateAllocatePretenured(assembler, kCidRegister, kInstanceSizeReg);
+      __ cbnz(&initialized, AllocateObjectABI::kResultReg);
+    }
+
     __ Bind(&slow_case);
   }  // kNewTopReg = R3
 
@@ -3836,7 +3867,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
 
   if (UseInlineAllocation()) {
     Label call_runtime;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime, R2));
+    __ MaybeTraceAllocation(cid, &call_runtime, R2);
     __ mov(R2, AllocateTypedDataArrayABI::kLengthReg);
     /* Check that length is a positive Smi. */
     /* R2: requested array length argument. */
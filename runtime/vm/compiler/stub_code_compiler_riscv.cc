@@ -1094,7 +1094,7 @@ void StubCodeCompiler::GenerateAllocateArrayStub() {
     __ BranchIf(HI, &slow_case);
 
     const intptr_t cid = kArrayCid;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kArrayCid, &slow_case, T4));
+    __ MaybeTraceAllocation(kArrayCid, &slow_case, T4);
 
     // Calculate and align allocation size.
     // Load new object start and calculate next object start.
@@ -1454,7 +1454,7 @@ static void GenerateAllocateContextSpaceStub(Assembler* assembler,
   __ AddImmediate(S8, fixed_size_plus_alignment_padding);
   __ andi(S8, S8, ~(target::ObjectAlignment::kObjectAlignment - 1));
 
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case, T4));
+  __ MaybeTraceAllocation(kContextCid, slow_case, T4);
   // Now allocate the object.
   // T1: number of context variables.
   // S8: object size.
@@ -1836,13 +1836,11 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
   {
     Label slow_case;
 
-#if !defined(PRODUCT)
-    {
+    if (Assembler::ChecksAllocationState()) {
       const Register kCidRegister = TMP2;
       __ ExtractClassIdFromTags(kCidRegister, AllocateObjectABI::kTagsReg);
       __ MaybeTraceAllocation(kCidRegister, &slow_case, TMP);
     }
-#endif
 
     const Register kNewTopReg = T3;
 
@@ -3349,7 +3347,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
 
   if (UseInlineAllocation()) {
     Label call_runtime;
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime, T3));
+    __ MaybeTraceAllocation(cid, &call_runtime, T3);
     __ mv(T3, AllocateTypedDataArrayABI::kLengthReg);
     /* Check that length is a positive Smi. */
     /* T3: requested array length argument. */
@@ -64,6 +64,30 @@ void StubCodeCompiler::EnsureIsNewOrRemembered() {
   __ Bind(&done);
 }
 
+// Allocates an instance of a pretenured class in old space with a leaf
+// runtime call, see DLRT_AllocatePretenured. Leaves the instance, or 0 if it
+// has to be allocated by the runtime, in AllocateObjectABI::kResultReg.
+// Preserves all other registers.
+static void GenerateAllocatePretenured(Assembler* assembler,
+                                       Register cid_reg,
+                                       Register size_reg) {
+  __ pushq(AllocateObjectABI::kResultReg);  // Space for the result.
+  __ pushq(cid_reg);
+  __ pushq(size_reg);
+  {
+    LeafRuntimeScope rt(assembler, /*frame_size=*/0,
+                        /*preserve_registers=*/true);
+    // The values pushed above are right above the saved frame pointer.
+    __ movq(CallingConventions::kArg1Reg, Address(RBP, 2 * target::kWordSize));
+    __ movq(CallingConventions::kArg2Reg, Address(RBP, 1 * target::kWordSize));
+    __ movq(CallingConventions::kArg3Reg, THR);
+    rt.Call(kAllocatePretenuredRuntimeEntry, 3);
+    __ movq(Address(RBP, 3 * target::kWordSize), RAX);
+  }
+  __ Drop(2);
+  __ popq(AllocateObjectABI::kResultReg);
+}
+
 // In TSAN mode the runtime will throw an exception using an intermediary
 // longjmp() call to unwind the C frames in a way that TSAN can understand.
 //
@@ -1808,7 +1832,7 @@ static void GenerateAllocateContextSpaceStub(Assembler* assembler,
   __ andq(R13, Immediate(-target::ObjectAlignment::kObjectAlignment));
 
   // Check for allocation tracing.
-  NOT_IN_PRODUCT(__ MaybeTraceAllocation(kContextCid, slow_case));
+  __ MaybeTraceAllocation(kContextCid, slow_case);
 
   // Now allocate the object.
   // R10: number of context variables.
@@ -2191,16 +2215,14 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
   const Register kTagsReg = AllocateObjectABI::kTagsReg;
 
   {
-    Label slow_case;
+    Label slow_case, allocation_state_set, initialized;
     const Register kNewTopReg = R9;
 
-#if !defined(PRODUCT)
-    {
+    if (Assembler::ChecksAllocationState()) {
       const Register kCidRegister = RSI;
       __ ExtractClassIdFromTags(kCidRegister, AllocateObjectABI::kTagsReg);
-      __ MaybeTraceAllocation(kCidRegister, &slow_case, TMP);
+      __ MaybeTraceAllocation(kCidRegister, &allocation_state_set, TMP);
     }
-#endif
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     {
@@ -2254,6 +2276,7 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
 
     __ WriteAllocationCanary(kNewTopReg);  // Fix overshoot.
 
+    __ Bind(&initialized);
     if (is_cls_parameterized) {
       Label not_parameterized_case;
 
@@ -2283,6 +2306,15 @@ static void GenerateAllocateObjectHelper(Assembler* assembler,
     InvokeAllocationProbePoint(assembler);
     __ ret();
 
+    if (Assembler::ChecksAllocationState()) {
+      // RSI: class id.
+      __ Bind(&allocation_state_set);
+      __ ExtractInstanceSizeFromTags(RDI, kTagsReg);
+      GenerateAllocatePretenured(assembler, RSI, RDI);
+      __ testq(AllocateObjectABI::kResultReg, AllocateObjectABI::kResultReg);
+      __ j(NOT_ZERO, &initialized);
+    }
+
     __ Bind(&slow_case);
   }  // kNewTopReg = R9;
 
@@ -3791,7 +3823,7 @@ void StubCodeCompiler::GenerateAllocateTypedDataArrayStub(intptr_t cid) {
     Label call_runtime;
     __ pushq(AllocateTypedDataArrayABI::kLengthReg);
 
-    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cid, &call_runtime));
+    __ MaybeTraceAllocation(cid, &call_runtime);
     __ movq(RDI, AllocateTypedDataArrayABI::kLengthReg);
     /* Check that length is a positive Smi. */
     /* RDI: requested array length argument. */
@@ -17,6 +17,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_tasks);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -101,6 +103,58 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   delete m;
 }
 
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionsOnHelperThreads) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 43; }\n"
+      "  static baz() { return 44; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const char* kNames[] = {"foo", "bar", "baz"};
+  const intptr_t kCount = ARRAY_SIZE(kNames);
+  Function* functions[kCount];
+  for (intptr_t i = 0; i < kCount; i++) {
+    functions[i] = &Function::Handle(
+        cls.LookupStaticFunction(String::Handle(String::New(kNames[i]))));
+    CompilerTest::TestCompileFunction(*functions[i]);
+    EXPECT(functions[i]->HasCode());
+    EXPECT(!functions[i]->HasOptimizedCode());
+  }
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  SetFlagScope<int> sfs(&FLAG_background_compiler_tasks, kCount);
+  auto isolate_group = thread->isolate_group();
+  for (intptr_t i = 0; i < kCount; i++) {
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(
+        *functions[i]));
+  }
+  Monitor* m = new Monitor();
+  {
+    SafepointMonitorLocker ml(m);
+    for (intptr_t i = 0; i < kCount; i++) {
+      while (!functions[i]->HasOptimizedCode()) {
+        ml.Wait(1);
+      }
+    }
+  }
+  delete m;
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
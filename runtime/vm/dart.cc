@@ -58,6 +58,7 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, pretenuring);
 DECLARE_FLAG(bool, print_class_table);
 DEFINE_FLAG(bool, trace_shutdown, false, "Trace VM shutdown on stderr");
 DEFINE_FLAG(bool,
@@ -513,6 +514,14 @@ char* Dart::Cleanup() {
   }
   Isolate::DisableIsolateCreation();
 
+  // Idle isolates never start their message loop and wouldn't handle the kill
+  // message below, so they are shut down directly.
+  if (FLAG_trace_shutdown) {
+    OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Shutting down idle isolates\n",
+                 UptimeMillis());
+  }
+  IsolateGroup::ShutdownIdleIsolates();
+
   // Send the OOB Kill message to all remaining application isolates.
   if (FLAG_trace_shutdown) {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Killing all app isolates\n",
@@ -953,6 +962,11 @@ char* Dart::FeaturesString(IsolateGroup* isolate_group, Snapshot::Kind kind) {
     ADD_ISOLATE_GROUP_FLAG(code_comments, code_comments, FLAG_code_comments);
     ADD_ISOLATE_GROUP_FLAG(dwarf_stack_traces, dwarf_stack_traces,
                            FLAG_dwarf_stack_traces_mode);
+#if defined(PRODUCT)
+    // Generated code only checks whether a class is pretenured if it was
+    // compiled with this flag (see AssemblerBase::ChecksAllocationState).
+    ADD_FLAG(pretenuring, FLAG_pretenuring)
+#endif
   }
 
   if (Snapshot::IncludesCode(kind) || FLAG_check_core_snapshot_match) {
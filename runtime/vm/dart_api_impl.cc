@@ -1164,6 +1164,33 @@ DART_EXPORT bool Dart_IsVMFlagSet(const char* flag_name) {
 DART_API_ISOLATE_GROUP_METRIC_LIST(ISOLATE_GROUP_METRIC_API)
 #undef ISOLATE_GROUP_METRIC_API
 
+DART_EXPORT intptr_t Dart_IsolateGroupGCStats(Dart_IsolateGroup isolate_group,
+                                              int64_t after_sequence,
+                                              Dart_GCStats* stats,
+                                              intptr_t length) {
+  if (isolate_group == nullptr) {
+    FATAL("%s expects argument 'isolate_group' to be non-null.", CURRENT_FUNC);
+  }
+  if ((stats == nullptr) && (length > 0)) {
+    FATAL("%s expects argument 'stats' to be non-null.", CURRENT_FUNC);
+  }
+  IsolateGroup* group = reinterpret_cast<IsolateGroup*>(isolate_group);
+  return group->heap()->gc_stats_buffer()->Read(after_sequence, stats, length);
+}
+
+DART_EXPORT void Dart_IsolateGroupGCPauseHistogram(
+    Dart_IsolateGroup isolate_group,
+    int64_t* buckets) {
+  if (isolate_group == nullptr) {
+    FATAL("%s expects argument 'isolate_group' to be non-null.", CURRENT_FUNC);
+  }
+  if (buckets == nullptr) {
+    FATAL("%s expects argument 'buckets' to be non-null.", CURRENT_FUNC);
+  }
+  IsolateGroup* group = reinterpret_cast<IsolateGroup*>(isolate_group);
+  group->heap()->gc_stats_buffer()->ReadPauseHistogram(buckets);
+}
+
 #if !defined(PRODUCT)
 #define ISOLATE_METRIC_API(type, variable, name, unit)                         \
   DART_EXPORT int64_t Dart_Isolate##variable##Metric(Dart_Isolate isolate) {   \
@@ -1933,6 +1960,12 @@ DART_EXPORT Dart_MessageNotifyCallback Dart_GetMessageNotifyCallback() {
   return isolate->message_notify_callback();
 }
 
+DART_EXPORT void Dart_SetLatencyCritical(bool latency_critical) {
+  Isolate* isolate = Isolate::Current();
+  CHECK_ISOLATE(isolate);
+  isolate->message_handler()->set_latency_critical(latency_critical);
+}
+
 struct RunLoopData {
   Monitor* monitor;
   bool done;
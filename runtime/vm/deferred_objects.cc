@@ -181,8 +181,10 @@ void DeferredPcMarker::Materialize(DeoptContext* deopt_context) {
               function.deoptimization_counter());
   }
   // Clear invocation counter so that hopefully the function gets reoptimized
-  // only after more feedback has been collected.
+  // only after more feedback has been collected. OSR code compiled in the
+  // background with the old feedback is dropped for the same reason.
   function.SetUsageCounter(0);
+  thread->isolate_group()->background_compiler()->DropOsrCode(function);
   if (function.HasOptimizedCode()) {
     function.SwitchToUnoptimizedCode();
   }
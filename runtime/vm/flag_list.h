@@ -146,6 +146,9 @@ constexpr bool FLAG_support_il_printer = false;
   P(marker_tasks, int, 2,                                                      \
     "The number of tasks to spawn during old gen GC marking (0 means "         \
     "perform all marking on main thread).")                                    \
+  P(sweeper_tasks, int, 2,                                                     \
+    "The number of tasks to spawn during concurrent old gen GC sweeping (0 "   \
+    "means perform all sweeping on the main thread).")                         \
   P(hash_map_probes_limit, int, kMaxInt32,                                     \
     "Limit number of probes while doing lookups in hash maps.")                \
   P(max_polymorphic_checks, int, 4,                                            \
@@ -555,6 +555,9 @@ char* Flags::CheckFlags() {
   if (FLAG_marker_tasks < 0) {
     return Utils::StrDup("Invalid marker_tasks");
   }
+  if (FLAG_sweeper_tasks < 0) {
+    return Utils::StrDup("Invalid sweeper_tasks");
+  }
   if (FLAG_compactor_tasks < 0) {
     return Utils::StrDup("Invalid compactor_tasks");
   }
@@ -0,0 +1,94 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/gc_stats.h"
+
+#include <string.h>
+
+#include "platform/assert.h"
+#include "platform/utils.h"
+
+namespace dart {
+
+GCStatsBuffer::GCStatsBuffer() {
+  for (intptr_t i = 0; i < kCapacity; i++) {
+    slots_[i].version.store(0, std::memory_order_relaxed);
+    for (intptr_t j = 0; j < kWords; j++) {
+      slots_[i].words[j].store(0, std::memory_order_relaxed);
+    }
+  }
+  for (intptr_t i = 0; i < kHistogramBuckets; i++) {
+    pause_histogram_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+intptr_t GCStatsBuffer::PauseHistogramBucket(int64_t micros) {
+  if (micros <= 0) return 0;
+  return Utils::Minimum<intptr_t>(Utils::BitLength(micros),
+                                  kHistogramBuckets - 1);
+}
+
+void GCStatsBuffer::Add(Dart_GCStats* stats) {
+  const int64_t sequence = last_sequence_.load(std::memory_order_relaxed) + 1;
+  stats->sequence = sequence;
+
+  uint64_t words[kWords];
+  memcpy(words, stats, sizeof(words));  // NOLINT
+
+  Slot* slot = &slots_[(sequence - 1) & kMask];
+  const uint64_t version = slot->version.load(std::memory_order_relaxed);
+  slot->version.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (intptr_t i = 0; i < kWords; i++) {
+    slot->words[i].store(words[i], std::memory_order_relaxed);
+  }
+  slot->version.store(version + 2, std::memory_order_release);
+  last_sequence_.store(sequence, std::memory_order_release);
+
+  const intptr_t bucket =
+      PauseHistogramBucket(stats->end_micros - stats->start_micros);
+  pause_histogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+bool GCStatsBuffer::TryReadSlot(int64_t sequence, Dart_GCStats* stats) {
+  Slot* slot = &slots_[(sequence - 1) & kMask];
+  const uint64_t version = slot->version.load(std::memory_order_acquire);
+  if ((version & 1) != 0) {
+    // Being overwritten by a newer collection.
+    return false;
+  }
+  uint64_t words[kWords];
+  for (intptr_t i = 0; i < kWords; i++) {
+    words[i] = slot->words[i].load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot->version.load(std::memory_order_relaxed) != version) {
+    return false;
+  }
+  memcpy(stats, words, sizeof(words));  // NOLINT
+  return stats->sequence == sequence;
+}
+
+intptr_t GCStatsBuffer::Read(int64_t after_sequence,
+                             Dart_GCStats* stats,
+                             intptr_t length) {
+  const int64_t last = last_sequence_.load(std::memory_order_acquire);
+  int64_t sequence = Utils::Maximum<int64_t>(after_sequence, 0) + 1;
+  sequence = Utils::Maximum<int64_t>(sequence, last - kCapacity + 1);
+  intptr_t count = 0;
+  for (; (sequence <= last) && (count < length); sequence++) {
+    if (TryReadSlot(sequence, &stats[count])) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void GCStatsBuffer::ReadPauseHistogram(int64_t* buckets) const {
+  for (intptr_t i = 0; i < kHistogramBuckets; i++) {
+    buckets[i] = pause_histogram_[i].load(std::memory_order_relaxed);
+  }
+}
+
+}  // namespace dart
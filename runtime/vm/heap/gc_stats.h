@@ -0,0 +1,70 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_GC_STATS_H_
+#define RUNTIME_VM_HEAP_GC_STATS_H_
+
+#if defined(SHOULD_NOT_INCLUDE_RUNTIME)
+#error "Should not include runtime"
+#endif
+
+#include <atomic>
+
+#include "include/dart_tools_api.h"
+#include "platform/globals.h"
+#include "vm/allocation.h"
+
+namespace dart {
+
+// Statistics of the most recent garbage collections of an isolate group and a
+// histogram of all pause times, for Dart_IsolateGroupGCStats.
+//
+// Collections are recorded by the thread performing the GC, of which there is
+// at most one at a time, and may be read concurrently by any thread without
+// locking. Each slot of the ring buffer is guarded by a sequence lock: readers
+// retry or skip a slot that is overwritten while they copy it.
+class GCStatsBuffer {
+ public:
+  static constexpr intptr_t kCapacity = 64;
+  static constexpr intptr_t kHistogramBuckets = DART_GC_PAUSE_HISTOGRAM_BUCKETS;
+
+  GCStatsBuffer();
+
+  // Records `stats`, assigning it the next sequence number. Only called by
+  // the thread owning the GC safepoint.
+  void Add(Dart_GCStats* stats);
+
+  // See Dart_IsolateGroupGCStats.
+  intptr_t Read(int64_t after_sequence, Dart_GCStats* stats, intptr_t length);
+
+  // See Dart_IsolateGroupGCPauseHistogram.
+  void ReadPauseHistogram(int64_t* buckets) const;
+
+  static intptr_t PauseHistogramBucket(int64_t micros);
+
+ private:
+  static constexpr intptr_t kMask = kCapacity - 1;
+  static constexpr intptr_t kWords = sizeof(Dart_GCStats) / sizeof(uint64_t);
+  static_assert((sizeof(Dart_GCStats) % sizeof(uint64_t)) == 0,
+                "Dart_GCStats is copied as words");
+
+  struct Slot {
+    // Odd while the slot is being written, otherwise twice the number of
+    // times it was written.
+    std::atomic<uint64_t> version;
+    std::atomic<uint64_t> words[kWords];
+  };
+
+  bool TryReadSlot(int64_t sequence, Dart_GCStats* stats);
+
+  std::atomic<int64_t> last_sequence_ = {0};
+  Slot slots_[kCapacity];
+  std::atomic<int64_t> pause_histogram_[kHistogramBuckets];
+
+  DISALLOW_COPY_AND_ASSIGN(GCStatsBuffer);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_GC_STATS_H_
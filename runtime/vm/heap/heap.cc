@@ -546,6 +546,7 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
     thread->isolate_group()->handler_info_cache()->Clear();
     thread->isolate_group()->ClearCatchEntryMovesCacheLocked();
     assume_scavenge_will_fail_ = false;
+    new_space_.ResetPretenuring();
   }
 }
 
@@ -1019,6 +1020,7 @@ void Heap::RecordAfterGC(GCType type) {
   stats_.after_.old_ = old_space_.GetCurrentUsage();
   stats_.after_.store_buffer_ = isolate_group_->store_buffer()->Size();
   RecordRSS();
+  RecordStatsBuffer();
 #ifndef PRODUCT
   // For now we'll emit the same GC events on all isolates.
   if (Service::gc_stream.enabled()) {
@@ -1037,6 +1039,64 @@ void Heap::RecordAfterGC(GCType type) {
   OS::NotifyAfterGC();
 }
 
+#define CHECK_GC_ENUM(vm, api)                                                 \
+  static_assert(static_cast<int>(vm) == api, #vm " must match " #api);
+CHECK_GC_ENUM(GCType::kScavenge, Dart_GCKind_Scavenge)
+CHECK_GC_ENUM(GCType::kEvacuate, Dart_GCKind_Evacuate)
+CHECK_GC_ENUM(GCType::kStartConcurrentMark, Dart_GCKind_StartConcurrentMark)
+CHECK_GC_ENUM(GCType::kMarkSweep, Dart_GCKind_MarkSweep)
+CHECK_GC_ENUM(GCType::kMarkCompact, Dart_GCKind_MarkCompact)
+CHECK_GC_ENUM(GCReason::kNewSpace, Dart_GCReason_NewSpace)
+CHECK_GC_ENUM(GCReason::kStoreBuffer, Dart_GCReason_StoreBuffer)
+CHECK_GC_ENUM(GCReason::kPromotion, Dart_GCReason_Promotion)
+CHECK_GC_ENUM(GCReason::kOldSpace, Dart_GCReason_OldSpace)
+CHECK_GC_ENUM(GCReason::kFinalize, Dart_GCReason_Finalize)
+CHECK_GC_ENUM(GCReason::kFull, Dart_GCReason_Full)
+CHECK_GC_ENUM(GCReason::kExternal, Dart_GCReason_External)
+CHECK_GC_ENUM(GCReason::kIdle, Dart_GCReason_Idle)
+CHECK_GC_ENUM(GCReason::kDestroyed, Dart_GCReason_Destroyed)
+CHECK_GC_ENUM(GCReason::kDebugging, Dart_GCReason_Debugging)
+CHECK_GC_ENUM(GCReason::kCatchUp, Dart_GCReason_CatchUp)
+#undef CHECK_GC_ENUM
+
+void Heap::RecordStatsBuffer() {
+  Dart_GCStats stats = {};
+  stats.kind = static_cast<int32_t>(stats_.type_);
+  stats.reason = static_cast<int32_t>(stats_.reason_);
+  stats.start_micros = stats_.before_.micros_;
+  stats.end_micros = stats_.after_.micros_;
+  const bool is_scavenge = (stats_.type_ == GCType::kScavenge) ||
+                           (stats_.type_ == GCType::kEvacuate);
+  if (!is_scavenge) {
+    stats.mark_micros = old_space_.last_mark_micros();
+    stats.sweep_micros = old_space_.last_sweep_micros();
+    stats.compact_micros = old_space_.last_compact_micros();
+  }
+  stats.new_used_before = stats_.before_.new_.used_in_words * kWordSize;
+  stats.new_used_after = stats_.after_.new_.used_in_words * kWordSize;
+  stats.new_capacity_after = stats_.after_.new_.capacity_in_words * kWordSize;
+  stats.new_external_after = stats_.after_.new_.external_in_words * kWordSize;
+  stats.old_used_before = stats_.before_.old_.used_in_words * kWordSize;
+  stats.old_used_after = stats_.after_.old_.used_in_words * kWordSize;
+  stats.old_capacity_after = stats_.after_.old_.capacity_in_words * kWordSize;
+  stats.old_external_after = stats_.after_.old_.external_in_words * kWordSize;
+  const ScavengeStats* scavenge = new_space_.last_stats();
+  if (is_scavenge && (scavenge != nullptr)) {
+    stats.promotion_candidates =
+        scavenge->promo_candidates_in_words() * kWordSize;
+    stats.promoted = scavenge->promoted_in_words() * kWordSize;
+  }
+  const PageSpaceController& controller = old_space_.page_space_controller();
+  stats.old_hard_threshold =
+      controller.hard_gc_threshold_in_words() * kWordSize;
+  stats.old_soft_threshold =
+      controller.soft_gc_threshold_in_words() * kWordSize;
+  stats.old_idle_threshold =
+      controller.idle_gc_threshold_in_words() * kWordSize;
+  stats.old_growth_in_pages = controller.last_growth_in_pages();
+  gc_stats_buffer_.Add(&stats);
+}
+
 void Heap::PrintStats() {
   if (!FLAG_verbose_gc) return;
 
@@ -1144,6 +1204,13 @@ Heap::Space Heap::SpaceForExternal(intptr_t size) const {
   }
 }
 
+Heap::Space Heap::SpaceForAllocation(intptr_t cid) const {
+  if (isolate_group_->class_table()->ShouldPretenure(cid)) {
+    return Heap::kOld;
+  }
+  return Heap::kNew;
+}
+
 ForceGrowthScope::ForceGrowthScope(Thread* thread)
     : ThreadStackResource(thread) {
   thread->IncrementForceGrowthScopeDepth();
@@ -17,6 +17,7 @@
 #include "vm/allocation.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/gc_stats.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/scavenger.h"
 #include "vm/heap/spaces.h"
@@ -299,8 +300,15 @@ class Heap {
 
   Space SpaceForExternal(intptr_t size) const;
 
+  // The space for instances of `cid` allocated by the runtime on behalf of
+  // generated code: old space if the class is pretenured (see
+  // PretenuringPolicy).
+  Space SpaceForAllocation(intptr_t cid) const;
+
   void CollectOnNthAllocation(intptr_t num_allocations);
 
+  GCStatsBuffer* gc_stats_buffer() { return &gc_stats_buffer_; }
+
  private:
   class GCStats : public ValueObject {
    public:
@@ -357,6 +365,7 @@ class Heap {
   // GC stats collection.
   void RecordBeforeGC(GCType type, GCReason reason);
   void RecordAfterGC(GCType type);
+  void RecordStatsBuffer();
   void PrintStats();
   void PrintStatsToTimeline(TimelineEventScope* event, GCReason reason);
 
@@ -379,6 +388,7 @@ class Heap {
 
   // GC stats collection.
   GCStats stats_;
+  GCStatsBuffer gc_stats_buffer_;
 
   RelaxedAtomic<Dart_PerformanceMode> mode_ = {Dart_PerformanceMode_Default};
 
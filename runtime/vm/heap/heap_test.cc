@@ -28,6 +28,7 @@
 namespace dart {
 
 DECLARE_FLAG(int, early_tenuring_threshold);
+DECLARE_FLAG(bool, pretenuring);
 
 TEST_CASE(OldGC) {
   const char* kScriptChars =
@@ -1662,6 +1663,225 @@ VM_UNIT_TEST_CASE(MutatorMarkerRace_DetectInTLAB) {
       });
 }
 
+ISOLATE_UNIT_TEST_CASE(ConcurrentSweep_MultipleTasks) {
+  SetFlagScope<int> sfs(&FLAG_sweeper_tasks, 4);
+  Heap* heap = IsolateGroup::Current()->heap();
+
+  // Spread survivors over many regular pages and a few large pages, so all
+  // sweeper tasks have pages to claim.
+  const intptr_t kNumElements = 256 * 1024;
+  const intptr_t kNumLarge = 16;
+  const Array& list = Array::Handle(Array::New(kNumElements, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kNumElements; i++) {
+    element = Array::New(8, Heap::kOld);
+    element.SetAt(0, Smi::Handle(Smi::New(i)));
+    list.SetAt(i, element);
+  }
+  for (intptr_t i = 0; i < kNumLarge; i++) {
+    element = Array::New(256 * KB / kCompressedWordSize, Heap::kOld);
+    list.SetAt(i * 1024, element);
+  }
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+  const intptr_t used_before = heap->old_space()->UsedInWords();
+
+  for (intptr_t i = 0; i < kNumElements; i++) {
+    if ((i % 3) != 0) {
+      list.SetAt(i, Object::null_object());
+    }
+  }
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+  EXPECT(heap->old_space()->UsedInWords() < used_before);
+  EXPECT_EQ(PageSpace::kDone, heap->old_space()->phase());
+  {
+    // The pages were not all swept by a single task.
+    MonitorLocker ml(heap->old_space()->tasks_lock());
+    EXPECT_LE(2, heap->old_space()->busy_sweeper_tasks());
+  }
+
+  for (intptr_t i = 0; i < kNumElements; i += 3) {
+    element ^= list.At(i);
+    if ((i % 1024) != 0) {
+      EXPECT_EQ(Smi::New(i), element.At(0));
+    }
+  }
+
+  // Allocate into the freed space to exercise all freelists.
+  for (intptr_t i = 0; i < kNumElements; i++) {
+    if ((i % 3) != 0) {
+      element = Array::New(8, Heap::kOld);
+      list.SetAt(i, element);
+    }
+  }
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+}
+
+VM_UNIT_TEST_CASE(GCStatsBuffer_WrapAround) {
+  GCStatsBuffer buffer;
+  Dart_GCStats stats[GCStatsBuffer::kCapacity];
+  EXPECT_EQ(0, buffer.Read(0, stats, GCStatsBuffer::kCapacity));
+
+  const intptr_t kCount = GCStatsBuffer::kCapacity + 10;
+  for (intptr_t i = 1; i <= kCount; i++) {
+    Dart_GCStats entry = {};
+    entry.start_micros = 1000 * i;
+    entry.end_micros = entry.start_micros + i;
+    buffer.Add(&entry);
+    EXPECT_EQ(i, entry.sequence);
+  }
+
+  // The oldest collections were dropped.
+  intptr_t count = buffer.Read(0, stats, GCStatsBuffer::kCapacity);
+  EXPECT_EQ(GCStatsBuffer::kCapacity, count);
+  for (intptr_t i = 0; i < count; i++) {
+    const int64_t sequence = kCount - GCStatsBuffer::kCapacity + 1 + i;
+    EXPECT_EQ(sequence, stats[i].sequence);
+    EXPECT_EQ(1000 * sequence, stats[i].start_micros);
+  }
+
+  // Only newer collections, and at most `length` of them.
+  count = buffer.Read(kCount - 5, stats, 3);
+  EXPECT_EQ(3, count);
+  EXPECT_EQ(kCount - 4, stats[0].sequence);
+  EXPECT_EQ(kCount - 2, stats[2].sequence);
+  EXPECT_EQ(0, buffer.Read(kCount, stats, GCStatsBuffer::kCapacity));
+
+  int64_t histogram[GCStatsBuffer::kHistogramBuckets];
+  buffer.ReadPauseHistogram(histogram);
+  int64_t total = 0;
+  for (intptr_t i = 0; i < GCStatsBuffer::kHistogramBuckets; i++) {
+    total += histogram[i];
+  }
+  EXPECT_EQ(kCount, total);
+  // Pauses of 1us, of 2-3us and of 4-7us.
+  EXPECT_EQ(1, histogram[1]);
+  EXPECT_EQ(2, histogram[2]);
+  EXPECT_EQ(4, histogram[3]);
+  EXPECT_EQ(0, GCStatsBuffer::PauseHistogramBucket(0));
+  EXPECT_EQ(GCStatsBuffer::kHistogramBuckets - 1,
+            GCStatsBuffer::PauseHistogramBucket(kMaxInt64));
+}
+
+TEST_CASE(Pretenuring_SurvivingClass) {
+  SetFlagScope<bool> sfs(&FLAG_pretenuring, true);
+  const char* kScriptChars =
+      "class A {\n"
+      "  var a;\n"
+      "  var b;\n"
+      "}\n";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  EXPECT_VALID(h_lib);
+  TransitionNativeToVM transition(thread);
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(h_lib)));
+  const Class& cls = Class::Handle(
+      lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  EXPECT(cls.EnsureIsAllocateFinalized(thread) == Error::null());
+  const intptr_t cid = cls.id();
+
+  // Core classes are allocated from too many sites to share one decision.
+  EXPECT(PretenuringPolicy::CanPretenure(cid));
+  EXPECT(!PretenuringPolicy::CanPretenure(kArrayCid));
+  EXPECT(!PretenuringPolicy::CanPretenure(kOneByteStringCid));
+
+  Heap* heap = thread->heap();
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  GCTestHelper::CollectAllGarbage();
+  EXPECT(!class_table->ShouldPretenure(cid));
+  EXPECT_EQ(Heap::kNew, heap->SpaceForAllocation(cid));
+
+  const intptr_t kNumInstances = 100000;
+  Instance& element = Instance::Handle();
+
+  // Instances that die young are not pretenured.
+  for (intptr_t i = 0; i < kNumInstances; i++) {
+    element = Instance::New(cls);
+  }
+  GCTestHelper::CollectNewSpace();
+  EXPECT(!class_table->ShouldPretenure(cid));
+  heap->new_space()->ResetPretenuring();  // Drop the samples of dead objects.
+
+  // Instances that survive are.
+  const Array& list = Array::Handle(Array::New(kNumInstances, Heap::kOld));
+  auto allocate_surviving = [&]() {
+    for (intptr_t i = 0; i < kNumInstances; i++) {
+      element = Instance::New(cls);
+      list.SetAt(i, element);
+    }
+    GCTestHelper::CollectNewSpace();
+  };
+  allocate_surviving();
+  EXPECT(class_table->ShouldPretenure(cid));
+  EXPECT_EQ(Heap::kOld, heap->SpaceForAllocation(cid));
+  EXPECT(heap->new_space()->pretenuring_policy().num_pretenured() > 0);
+#if !defined(PRODUCT)
+  // Pretenuring does not hide the class from the allocation profiler.
+  EXPECT(!class_table->ShouldTraceAllocationFor(cid));
+  class_table->SetTraceAllocationFor(cid, true);
+  class_table->SetTraceAllocationFor(cid, false);
+  EXPECT(class_table->ShouldPretenure(cid));
+#endif  // !defined(PRODUCT)
+
+  // The next old-space collection revisits the decision.
+  GCTestHelper::CollectOldSpace();
+  EXPECT(!class_table->ShouldPretenure(cid));
+  EXPECT_EQ(Heap::kNew, heap->SpaceForAllocation(cid));
+  EXPECT_EQ(0, heap->new_space()->pretenuring_policy().num_pretenured());
+
+  // Pretenured again right away, so the decision is kept for longer.
+  allocate_surviving();
+  EXPECT(class_table->ShouldPretenure(cid));
+  GCTestHelper::CollectOldSpace();
+  EXPECT(class_table->ShouldPretenure(cid));
+  GCTestHelper::CollectOldSpace();
+  EXPECT(!class_table->ShouldPretenure(cid));
+  EXPECT_EQ(0, heap->new_space()->pretenuring_policy().num_pretenured());
+}
+
+// In product builds, generated code only checks the allocation state of a
+// class when --pretenuring is given before the stubs are generated.
+#if !defined(PRODUCT)
+TEST_CASE(Pretenuring_AllocationStubs) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  var a;\n"
+      "  A(this.a);\n"
+      "}\n"
+      "allocateObject() => A(1);\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_Handle object =
+      Dart_Invoke(lib, NewString("allocateObject"), 0, nullptr);
+  EXPECT_VALID(object);
+
+  intptr_t cid;
+  {
+    TransitionNativeToVM transition(thread);
+    EXPECT(Api::UnwrapHandle(object)->IsNewObject());
+    cid = Api::UnwrapHandle(object)->GetClassId();
+    ClassTable* class_table = thread->isolate_group()->class_table();
+    class_table->SetPretenure(cid, true);
+  }
+
+  // The stubs allocate instances of pretenured classes in old space.
+  object = Dart_Invoke(lib, NewString("allocateObject"), 0, nullptr);
+  EXPECT_VALID(object);
+  {
+    TransitionNativeToVM transition(thread);
+    const Instance& instance =
+        Instance::Handle(Instance::RawCast(Api::UnwrapHandle(object)));
+    EXPECT(instance.IsOld());
+    EXPECT_EQ(cid, instance.GetClassId());
+    ClassTable* class_table = thread->isolate_group()->class_table();
+    class_table->SetPretenure(cid, false);
+    GCTestHelper::CollectAllGarbage();
+  }
+}
+#endif  // !defined(PRODUCT)
+
 #if defined(DART_COMPRESSED_POINTERS)
 TEST_CASE_WITH_EXPECTATION(CompressedHeapGuardLow, "Crash") {
   SetFlagScope<bool> sfs(&FLAG_pointer_cage, true);
@@ -57,6 +57,8 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       tasks_(0),
       concurrent_marker_tasks_(0),
       concurrent_marker_tasks_active_(0),
+      concurrent_sweeper_tasks_(0),
+      busy_sweeper_tasks_(0),
       pause_concurrent_marking_(0),
       phase_(kDone),
 #if defined(DEBUG)
@@ -417,6 +419,20 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   return result;
 }
 
+uword PageSpace::TryAllocateFromFreeLists(intptr_t size) {
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  if (!IsAllocatableViaFreeLists(size)) {
+    return 0;
+  }
+  const uword result =
+      freelists_[kDataFreelist].TryAllocate(size, /*is_protected=*/false);
+  if (result != 0) {
+    Page::Of(result)->add_live_bytes(size);
+    usage_.used_in_words += (size >> kWordSizeLog2);
+  }
+  return result;
+}
+
 void PageSpace::AcquireLock(FreeList* freelist) {
   freelist->mutex()->Lock();
 }
@@ -1111,21 +1127,28 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     ASSERT(phase() == kAwaitingFinalization);
   }
 
+  last_mark_micros_ = 0;
+  last_sweep_micros_ = 0;
+  last_compact_micros_ = 0;
   if (!finalize) {
     ASSERT(phase() == kDone);
     marker_->StartConcurrentMark(this);
+    last_mark_micros_ = OS::GetCurrentMonotonicMicros() - start;
     return;
   }
 
   // Abandon the remainder of the bump allocation block.
   ReleaseBumpAllocation();
 
+  const int64_t mark_start = OS::GetCurrentMonotonicMicros();
   marker_->MarkObjects(this);
   usage_.used_in_words = marker_->marked_words() + allocated_black_in_words_;
   allocated_black_in_words_ = 0;
   mark_words_per_micro_ = marker_->MarkedWordsPerMicro();
   delete marker_;
   marker_ = nullptr;
+  const int64_t sweep_start = OS::GetCurrentMonotonicMicros();
+  last_mark_micros_ = sweep_start - mark_start;
 
   if (FLAG_verify_store_buffer) {
     VerifyStoreBuffers("Verifying remembered set after marking");
@@ -1183,10 +1206,13 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
 
   bool is_concurrent_sweep_running = false;
   if (compact) {
+    const int64_t compact_start = OS::GetCurrentMonotonicMicros();
     Compact(thread);
+    last_compact_micros_ = OS::GetCurrentMonotonicMicros() - compact_start;
     set_phase(kDone);
     is_concurrent_sweep_running = true;
-  } else if (FLAG_concurrent_sweep && has_reservation) {
+  } else if (FLAG_concurrent_sweep && (FLAG_sweeper_tasks > 0) &&
+             has_reservation) {
     ConcurrentSweep(isolate_group);
     is_concurrent_sweep_running = true;
   } else {
@@ -1194,6 +1220,8 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     Sweep(/*exclusive*/ true);
     set_phase(kDone);
   }
+  last_sweep_micros_ =
+      OS::GetCurrentMonotonicMicros() - sweep_start - last_compact_micros_;
 
   if (FLAG_verify_after_gc && !is_concurrent_sweep_running) {
     heap_->VerifyGC("Verifying after sweeping", kForbidMarked);
@@ -1426,12 +1454,14 @@ void PageSpace::SweepNew() {
   heap_->new_space()->add_freed_in_words(free >> kWordSizeLog2);
 }
 
-void PageSpace::SweepLarge() {
+intptr_t PageSpace::SweepLarge() {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "SweepLarge");
 
   GCSweeper sweeper;
+  intptr_t swept = 0;
   MutexLocker ml(&pages_lock_);
   while (sweep_large_ != nullptr) {
+    swept++;
     Page* page = sweep_large_;
     sweep_large_ = page->next();
     page->set_next(nullptr);
@@ -1451,16 +1481,20 @@ void PageSpace::SweepLarge() {
       AddLargePageLocked(page);
     }
   }
+  return swept;
 }
 
-void PageSpace::Sweep(bool exclusive, bool one_page) {
+intptr_t PageSpace::Sweep(bool exclusive,
+                          bool one_page,
+                          intptr_t first_shard) {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "Sweep");
 
   GCSweeper sweeper;
 
-  intptr_t shard = 0;
   const intptr_t num_shards = heap_->new_space()->NumScavengeWorkers();
   ASSERT(num_shards < num_freelists_);
+  intptr_t shard = first_shard % num_shards;
+  intptr_t swept = 0;
   if (exclusive) {
     for (intptr_t i = 0; i < num_shards; i++) {
       DataFreeList(i)->mutex()->Lock();
@@ -1473,6 +1507,7 @@ void PageSpace::Sweep(bool exclusive, bool one_page) {
     sweep_regular_ = page->next();
     page->set_next(nullptr);
     ASSERT(!page->is_executable());
+    swept++;
 
     ml.Unlock();
     // Cycle through the shards round-robin so that free space is roughly
@@ -1508,6 +1543,7 @@ void PageSpace::Sweep(bool exclusive, bool one_page) {
       DataFreeList(i)->mutex()->Unlock();
     }
   }
+  return swept;
 }
 
 void PageSpace::ConcurrentSweep(IsolateGroup* isolate_group) {
@@ -1823,6 +1859,8 @@ void PageSpaceController::RecordUpdate(SpaceUsage before,
                                        SpaceUsage after,
                                        intptr_t growth_in_pages,
                                        const char* reason) {
+  last_growth_in_pages_ = growth_in_pages;
+
   // Save final threshold compared before growing.
   intptr_t threshold =
       after.CombinedUsedInWords() + (Page::kPageSizeInWords * growth_in_pages);
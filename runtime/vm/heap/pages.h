@@ -81,6 +81,18 @@ class PageSpaceController {
 
   void set_last_usage(SpaceUsage current) { last_usage_ = current; }
 
+  intptr_t hard_gc_threshold_in_words() const {
+    return hard_gc_threshold_in_words_;
+  }
+  intptr_t soft_gc_threshold_in_words() const {
+    return soft_gc_threshold_in_words_;
+  }
+  intptr_t idle_gc_threshold_in_words() const {
+    return idle_gc_threshold_in_words_;
+  }
+  // The number of pages the thresholds were last set above the usage.
+  intptr_t last_growth_in_pages() const { return last_growth_in_pages_; }
+
  private:
   friend class PageSpace;  // For MergeOtherPageSpaceController
 
@@ -119,6 +131,8 @@ class PageSpaceController {
   // Run idle GC if time permits when usage exceeds this amount.
   intptr_t idle_gc_threshold_in_words_;
 
+  intptr_t last_growth_in_pages_ = 0;
+
   PageSpaceGarbageCollectionHistory history_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpaceController);
@@ -147,6 +161,10 @@ class PageSpace {
         size, &freelists_[is_executable ? kExecutableFreelist : kDataFreelist],
         is_executable, growth_policy, is_protected, is_locked);
   }
+  // Allocates from the data free lists only, so it never grows old space or
+  // starts a collection. Returns 0 on failure.
+  uword TryAllocateFromFreeLists(intptr_t size);
+
   DART_FORCE_INLINE
   uword TryAllocatePromoLocked(FreeList* freelist, intptr_t size) {
     if (IsAllocatableViaFreeLists(size)) [[likely]] {
@@ -264,6 +282,16 @@ class PageSpace {
 
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
+  // Durations of the stop-the-world phases of the most recent collection.
+  // Sweeping excludes the part done concurrently by the sweeper tasks.
+  int64_t last_mark_micros() const { return last_mark_micros_; }
+  int64_t last_sweep_micros() const { return last_sweep_micros_; }
+  int64_t last_compact_micros() const { return last_compact_micros_; }
+
+  const PageSpaceController& page_space_controller() const {
+    return page_space_controller_;
+  }
+
   int64_t gc_time_micros() const { return gc_time_micros_; }
 
   void IncrementCollections() { collections_++; }
@@ -343,6 +371,26 @@ class PageSpace {
     DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
     concurrent_marker_tasks_active_ = val;
   }
+  intptr_t concurrent_sweeper_tasks() const {
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    return concurrent_sweeper_tasks_;
+  }
+  void set_concurrent_sweeper_tasks(intptr_t val) {
+    ASSERT(val >= 0);
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    concurrent_sweeper_tasks_ = val;
+  }
+  // The number of tasks of the last concurrent sweep that swept at least one
+  // page.
+  intptr_t busy_sweeper_tasks() const {
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    return busy_sweeper_tasks_;
+  }
+  void set_busy_sweeper_tasks(intptr_t val) {
+    ASSERT(val >= 0);
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    busy_sweeper_tasks_ = val;
+  }
   bool pause_concurrent_marking() const {
     return pause_concurrent_marking_.load() != 0;
   }
@@ -428,8 +476,15 @@ class PageSpace {
   void VerifyStoreBuffers(const char* msg);
   void SweepExecutable();
   void SweepNew();
-  void SweepLarge();
-  void Sweep(bool exclusive, bool one_page = false);
+  // Sweeps the large pages and returns how many were swept.
+  intptr_t SweepLarge();
+  // Sweeps regular data pages until none are left, or only one page if
+  // `one_page` is set. Several threads may sweep concurrently, `first_shard`
+  // spreads them over different data freelists. Returns how many pages were
+  // swept.
+  intptr_t Sweep(bool exclusive,
+                 bool one_page = false,
+                 intptr_t first_shard = 0);
   void ConcurrentSweep(IsolateGroup* isolate_group);
   void Compact(Thread* thread);
 
@@ -492,6 +547,8 @@ class PageSpace {
   intptr_t tasks_;
   intptr_t concurrent_marker_tasks_;
   intptr_t concurrent_marker_tasks_active_;
+  intptr_t concurrent_sweeper_tasks_;
+  intptr_t busy_sweeper_tasks_;
   RelaxedAtomic<uword> pause_concurrent_marking_;
   Phase phase_;
 
@@ -505,6 +562,10 @@ class PageSpace {
   intptr_t collections_;
   intptr_t mark_words_per_micro_;
 
+  int64_t last_mark_micros_ = 0;
+  int64_t last_sweep_micros_ = 0;
+  int64_t last_compact_micros_ = 0;
+
   bool enable_concurrent_mark_;
 
   friend class BasePageIterator;
@@ -0,0 +1,63 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/pretenuring.h"
+
+#include "platform/utils.h"
+#include "vm/class_table.h"
+
+namespace dart {
+
+void PretenuringPolicy::Update(ClassTable* class_table,
+                               intptr_t survival_threshold) {
+  const intptr_t num_cids =
+      Utils::Minimum(classes_.length(), class_table->NumCids());
+  for (intptr_t cid = kNumPredefinedCids; cid < num_cids; cid++) {
+    ClassState* state = &classes_[cid];
+    if (state->sampled_words >= kMinSampledWords) {
+      const bool pretenure =
+          (state->survived_words * 100) >=
+          (state->sampled_words * survival_threshold);
+      if (pretenure != class_table->ShouldPretenure(cid)) {
+        class_table->SetPretenure(cid, pretenure);
+        num_pretenured_ += pretenure ? 1 : -1;
+        if (pretenure) {
+          if (state->revisiting) {
+            state->kept_collections = Utils::Minimum(
+                state->kept_collections * 2, kMaxKeptCollections);
+          }
+          state->remaining_collections = state->kept_collections;
+        } else {
+          state->remaining_collections = 0;
+        }
+      }
+      if (!pretenure) {
+        // Instances of the class die young again, start over.
+        state->kept_collections = 1;
+      }
+      state->revisiting = false;
+    }
+    // Age the samples so decisions follow the recent behavior of a class.
+    state->sampled_words >>= 1;
+    state->survived_words >>= 1;
+  }
+}
+
+void PretenuringPolicy::Reset(ClassTable* class_table) {
+  const intptr_t num_cids =
+      Utils::Minimum(classes_.length(), class_table->NumCids());
+  for (intptr_t cid = kNumPredefinedCids; cid < num_cids; cid++) {
+    ClassState* state = &classes_[cid];
+    if ((state->remaining_collections > 0) &&
+        (--state->remaining_collections == 0)) {
+      class_table->SetPretenure(cid, false);
+      num_pretenured_--;
+      state->revisiting = true;
+    }
+    state->sampled_words = 0;
+    state->survived_words = 0;
+  }
+}
+
+}  // namespace dart
@@ -0,0 +1,97 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_PRETENURING_H_
+#define RUNTIME_VM_HEAP_PRETENURING_H_
+
+#if defined(SHOULD_NOT_INCLUDE_RUNTIME)
+#error "Should not include runtime"
+#endif
+
+#include "platform/growable_array.h"
+#include "vm/allocation.h"
+#include "vm/class_id.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class ClassTable;
+
+// Decides which classes have their instances allocated directly in old space.
+//
+// After a scavenge, the scavenger samples some pages of from-space and reports
+// the size of each object and whether it survived. A class is pretenured when
+// enough of its sampled instances survive. Its bit in the class table then
+// makes the allocation stubs allocate instances directly in old space (see
+// DLRT_AllocatePretenured), and the runtime allocate them in old space when
+// it is called instead (see Heap::SpaceForAllocation). Pretenured objects
+// are never copied by the scavenger.
+//
+// Only user-defined classes are pretenured. Decisions are per class rather
+// than per allocation site, and the core classes (arrays, maps, sets, strings,
+// typed data, ...) are allocated from too many sites with different lifetimes
+// for a single decision to fit all of them.
+//
+// Pretenured instances no longer show up in new space, so a decision is
+// revisited by dropping it after an old-space collection. A class which is
+// pretenured again right afterwards keeps its next decision for twice as many
+// old-space collections, so long-lived classes are not repeatedly moved back
+// to new space.
+//
+// Only used by the thread owning the GC safepoint.
+class PretenuringPolicy {
+ public:
+  PretenuringPolicy() {}
+
+  // Whether instances of `cid` may be pretenured. Other classes never are,
+  // since their bit would only slow down their allocation.
+  static bool CanPretenure(intptr_t cid) { return cid >= kNumPredefinedCids; }
+
+  void RecordSample(intptr_t cid, intptr_t size, bool survived) {
+    if (cid >= classes_.length()) {
+      classes_.EnsureLength(cid + 1, ClassState());
+    }
+    classes_[cid].sampled_words += size >> kWordSizeLog2;
+    if (survived) {
+      classes_[cid].survived_words += size >> kWordSizeLog2;
+    }
+  }
+
+  // Pretenures the classes whose samples survive at least
+  // `survival_threshold` percent of the time, and ages all samples.
+  void Update(ClassTable* class_table, intptr_t survival_threshold);
+
+  // Called after an old-space collection. Drops the decisions which are due
+  // to be revisited, and all samples.
+  void Reset(ClassTable* class_table);
+
+  intptr_t num_pretenured() const { return num_pretenured_; }
+
+ private:
+  // Classes with fewer sampled words are not considered.
+  static constexpr intptr_t kMinSampledWords = 16 * KBInWords;
+  // Upper bound on the number of old-space collections a decision is kept.
+  static constexpr intptr_t kMaxKeptCollections = 64;
+
+  struct ClassState {
+    intptr_t sampled_words = 0;
+    intptr_t survived_words = 0;
+    // Number of old-space collections the next decision to pretenure the
+    // class is kept, and how many of them are left for the current one (0 if
+    // the class is not pretenured).
+    intptr_t kept_collections = 1;
+    intptr_t remaining_collections = 0;
+    // Whether the last decision was dropped by an old-space collection.
+    bool revisiting = false;
+  };
+
+  MallocGrowableArray<ClassState> classes_;
+  intptr_t num_pretenured_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(PretenuringPolicy);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_PRETENURING_H_
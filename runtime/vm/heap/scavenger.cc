@@ -47,6 +47,19 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(bool,
+            pretenuring,
+            false,
+            "Allocate instances of user-defined classes that mostly survive "
+            "scavenges directly in old space. Only the x64 and arm64 "
+            "allocation stubs do so, other architectures call the runtime. "
+            "In product mode, snapshots containing code must be created with "
+            "the same setting.");
+DEFINE_FLAG(int,
+            pretenuring_survival_threshold,
+            85,
+            "Pretenure a class when at least this percentage of its sampled "
+            "new-space instances survive a scavenge.");
 
 // Scavenger uses the kCardRememberedBit to distinguish forwarded and
 // non-forwarded objects. We must choose a bit that is clear for all new-space
@@ -1915,6 +1928,10 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   }
   ASSERT(promotion_stack_.IsEmpty());
 
+  if (FLAG_pretenuring && !abort_) {
+    SamplePretenuring(from);
+  }
+
   // Scavenge finished. Run accounting.
   int64_t end = OS::GetCurrentMonotonicMicros();
   stats_history_.Add(ScavengeStats(
@@ -1968,6 +1985,50 @@ intptr_t Scavenger::NumDataFreelists() {
   }
 }
 
+// Number of from-space pages whose objects are sampled after each scavenge.
+static constexpr intptr_t kPretenuringSampledPages = 2;
+
+void Scavenger::SamplePretenuring(SemiSpace* from) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "SamplePretenuring");
+
+  // Spread the sampled pages over the whole semi-space.
+  intptr_t num_pages = 0;
+  for (Page* page = from->head(); page != nullptr; page = page->next()) {
+    num_pages++;
+  }
+  const intptr_t stride =
+      Utils::Maximum<intptr_t>(1, num_pages / kPretenuringSampledPages);
+
+  intptr_t index = 0;
+  for (Page* page = from->head(); page != nullptr; page = page->next()) {
+    if ((index++ % stride) != 0) continue;
+    uword addr = page->object_start();
+    const uword end = page->object_end();
+    while (addr < end) {
+      ObjectPtr obj = UntaggedObject::FromAddr(addr);
+      const uword header = ReadHeaderRelaxed(obj);
+      // The header of a survivor is replaced by the address of its copy.
+      const bool survived = IsForwarding(header);
+      if (survived) {
+        obj = ForwardedObj(header);
+      }
+      const intptr_t cid = obj->GetClassId();
+      const intptr_t size = obj->untag()->HeapSize();
+      if (PretenuringPolicy::CanPretenure(cid)) {
+        pretenuring_policy_.RecordSample(cid, size, survived);
+      }
+      addr += size;
+    }
+  }
+
+  pretenuring_policy_.Update(heap_->isolate_group()->class_table(),
+                             FLAG_pretenuring_survival_threshold);
+}
+
+void Scavenger::ResetPretenuring() {
+  pretenuring_policy_.Reset(heap_->isolate_group()->class_table());
+}
+
 void Scavenger::ReverseScavenge(SemiSpace** from) {
   Thread* thread = Thread::Current();
   TIMELINE_FUNCTION_GC_DURATION(thread, "ReverseScavenge");
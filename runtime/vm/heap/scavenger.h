@@ -12,6 +12,7 @@
 #include "vm/flags.h"
 #include "vm/globals.h"
 #include "vm/heap/page.h"
+#include "vm/heap/pretenuring.h"
 #include "vm/heap/spaces.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
@@ -109,6 +110,10 @@ class ScavengeStats {
   }
 
   intptr_t UsedBeforeInWords() const { return before_.used_in_words; }
+  intptr_t promo_candidates_in_words() const {
+    return promo_candidates_in_words_;
+  }
+  intptr_t promoted_in_words() const { return promoted_in_words_; }
 
   int64_t DurationMicros() const { return end_micros_ - start_micros_; }
 
@@ -176,6 +181,11 @@ class Scavenger {
   }
   intptr_t ThresholdInWords() const { return to_->gc_threshold_in_words(); }
 
+  // The stats of the most recent scavenge, or nullptr before the first one.
+  const ScavengeStats* last_stats() const {
+    return stats_history_.Size() > 0 ? &stats_history_.Get(0) : nullptr;
+  }
+
   void VisitObjects(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
@@ -193,6 +203,13 @@ class Scavenger {
 
   intptr_t collections() const { return collections_; }
 
+  const PretenuringPolicy& pretenuring_policy() const {
+    return pretenuring_policy_;
+  }
+
+  // Called after old-space collections, see PretenuringPolicy.
+  void ResetPretenuring();
+
 #ifndef PRODUCT
   void PrintToJSONObject(JSONObject* object) const;
 #endif  // !PRODUCT
@@ -287,6 +304,7 @@ class Scavenger {
   void MournWeakHandles();
   void MournWeakTables();
   void Epilogue(SemiSpace* from);
+  void SamplePretenuring(SemiSpace* from);
 
   void VerifyStoreBuffers(const char* msg);
 
@@ -315,6 +333,8 @@ class Scavenger {
   static constexpr int kStatsHistoryCapacity = 4;
   RingBuffer<ScavengeStats, kStatsHistoryCapacity> stats_history_;
 
+  PretenuringPolicy pretenuring_policy_;
+
   intptr_t scavenge_words_per_micro_;
   intptr_t idle_scavenge_threshold_in_words_ = 0;
 
@@ -164,35 +164,37 @@ intptr_t GCSweeper::SweepLargePage(Page* page) {
   return words_to_end;
 }
 
+// One of several tasks sweeping old space concurrently with the mutator. The
+// first task sweeps the large pages and then helps with the regular pages,
+// the others start sweeping regular pages right away. Pages are claimed one
+// at a time from the shared sweep lists, so the tasks balance themselves.
 class ConcurrentSweeperTask : public ThreadPool::Task {
  public:
-  explicit ConcurrentSweeperTask(IsolateGroup* isolate_group)
-      : isolate_group_(isolate_group) {
+  ConcurrentSweeperTask(IsolateGroup* isolate_group, intptr_t task_index)
+      : isolate_group_(isolate_group), task_index_(task_index) {
     ASSERT(isolate_group != nullptr);
-    PageSpace* old_space = isolate_group->heap()->old_space();
-    MonitorLocker ml(old_space->tasks_lock());
-    old_space->set_tasks(old_space->tasks() + 1);
-    old_space->set_phase(PageSpace::kSweepingLarge);
   }
 
   virtual void Run() {
     Thread::EnterIsolateGroupAsNonMutator(isolate_group_, Thread::kSweeperTask);
     PageSpace* old_space = isolate_group_->heap()->old_space();
+    intptr_t swept = 0;
     {
       Thread* thread = Thread::Current();
       ASSERT(thread->BypassSafepoints());  // Or we should be checking in.
       TIMELINE_FUNCTION_GC_DURATION(thread, "ConcurrentSweep");
 
-      old_space->SweepLarge();
+      if (task_index_ == 0) {
+        swept += old_space->SweepLarge();
 
-      {
         MonitorLocker ml(old_space->tasks_lock());
         ASSERT(old_space->phase() == PageSpace::kSweepingLarge);
         old_space->set_phase(PageSpace::kSweepingRegular);
         ml.NotifyAll();
       }
 
-      old_space->Sweep(/*exclusive*/ false);
+      swept += old_space->Sweep(/*exclusive*/ false, /*one_page*/ false,
+                                task_index_);
     }
     // Exit isolate cleanly *before* notifying it, to avoid shutdown race.
     Thread::ExitIsolateGroupAsNonMutator();
@@ -200,19 +202,43 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
     {
       MonitorLocker ml(old_space->tasks_lock());
       old_space->set_tasks(old_space->tasks() - 1);
-      ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
-      old_space->set_phase(PageSpace::kDone);
+      if (swept > 0) {
+        old_space->set_busy_sweeper_tasks(old_space->busy_sweeper_tasks() + 1);
+      }
+      const intptr_t remaining = old_space->concurrent_sweeper_tasks() - 1;
+      old_space->set_concurrent_sweeper_tasks(remaining);
+      if (remaining == 0) {
+        // The first task only starts on the regular pages after it is done
+        // with the large pages, so they are all swept now.
+        ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
+        old_space->set_phase(PageSpace::kDone);
+      }
       ml.NotifyAll();
     }
   }
 
  private:
   IsolateGroup* isolate_group_;
+  intptr_t task_index_;
 };
 
 void GCSweeper::SweepConcurrent(IsolateGroup* isolate_group) {
-  bool result = Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group);
-  ASSERT(result);
+  const intptr_t num_tasks = FLAG_sweeper_tasks;
+  ASSERT(num_tasks > 0);
+  PageSpace* old_space = isolate_group->heap()->old_space();
+  {
+    MonitorLocker ml(old_space->tasks_lock());
+    ASSERT(old_space->concurrent_sweeper_tasks() == 0);
+    old_space->set_tasks(old_space->tasks() + num_tasks);
+    old_space->set_concurrent_sweeper_tasks(num_tasks);
+    old_space->set_busy_sweeper_tasks(0);
+    old_space->set_phase(PageSpace::kSweepingLarge);
+  }
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    bool result =
+        Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group, i);
+    ASSERT(result);
+  }
 }
 
 }  // namespace dart
@@ -16,6 +16,7 @@
 #include "vm/class_finalizer.h"
 #include "vm/code_observers.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/dart_api_impl.h"
 #include "vm/dart_api_message.h"
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
@@ -57,6 +58,7 @@
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/compiler/assembler/assembler.h"
+#include "vm/compiler/compiler_feedback.h"
 #include "vm/compiler/stub_code_compiler.h"
 #endif
 
@@ -76,6 +78,10 @@ DECLARE_FLAG(bool, reload_every_back_off);
 DECLARE_FLAG(bool, trace_reload);
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+DECLARE_FLAG(charp, write_compiler_feedback_to);
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 static void DeterministicModeHandler(bool value) {
   if (value) {
     FLAG_background_compilation = false;  // Timing dependent.
@@ -97,6 +103,12 @@ DEFINE_FLAG(bool,
             "Disables the limit of the thread pool (simulates custom embedder "
             "with custom message handler on unlimited number of threads).");
 
+DEFINE_FLAG(int,
+            isolate_pool_size,
+            0,
+            "Number of idle isolates each isolate group keeps ready for "
+            "lightweight spawns.");
+
 // Quick access to the locally defined thread() and isolate() methods.
 #define T (thread())
 #define I (isolate())
@@ -399,6 +411,7 @@ IsolateGroup::~IsolateGroup() {
 
   // Ensure we destroy the heap before the other members.
   heap_ = nullptr;
+  ASSERT(idle_isolates_.is_empty());
   ASSERT(old_marking_stack_ == nullptr);
   ASSERT(new_marking_stack_ == nullptr);
   ASSERT(deferred_marking_stack_ == nullptr);
@@ -450,10 +463,23 @@ void IsolateGroup::UnregisterIsolate(Isolate* isolate) {
   }
 }
 
-bool IsolateGroup::UnregisterIsolateDecrementCount() {
+bool IsolateGroup::UnregisterIsolateDecrementCount(
+    MallocGrowableArray<Isolate*>* unused_idle_isolates) {
   SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
   isolate_count_--;
-  return isolate_count_ == 0;
+  if (isolate_count_ == 0) {
+    return true;
+  }
+  // Idle isolates are only added by spawns, which keep their spawning isolate
+  // alive until they are done. So if every isolate still counted is idle
+  // nobody can take them anymore.
+  MutexLocker ml2(&idle_isolates_mutex_);
+  if (isolate_count_ == idle_isolates_.length()) {
+    while (!idle_isolates_.is_empty()) {
+      unused_idle_isolates->Add(idle_isolates_.RemoveLast());
+    }
+  }
+  return false;
 }
 
 void IsolateGroup::IncrementIsolateGroupMutatorCount() {
@@ -1862,6 +1888,11 @@ Isolate::~Isolate() {
 
   free(name_);
   delete field_table_;
+  for (MessageStream* stream : message_streams_) {
+    if (stream != nullptr) {
+      stream->Release();
+    }
+  }
   delete message_handler_;
   message_handler_ =
       nullptr;  // Fail fast if we send messages to a dead isolate.
@@ -2442,6 +2473,89 @@ static void ShutdownIsolate(uword parameter) {
   Dart_ShutdownIsolate();
 }
 
+Isolate* IsolateGroup::TakeIdleIsolate() {
+  MutexLocker ml(&idle_isolates_mutex_);
+  if (idle_isolates_.is_empty()) {
+    return nullptr;
+  }
+  return idle_isolates_.RemoveLast();
+}
+
+intptr_t IsolateGroup::ReserveIdleIsolates() {
+  if (is_system_isolate_group()) {
+    return 0;
+  }
+  MutexLocker ml(&idle_isolates_mutex_);
+  const intptr_t needed = FLAG_isolate_pool_size - idle_isolates_.length() -
+                          pending_idle_isolates_;
+  if (needed <= 0) {
+    return 0;
+  }
+  pending_idle_isolates_ += needed;
+  return needed;
+}
+
+void IsolateGroup::AddIdleIsolate(Isolate* isolate) {
+  {
+    MutexLocker ml(&idle_isolates_mutex_);
+    ASSERT(pending_idle_isolates_ > 0);
+    pending_idle_isolates_--;
+    if (isolate == nullptr) {
+      return;
+    }
+    if (!idle_isolates_closed_) {
+      idle_isolates_.Add(isolate);
+      return;
+    }
+  }
+  // The VM is shutting down and nobody will take the isolate anymore.
+  ShutdownIsolate(reinterpret_cast<uword>(isolate));
+}
+
+void IsolateGroup::FillIdleIsolates() {
+  ASSERT(Isolate::Current() == nullptr);
+  auto initialize_callback = Isolate::InitializeCallback();
+  if (initialize_callback == nullptr) {
+    return;
+  }
+  for (intptr_t i = ReserveIdleIsolates(); i > 0; i--) {
+    char* error = nullptr;
+    Isolate* isolate =
+        CreateWithinExistingIsolateGroup(this, /*name=*/nullptr, &error);
+    if (isolate == nullptr) {
+      free(error);
+      AddIdleIsolate(nullptr);
+      continue;
+    }
+    void* isolate_data = nullptr;
+    if (!initialize_callback(&isolate_data, &error)) {
+      free(error);
+      Dart_ShutdownIsolate();
+      AddIdleIsolate(nullptr);
+      continue;
+    }
+    isolate->set_init_callback_data(isolate_data);
+    Dart_ExitIsolate();
+    AddIdleIsolate(isolate);
+  }
+}
+
+void IsolateGroup::ShutdownIdleIsolates() {
+  MallocGrowableArray<Isolate*> idle_isolates;
+  ForEach([&](IsolateGroup* group) {
+    MutexLocker ml(&group->idle_isolates_mutex_);
+    group->idle_isolates_closed_ = true;
+    while (!group->idle_isolates_.is_empty()) {
+      idle_isolates.Add(group->idle_isolates_.RemoveLast());
+    }
+  });
+  // Shutting down the last isolate of a group deletes the group, so this
+  // can't be done while iterating over the groups.
+  for (intptr_t i = 0; i < idle_isolates.length(); i++) {
+    ShutdownIsolate(reinterpret_cast<uword>(idle_isolates[i]));
+  }
+}
+
 void Isolate::SetStickyError(ErrorPtr sticky_error) {
   ASSERT(
       ((sticky_error_ == Error::null()) || (sticky_error == Error::null())) &&
@@ -2458,6 +2572,26 @@ MessageHandler* Isolate::message_handler() const {
   return message_handler_;
 }
 
+MessageStream* Isolate::GetMessageStream(Dart_Port dest_port) {
+  if (dest_port == ILLEGAL_PORT) {
+    return nullptr;
+  }
+  for (MessageStream* stream : message_streams_) {
+    if ((stream != nullptr) && (stream->dest_port() == dest_port)) {
+      return stream;
+    }
+  }
+  // Replace the oldest stream. Messages written with it keep it alive until
+  // they have been received.
+  MessageStream*& slot = message_streams_[next_message_stream_];
+  next_message_stream_ = (next_message_stream_ + 1) % kMaxMessageStreams;
+  if (slot != nullptr) {
+    slot->Release();
+  }
+  slot = new MessageStream(dest_port);
+  return slot;
+}
+
 void Isolate::RunAndCleanupFinalizersOnShutdown() {
   if (finalizers_ == GrowableObjectArray::null()) return;
 
@@ -2604,6 +2738,14 @@ void Isolate::Shutdown() {
 #endif
   }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if ((FLAG_write_compiler_feedback_to != nullptr) && is_runnable() &&
+      !Isolate::IsSystemIsolate(this)) {
+    StackZone zone(thread);
+    CompilerFeedback::Write(thread, FLAG_write_compiler_feedback_to);
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 #if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
   if (FLAG_check_reloaded && is_runnable() && !Isolate::IsSystemIsolate(this)) {
     if (!group()->HasAttemptedReload()) {
@@ -2654,6 +2796,7 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
   IsolateGroup* isolate_group = isolate->isolate_group_;
   Dart_IsolateCleanupCallback cleanup = isolate->on_cleanup_callback();
   auto callback_data = isolate->init_callback_data_;
+  const bool has_exited = isolate->has_exited();
 
   // From this point on the isolate is no longer visited by GC (which is ok,
   // since we're just going to delete it anyway).
@@ -2672,7 +2815,16 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
     cleanup(isolate_group->embedder_data(), callback_data);
   }
 
-  const bool shutdown_group = isolate_group->UnregisterIsolateDecrementCount();
+  // An isolate that left through `Isolate.exit` has already sent its final
+  // message, so its thread is free to put a fresh isolate into the pool in
+  // its place. It still counts towards the group, keeping the group alive.
+  if (has_exited) {
+    isolate_group->FillIdleIsolates();
+  }
+
+  MallocGrowableArray<Isolate*> unused_idle_isolates;
+  const bool shutdown_group =
+      isolate_group->UnregisterIsolateDecrementCount(&unused_idle_isolates);
   if (shutdown_group) {
     KernelIsolate::NotifyAboutIsolateGroupShutdown(isolate_group);
 #if defined(DART_INCLUDE_PROFILER)
@@ -2727,6 +2879,11 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
     // TODO(dartbug.com/36097): An isolate just died. A significant amount of
     // memory might have become unreachable. We should evaluate how to best
     // inform the GC about this situation.
+
+    // Shutting down the last idle isolate shuts down the group.
+    for (intptr_t i = 0; i < unused_idle_isolates.length(); i++) {
+      ShutdownIsolate(reinterpret_cast<uword>(unused_idle_isolates[i]));
+    }
   }
 }
 
@@ -63,6 +63,7 @@ class IsolateProfilerData;
 class Log;
 class Message;
 class MessageHandler;
+class MessageStream;
 class Mutex;
 class Object;
 class ObjectIdRing;
@@ -373,11 +374,34 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   void UnregisterIsolate(Isolate* isolate);
   // Returns `true` if this was the last isolate and the caller is responsible
   // for deleting the isolate group.
-  bool UnregisterIsolateDecrementCount();
+  //
+  // If only idle isolates are left they are moved to [unused_idle_isolates]
+  // and the caller is responsible for shutting them down, as they would
+  // otherwise keep the group alive forever.
+  bool UnregisterIsolateDecrementCount(
+      MallocGrowableArray<Isolate*>* unused_idle_isolates);
   void IncrementIsolateGroupMutatorCount();
   void DecrementIsolateGroupMutatorCount();
   bool ContainsOnlyOneIsolate();
   void RegisterIsolateGroupMutator(Thread* mutator);
+
+  // Idle isolates are created and initialized by the embedder ahead of time
+  // (see --isolate-pool-size) but have not started their message loop. A
+  // lightweight spawn takes one instead of creating a new isolate.
+  //
+  // Returns `nullptr` if the pool is empty.
+  Isolate* TakeIdleIsolate();
+  // Returns the number of idle isolates the caller should create to top up
+  // the pool. Every one of them has to be handed to [AddIdleIsolate].
+  intptr_t ReserveIdleIsolates();
+  // [isolate] is `nullptr` if creating a reserved idle isolate failed.
+  void AddIdleIsolate(Isolate* isolate);
+  // Creates and initializes isolates until the pool is full. The caller must
+  // keep the group alive meanwhile.
+  void FillIdleIsolates();
+  // Shuts down the idle isolates of all groups on VM shutdown. They never
+  // start their message loop, so they don't handle kill messages.
+  static void ShutdownIdleIsolates();
   void UnregisterIsolateGroupMutator(Thread* mutator);
 
   Dart_Port interrupt_port() { return interrupt_port_; }
@@ -919,6 +943,11 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   IntrusiveDList<Isolate> isolates_;
   RelaxedAtomic<Dart_Port> interrupt_port_ = ILLEGAL_PORT;
   intptr_t isolate_count_ = 0;
+  Mutex idle_isolates_mutex_;
+  MallocGrowableArray<Isolate*> idle_isolates_;
+  intptr_t pending_idle_isolates_ = 0;
+  // Set once the VM shuts down, after which idle isolates aren't pooled.
+  bool idle_isolates_closed_ = false;
   IntrusiveDList<Thread> mutators_;
   intptr_t group_mutator_count_ = 0;
   bool initial_spawn_successful_ = false;
@@ -1134,6 +1163,10 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
     bequest_ = std::move(bequest);
   }
 
+  // Whether the isolate is shutting down because it called `Isolate.exit`.
+  bool has_exited() const { return isolate_flags_.Read<HasExitedBit>(); }
+  void set_has_exited() { isolate_flags_.UpdateBool<HasExitedBit>(true); }
+
   IsolateGroupSource* source() const { return isolate_group_->source(); }
   IsolateGroup* group() const { return isolate_group_; }
 
@@ -1193,6 +1226,11 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
 
   MessageHandler* message_handler() const;
 
+  // Returns the stream for snapshot messages this isolate sends to
+  // [dest_port], or nullptr if they are written without one. Only the most
+  // recently used ports have a stream.
+  MessageStream* GetMessageStream(Dart_Port dest_port);
+
   bool is_runnable() const { return isolate_flags_.Read<IsRunnableBit>(); }
   void set_is_runnable(bool value) {
     isolate_flags_.UpdateBool<IsRunnableBit>(value);
@@ -1622,7 +1660,8 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
   V(HasAttemptedStepping)                                                      \
   V(ShouldPausePostServiceRequest)                                             \
   V(IsSystemIsolate)                                                           \
-  V(IsServiceRegistered)
+  V(IsServiceRegistered)                                                       \
+  V(HasExited)
 
   // Isolate specific flags.
   enum FlagBits {
@@ -1707,6 +1746,9 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
   Dart_EnvironmentCallback environment_callback_ = nullptr;
   Mutex mutex_;  // Protects compiler stats.
   IsolateMessageHandler* message_handler_ = nullptr;
+  static constexpr intptr_t kMaxMessageStreams = 8;
+  MessageStream* message_streams_[kMaxMessageStreams] = {};
+  intptr_t next_message_stream_ = 0;
   intptr_t defer_finalization_count_ = 0;
   FfiCallbackMetadata::MetadataEntry* ffi_callback_list_head_ = nullptr;
   intptr_t ffi_callback_keep_alive_counter_ = 0;
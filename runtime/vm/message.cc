@@ -8,6 +8,7 @@
 
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
+#include "vm/message_snapshot.h"
 #include "vm/object.h"
 #include "vm/port.h"
 
@@ -57,6 +58,9 @@ Message::~Message() {
     free(payload_.snapshot_);
   }
   delete finalizable_data_;
+  if (stream_ != nullptr) {
+    stream_->Release();
+  }
   if (IsPersistentHandle() || IsFinalizerInvocationRequest()) {
     auto isolate_group = IsolateGroup::Current();
     isolate_group->api_state()->FreePersistentHandle(
@@ -64,6 +68,13 @@ Message::~Message() {
   }
 }
 
+void Message::set_stream(MessageStream* stream) {
+  ASSERT(IsSnapshot());
+  ASSERT(stream_ == nullptr);
+  stream->Retain();
+  stream_ = stream;
+}
+
 MessageQueue::MessageQueue() {
   head_ = nullptr;
   tail_ = nullptr;
@@ -178,4 +189,72 @@ intptr_t MessageQueue::Length() const {
   return length;
 }
 
+ConcurrentMessageQueue::~ConcurrentMessageQueue() {
+  std::unique_ptr<Message> cur(head_.exchange(nullptr));
+  while (cur != nullptr) {
+    std::unique_ptr<Message> next(cur->next_);
+    cur = std::move(next);
+  }
+}
+
+void ConcurrentMessageQueue::Push(std::unique_ptr<Message> msg0) {
+  Message* msg = msg0.release();
+  // Make sure messages are not reused.
+  ASSERT(msg->next_ == nullptr);
+  Message* head = head_.load(std::memory_order_relaxed);
+  do {
+    msg->next_ = head;
+  } while (!head_.compare_exchange_weak(head, msg, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed));
+}
+
+intptr_t ConcurrentMessageQueue::PushAll(MessageQueue* messages) {
+  Message* oldest = messages->head_;
+  if (oldest == nullptr) {
+    return 0;
+  }
+  messages->head_ = nullptr;
+  messages->tail_ = nullptr;
+  // Link the messages from the newest to the oldest, like separate pushes.
+  Message* newest = nullptr;
+  intptr_t count = 0;
+  for (Message* cur = oldest; cur != nullptr; count++) {
+    Message* next = cur->next_;
+    cur->next_ = newest;
+    newest = cur;
+    cur = next;
+  }
+  Message* head = head_.load(std::memory_order_relaxed);
+  do {
+    oldest->next_ = head;
+  } while (!head_.compare_exchange_weak(head, newest, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed));
+  return count;
+}
+
+intptr_t ConcurrentMessageQueue::DrainTo(MessageQueue* queue) {
+  // Messages are only ever taken all at once, so pushes never race with
+  // the removal of a single message.
+  Message* pushed = head_.exchange(nullptr);
+  if (pushed == nullptr) {
+    return 0;
+  }
+  Message* oldest = nullptr;
+  while (pushed != nullptr) {
+    Message* next = pushed->next_;
+    pushed->next_ = oldest;
+    oldest = pushed;
+    pushed = next;
+  }
+  intptr_t count = 0;
+  while (oldest != nullptr) {
+    Message* next = oldest->next_;
+    oldest->next_ = nullptr;
+    queue->Enqueue(std::unique_ptr<Message>(oldest), /*before_events=*/false);
+    oldest = next;
+    count++;
+  }
+  return count;
+}
+
 }  // namespace dart
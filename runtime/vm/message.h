@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_H_
 #define RUNTIME_VM_MESSAGE_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -19,6 +20,7 @@ typedef int64_t Dart_Port;
 
 namespace dart {
 
+class MessageStream;
 class PersistentHandle;
 
 class Message {
@@ -82,6 +84,11 @@ class Message {
 
   MessageFinalizableData* finalizable_data() { return finalizable_data_; }
 
+  // The stream whose tables a snapshot message refers to, if any. The message
+  // keeps the stream alive until it is destroyed.
+  MessageStream* stream() const { return stream_; }
+  void set_stream(MessageStream* stream);
+
   intptr_t Size() const {
     intptr_t size = snapshot_length_;
     if (finalizable_data_ != nullptr) {
@@ -130,6 +137,7 @@ class Message {
   static intptr_t const kFinalizerSnapshotLen = -2;
 
   friend class MessageQueue;
+  friend class ConcurrentMessageQueue;
 
   Message* next_ = nullptr;
   Dart_Port dest_port_;
@@ -145,6 +153,7 @@ class Message {
   } payload_;
   intptr_t snapshot_length_ = 0;
   MessageFinalizableData* finalizable_data_ = nullptr;
+  MessageStream* stream_ = nullptr;
   Priority priority_;
 
   DISALLOW_COPY_AND_ASSIGN(Message);
@@ -188,12 +197,45 @@ class MessageQueue {
   intptr_t Length() const;
 
  private:
+  friend class ConcurrentMessageQueue;
+
   Message* head_;
   Message* tail_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
 
+// A queue of messages which any number of threads can append to without
+// locking, while one thread at a time moves them to a MessageQueue.
+//
+// Messages pushed by the same thread are drained in the order they were
+// pushed.
+class ConcurrentMessageQueue {
+ public:
+  ConcurrentMessageQueue() {}
+  ~ConcurrentMessageQueue();
+
+  void Push(std::unique_ptr<Message> msg);
+
+  // Moves all messages from [messages] with a single atomic update, so they
+  // are drained in order and without messages from other threads in between.
+  // Returns the number of messages moved.
+  intptr_t PushAll(MessageQueue* messages);
+
+  // Appends all pushed messages to [queue] in the order they were pushed.
+  // Calls must be serialized by the caller. Returns the number of messages
+  // moved.
+  intptr_t DrainTo(MessageQueue* queue);
+
+  bool IsEmpty() const { return head_.load() == nullptr; }
+
+ private:
+  // The most recently pushed message, linked to the earlier ones.
+  std::atomic<Message*> head_ = {nullptr};
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageQueue);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_MESSAGE_H_
@@ -20,6 +20,19 @@ namespace dart {
 
 DECLARE_FLAG(bool, trace_service_pause_events);
 
+DEFINE_FLAG(int,
+            message_slice_micros,
+            0,
+            "Time after which an isolate running on a thread pool gives up "
+            "its thread to other tasks if it still has messages to handle "
+            "(0 means no limit).");
+DEFINE_FLAG(int,
+            message_slice_messages,
+            0,
+            "Number of messages after which an isolate running on a thread "
+            "pool gives up its thread to other tasks if it still has "
+            "messages to handle (0 means no limit).");
+
 class MessageHandlerTask : public ThreadPool::Task {
  public:
   explicit MessageHandlerTask(MessageHandler* handler) : handler_(handler) {
@@ -67,7 +80,13 @@ MessageHandler::MessageHandler()
       task_running_(false),
       pool_(nullptr),
       end_callback_(nullptr),
-      callback_data_(0) {
+      callback_data_(0),
+      latency_critical_(false),
+      task_scheduled_micros_(0),
+      num_slices_(0),
+      num_yields_(0),
+      total_wait_micros_(0),
+      max_wait_micros_(0) {
   ASSERT(queue_ != nullptr);
   ASSERT(oob_queue_ != nullptr);
 }
@@ -104,7 +123,7 @@ bool MessageHandler::Run(ThreadPool* pool,
   end_callback_ = end_callback;
   callback_data_ = data;
   task_running_ = true;
-  bool result = pool_->Run<MessageHandlerTask>(this);
+  bool result = StartTaskLocked(pool, /*yield=*/false);
   if (!result) {
     pool_ = nullptr;
     end_callback_ = nullptr;
@@ -122,7 +141,16 @@ void MessageHandler::RunSync() {
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
+  const Message::Priority saved_priority = message->priority();
+
+  // Normal messages don't need the monitor, unless a task has to be started
+  // to handle them.
+  if (!message->IsOOB() && !before_events && !FLAG_trace_isolates) {
+    inbox_.Push(std::move(message));
+    StartTaskForInbox();
+    MessageNotify(saved_priority);
+    return;
+  }
 
   {
     MonitorLocker ml(&monitor_);
@@ -147,16 +175,18 @@ void MessageHandler::PostMessage(std::unique_ptr<Message> message,
       }
     }
 
-    saved_priority = message->priority();
     if (message->IsOOB()) {
       oob_queue_->Enqueue(std::move(message), before_events);
     } else {
+      // Keep the order with the messages posted without the monitor.
+      DrainInboxLocked();
       queue_->Enqueue(std::move(message), before_events);
     }
 
     if (pool_ != nullptr && !task_running_) {
       task_running_ = true;
-      const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
+      const bool launched_successfully =
+          StartTaskLocked(pool_, /*yield=*/false);
       ASSERT(launched_successfully);
     }
   }
@@ -165,16 +195,79 @@ void MessageHandler::PostMessage(std::unique_ptr<Message> message,
   MessageNotify(saved_priority);
 }
 
+void MessageHandler::PostMessages(MessageQueue* messages) {
+  bool all_normal = true;
+  MessageQueue::Iterator it(messages);
+  while (it.HasNext()) {
+    if (it.Next()->IsOOB()) {
+      all_normal = false;
+      break;
+    }
+  }
+  if (!all_normal || FLAG_trace_isolates) {
+    PortHandler::PostMessages(messages);
+    return;
+  }
+  if (inbox_.PushAll(messages) > 0) {
+    StartTaskForInbox();
+    MessageNotify(Message::kNormalPriority);
+  }
+}
+
+void MessageHandler::StartTaskForInbox() {
+  // Pairs with EndTaskLocked: either the task sees the pushed messages, or we
+  // see that the task has ended.
+  if (!task_running_ && (pool_ != nullptr)) {
+    MonitorLocker ml(&monitor_);
+    if (pool_ != nullptr && !task_running_) {
+      task_running_ = true;
+      const bool launched_successfully =
+          StartTaskLocked(pool_, /*yield=*/false);
+      ASSERT(launched_successfully);
+    }
+  }
+}
+
+bool MessageHandler::StartTaskLocked(ThreadPool* pool, bool yield) {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  ASSERT(task_running_);
+  task_scheduled_micros_ = OS::GetCurrentMonotonicMicros();
+  if (latency_critical_ || yield) {
+    return pool->RunShared<MessageHandlerTask>(/*urgent=*/latency_critical_,
+                                               this);
+  }
+  return pool->Run<MessageHandlerTask>(this);
+}
+
 std::unique_ptr<Message> MessageHandler::DequeueMessage(
     Message::Priority min_priority) {
   ASSERT(monitor_.IsOwnedByCurrentThread());
   std::unique_ptr<Message> message = oob_queue_->Dequeue();
   if ((message == nullptr) && (min_priority < Message::kOOBPriority)) {
     message = queue_->Dequeue();
+    if (message == nullptr && inbox_.DrainTo(queue_) > 0) {
+      message = queue_->Dequeue();
+    }
   }
   return message;
 }
 
+void MessageHandler::EndTaskLocked() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  ASSERT(task_running_);
+  // Messages already posted are handled by the next task, if any, like
+  // messages which could not be handled by this one.
+  DrainInboxLocked();
+  task_running_ = false;
+  if (!inbox_.IsEmpty() && (pool_ != nullptr)) {
+    // A message was posted after the drain, but possibly before its poster
+    // could see that task_running_ was cleared.
+    task_running_ = true;
+    const bool launched_successfully = StartTaskLocked(pool_, /*yield=*/false);
+    ASSERT(launched_successfully);
+  }
+}
+
 void MessageHandler::ClearOOBQueue() {
   oob_queue_->Clear();
 }
@@ -182,7 +275,8 @@ void MessageHandler::ClearOOBQueue() {
 MessageHandler::MessageStatus MessageHandler::HandleMessages(
     MonitorLocker* ml,
     bool allow_normal_messages,
-    bool allow_multiple_normal_messages) {
+    bool allow_multiple_normal_messages,
+    bool* slice_expired) {
   ASSERT(monitor_.IsOwnedByCurrentThread());
 
   // Scheduling of the mutator thread during the isolate start can cause this
@@ -199,6 +293,19 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
   auto idle_time_handler =
       isolate() != nullptr ? isolate()->group()->idle_time_handler() : nullptr;
 
+  // Only handlers running on a pool can give up their thread and continue
+  // later.
+  const bool sliced = (slice_expired != nullptr) && (pool_ != nullptr) &&
+                      ((FLAG_message_slice_micros > 0) ||
+                       (FLAG_message_slice_messages > 0));
+  const int64_t slice_end_micros =
+      (sliced && (FLAG_message_slice_micros > 0))
+          ? OS::GetCurrentMonotonicMicros() + FLAG_message_slice_micros
+          : kMaxInt64;
+  intptr_t slice_messages_left = (sliced && (FLAG_message_slice_messages > 0))
+                                     ? FLAG_message_slice_messages
+                                     : kIntptrMax;
+
   MessageStatus max_status = kOK;
   Message::Priority min_priority =
       ((allow_normal_messages && !paused()) ? Message::kNormalPriority
@@ -262,6 +369,17 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
       allow_normal_messages = false;
     }
 
+    // Stop handling normal messages once the time slice is used up, so other
+    // tasks waiting for a thread of the pool get a chance to run.
+    if (sliced && allow_normal_messages &&
+        (saved_priority == Message::kNormalPriority) &&
+        ((--slice_messages_left == 0) ||
+         ((slice_end_micros != kMaxInt64) &&
+          (OS::GetCurrentMonotonicMicros() >= slice_end_micros)))) {
+      allow_normal_messages = false;
+      *slice_expired = true;
+    }
+
     // Reevaluate the minimum allowable priority.  The paused state
     // may have changed as part of handling the message.  We may also
     // have encountered an error during message processing.
@@ -332,13 +450,28 @@ std::unique_ptr<Message> MessageHandler::StealOOBMessage() {
 
 bool MessageHandler::HasMessages() {
   MonitorLocker ml(&monitor_);
-  return !queue_->IsEmpty();
+  return !queue_->IsEmpty() || !inbox_.IsEmpty();
 }
 
 MessageHandler::MessageCount MessageHandler::GetMessageCounts() {
   MonitorLocker ml(&monitor_);
+  DrainInboxLocked();
   return {.num_messages = queue_->Length(),
-          .num_oob_messages = queue_->Length()};
+          .num_oob_messages = oob_queue_->Length(),
+          .num_slices = num_slices_,
+          .num_yields = num_yields_,
+          .total_wait_micros = total_wait_micros_,
+          .max_wait_micros = max_wait_micros_};
+}
+
+bool MessageHandler::latency_critical() {
+  MonitorLocker ml(&monitor_);
+  return latency_critical_;
+}
+
+void MessageHandler::set_latency_critical(bool value) {
+  MonitorLocker ml(&monitor_);
+  latency_critical_ = value;
 }
 
 void MessageHandler::TaskCallback() {
@@ -359,6 +492,15 @@ void MessageHandler::TaskCallback() {
     // [task_running_] to false.
     ASSERT(task_running_);
 
+    if (task_scheduled_micros_ != 0) {
+      const int64_t wait_micros =
+          OS::GetCurrentMonotonicMicros() - task_scheduled_micros_;
+      task_scheduled_micros_ = 0;
+      num_slices_++;
+      total_wait_micros_ += wait_micros;
+      max_wait_micros_ = Utils::Maximum(max_wait_micros_, wait_micros);
+    }
+
 #if !defined(PRODUCT)
     if (ShouldPauseOnStart(kOK)) {
       if (!is_paused_on_start()) {
@@ -369,7 +511,7 @@ void MessageHandler::TaskCallback() {
       if (ShouldPauseOnStart(status)) {
         // Still paused.
         ASSERT(oob_queue_->IsEmpty());
-        task_running_ = false;  // No task in queue.
+        EndTaskLocked();  // No task in queue.
         return;
       } else {
         PausedOnStartLocked(&ml, false);
@@ -380,7 +522,7 @@ void MessageHandler::TaskCallback() {
       if (ShouldPauseOnExit(status)) {
         // Still paused.
         ASSERT(oob_queue_->IsEmpty());
-        task_running_ = false;  // No task in queue.
+        EndTaskLocked();  // No task in queue.
         return;
       } else {
         PausedOnExitLocked(&ml, false);
@@ -391,10 +533,11 @@ void MessageHandler::TaskCallback() {
     }
 #endif  // !defined(PRODUCT)
 
+    bool slice_expired = false;
     if (status == kOK) {
       // Handle any pending messages for this message handler.
       if (status != kShutdown) {
-        status = HandleMessages(&ml, (status == kOK), true);
+        status = HandleMessages(&ml, (status == kOK), true, &slice_expired);
       }
     }
 
@@ -417,7 +560,7 @@ void MessageHandler::TaskCallback() {
         if (ShouldPauseOnExit(status)) {
           // Still paused.
           ASSERT(oob_queue_->IsEmpty());
-          task_running_ = false;  // No task in queue.
+          EndTaskLocked();  // No task in queue.
           return;
         } else {
           PausedOnExitLocked(&ml, false);
@@ -446,10 +589,20 @@ void MessageHandler::TaskCallback() {
       run_end_callback = end_callback_ != nullptr;
     }
 
+    ASSERT(oob_queue_->IsEmpty());
+    DrainInboxLocked();
+    if (slice_expired && (pool_ != nullptr) && !queue_->IsEmpty()) {
+      // Continue with the remaining messages in a new task behind the tasks
+      // that are already waiting. task_running_ stays set for it.
+      num_yields_++;
+      const bool launched_successfully = StartTaskLocked(pool_, /*yield=*/true);
+      ASSERT(launched_successfully);
+      return;
+    }
+
     // Clear task_running_ last.  This allows other tasks to potentially start
     // for this message handler.
-    ASSERT(oob_queue_->IsEmpty());
-    task_running_ = false;
+    EndTaskLocked();
   }
 
   // The handler may have been deleted by another thread here if it is a native
@@ -481,6 +634,7 @@ void MessageHandler::OnAllPortsClosed() {
         "\thandler:    %s\n",
         name());
   }
+  DrainInboxLocked();
   queue_->Clear();
   oob_queue_->Clear();
 }
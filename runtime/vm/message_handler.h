@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_HANDLER_H_
 #define RUNTIME_VM_MESSAGE_HANDLER_H_
 
+#include <atomic>
 #include <memory>
 
 #include "vm/isolate.h"
@@ -84,10 +85,22 @@ class MessageHandler : public PortHandler {
   struct MessageCount {
     intptr_t num_messages;
     intptr_t num_oob_messages;
+    // How often the handler was scheduled on its thread pool, how often it
+    // gave up its thread at the end of a time slice, and how long it waited
+    // for a thread after being scheduled.
+    int64_t num_slices;
+    int64_t num_yields;
+    int64_t total_wait_micros;
+    int64_t max_wait_micros;
   };
 
   MessageCount GetMessageCounts();
 
+  // Latency-critical handlers are scheduled ahead of all other tasks waiting
+  // for a thread of the pool.
+  bool latency_critical();
+  void set_latency_critical(bool value);
+
   // Whether to keep this message handler alive or whether it should shutdown.
   virtual bool KeepAliveLocked() { return true; }
 
@@ -146,6 +159,9 @@ class MessageHandler : public PortHandler {
   void PostMessage(std::unique_ptr<Message> message,
                    bool before_events = false) override;
 
+  // Posts a batch of messages, notifying the handler only once.
+  void PostMessages(MessageQueue* messages) override;
+
   virtual void set_is_scheduled() {}
 
  private:
@@ -201,17 +217,41 @@ class MessageHandler : public PortHandler {
   // messages from the queue_.
   std::unique_ptr<Message> DequeueMessage(Message::Priority min_priority);
 
+  // Moves the messages posted without the monitor to the queue_.
+  void DrainInboxLocked() { inbox_.DrainTo(queue_); }
+
+  // Starts a task to handle messages pushed to the inbox_, unless one is
+  // already running or the handler is not running on a pool.
+  void StartTaskForInbox();
+
+  // Schedules a MessageHandlerTask on [pool]. A task which [yield]s its thread
+  // at the end of a time slice goes behind the tasks already waiting.
+  bool StartTaskLocked(ThreadPool* pool, bool yield);
+
+  // Clears task_running_ at the end of a MessageHandlerTask, starting another
+  // one if messages were posted to the inbox_ in the meantime.
+  void EndTaskLocked();
+
   void ClearOOBQueue();
 
   // Handles any pending messages.
+  //
+  // If [slice_expired] is given, handling of normal messages stops once the
+  // time slice configured by --message-slice-micros and
+  // --message-slice-messages is used up, and [slice_expired] is set.
   MessageStatus HandleMessages(MonitorLocker* ml,
                                bool allow_normal_messages,
-                               bool allow_multiple_normal_messages);
+                               bool allow_multiple_normal_messages,
+                               bool* slice_expired = nullptr);
 
-  Monitor monitor_;  // Protects all fields in MessageHandler.
+  Monitor monitor_;  // Protects all fields in MessageHandler unless noted.
   MessageQueue* queue_;
   MessageQueue* oob_queue_;
 
+  // Normal messages posted without holding the monitor_. They are moved to
+  // the queue_ by whoever holds the monitor_ before it looks at the queue_.
+  ConcurrentMessageQueue inbox_;
+
   // Only accessed by [PortMap], protected by [PortMap]s lock. See ports()
   // getter.
   PortSet<PortSetEntry> ports_;
@@ -227,11 +267,19 @@ class MessageHandler : public PortHandler {
   MessageStatus remembered_paused_on_exit_status_;
   int64_t paused_timestamp_;
 #endif
-  bool task_running_;
-  ThreadPool* pool_;
+  // Written with the monitor_ held, but read by PostMessage without it.
+  std::atomic<bool> task_running_;
+  std::atomic<ThreadPool*> pool_;
   EndCallback end_callback_;
   CallbackData callback_data_;
 
+  bool latency_critical_;
+  int64_t task_scheduled_micros_;
+  int64_t num_slices_;
+  int64_t num_yields_;
+  int64_t total_wait_micros_;
+  int64_t max_wait_micros_;
+
   DISALLOW_COPY_AND_ASSIGN(MessageHandler);
 };
 
@@ -10,6 +10,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, message_slice_messages);
+
 class MessageHandlerTestPeer {
  public:
   explicit MessageHandlerTestPeer(MessageHandler* handler)
@@ -21,7 +23,11 @@ class MessageHandlerTestPeer {
   void OnPortClosed(Dart_Port port) { handler_->OnPortClosed(port); }
   void OnAllPortsClosed() { handler_->OnAllPortsClosed(); }
 
-  MessageQueue* queue() const { return handler_->queue_; }
+  MessageQueue* queue() const {
+    MonitorLocker ml(&handler_->monitor_);
+    handler_->DrainInboxLocked();
+    return handler_->queue_;
+  }
   MessageQueue* oob_queue() const { return handler_->oob_queue_; }
 
  private:
@@ -384,4 +390,42 @@ VM_UNIT_TEST_CASE(MessageHandler_Run) {
   OSThread::Join(info.join_id);
 }
 
+VM_UNIT_TEST_CASE(MessageHandler_RunSliced) {
+  SetFlagScope<int> sfs(&FLAG_message_slice_messages, 2);
+  TestMessageHandler handler;
+  ThreadPool pool;
+  MessageHandlerTestPeer handler_peer(&handler);
+
+  Dart_Port ports[10];
+  for (int i = 0; i < 10; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+    handler_peer.PostMessage(BlankMessage(ports[i], Message::kNormalPriority));
+  }
+  EXPECT_EQ(10, handler.GetMessageCounts().num_messages);
+
+  handler.Run(&pool, TestEndFunction, reinterpret_cast<uword>(&handler));
+
+  {
+    MonitorLocker ml(handler.monitor());
+    while (handler.message_count() < 10) {
+      ml.Wait();
+    }
+    Dart_Port* handler_ports = handler.port_buffer();
+    for (int i = 0; i < 10; i++) {
+      EXPECT_EQ(ports[i], handler_ports[i]);
+    }
+  }
+
+  // The messages were handled two at a time, giving up the thread in between.
+  const auto count = handler.GetMessageCounts();
+  EXPECT_EQ(0, count.num_messages);
+  EXPECT_EQ(5, count.num_slices);
+  EXPECT_EQ(4, count.num_yields);
+  EXPECT_LE(count.max_wait_micros, count.total_wait_micros);
+
+  for (int i = 0; i < 10; i++) {
+    PortMap::ClosePort(ports[i]);
+  }
+}
+
 }  // namespace dart
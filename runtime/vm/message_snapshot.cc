@@ -26,6 +26,168 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            message_streams,
+            true,
+            "Let snapshot messages an isolate sends to the same port share "
+            "tables of class references and canonical strings.");
+
+// Returns the length of the Latin-1 string [data] when encoded as UTF-8.
+static intptr_t Latin1ToUtf8Length(const uint8_t* data, intptr_t length) {
+  intptr_t utf8_len = 0;
+  for (intptr_t i = 0; i < length; i++) {
+    utf8_len += Utf8::Length(data[i]);
+  }
+  return utf8_len;
+}
+
+// Encodes the Latin-1 string [data] as NUL-terminated UTF-8 into [utf8].
+static void Latin1ToUtf8(const uint8_t* data, intptr_t length, char* utf8) {
+  for (intptr_t i = 0; i < length; i++) {
+    utf8 += Utf8::Encode(data[i], utf8);
+  }
+  *utf8 = '\0';
+}
+
+// Returns the length of the UTF-16 string [utf16] when encoded as UTF-8, or -1
+// if it contains unpaired surrogates and thus cannot be encoded.
+static intptr_t Utf16ToUtf8Length(const uint16_t* utf16, intptr_t length) {
+  intptr_t utf8_len = 0;
+  intptr_t i = 0;
+  while (i < length) {
+    int32_t ch = Utf16::Next(utf16, &i, length);
+    if (Utf16::IsSurrogate(ch)) {
+      return -1;
+    }
+    utf8_len += Utf8::Length(ch);
+  }
+  return utf8_len;
+}
+
+// Encodes the UTF-16 string [utf16] as NUL-terminated UTF-8 into [utf8].
+static void Utf16ToUtf8(const uint16_t* utf16, intptr_t length, char* utf8) {
+  intptr_t i = 0;
+  while (i < length) {
+    utf8 += Utf8::Encode(Utf16::Next(utf16, &i, length), utf8);
+  }
+  *utf8 = '\0';
+}
+
+MessageStream::~MessageStream() {
+  for (const ClassEntry& entry : classes_) {
+    free(entry.library_uri);
+    free(entry.class_name);
+  }
+  for (SymbolEntry* entry : symbols_) {
+    free(entry->data);
+    free(entry->utf8);
+    delete entry;
+  }
+}
+
+intptr_t MessageStream::ClassIndex(const Class& cls) {
+  auto* pair = class_indices_.Lookup(cls.id());
+  if (pair != nullptr) {
+    return pair->value;
+  }
+  Zone* zone = Thread::Current()->zone();
+  const auto& lib = Library::Handle(zone, cls.library());
+  const auto& uri = String::Handle(zone, lib.url());
+  const auto& name = String::Handle(zone, cls.Name());
+  ClassEntry entry = {uri.ToMallocCString(), name.ToMallocCString(),
+                      kIllegalCid};
+  intptr_t index;
+  {
+    MutexLocker ml(&mutex_);
+    index = classes_.length();
+    classes_.Add(entry);
+  }
+  class_indices_.Insert({cls.id(), index});
+  return index;
+}
+
+intptr_t MessageStream::SymbolIndex(const String& str) {
+  ASSERT(str.IsCanonical());
+  const intptr_t cid = str.GetClassId();
+  NoSafepointScope no_safepoint;
+  SymbolEntry key;
+  key.cid = cid;
+  key.length = str.Length();
+  key.hash = str.Hash();
+  key.data = cid == kOneByteStringCid
+                 ? OneByteString::DataStart(str)
+                 : reinterpret_cast<uint8_t*>(TwoByteString::DataStart(str));
+  key.utf8 = nullptr;
+  auto* pair = symbol_indices_.Lookup(&key);
+  if (pair != nullptr) {
+    return pair->value;
+  }
+  const intptr_t byte_length = ByteLength(key);
+  if ((symbols_.length() >= kMaxSymbols) ||
+      (symbol_bytes_ + byte_length > kMaxSymbolBytes)) {
+    return -1;
+  }
+  auto* entry = new SymbolEntry(key);
+  entry->data = reinterpret_cast<uint8_t*>(malloc(byte_length));
+  memmove(entry->data, key.data, byte_length);
+  intptr_t index;
+  {
+    MutexLocker ml(&mutex_);
+    index = symbols_.length();
+    symbols_.Add(entry);
+  }
+  symbol_bytes_ += byte_length;
+  symbol_indices_.Insert({entry, index});
+  return index;
+}
+
+void MessageStream::ClassAt(intptr_t index,
+                            const char** library_uri,
+                            const char** class_name,
+                            intptr_t* receiver_cid) {
+  MutexLocker ml(&mutex_);
+  const ClassEntry& entry = classes_[index];
+  *library_uri = entry.library_uri;
+  *class_name = entry.class_name;
+  *receiver_cid = entry.receiver_cid;
+}
+
+void MessageStream::SetReceiverCid(intptr_t index, intptr_t cid) {
+  MutexLocker ml(&mutex_);
+  classes_[index].receiver_cid = cid;
+}
+
+const uint8_t* MessageStream::SymbolAt(intptr_t index,
+                                       intptr_t cid,
+                                       intptr_t* length) {
+  MutexLocker ml(&mutex_);
+  const SymbolEntry* entry = symbols_[index];
+  ASSERT(entry->cid == cid);
+  *length = entry->length;
+  return entry->data;
+}
+
+const char* MessageStream::SymbolAtAsUtf8(intptr_t index) {
+  MutexLocker ml(&mutex_);
+  SymbolEntry* entry = symbols_[index];
+  if (entry->utf8 == nullptr) {
+    if (entry->cid == kOneByteStringCid) {
+      const intptr_t utf8_len = Latin1ToUtf8Length(entry->data, entry->length);
+      entry->utf8 = reinterpret_cast<char*>(malloc(utf8_len + 1));
+      Latin1ToUtf8(entry->data, entry->length, entry->utf8);
+    } else {
+      const auto* utf16 = reinterpret_cast<const uint16_t*>(entry->data);
+      const intptr_t utf8_len = Utf16ToUtf8Length(utf16, entry->length);
+      if (utf8_len < 0) {
+        return nullptr;
+      }
+      entry->utf8 = reinterpret_cast<char*>(malloc(utf8_len + 1));
+      Utf16ToUtf8(utf16, entry->length, entry->utf8);
+    }
+  }
+  return entry->utf8;
+}
+
 static Dart_CObject cobj_sentinel = {.type = Dart_CObject_kUnsupported};
 static Dart_CObject cobj_dynamic_type = {.type = Dart_CObject_kUnsupported};
 static Dart_CObject cobj_void_type = {.type = Dart_CObject_kUnsupported};
@@ -161,16 +323,23 @@ class BaseSerializer : public StackResource {
     finalizable_data->SerializationSucceeded();
     intptr_t size;
     uint8_t* buffer = stream_.Steal(&size);
-    return Message::New(dest_port, buffer, size, finalizable_data, priority);
+    auto message =
+        Message::New(dest_port, buffer, size, finalizable_data, priority);
+    if (message_stream_ != nullptr) {
+      message->set_stream(message_stream_);
+    }
+    return message;
   }
 
   Zone* zone() const { return zone_; }
   MessageFinalizableData* finalizable_data() const { return finalizable_data_; }
   intptr_t next_ref_index() const { return next_ref_index_; }
+  MessageStream* message_stream() const { return message_stream_; }
 
  protected:
   Zone* const zone_;
   MallocWriteStream stream_;
+  MessageStream* message_stream_ = nullptr;
   MessageFinalizableData* finalizable_data_;
   GrowableArray<MessageSerializationCluster*> clusters_;
   intptr_t num_base_objects_;
@@ -180,7 +349,8 @@ class BaseSerializer : public StackResource {
 
 class MessageSerializer : public BaseSerializer {
  public:
-  explicit MessageSerializer(Thread* thread);
+  explicit MessageSerializer(Thread* thread,
+                             MessageStream* message_stream = nullptr);
   ~MessageSerializer();
 
   bool MarkObjectId(ObjectPtr object, intptr_t id) {
@@ -349,10 +519,12 @@ class BaseDeserializer : public ValueObject {
   Zone* zone() const { return zone_; }
   intptr_t next_index() const { return next_ref_index_; }
   MessageFinalizableData* finalizable_data() const { return finalizable_data_; }
+  MessageStream* message_stream() const { return message_stream_; }
 
  protected:
   Zone* zone_;
   ReadStream stream_;
+  MessageStream* message_stream_;
   MessageFinalizableData* finalizable_data_;
   intptr_t next_ref_index_;
 };
@@ -416,6 +588,20 @@ class ApiMessageDeserializer : public BaseDeserializer {
     return result;
   }
 
+  // Returns a string object with a copy of [utf8], or an unsupported object
+  // if [utf8] is null.
+  Dart_CObject* AllocateString(const char* utf8) {
+    if (utf8 == nullptr) {
+      return Allocate(Dart_CObject_kUnsupported);
+    }
+    Dart_CObject* result = Allocate(Dart_CObject_kString);
+    const intptr_t len = strlen(utf8);
+    char* copy = zone()->Alloc<char>(len + 1);
+    memmove(copy, utf8, len + 1);
+    result->value.as_string = copy;
+    return result;
+  }
+
   Dart_CObject* Ref(intptr_t index) const {
     ASSERT(index > 0);
     ASSERT(index <= next_ref_index_);
@@ -498,6 +684,9 @@ class ClassMessageSerializationCluster : public MessageSerializationCluster {
       if (cid < kNumPredefinedCids) {
         ASSERT(cid != 0);
         s->WriteUnsigned(cid);
+      } else if (s->message_stream() != nullptr) {
+        s->WriteUnsigned(0);
+        s->WriteUnsigned(s->message_stream()->ClassIndex(*cls));
       } else {
         s->WriteUnsigned(0);
         lib = cls->library();
@@ -522,31 +711,29 @@ class ClassMessageDeserializationCluster
 
   void ReadNodes(MessageDeserializer* d) {
     auto* class_table = d->isolate_group()->class_table();
-    String& uri = String::Handle(d->zone());
-    Library& lib = Library::Handle(d->zone());
-    String& name = String::Handle(d->zone());
+    MessageStream* message_stream = d->message_stream();
     Class& cls = Class::Handle(d->zone());
     intptr_t count = d->ReadUnsigned();
     for (intptr_t i = 0; i < count; i++) {
       intptr_t cid = d->ReadUnsigned();
       if (cid != 0) {
         cls = class_table->At(cid);
-      } else {
-        uri = String::New(d->ReadAscii());   // Library URI.
-        name = String::New(d->ReadAscii());  // Class name.
-        lib = Library::LookupLibrary(d->thread(), uri);
-        if (lib.IsNull()) [[unlikely]] {
-          FATAL("Not found: %s %s\n", uri.ToCString(), name.ToCString());
-        }
-        if (name.Equals(Symbols::TopLevel())) {
-          cls = lib.toplevel_class();
+      } else if (message_stream != nullptr) {
+        const intptr_t index = d->ReadUnsigned();
+        const char* uri;
+        const char* name;
+        intptr_t receiver_cid;
+        message_stream->ClassAt(index, &uri, &name, &receiver_cid);
+        if (receiver_cid != kIllegalCid) {
+          cls = class_table->At(receiver_cid);
         } else {
-          cls = lib.LookupClass(name);
-        }
-        if (cls.IsNull()) [[unlikely]] {
-          FATAL("Not found: %s %s\n", uri.ToCString(), name.ToCString());
+          cls = LookupClass(d, uri, name);
+          message_stream->SetReceiverCid(index, cls.id());
         }
-        cls.EnsureIsFinalized(d->thread());
+      } else {
+        const char* uri = d->ReadAscii();   // Library URI.
+        const char* name = d->ReadAscii();  // Class name.
+        cls = LookupClass(d, uri, name);
       }
       d->AssignRef(cls.ptr());
     }
@@ -557,12 +744,40 @@ class ClassMessageDeserializationCluster
     for (intptr_t i = 0; i < count; i++) {
       intptr_t cid = d->ReadUnsigned();
       if (cid == 0) {
-        d->ReadAscii();  // Library URI.
-        d->ReadAscii();  // Class name.
+        if (d->message_stream() != nullptr) {
+          d->ReadUnsigned();  // Stream index.
+        } else {
+          d->ReadAscii();  // Library URI.
+          d->ReadAscii();  // Class name.
+        }
       }
       d->AssignRef(nullptr);
     }
   }
+
+ private:
+  static ClassPtr LookupClass(MessageDeserializer* d,
+                              const char* uri_str,
+                              const char* name_str) {
+    const auto& uri = String::Handle(d->zone(), String::New(uri_str));
+    const auto& name = String::Handle(d->zone(), String::New(name_str));
+    const auto& lib =
+        Library::Handle(d->zone(), Library::LookupLibrary(d->thread(), uri));
+    if (lib.IsNull()) [[unlikely]] {
+      FATAL("Not found: %s %s\n", uri.ToCString(), name.ToCString());
+    }
+    auto& cls = Class::Handle(d->zone());
+    if (name.Equals(Symbols::TopLevel())) {
+      cls = lib.toplevel_class();
+    } else {
+      cls = lib.LookupClass(name);
+    }
+    if (cls.IsNull()) [[unlikely]] {
+      FATAL("Not found: %s %s\n", uri.ToCString(), name.ToCString());
+    }
+    cls.EnsureIsFinalized(d->thread());
+    return cls.ptr();
+  }
 };
 
 class TypeArgumentsMessageSerializationCluster
@@ -2458,6 +2673,12 @@ class OneByteStringMessageSerializationCluster
     for (intptr_t i = 0; i < count; i++) {
       String* str = objects_[i];
       s->AssignRef(str);
+      if (is_canonical() && (s->message_stream() != nullptr)) {
+        // 0 if the string is written inline, its index + 1 otherwise.
+        const intptr_t index = s->message_stream()->SymbolIndex(*str);
+        s->WriteUnsigned(index + 1);
+        if (index >= 0) continue;
+      }
       intptr_t length = str->Length();
       s->WriteUnsigned(length);
       NoSafepointScope no_safepoint;
@@ -2507,6 +2728,16 @@ class OneByteStringMessageDeserializationCluster
   void ReadNodes(MessageDeserializer* d) {
     const intptr_t count = d->ReadUnsigned();
     for (intptr_t i = 0; i < count; i++) {
+      if (is_canonical() && (d->message_stream() != nullptr)) {
+        const intptr_t index = d->ReadUnsigned() - 1;
+        if (index >= 0) {
+          intptr_t length;
+          const uint8_t* data =
+              d->message_stream()->SymbolAt(index, kOneByteStringCid, &length);
+          d->AssignRef(Symbols::FromLatin1(d->thread(), data, length));
+          continue;
+        }
+      }
       intptr_t length = d->ReadUnsigned();
       const uint8_t* data = d->CurrentBufferAddress();
       d->Advance(length * sizeof(uint8_t));
@@ -2519,22 +2750,24 @@ class OneByteStringMessageDeserializationCluster
   void ReadNodesApi(ApiMessageDeserializer* d) {
     intptr_t count = d->ReadUnsigned();
     for (intptr_t i = 0; i < count; i++) {
+      if (is_canonical() && (d->message_stream() != nullptr)) {
+        const intptr_t index = d->ReadUnsigned() - 1;
+        if (index >= 0) {
+          d->AssignRef(d->AllocateString(
+              d->message_stream()->SymbolAtAsUtf8(index)));
+          continue;
+        }
+      }
       Dart_CObject* str = d->Allocate(Dart_CObject_kString);
       intptr_t latin1_length = d->ReadUnsigned();
       const uint8_t* data = d->CurrentBufferAddress();
 
       d->Advance(latin1_length * sizeof(uint8_t));
 
-      intptr_t utf8_len = 0;
-      for (intptr_t i = 0; i < latin1_length; i++) {
-        utf8_len += Utf8::Length(data[i]);
-      }
+      intptr_t utf8_len = Latin1ToUtf8Length(data, latin1_length);
       char* utf8_data = d->zone()->Alloc<char>(utf8_len + 1);
       str->value.as_string = utf8_data;
-      for (intptr_t i = 0; i < latin1_length; i++) {
-        utf8_data += Utf8::Encode(data[i], utf8_data);
-      }
-      *utf8_data = '\0';
+      Latin1ToUtf8(data, latin1_length, utf8_data);
 
       d->AssignRef(str);
     }
@@ -2564,6 +2797,12 @@ class TwoByteStringMessageSerializationCluster
     for (intptr_t i = 0; i < count; i++) {
       String* str = objects_[i];
       s->AssignRef(str);
+      if (is_canonical() && (s->message_stream() != nullptr)) {
+        // 0 if the string is written inline, its index + 1 otherwise.
+        const intptr_t index = s->message_stream()->SymbolIndex(*str);
+        s->WriteUnsigned(index + 1);
+        if (index >= 0) continue;
+      }
       intptr_t length = str->Length();
       s->WriteUnsigned(length);
       NoSafepointScope no_safepoint;
@@ -2616,6 +2855,16 @@ class TwoByteStringMessageDeserializationCluster
   void ReadNodes(MessageDeserializer* d) {
     const intptr_t count = d->ReadUnsigned();
     for (intptr_t i = 0; i < count; i++) {
+      if (is_canonical() && (d->message_stream() != nullptr)) {
+        const intptr_t index = d->ReadUnsigned() - 1;
+        if (index >= 0) {
+          intptr_t length;
+          const uint16_t* data = reinterpret_cast<const uint16_t*>(
+              d->message_stream()->SymbolAt(index, kTwoByteStringCid, &length));
+          d->AssignRef(Symbols::FromUTF16(d->thread(), data, length));
+          continue;
+        }
+      }
       intptr_t length = d->ReadUnsigned();
       const uint16_t* data =
           reinterpret_cast<const uint16_t*>(d->CurrentBufferAddress());
@@ -2629,6 +2878,14 @@ class TwoByteStringMessageDeserializationCluster
   void ReadNodesApi(ApiMessageDeserializer* d) {
     intptr_t count = d->ReadUnsigned();
     for (intptr_t j = 0; j < count; j++) {
+      if (is_canonical() && (d->message_stream() != nullptr)) {
+        const intptr_t index = d->ReadUnsigned() - 1;
+        if (index >= 0) {
+          d->AssignRef(d->AllocateString(
+              d->message_stream()->SymbolAtAsUtf8(index)));
+          continue;
+        }
+      }
       // Read all the UTF-16 code units.
       intptr_t utf16_length = d->ReadUnsigned();
       const uint16_t* utf16 =
@@ -2637,25 +2894,14 @@ class TwoByteStringMessageDeserializationCluster
 
       // Calculate the UTF-8 length and check if the string can be
       // UTF-8 encoded.
-      intptr_t utf8_len = 0;
-      bool valid = true;
-      intptr_t i = 0;
-      while (i < utf16_length && valid) {
-        int32_t ch = Utf16::Next(utf16, &i, utf16_length);
-        utf8_len += Utf8::Length(ch);
-        valid = !Utf16::IsSurrogate(ch);
-      }
-      if (!valid) {
+      intptr_t utf8_len = Utf16ToUtf8Length(utf16, utf16_length);
+      if (utf8_len < 0) {
         d->AssignRef(d->Allocate(Dart_CObject_kUnsupported));
       } else {
         Dart_CObject* str = d->Allocate(Dart_CObject_kString);
         char* utf8 = d->zone()->Alloc<char>(utf8_len + 1);
         str->value.as_string = utf8;
-        i = 0;
-        while (i < utf16_length) {
-          utf8 += Utf8::Encode(Utf16::Next(utf16, &i, utf16_length), utf8);
-        }
-        *utf8 = '\0';
+        Utf16ToUtf8(utf16, utf16_length, utf8);
         d->AssignRef(str);
       }
     }
@@ -2679,11 +2925,13 @@ BaseSerializer::~BaseSerializer() {
   delete finalizable_data_;
 }
 
-MessageSerializer::MessageSerializer(Thread* thread)
+MessageSerializer::MessageSerializer(Thread* thread,
+                                     MessageStream* message_stream)
     : BaseSerializer(thread, thread->zone()),
       forward_table_new_(),
       forward_table_old_(),
       stack_(thread->zone(), 0) {
+  message_stream_ = message_stream;
   thread->set_forward_table_new(new WeakTable());
   thread->set_forward_table_old(new WeakTable());
 }
@@ -3038,6 +3286,7 @@ void MessageSerializer::IllegalObject(const Object& object,
 BaseDeserializer::BaseDeserializer(Zone* zone, Message* message)
     : zone_(zone),
       stream_(message->snapshot(), message->snapshot_length()),
+      message_stream_(message->stream()),
       finalizable_data_(message->finalizable_data()),
       next_ref_index_(kFirstReference) {}
 
@@ -3401,7 +3650,11 @@ std::unique_ptr<Message> WriteMessage(bool same_group,
   }
 
   Thread* thread = Thread::Current();
-  MessageSerializer serializer(thread);
+  MessageStream* message_stream = nullptr;
+  if (FLAG_message_streams && (thread->isolate() != nullptr)) {
+    message_stream = thread->isolate()->GetMessageStream(dest_port);
+  }
+  MessageSerializer serializer(thread, message_stream);
   serializer.Serialize(obj);
   return serializer.Finish(dest_port, priority);
 }
@@ -5,14 +5,130 @@
 #ifndef RUNTIME_VM_MESSAGE_SNAPSHOT_H_
 #define RUNTIME_VM_MESSAGE_SNAPSHOT_H_
 
+#include <atomic>
 #include <memory>
 
 #include "include/dart_native_api.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
 #include "vm/message.h"
 #include "vm/object.h"
+#include "vm/os_thread.h"
 
 namespace dart {
 
+// Class references and canonical strings shared by the snapshot messages an
+// isolate sends to a port in another isolate group.
+//
+// Instead of spelling out a library URI and class name or the characters of a
+// symbol in every message, messages written with a stream refer to entries of
+// its tables. The tables only ever grow, so an entry can be resolved no matter
+// in which order messages are received, and every such message holds a
+// reference to its stream (see [Message::stream]).
+//
+// The sending isolate adds entries, the receiving one resolves them; both
+// sides synchronize through [mutex_].
+class MessageStream {
+ public:
+  // Canonical strings beyond these limits are written into the message.
+  static constexpr intptr_t kMaxSymbols = 4 * KB;
+  static constexpr intptr_t kMaxSymbolBytes = 1 * MB;
+
+  explicit MessageStream(Dart_Port dest_port) : dest_port_(dest_port) {}
+  ~MessageStream();
+
+  Dart_Port dest_port() const { return dest_port_; }
+
+  void Retain() { ref_count_.fetch_add(1); }
+  void Release() {
+    if (ref_count_.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+  // Returns the index of the entry for the class [cls] of the sender,
+  // adding one if needed.
+  intptr_t ClassIndex(const Class& cls);
+
+  // Returns the index of the entry for the canonical string [str], adding one
+  // if needed. Returns -1 if the table is full.
+  intptr_t SymbolIndex(const String& str);
+
+  // Returns the library URI and class name of the entry [index], and the class
+  // id it was resolved to by the receiver or kIllegalCid.
+  void ClassAt(intptr_t index,
+               const char** library_uri,
+               const char** class_name,
+               intptr_t* receiver_cid);
+  void SetReceiverCid(intptr_t index, intptr_t cid);
+
+  // Returns the characters of the entry [index] in the representation of
+  // strings with class id [cid] (Latin-1 or UTF-16).
+  const uint8_t* SymbolAt(intptr_t index, intptr_t cid, intptr_t* length);
+
+  // Returns the entry [index] encoded as a NUL-terminated UTF-8 string.
+  const char* SymbolAtAsUtf8(intptr_t index);
+
+ private:
+  struct ClassEntry {
+    char* library_uri;
+    char* class_name;
+    intptr_t receiver_cid;
+  };
+
+  struct SymbolEntry {
+    intptr_t cid;
+    intptr_t length;  // In code units.
+    uword hash;
+    uint8_t* data;
+    char* utf8;  // Computed on demand.
+  };
+
+  struct SymbolKeyValueTrait {
+    typedef const SymbolEntry* Key;
+    typedef intptr_t Value;
+
+    struct Pair {
+      Key key;
+      Value value;
+      Pair() : key(nullptr), value(-1) {}
+      Pair(const Key key, const Value& value) : key(key), value(value) {}
+      Pair(const Pair& other) : key(other.key), value(other.value) {}
+      Pair& operator=(const Pair&) = default;
+    };
+
+    static Key KeyOf(Pair kv) { return kv.key; }
+    static Value ValueOf(Pair kv) { return kv.value; }
+    static uword Hash(Key key) { return key->hash; }
+    static bool IsKeyEqual(Pair kv, Key key) {
+      return (kv.key->cid == key->cid) && (kv.key->length == key->length) &&
+             (memcmp(kv.key->data, key->data, ByteLength(*key)) == 0);
+    }
+  };
+
+  static intptr_t ByteLength(const SymbolEntry& entry) {
+    return entry.length *
+           (entry.cid == kOneByteStringCid ? sizeof(uint8_t) : sizeof(uint16_t));
+  }
+
+  const Dart_Port dest_port_;
+  std::atomic<intptr_t> ref_count_ = {1};
+
+  Mutex mutex_;
+  MallocGrowableArray<ClassEntry> classes_;
+  MallocGrowableArray<SymbolEntry*> symbols_;
+  intptr_t symbol_bytes_ = 0;
+
+  // Only accessed by the sender.
+  MallocDirectChainedHashMap<IntKeyRawPointerValueTrait<intptr_t>>
+      class_indices_;
+  MallocDirectChainedHashMap<SymbolKeyValueTrait> symbol_indices_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageStream);
+};
+
+// Messages to a receiver in another group are written with the current
+// isolate's stream for [dest_port] (see [Isolate::GetMessageStream]).
 std::unique_ptr<Message> WriteMessage(bool same_group,
                                       const Object& obj,
                                       Dart_Port dest_port,
@@ -3,7 +3,12 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/message.h"
+
+#include <atomic>
+
 #include "platform/assert.h"
+#include "vm/lockers.h"
+#include "vm/thread_pool.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -133,4 +138,100 @@ TEST_CASE(MessageQueue_Clear) {
   EXPECT(queue.IsEmpty());
 }
 
+TEST_CASE(ConcurrentMessageQueue_BasicOperations) {
+  ConcurrentMessageQueue inbox;
+  MessageQueue queue;
+  EXPECT(inbox.IsEmpty());
+  EXPECT_EQ(0, inbox.DrainTo(&queue));
+
+  for (intptr_t i = 1; i <= 3; i++) {
+    inbox.Push(Message::New(i, Smi::New(i), Message::kNormalPriority));
+  }
+  EXPECT(!inbox.IsEmpty());
+  EXPECT_EQ(3, inbox.DrainTo(&queue));
+  EXPECT(inbox.IsEmpty());
+
+  // Messages pushed later are appended after the drained ones.
+  inbox.Push(Message::New(4, Smi::New(4), Message::kNormalPriority));
+  EXPECT_EQ(1, inbox.DrainTo(&queue));
+  for (intptr_t i = 1; i <= 4; i++) {
+    std::unique_ptr<Message> msg = queue.Dequeue();
+    EXPECT(msg != nullptr);
+    EXPECT_EQ(i, msg->dest_port());
+  }
+  EXPECT(queue.IsEmpty());
+
+  // Messages which were never drained are freed with the queue.
+  inbox.Push(Message::New(5, AllocMsg("msg5"), 5, nullptr,
+                          Message::kNormalPriority));
+}
+
+namespace {
+
+const intptr_t kNumProducers = 4;
+const intptr_t kMessagesPerProducer = 10000;
+
+struct ProducerState {
+  ConcurrentMessageQueue inbox;
+  Monitor monitor;
+  intptr_t producers_finished = 0;
+};
+
+class ProducerTask : public ThreadPool::Task {
+ public:
+  ProducerTask(ProducerState* state, intptr_t id) : state_(state), id_(id) {}
+
+  virtual void Run() {
+    for (intptr_t i = 0; i < kMessagesPerProducer; i++) {
+      // The port encodes the producer and the sequence number.
+      state_->inbox.Push(Message::New(id_ * kMessagesPerProducer + i + 1,
+                                      Smi::New(0), Message::kNormalPriority));
+    }
+    MonitorLocker ml(&state_->monitor);
+    state_->producers_finished++;
+    ml.Notify();
+  }
+
+ private:
+  ProducerState* state_;
+  intptr_t id_;
+};
+
+}  // namespace
+
+// Each producer's messages are received in order while the consumer drains
+// the queue concurrently.
+TEST_CASE(ConcurrentMessageQueue_MultipleProducers) {
+  ProducerState state;
+  MessageQueue queue;
+  intptr_t next[kNumProducers] = {};
+  intptr_t received = 0;
+  auto consume = [&]() {
+    state.inbox.DrainTo(&queue);
+    while (std::unique_ptr<Message> msg = queue.Dequeue()) {
+      const intptr_t port = msg->dest_port() - 1;
+      const intptr_t producer = port / kMessagesPerProducer;
+      EXPECT_EQ(next[producer], port % kMessagesPerProducer);
+      next[producer]++;
+      received++;
+    }
+  };
+  {
+    ThreadPool pool;
+    for (intptr_t i = 0; i < kNumProducers; i++) {
+      EXPECT(pool.Run<ProducerTask>(&state, i));
+    }
+    while (true) {
+      {
+        MonitorLocker ml(&state.monitor);
+        if (state.producers_finished == kNumProducers) break;
+      }
+      consume();
+    }
+  }
+  consume();
+  EXPECT_EQ(kNumProducers * kMessagesPerProducer, received);
+  EXPECT(state.inbox.IsEmpty());
+}
+
 }  // namespace dart
@@ -114,4 +114,64 @@ ISOLATE_UNIT_TEST_CASE(Metric_EmbedderAPI) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(Metric_GCStatsAPI) {
+  Dart_IsolateGroup isolate_group = nullptr;
+  int64_t last_sequence = 0;
+  int64_t histogram_before[DART_GC_PAUSE_HISTOGRAM_BUCKETS];
+  {
+    TransitionVMToNative transition(thread);
+    isolate_group = Dart_CurrentIsolateGroup();
+    Dart_GCStats stats[GCStatsBuffer::kCapacity];
+    const intptr_t count = Dart_IsolateGroupGCStats(
+        isolate_group, 0, stats, GCStatsBuffer::kCapacity);
+    if (count > 0) {
+      last_sequence = stats[count - 1].sequence;
+    }
+    Dart_IsolateGroupGCPauseHistogram(isolate_group, histogram_before);
+  }
+
+  String::New("<land-in-new-space>", Heap::kNew);
+  thread->heap()->CollectGarbage(thread, GCType::kScavenge,
+                                 GCReason::kDebugging);
+  thread->heap()->CollectGarbage(thread, GCType::kMarkCompact,
+                                 GCReason::kDebugging);
+
+  {
+    TransitionVMToNative transition(thread);
+    Dart_GCStats stats[4];
+    const intptr_t count =
+        Dart_IsolateGroupGCStats(isolate_group, last_sequence, stats, 4);
+    EXPECT_EQ(2, count);
+    EXPECT_EQ(last_sequence + 1, stats[0].sequence);
+    EXPECT_EQ(Dart_GCKind_Scavenge, stats[0].kind);
+    EXPECT_EQ(Dart_GCReason_Debugging, stats[0].reason);
+    EXPECT(stats[0].end_micros >= stats[0].start_micros);
+    EXPECT_EQ(0, stats[0].mark_micros);
+    EXPECT(stats[0].new_capacity_after > 0);
+
+    EXPECT_EQ(last_sequence + 2, stats[1].sequence);
+    EXPECT_EQ(Dart_GCKind_MarkCompact, stats[1].kind);
+    EXPECT(stats[1].start_micros >= stats[0].end_micros);
+    EXPECT(stats[1].old_used_after > 0);
+    EXPECT(stats[1].old_capacity_after >= stats[1].old_used_after);
+    EXPECT(stats[1].old_growth_in_pages >= 0);
+    EXPECT(stats[1].mark_micros + stats[1].sweep_micros +
+               stats[1].compact_micros <=
+           stats[1].end_micros - stats[1].start_micros);
+
+    // Nothing new since the last collection.
+    EXPECT_EQ(0, Dart_IsolateGroupGCStats(isolate_group, stats[1].sequence,
+                                          stats, 4));
+
+    int64_t histogram_after[DART_GC_PAUSE_HISTOGRAM_BUCKETS];
+    Dart_IsolateGroupGCPauseHistogram(isolate_group, histogram_after);
+    int64_t pauses = 0;
+    for (intptr_t i = 0; i < DART_GC_PAUSE_HISTOGRAM_BUCKETS; i++) {
+      EXPECT(histogram_after[i] >= histogram_before[i]);
+      pauses += histogram_after[i] - histogram_before[i];
+    }
+    EXPECT_EQ(2, pauses);
+  }
+}
+
 }  // namespace dart
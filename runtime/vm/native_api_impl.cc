@@ -58,6 +58,30 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message) {
   return PostCObjectHelper(port_id, message);
 }
 
+DART_EXPORT bool Dart_PostCObjectBatch(Dart_Port port_id,
+                                       intptr_t num_messages,
+                                       Dart_CObject** messages) {
+  if (num_messages < 0 || (num_messages > 0 && messages == nullptr)) {
+    return false;
+  }
+  MessageQueue batch;
+  for (intptr_t i = 0; i < num_messages; i++) {
+    AllocOnlyStackZone zone;
+    std::unique_ptr<Message> msg = WriteApiMessage(
+        zone.GetZone(), messages[i], port_id, Message::kNormalPriority);
+    if (msg == nullptr) {
+      // Ownership of external data remains with the poster.
+      MessageQueue::Iterator it(&batch);
+      while (it.HasNext()) {
+        it.Next()->DropFinalizers();
+      }
+      return false;
+    }
+    batch.Enqueue(std::move(msg), /*before_events=*/false);
+  }
+  return PortMap::PostMessages(port_id, &batch);
+}
+
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   if (Smi::IsValid(message)) {
     return PortMap::PostMessage(
@@ -46,6 +46,31 @@ class HandleMessage : public ThreadPool::Task {
 
   DISALLOW_COPY_AND_ASSIGN(HandleMessage);
 };
+
+class HandleMessages : public ThreadPool::Task {
+ public:
+  HandleMessages(Dart_NativeMessageHandler handler, MessageQueue* messages)
+      : handler_(handler) {
+    ASSERT(handler != nullptr);
+    while (std::unique_ptr<Message> message = messages->Dequeue()) {
+      messages_.Enqueue(std::move(message), /*before_events=*/false);
+    }
+  }
+
+  virtual void Run() {
+    while (std::unique_ptr<Message> message = messages_.Dequeue()) {
+      ApiNativeScope scope;
+      Dart_CObject* object = ReadApiMessage(scope.zone(), message.get());
+      handler_(message->dest_port(), object);
+    }
+  }
+
+ private:
+  Dart_NativeMessageHandler handler_;
+  MessageQueue messages_;
+
+  DISALLOW_COPY_AND_ASSIGN(HandleMessages);
+};
 }  // namespace
 
 void NativeMessageHandler::PostMessage(std::unique_ptr<Message> message,
@@ -57,6 +82,13 @@ void NativeMessageHandler::PostMessage(std::unique_ptr<Message> message,
   pool_.Run<HandleMessage>(func_, std::move(message));
 }
 
+void NativeMessageHandler::PostMessages(MessageQueue* messages) {
+  if (messages->IsEmpty()) {
+    return;
+  }
+  pool_.Run<HandleMessages>(func_, messages);
+}
+
 void NativeMessageHandler::RequestDeletion(NativeMessageHandler* handler) {
   {
     MonitorLocker ml(monitor_);
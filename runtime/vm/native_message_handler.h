@@ -38,6 +38,10 @@ class NativeMessageHandler final : public PortHandler {
   void PostMessage(std::unique_ptr<Message> message,
                    bool before_events = false) override;
 
+  // Posts a batch of messages, which are handled in order by a single worker
+  // thread.
+  void PostMessages(MessageQueue* messages) override;
+
   // Request deletion of the given handler once it is down with the currently
   // running Dart_NativeMessageHandler callbacks. No new callbacks will be
   // scheduled after this call.
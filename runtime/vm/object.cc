@@ -2657,6 +2657,28 @@ ObjectPtr Object::Allocate(intptr_t cls_id,
   return raw_obj;
 }
 
+ObjectPtr Object::TryAllocatePretenured(Thread* thread,
+                                        intptr_t cls_id,
+                                        intptr_t size) {
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  Heap* heap = thread->heap();
+  const uword address = heap->old_space()->TryAllocateFromFreeLists(size);
+  if (address == 0) {
+    return Object::null();
+  }
+  NoSafepointScope no_safepoint(thread);
+  InitializeObject(address, cls_id, size,
+                   Instance::ContainsCompressedPointers(),
+                   sizeof(UntaggedObject), size - kCompressedWordSize);
+  ObjectPtr raw_obj = static_cast<ObjectPtr>(address + kHeapObjectTag);
+  if (UNLIKELY(thread->is_marking())) {
+    // Black allocation, see Object::Allocate.
+    raw_obj->untag()->SetMarkBitRelease();
+    heap->old_space()->AllocateBlack(size);
+  }
+  return raw_obj;
+}
+
 class WriteBarrierUpdateVisitor : public ObjectPointerVisitor {
  public:
   explicit WriteBarrierUpdateVisitor(Thread* thread, ObjectPtr obj)
@@ -27309,6 +27331,33 @@ void RegExp::set_bytecode(bool is_one_byte,
   }
 }
 
+void RegExp::set_native_code(bool is_one_byte,
+                             bool sticky,
+                             const Code& code) const {
+  if (sticky) {
+    if (is_one_byte) {
+      untag()->set_one_byte_sticky_code<std::memory_order_release>(code.ptr());
+    } else {
+      untag()->set_two_byte_sticky_code<std::memory_order_release>(code.ptr());
+    }
+  } else {
+    if (is_one_byte) {
+      untag()->set_one_byte_code<std::memory_order_release>(code.ptr());
+    } else {
+      untag()->set_two_byte_code<std::memory_order_release>(code.ptr());
+    }
+  }
+}
+
+void RegExp::set_experimental_bytecode(bool sticky,
+                                       const TypedData& bytecode) const {
+  if (sticky) {
+    untag()->set_experimental_sticky<std::memory_order_release>(bytecode.ptr());
+  } else {
+    untag()->set_experimental<std::memory_order_release>(bytecode.ptr());
+  }
+}
+
 void RegExp::set_capture_name_map(const Array& array) const {
   untag()->set_capture_name_map<std::memory_order_release>(array.ptr());
 }
@@ -27320,6 +27369,10 @@ RegExpPtr RegExp::New(const String& pattern, RegExpFlags flags) {
   result.set_num_bracket_expressions(-1);
   result.set_num_registers(/*is_one_byte=*/false, -1);
   result.set_num_registers(/*is_one_byte=*/true, -1);
+  result.set_usage_counter(0);
+  result.set_is_atom(false);
+  result.StoreNonPointer(&result.untag()->native_code_failures_, 0);
+  result.set_experimental_support(ExperimentalSupport::kUnknown);
   return result.ptr();
 }
 
@@ -692,6 +692,14 @@ class KNOWN_VTABLE_DISCRIMINATOR Object {
 
   void EnsureDeeplyImmutable(Zone* zone) const;
 
+  // Allocates an instance of [cls_id] in old space with all fields after the
+  // header set to null, like the allocation stubs do. Only uses the free
+  // lists, so it never enters a safepoint and may be called from a leaf
+  // runtime entry. Returns Object::null() on failure.
+  static ObjectPtr TryAllocatePretenured(Thread* thread,
+                                         intptr_t cls_id,
+                                         intptr_t size);
+
  protected:
   friend ObjectPtr AllocateObject(intptr_t, intptr_t, intptr_t);
 
@@ -13252,6 +13260,18 @@ class RegExp : public Instance {
     }
   }
 
+  CodePtr native_code(bool is_one_byte, bool sticky) const {
+    if (sticky) {
+      return is_one_byte
+                 ? untag()->one_byte_sticky_code<std::memory_order_acquire>()
+                 : untag()->two_byte_sticky_code<std::memory_order_acquire>();
+    } else {
+      return is_one_byte
+                 ? untag()->one_byte_code<std::memory_order_acquire>()
+                 : untag()->two_byte_code<std::memory_order_acquire>();
+    }
+  }
+
   static intptr_t function_offset(intptr_t cid, bool sticky) {
     if (sticky) {
       switch (cid) {
@@ -13298,6 +13318,70 @@ class RegExp : public Instance {
   void set_bytecode(bool is_one_byte,
                     bool sticky,
                     const TypedData& bytecode) const;
+  void set_native_code(bool is_one_byte, bool sticky, const Code& code) const;
+
+  // The program of the linear-time engine, an array of RegExpInstructions.
+  TypedDataPtr experimental_bytecode(bool sticky) const {
+    return sticky ? untag()->experimental_sticky<std::memory_order_acquire>()
+                  : untag()->experimental<std::memory_order_acquire>();
+  }
+  void set_experimental_bytecode(bool sticky, const TypedData& bytecode) const;
+
+  // Whether the linear-time engine can handle the pattern. This doesn't
+  // depend on stickiness.
+  enum class ExperimentalSupport : uint8_t {
+    kUnknown,
+    kSupported,
+    kUnsupported,
+  };
+  ExperimentalSupport experimental_support() const {
+    return static_cast<ExperimentalSupport>(
+        LoadNonPointer<uint8_t, std::memory_order_relaxed>(
+            &untag()->experimental_support_));
+  }
+  void set_experimental_support(ExperimentalSupport value) const {
+    StoreNonPointer<uint8_t, uint8_t, std::memory_order_relaxed>(
+        &untag()->experimental_support_, static_cast<uint8_t>(value));
+  }
+
+  // Usage counter used to decide when to compile the pattern to machine code.
+  // It is shared by all specializations and updated by mutators of any
+  // isolate of the group, hence the atomic increment.
+  int32_t usage_counter() const {
+    return LoadNonPointer<int32_t, std::memory_order_relaxed>(
+        &untag()->usage_counter_);
+  }
+  void set_usage_counter(int32_t value) const {
+    StoreNonPointer<int32_t, int32_t, std::memory_order_relaxed>(
+        &untag()->usage_counter_, value);
+  }
+  void IncrementUsageCounter() const {
+    std::atomic_ref<int32_t>(untag()->usage_counter_)
+        .fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Whether compiling the given specialization to machine code failed, in
+  // which case it keeps using the bytecode.
+  bool native_code_failed(bool is_one_byte, bool sticky) const {
+    return (LoadNonPointer<uint8_t, std::memory_order_relaxed>(
+                &untag()->native_code_failures_) &
+            NativeCodeFailureBit(is_one_byte, sticky)) != 0;
+  }
+  void set_native_code_failed(bool is_one_byte, bool sticky) const {
+    std::atomic_ref<uint8_t>(untag()->native_code_failures_)
+        .fetch_or(NativeCodeFailureBit(is_one_byte, sticky),
+                  std::memory_order_relaxed);
+  }
+
+  // Whether the pattern is a plain string without captures or case folding
+  // that can be matched by a substring search.
+  bool is_atom() const {
+    return LoadNonPointer<bool, std::memory_order_relaxed>(&untag()->is_atom_);
+  }
+  void set_is_atom(bool value) const {
+    StoreNonPointer<bool, bool, std::memory_order_relaxed>(&untag()->is_atom_,
+                                                           value);
+  }
 
   template <std::memory_order order = std::memory_order_relaxed>
   void set_num_bracket_expressions(intptr_t value) const {
@@ -13324,6 +13408,10 @@ class RegExp : public Instance {
   static RegExpPtr New(const String& pattern, RegExpFlags flags);
 
  private:
+  static uint8_t NativeCodeFailureBit(bool is_one_byte, bool sticky) {
+    return 1 << ((is_one_byte ? 1 : 0) + (sticky ? 2 : 0));
+  }
+
   FINAL_HEAP_OBJECT_IMPLEMENTATION(RegExp, Instance);
   friend class Class;
 };
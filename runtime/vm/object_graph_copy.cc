@@ -4,16 +4,20 @@
 
 #include "vm/object_graph_copy.h"
 
+#include <atomic>
 #include <memory>
 
+#include "vm/dart.h"
 #include "vm/dart_api_state.h"
 #include "vm/flags.h"
+#include "vm/heap/pointer_block.h"
 #include "vm/heap/weak_table.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/snapshot.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 
 #define Z zone_
@@ -105,6 +109,17 @@ DEFINE_FLAG(bool,
             gc_on_foc_slow_path,
             false,
             "Cause a GC when falling off the fast path for fast object copy.");
+DEFINE_FLAG(int,
+            object_copy_tasks,
+            0,
+            "Number of helper tasks that join the sending thread when the fast "
+            "path copies a large message graph (0 copies on the sending thread "
+            "only).");
+DEFINE_FLAG(int,
+            parallel_object_copy_threshold,
+            64 * KB,
+            "Number of objects the fast path copies on its own before it asks "
+            "helper tasks to copy the rest of the message graph.");
 
 const char* const kFastAllocationFailed = "fast allocation failed";
 
@@ -487,9 +502,21 @@ class IdentityMap {
     }
   }
 
- private:
+  // Re-inserts all entries of [from_to] after they have been reordered or
+  // appended to without going through [Insert].
+  template <typename T>
+  void Rebuild(T from_to) {
+    intptr_t capacity = hash_table_capacity_;
+    while (from_to.Length() > capacity) {
+      capacity *= 2;
+    }
+    Rehash(capacity, from_to, /*check_for_safepoint=*/false);
+  }
+
+  // Returns the identity hash of [object], assigning one drawn from
+  // [thread]'s random number generator if it doesn't have one yet.
   DART_FORCE_INLINE
-  uint32_t GetHeaderHash(ObjectPtr object) {
+  static uint32_t GetHeaderHash(Thread* thread, ObjectPtr object) {
     uint32_t hash = Object::GetCachedHash(object);
     if (hash == 0) {
       switch (object->GetClassIdOfHeapObject()) {
@@ -509,7 +536,7 @@ class IdentityMap {
           break;
         default:
           do {
-            hash = thread_->random()->NextUInt32();
+            hash = thread->random()->NextUInt32();
           } while (hash == 0 || !Smi::IsValid(hash));
           hash = Object::SetCachedHashIfNotSet(object, hash);
           break;
@@ -518,6 +545,12 @@ class IdentityMap {
     return hash;
   }
 
+ private:
+  DART_FORCE_INLINE
+  uint32_t GetHeaderHash(ObjectPtr object) {
+    return GetHeaderHash(thread_, object);
+  }
+
   template <typename T>
   void Rehash(intptr_t new_capacity, T from_to, bool check_for_safepoint) {
     hash_table_capacity_ = new_capacity;
@@ -608,6 +641,233 @@ class IdentityMap {
 };
 #endif  // defined(HASH_IN_OBJECT_HEADER)
 
+#if defined(HASH_IN_OBJECT_HEADER)
+// A fixed capacity identity map shared by the workers of a parallel copy phase
+// (see FastObjectCopy::CopyPendingObjectsInParallel).
+//
+// The first worker to install an object as a key claims it: that worker
+// allocates the copy and then publishes it. Other workers that look up a
+// claimed object spin until the copy is published, which happens right after
+// the allocation.
+class ParallelForwardingTable {
+ public:
+  explicit ParallelForwardingTable(intptr_t capacity)
+      : mask_(capacity - 1), entries_(new Entry[capacity]) {
+    ASSERT(Utils::IsPowerOfTwo(capacity));
+  }
+  ~ParallelForwardingTable() { delete[] entries_; }
+
+  // Returns the copy of [object] or Marker() if it has none.
+  ObjectPtr Lookup(ObjectPtr object, uint32_t hash) {
+    const uword key = static_cast<uword>(object);
+    for (intptr_t i = hash & mask_;; i = (i + 1) & mask_) {
+      const uword existing = entries_[i].key.load(std::memory_order_acquire);
+      if (existing == 0) {
+        return Marker();
+      }
+      if (existing == key) {
+        return WaitForCopy(i);
+      }
+    }
+  }
+
+  // Claims [object] for the calling worker and returns the index of its entry,
+  // which must then be passed to either [Publish] or [Abandon].
+  //
+  // Returns -1 if [object] was claimed before, in which case [existing_to] is
+  // set to its copy (or Marker() if that copy failed), or if the table is
+  // full, in which case [existing_to] is set to Marker().
+  intptr_t Claim(ObjectPtr object, uint32_t hash, ObjectPtr* existing_to) {
+    const uword key = static_cast<uword>(object);
+    for (intptr_t i = hash & mask_;; i = (i + 1) & mask_) {
+      uword existing = entries_[i].key.load(std::memory_order_acquire);
+      if (existing == 0) {
+        // Keep the load factor below 1/2 so probe sequences stay short.
+        if (used_.load() * 2 > mask_) {
+          full_ = true;
+          *existing_to = Marker();
+          return -1;
+        }
+        if (entries_[i].key.compare_exchange_strong(
+                existing, key, std::memory_order_acq_rel)) {
+          used_.fetch_add(1);
+          return i;
+        }
+        // Another worker installed a key in this entry first.
+      }
+      if (existing == key) {
+        *existing_to = WaitForCopy(i);
+        return -1;
+      }
+    }
+  }
+
+  void Publish(intptr_t index, ObjectPtr to) {
+    entries_[index].value.store(static_cast<uword>(to),
+                                std::memory_order_release);
+  }
+  void Abandon(intptr_t index) {
+    entries_[index].value.store(kAbandoned, std::memory_order_release);
+  }
+
+  bool is_full() const { return full_; }
+
+ private:
+  struct Entry {
+    std::atomic<uword> key = {0};
+    std::atomic<uword> value = {kUnpublished};
+  };
+
+  static constexpr uword kUnpublished = 0;
+  // A tagged pointer to address 0, which is never a copy.
+  static constexpr uword kAbandoned = kHeapObjectTag;
+
+  ObjectPtr WaitForCopy(intptr_t index) {
+    uword value;
+    do {
+      value = entries_[index].value.load(std::memory_order_acquire);
+    } while (value == kUnpublished);
+    return value == kAbandoned ? Marker() : ObjectPtr(value);
+  }
+
+  const intptr_t mask_;
+  Entry* const entries_;
+  RelaxedAtomic<intptr_t> used_ = {0};
+  RelaxedAtomic<bool> full_ = {false};
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelForwardingTable);
+};
+
+// Holds pairs of (from, to) objects whose copy still has to be filled in.
+// Pairs are always pushed and popped together and blocks have an even size,
+// so a pair never straddles two blocks.
+class ObjectCopyStack : public BlockStack<kMarkingStackBlockSize> {
+ public:
+  void PushBlock(Block* block) {
+    BlockStack<Block::kSize>::PushBlockImpl(block);
+  }
+};
+
+typedef BlockWorkList<ObjectCopyStack> ObjectCopyWorkList;
+
+// The state shared by the sending thread and the helper tasks taking part in
+// a parallel copy phase.
+//
+// It is reference counted because helper tasks may start running only after
+// the phase is over, in which case they must not touch the heap anymore.
+class ParallelCopyState {
+ public:
+  ParallelCopyState(Thread* thread,
+                    IdentityMap* map,
+                    GrowableArray<ObjectPtr>* from_to,
+                    intptr_t capacity,
+                    intptr_t num_refs)
+      : thread_(thread),
+        map_(map),
+        from_to_(from_to),
+        table_(capacity),
+        refs_(num_refs) {}
+
+  void Release() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  // Looks [object] up among the objects forwarded before this phase, which
+  // don't change during the phase, and then among the ones forwarded by the
+  // workers.
+  ObjectPtr ForwardedObject(Thread* thread, ObjectPtr object) {
+    // Assign missing hashes using the worker's own random number generator;
+    // [map_] would use the sending thread's.
+    const uint32_t hash = IdentityMap::GetHeaderHash(thread, object);
+    const ObjectPtr to = map_->ForwardedObject(object, FastFromTo(*from_to_));
+    if (to != Marker()) {
+      return to;
+    }
+    return table_.Lookup(object, hash);
+  }
+
+  // Must only be called after [ForwardedObject] found no copy of [object].
+  intptr_t Claim(Thread* thread, ObjectPtr object, ObjectPtr* existing_to) {
+    const uint32_t hash = IdentityMap::GetHeaderHash(thread, object);
+    return table_.Claim(object, hash, existing_to);
+  }
+  void Publish(intptr_t index, ObjectPtr to) { table_.Publish(index, to); }
+  void Abandon(intptr_t index) { table_.Abandon(index); }
+
+  bool aborted() const { return aborted_; }
+  void Abort() {
+    MonitorLocker ml(&monitor_);
+    aborted_ = true;
+  }
+
+  // Called by a helper task before it enters the isolate group. Returns false
+  // if the phase is already over.
+  bool TryJoin() {
+    MonitorLocker ml(&monitor_);
+    if (aborted_) {
+      return false;
+    }
+    // Once the number of busy workers dropped to zero the work list was
+    // found empty and the phase is over.
+    uintptr_t busy = num_busy_.load();
+    do {
+      if (busy == 0) {
+        return false;
+      }
+    } while (!num_busy_.compare_exchange_weak(busy, busy + 1));
+    num_helpers_++;
+    return true;
+  }
+
+  // Called by a helper task after it has left the isolate group.
+  void Leave() {
+    MonitorLocker ml(&monitor_);
+    if (--num_helpers_ == 0) {
+      ml.Notify();
+    }
+  }
+
+  void WaitForHelpers() {
+    MonitorLocker ml(&monitor_);
+    while (num_helpers_ > 0) {
+      ml.Wait();
+    }
+  }
+
+ private:
+  friend class FastObjectCopy;
+  friend class ParallelObjectCopyTask;
+
+  Thread* const thread_;
+  IdentityMap* const map_;
+  GrowableArray<ObjectPtr>* const from_to_;
+  ParallelForwardingTable table_;
+  ObjectCopyStack stack_;
+  // The sending thread starts out busy.
+  RelaxedAtomic<uintptr_t> num_busy_ = {1};
+  RelaxedAtomic<bool> aborted_ = {false};
+  std::atomic<intptr_t> refs_;
+
+  Monitor monitor_;
+  intptr_t num_helpers_ = 0;
+
+  // What the workers hand over at the end of the phase, guarded by
+  // [monitor_].
+  MallocGrowableArray<ObjectPtr> from_to_results_;
+  MallocGrowableArray<TransferableTypedDataPtr> transferables_from_to_;
+  MallocGrowableArray<ExternalTypedDataPtr> external_typed_data_to_;
+  MallocGrowableArray<ObjectPtr> objects_to_rehash_;
+  MallocGrowableArray<ObjectPtr> expandos_to_rehash_;
+  MallocGrowableArray<WeakPropertyPtr> weak_properties_;
+  MallocGrowableArray<WeakReferencePtr> weak_references_;
+  intptr_t allocated_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelCopyState);
+};
+#endif  // defined(HASH_IN_OBJECT_HEADER)
+
 class ForwardMapBase {
  public:
   explicit ForwardMapBase(Thread* thread)
@@ -666,10 +926,50 @@ class FastForwardMap : public ForwardMapBase {
   }
 
   ObjectPtr ForwardedObject(ObjectPtr object) {
+#if defined(HASH_IN_OBJECT_HEADER)
+    if (parallel_ != nullptr) {
+      return parallel_->ForwardedObject(thread_, object);
+    }
+#endif
     return map_->ForwardedObject(object, FastFromTo(raw_from_to_));
   }
 
+#if defined(HASH_IN_OBJECT_HEADER)
+  // In a parallel copy phase an object has to be claimed before it is copied.
+  // Returns false if the caller must use [existing_to] instead.
+  bool TryClaim(ObjectPtr from, ObjectPtr* existing_to) {
+    if (parallel_ == nullptr) {
+      return true;
+    }
+    ASSERT(claimed_index_ == -1);
+    claimed_index_ = parallel_->Claim(thread_, from, existing_to);
+    return claimed_index_ != -1;
+  }
+
+  // Releases the claim on an object that could not be copied.
+  void AbandonClaim() {
+    if (parallel_ != nullptr && claimed_index_ != -1) {
+      parallel_->Abandon(claimed_index_);
+      claimed_index_ = -1;
+    }
+  }
+#endif
+
   void Insert(ObjectPtr from, ObjectPtr to, intptr_t size) {
+#if defined(HASH_IN_OBJECT_HEADER)
+    if (parallel_ != nullptr) {
+      // [raw_from_to_] only records the pairs this worker created, the pairs
+      // still to be filled in go to the shared work list.
+      ASSERT(claimed_index_ != -1);
+      parallel_->Publish(claimed_index_, to);
+      claimed_index_ = -1;
+      FastFromTo(raw_from_to_).Add(from, to);
+      work_list_->Push(from);
+      work_list_->Push(to);
+      allocated_bytes += size;
+      return;
+    }
+#endif
     map_->Insert(from, to, FastFromTo(raw_from_to_),
                  /*check_for_safepoint*/ false);
     allocated_bytes += size;
@@ -705,6 +1005,12 @@ class FastForwardMap : public ForwardMapBase {
   GrowableArray<WeakReferencePtr> raw_weak_references_;
   intptr_t fill_cursor_ = 0;
   intptr_t allocated_bytes = 0;
+#if defined(HASH_IN_OBJECT_HEADER)
+  // Set while this map belongs to a worker of a parallel copy phase.
+  ParallelCopyState* parallel_ = nullptr;
+  ObjectCopyWorkList* work_list_ = nullptr;
+  intptr_t claimed_index_ = -1;
+#endif
 
   DISALLOW_COPY_AND_ASSIGN(FastForwardMap);
 };
@@ -1411,6 +1717,15 @@ class FastObjectCopyBase : public ObjectCopyBase {
     const auto cid = UntaggedObject::ClassIdTag::decode(tags);
     const uword size =
         header_size != 0 ? header_size : from.untag()->HeapSize();
+#if defined(HASH_IN_OBJECT_HEADER)
+    ObjectPtr existing_to;
+    if (!fast_forward_map_.TryClaim(from, &existing_to)) [[unlikely]] {
+      if (existing_to == Marker()) {
+        exception_msg_ = kFastAllocationFailed;
+      }
+      return existing_to;
+    }
+#endif
     if (Heap::IsAllocatableInNewSpace(size)) {
       const uword alloc = new_space_->TryAllocateNoSafepoint(thread_, size);
       if (alloc != 0) {
@@ -1433,6 +1748,9 @@ class FastObjectCopyBase : public ObjectCopyBase {
         return to;
       }
     }
+#if defined(HASH_IN_OBJECT_HEADER)
+    fast_forward_map_.AbandonClaim();
+#endif
     exception_msg_ = kFastAllocationFailed;
     return Marker();
   }
@@ -2124,6 +2442,56 @@ class ObjectCopy : public Base {
 #undef DO
 };
 
+#if defined(HASH_IN_OBJECT_HEADER)
+// Don't bother helper tasks with fewer pending objects than this.
+static constexpr intptr_t kMinParallelCopyWork = 4 * kMarkingStackBlockSize;
+
+template <typename From, typename To>
+static void AppendAll(const From& from, To* to, intptr_t start = 0) {
+  for (intptr_t i = start; i < from.length(); i++) {
+    to->Add(from[i]);
+  }
+}
+
+static int CompareObjectPtrs(const ObjectPtr* a, const ObjectPtr* b) {
+  const uword x = static_cast<uword>(*a);
+  const uword y = static_cast<uword>(*b);
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static bool SortedContains(const GrowableArray<ObjectPtr>& sorted,
+                           ObjectPtr object) {
+  intptr_t lo = 0;
+  intptr_t hi = sorted.length() - 1;
+  while (lo <= hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    const int result = CompareObjectPtrs(&sorted[mid], &object);
+    if (result == 0) {
+      return true;
+    }
+    if (result < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return false;
+}
+
+class ParallelObjectCopyTask : public ThreadPool::Task {
+ public:
+  explicit ParallelObjectCopyTask(ParallelCopyState* state) : state_(state) {}
+  ~ParallelObjectCopyTask() { state_->Release(); }
+
+  virtual void Run();
+
+ private:
+  ParallelCopyState* state_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelObjectCopyTask);
+};
+#endif  // defined(HASH_IN_OBJECT_HEADER)
+
 class FastObjectCopy : public ObjectCopy<FastObjectCopyBase, false> {
  public:
   FastObjectCopy(Thread* thread, IdentityMap* map) : ObjectCopy(thread, map) {}
@@ -2131,6 +2499,9 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase, false> {
 
   ObjectPtr TryCopyGraphFast(ObjectPtr root) {
     NoSafepointScope no_safepoint_scope;
+#if defined(HASH_IN_OBJECT_HEADER)
+    parallel_copy_allowed_ = FLAG_object_copy_tasks > 0;
+#endif
 
     ObjectPtr root_copy = Forward(TagsFromUntaggedObject(root.untag()), root);
     if (root_copy == Marker()) {
@@ -2163,6 +2534,12 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase, false> {
           exception_msg_ = kFastAllocationFailed;
           return root_copy;
         }
+
+#if defined(HASH_IN_OBJECT_HEADER)
+        if (ShouldCopyInParallel()) {
+          parallel_copy_allowed_ = CopyPendingObjectsInParallel();
+        }
+#endif
       }
 
       // Possibly forward values of [WeakProperty]s if keys became reachable.
@@ -2259,9 +2636,188 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase, false> {
     return array;
   }
 
+#if defined(HASH_IN_OBJECT_HEADER)
+  // Takes part in a parallel copy phase: fills in the copies on [state]'s work
+  // list until it runs dry or the phase is aborted, then hands everything
+  // this worker forwarded over to [state].
+  void CopyInParallel(ParallelCopyState* state) {
+    ObjectCopyWorkList work_list(&state->stack_);
+    fast_forward_map_.parallel_ = state;
+    fast_forward_map_.work_list_ = &work_list;
+
+    for (;;) {
+      if (!DrainWorkList(state, &work_list)) {
+        // The sending thread finishes whatever is left.
+        work_list.AbandonWork();
+        state->stack_.WaitForWork(&state->num_busy_, /*abort=*/true);
+        break;
+      }
+      if (!work_list.WaitForWork(&state->num_busy_, state->aborted())) {
+        work_list.Finalize();
+        break;
+      }
+    }
+    fast_forward_map_.parallel_ = nullptr;
+    fast_forward_map_.work_list_ = nullptr;
+
+    auto& map = fast_forward_map_;
+    MonitorLocker ml(&state->monitor_);
+    AppendAll(map.raw_from_to_, &state->from_to_results_,
+              /*start=*/2);  // Skip the null entry.
+    AppendAll(map.raw_transferables_from_to_, &state->transferables_from_to_);
+    AppendAll(map.raw_external_typed_data_to_,
+              &state->external_typed_data_to_);
+    AppendAll(map.raw_objects_to_rehash_, &state->objects_to_rehash_);
+    AppendAll(map.raw_expandos_to_rehash_, &state->expandos_to_rehash_);
+    AppendAll(map.raw_weak_properties_, &state->weak_properties_);
+    AppendAll(map.raw_weak_references_, &state->weak_references_);
+    state->allocated_bytes_ += map.allocated_bytes;
+  }
+#endif  // defined(HASH_IN_OBJECT_HEADER)
+
  private:
   friend class ObjectGraphCopier;
 
+#if defined(HASH_IN_OBJECT_HEADER)
+  bool ShouldCopyInParallel() const {
+    if (!parallel_copy_allowed_) {
+      return false;
+    }
+    const intptr_t length = fast_forward_map_.raw_from_to_.length();
+    return length >= 2 * FLAG_parallel_object_copy_threshold &&
+           length - fast_forward_map_.fill_cursor_ >= 2 * kMinParallelCopyWork;
+  }
+
+  // Copies the pending objects, i.e. the ones after [fill_cursor_], together
+  // with FLAG_object_copy_tasks helper tasks, each of which allocates the
+  // copies in its own TLAB. Afterwards any objects the workers did not get
+  // to are after [fill_cursor_] again.
+  //
+  // Returns false if the phase was aborted for a reason that would abort
+  // another phase as well.
+  bool CopyPendingObjectsInParallel() {
+    TIMELINE_DURATION(thread_, Isolate, "ParallelObjectCopy");
+    auto& map = fast_forward_map_;
+    const intptr_t num_tasks = FLAG_object_copy_tasks;
+    // Leaves room for twice as many objects as have been forwarded so far.
+    const intptr_t capacity =
+        Utils::RoundUpToPowerOfTwo(2 * map.raw_from_to_.length());
+    auto state =
+        new ParallelCopyState(thread_, map.map_, &map.raw_from_to_, capacity,
+                              /*num_refs=*/num_tasks + 1);
+    {
+      ObjectCopyWorkList work_list(&state->stack_);
+      for (intptr_t i = map.fill_cursor_; i < map.raw_from_to_.length();
+           i += 2) {
+        work_list.Push(map.raw_from_to_[i]);
+        work_list.Push(map.raw_from_to_[i + 1]);
+      }
+      work_list.Flush();
+      work_list.Finalize();
+    }
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      Dart::thread_pool()->Run<ParallelObjectCopyTask>(state);
+    }
+    {
+      FastObjectCopy worker(thread_, map.map_);
+      worker.CopyInParallel(state);
+    }
+    state->WaitForHelpers();
+
+    const bool allow_retry = !state->aborted() || state->table_.is_full();
+    MergeParallelCopy(state);
+    state->Release();
+    return allow_retry;
+  }
+
+  void MergeParallelCopy(ParallelCopyState* state) {
+    auto& map = fast_forward_map_;
+    auto& from_to = map.raw_from_to_;
+
+    GrowableArray<ObjectPtr> unfinished(zone_, 0);
+    ObjectCopyStack::Block* block;
+    while ((block = state->stack_.PopNonEmptyBlock()) != nullptr) {
+      while (!block->IsEmpty()) {
+        const ObjectPtr to = block->Pop();
+        const ObjectPtr from = block->Pop();
+        FastFromTo(unfinished).Add(from, to);
+      }
+      state->stack_.PushBlock(block);
+    }
+
+    const auto& results = state->from_to_results_;
+    if (unfinished.is_empty()) {
+      for (intptr_t i = 0; i < results.length(); i += 2) {
+        map.Insert(results[i], results[i + 1], /*size=*/0);
+      }
+      map.fill_cursor_ = from_to.length();
+    } else {
+      // Only the objects after [fill_cursor_] may still need to be filled in,
+      // so reorder them as <copied by the workers> <unfinished> and rebuild
+      // the identity map.
+      GrowableArray<ObjectPtr> unfinished_from(zone_, unfinished.length() / 2);
+      for (intptr_t i = 0; i < unfinished.length(); i += 2) {
+        unfinished_from.Add(unfinished[i]);
+      }
+      unfinished_from.Sort(CompareObjectPtrs);
+
+      intptr_t length = map.fill_cursor_;
+      for (intptr_t i = map.fill_cursor_; i < from_to.length(); i += 2) {
+        if (!SortedContains(unfinished_from, from_to[i])) {
+          from_to[length++] = from_to[i];
+          from_to[length++] = from_to[i + 1];
+        }
+      }
+      from_to.SetLength(length);
+      for (intptr_t i = 0; i < results.length(); i += 2) {
+        if (!SortedContains(unfinished_from, results[i])) {
+          FastFromTo(from_to).Add(results[i], results[i + 1]);
+        }
+      }
+      map.fill_cursor_ = from_to.length();
+      AppendAll(unfinished, &from_to);
+      map.map_->Rebuild(FastFromTo(from_to));
+    }
+
+    AppendAll(state->transferables_from_to_, &map.raw_transferables_from_to_);
+    AppendAll(state->external_typed_data_to_,
+              &map.raw_external_typed_data_to_);
+    AppendAll(state->objects_to_rehash_, &map.raw_objects_to_rehash_);
+    AppendAll(state->expandos_to_rehash_, &map.raw_expandos_to_rehash_);
+    AppendAll(state->weak_properties_, &map.raw_weak_properties_);
+    AppendAll(state->weak_references_, &map.raw_weak_references_);
+    map.allocated_bytes += state->allocated_bytes_;
+  }
+
+  // Returns false if the phase was aborted.
+  bool DrainWorkList(ParallelCopyState* state, ObjectCopyWorkList* work_list) {
+    ObjectPtr from;
+    ObjectPtr to;
+    while (!state->aborted()) {
+      if (!work_list->Pop(&to)) {
+        return true;
+      }
+      const bool popped = work_list->Pop(&from);
+      ASSERT(popped);
+      USE(popped);
+      FastCopyObject(from, to);
+      if (exception_msg_ != nullptr) {
+        // The sending thread copies this object again and reports the error,
+        // if any, after the phase.
+        work_list->Push(from);
+        work_list->Push(to);
+        state->Abort();
+        return false;
+      }
+      if (state->thread_->IsSafepointRequested()) {
+        state->Abort();
+        return false;
+      }
+    }
+    return false;
+  }
+#endif  // defined(HASH_IN_OBJECT_HEADER)
+
   void FastCopyObject(ObjectPtr from, ObjectPtr to) {
     const uword tags = TagsFromUntaggedObject(from.untag());
     const intptr_t cid = UntaggedObject::ClassIdTag::decode(tags);
@@ -2291,8 +2847,32 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase, false> {
 
   ArrayPtr raw_objects_to_rehash_ = Array::null();
   ArrayPtr raw_expandos_to_rehash_ = Array::null();
+#if defined(HASH_IN_OBJECT_HEADER)
+  bool parallel_copy_allowed_ = false;
+#endif
 };
 
+#if defined(HASH_IN_OBJECT_HEADER)
+void ParallelObjectCopyTask::Run() {
+  if (!state_->TryJoin()) {
+    return;
+  }
+  // The sending thread doesn't check in while it waits for the helpers, so
+  // they must not wait for safepoints either.
+  Thread::EnterIsolateGroupAsHelper(state_->thread_->isolate_group(),
+                                    Thread::kUnknownTask,
+                                    /*bypass_safepoint=*/true);
+  {
+    Thread* thread = Thread::Current();
+    StackZone stack_zone(thread);
+    FastObjectCopy worker(thread, state_->map_);
+    worker.CopyInParallel(state_);
+  }
+  Thread::ExitIsolateGroupAsHelper(/*bypass_safepoint=*/true);
+  state_->Leave();
+}
+#endif  // defined(HASH_IN_OBJECT_HEADER)
+
 class SlowObjectCopy : public ObjectCopy<SlowObjectCopyBase, true> {
  public:
   SlowObjectCopy(Thread* thread, IdentityMap* map)
@@ -2738,4 +3318,311 @@ ObjectPtr CopyMutableObjectGraph(const Object& object) {
   return result;
 }
 
+// Builds a deeply immutable copy of an object graph in old space (see
+// [CopyDeeplyImmutableObjectGraph]).
+//
+// Objects are forwarded in two steps: [Forward] allocates an empty copy and
+// records it in [from_to_], which doubles as the worklist of copies whose
+// contents still have to be filled in by [FillCopies].
+class ObjectGraphFreezer : public StackResource {
+ public:
+  explicit ObjectGraphFreezer(Thread* thread)
+      : StackResource(thread),
+        thread_(thread),
+        zone_(thread->zone()),
+        map_(thread),
+        from_to_(GrowableObjectArray::Handle(
+            zone_,
+            GrowableObjectArray::New(kInitialCapacity, Heap::kOld))),
+        from_(Object::Handle(zone_)),
+        to_(Object::Handle(zone_)),
+        key_(Object::Handle(zone_)),
+        value_(Object::Handle(zone_)),
+        type_arguments_(TypeArguments::Handle(zone_)),
+        exception_unexpected_object_(Object::Handle(zone_)) {
+    // Index 0 is reserved as "not found" marker by [IdentityMap].
+    from_to_.Add(Object::null_object());
+    from_to_.Add(Object::null_object());
+  }
+
+  ObjectPtr Freeze(const Object& root) {
+    auto& result = Object::Handle(zone_);
+    {
+      LongJumpScope jump(thread_);  // e.g. for OOMs.
+      if (DART_SETJMP(*jump.Set()) == 0) {
+        result = Forward(root);
+        if (exception_msg_ == nullptr) {
+          FillCopies();
+        }
+      } else {
+        // The copy failed due to non-application error (e.g. OOM error),
+        // propagate this error.
+        result = thread_->StealStickyError();
+        RELEASE_ASSERT(result.IsError());
+      }
+    }
+
+    if (result.IsError()) {
+      Exceptions::PropagateError(Error::Cast(result));
+      UNREACHABLE();
+    }
+    if (exception_msg_ != nullptr) {
+      const char* message = exception_msg_;
+      if (!exception_unexpected_object_.IsNull()) {
+        message = OS::SCreate(
+            zone_, "%s\n%s", message,
+            FindRetainingPath(zone_, thread_, root,
+                              exception_unexpected_object_,
+                              TraversalRules::kInternalToIsolateGroup));
+      }
+      Exceptions::ThrowArgumentError(
+          String::Handle(zone_, String::New(message)));
+      UNREACHABLE();
+    }
+    return result.ptr();
+  }
+
+  intptr_t copied_objects() const { return (from_to_.Length() - 2) / 2; }
+
+ private:
+  static constexpr intptr_t kInitialCapacity = 64;
+
+  // Returns the shareable counterpart of [object], allocating an empty copy if
+  // it needs one. Records an error and returns null if [object] cannot be
+  // frozen.
+  ObjectPtr Forward(const Object& object) {
+    if (object.ptr()->IsImmediateObject() ||
+        CanShareObjectAcrossIsolates(object.ptr())) {
+      return object.ptr();
+    }
+    ObjectPtr existing = map_.ForwardedObject(object, SlowFromTo(from_to_));
+    if (existing != Marker()) {
+      return existing;
+    }
+
+    const intptr_t cid = object.GetClassId();
+    auto& to = Object::Handle(zone_);
+    switch (cid) {
+      case kArrayCid:
+      case kImmutableArrayCid: {
+        const auto& from = Array::Cast(object);
+        const auto& copy = Array::Handle(
+            zone_, ImmutableArray::New(from.Length(), Heap::kOld));
+        copy.SetTypeArguments(
+            TypeArguments::Handle(zone_, from.GetTypeArguments()));
+        to = copy.ptr();
+        break;
+      }
+      case kGrowableObjectArrayCid: {
+        const auto& from = GrowableObjectArray::Cast(object);
+        const auto& copy = Array::Handle(
+            zone_, ImmutableArray::New(from.Length(), Heap::kOld));
+        copy.SetTypeArguments(
+            TypeArguments::Handle(zone_, from.GetTypeArguments()));
+        to = copy.ptr();
+        break;
+      }
+      case kMapCid: {
+        const auto& from = Map::Cast(object);
+        const auto& copy =
+            Map::Handle(zone_, ConstMap::NewUninitialized(Heap::kOld));
+        InitializeConstHash(copy, from.GetTypeArguments(), 2 * from.Length());
+        to = copy.ptr();
+        break;
+      }
+      case kSetCid: {
+        const auto& from = Set::Cast(object);
+        const auto& copy =
+            Set::Handle(zone_, ConstSet::NewUninitialized(Heap::kOld));
+        InitializeConstHash(copy, from.GetTypeArguments(), from.Length());
+        to = copy.ptr();
+        break;
+      }
+      case kRecordCid: {
+        const auto& from = Record::Cast(object);
+        to = Record::New(from.shape(), Heap::kOld);
+        break;
+      }
+      default:
+        if (IsTypedDataBaseClassId(cid) && cid != kPointerCid) {
+          to = FreezeTypedData(TypedDataBase::Cast(object));
+          break;
+        }
+        SetError(object, "Only lists, maps, sets, records, typed data and "
+                         "deeply immutable objects can be frozen");
+        return Object::null();
+    }
+    to.SetDeeplyImmutable();
+    map_.Insert(object, to, SlowFromTo(from_to_),
+                /*check_for_safepoint=*/true);
+    return to.ptr();
+  }
+
+  void InitializeConstHash(const LinkedHashBase& copy,
+                           TypeArgumentsPtr type_arguments,
+                           intptr_t used_data) {
+    type_arguments_ = type_arguments;
+    copy.SetTypeArguments(type_arguments_);
+    copy.set_used_data(used_data);
+    const auto& data =
+        Array::Handle(zone_, ImmutableArray::New(used_data, Heap::kOld));
+    data.SetDeeplyImmutable();
+    copy.set_data(data);
+    copy.set_deleted_keys(0);
+    copy.ComputeAndSetHashMask();
+  }
+
+  // Copies the bytes viewed by [from] into a fresh immutable backing store and
+  // returns an unmodifiable view of it.
+  ObjectPtr FreezeTypedData(const TypedDataBase& from) {
+    const intptr_t cid = from.GetClassId();
+    intptr_t data_cid;
+    intptr_t view_cid;
+    if (cid == kByteDataViewCid || cid == kUnmodifiableByteDataViewCid) {
+      data_cid = kTypedDataUint8ArrayCid;
+      view_cid = kUnmodifiableByteDataViewCid;
+    } else {
+      data_cid =
+          cid - ((cid - kFirstTypedDataCid) % kNumTypedDataCidRemainders);
+      view_cid = data_cid + kTypedDataCidRemainderUnmodifiable;
+    }
+    const intptr_t length_in_bytes = from.LengthInBytes();
+    const auto& data = TypedData::Handle(
+        zone_, TypedData::New(data_cid,
+                              length_in_bytes /
+                                  TypedData::ElementSizeInBytes(data_cid),
+                              Heap::kOld));
+    if (length_in_bytes > 0) {
+      NoSafepointScope no_safepoint;
+      memmove(data.DataAddr(0), from.DataAddr(0), length_in_bytes);
+    }
+    data.SetDeeplyImmutable();  // Can pass by reference.
+    return TypedDataView::New(view_cid, data, 0, data.Length(), Heap::kOld);
+  }
+
+  // Fills in the contents of all copies made by [Forward], including the ones
+  // it makes while doing so.
+  void FillCopies() {
+    for (intptr_t i = 2; i < from_to_.Length(); i += 2) {
+      from_ = from_to_.At(i);
+      to_ = from_to_.At(i + 1);
+      switch (from_.GetClassId()) {
+        case kArrayCid:
+        case kImmutableArrayCid: {
+          const auto& from = Array::Cast(from_);
+          const auto& to = Array::Cast(to_);
+          for (intptr_t j = 0, n = from.Length(); j < n; j++) {
+            value_ = from.At(j);
+            value_ = Forward(value_);
+            to.SetAt(j, value_);
+          }
+          break;
+        }
+        case kGrowableObjectArrayCid: {
+          const auto& from = GrowableObjectArray::Cast(from_);
+          const auto& to = Array::Cast(to_);
+          for (intptr_t j = 0, n = to.Length(); j < n; j++) {
+            value_ = from.At(j);
+            value_ = Forward(value_);
+            to.SetAt(j, value_);
+          }
+          break;
+        }
+        case kMapCid: {
+          const auto& data =
+              Array::Handle(zone_, LinkedHashBase::Cast(to_).data());
+          Map::Iterator iterator(Map::Cast(from_));
+          intptr_t j = 0;
+          while (iterator.MoveNext()) {
+            key_ = iterator.CurrentKey();
+            if (!CheckKey(key_)) return;
+            data.SetAt(j++, key_);
+            value_ = iterator.CurrentValue();
+            value_ = Forward(value_);
+            data.SetAt(j++, value_);
+          }
+          break;
+        }
+        case kSetCid: {
+          const auto& data =
+              Array::Handle(zone_, LinkedHashBase::Cast(to_).data());
+          Set::Iterator iterator(Set::Cast(from_));
+          intptr_t j = 0;
+          while (iterator.MoveNext()) {
+            key_ = iterator.CurrentKey();
+            if (!CheckKey(key_)) return;
+            data.SetAt(j++, key_);
+          }
+          break;
+        }
+        case kRecordCid: {
+          const auto& from = Record::Cast(from_);
+          const auto& to = Record::Cast(to_);
+          for (intptr_t j = 0, n = from.num_fields(); j < n; j++) {
+            value_ = from.FieldAt(j);
+            value_ = Forward(value_);
+            to.SetFieldAt(j, value_);
+          }
+          break;
+        }
+        default:
+          // Typed data is copied eagerly by [Forward].
+          ASSERT(IsTypedDataBaseClassId(from_.GetClassId()));
+          break;
+      }
+      if (exception_msg_ != nullptr) return;
+      thread_->CheckForSafepoint();
+    }
+  }
+
+  // Constant maps and sets hash predefined classes by value and all other
+  // keys by identity, so only keys that keep both their identity and their
+  // hash code can be used as they are.
+  bool CheckKey(const Object& key) {
+    if (key.ptr()->IsImmediateObject() || key.IsNull() || key.IsCanonical()) {
+      return true;
+    }
+    if (key.GetClassId() < kNumPredefinedCids &&
+        CanShareObjectAcrossIsolates(key.ptr())) {
+      return true;
+    }
+    SetError(key, "Only constants and deeply immutable objects of core "
+                  "types can be keys of frozen maps and sets");
+    return false;
+  }
+
+  void SetError(const Object& object, const char* message) {
+    exception_msg_ = OS::SCreate(
+        zone_, "Illegal argument in Isolate.freeze: %s - %s", message,
+        Class::Handle(zone_, object.clazz()).ToCString());
+    exception_unexpected_object_ = object.ptr();
+  }
+
+  Thread* thread_;
+  Zone* zone_;
+  IdentityMap map_;
+  const GrowableObjectArray& from_to_;
+  Object& from_;
+  Object& to_;
+  Object& key_;
+  Object& value_;
+  TypeArguments& type_arguments_;
+  const char* exception_msg_ = nullptr;
+  Object& exception_unexpected_object_;
+};
+
+ObjectPtr CopyDeeplyImmutableObjectGraph(const Object& root) {
+  auto thread = Thread::Current();
+  TIMELINE_DURATION(thread, Isolate, "CopyDeeplyImmutableObjectGraph");
+  ObjectGraphFreezer freezer(thread);
+  ObjectPtr result = freezer.Freeze(root);
+#if defined(SUPPORT_TIMELINE)
+  if (tbes.enabled()) {
+    tbes.SetNumArguments(1);
+    tbes.FormatArgument(0, "CopiedObjects", "%" Pd, freezer.copied_objects());
+  }
+#endif
+  return result;
+}
+
 }  // namespace dart
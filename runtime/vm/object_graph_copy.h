@@ -31,6 +31,16 @@ bool CanShareObjectAcrossIsolates(ObjectPtr obj);
 // those objects.
 ObjectPtr CopyMutableObjectGraph(const Object& root);
 
+// Makes a deeply immutable copy of the object graph referenced by [root] in old
+// space, which can then be shared by reference with all isolates of the group.
+//
+// Lists, maps and sets are copied into their constant counterparts, typed data
+// into unmodifiable views of immutable copies and records field by field.
+// Objects that can already be shared are used as they are. Throws an
+// ArgumentError if the graph contains any other object, or a map key or set
+// element that wouldn't behave the same in a constant map or set.
+ObjectPtr CopyDeeplyImmutableObjectGraph(const Object& root);
+
 typedef enum {
   kInternalToIsolateGroup,
   kExternalBetweenIsolateGroups,
@@ -217,6 +217,7 @@ class ObjectPointerVisitor;
   RW(Array, ffi_callback_functions)                                            \
   /* Roots for JIT/AOT snapshots are up until here (see to_snapshot() below)*/ \
   RW(Array, dispatch_table_code_entries)                                       \
+  RW(Array, code_hotness)                                                      \
   RW(GrowableObjectArray, instructions_tables)                                 \
   RW(GrowableObjectArray, tag_table)                                           \
   RW(Array, obfuscation_map)                                                   \
@@ -227,6 +228,7 @@ class ObjectPointerVisitor;
   R_(Array, dart_args_1)                                                       \
   R_(Array, dart_args_2)                                                       \
   RW(Array, thread_locals)                                                     \
+  RW(WeakArray, regexp_match_cache)                                            \
   R_(GrowableObjectArray, resume_capabilities)                                 \
   R_(GrowableObjectArray, exit_listeners)                                      \
   R_(GrowableObjectArray, error_listeners)
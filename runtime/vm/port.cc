@@ -20,10 +20,11 @@
 namespace dart {
 
 Mutex* PortMap::mutex_ = nullptr;
-PortSet<PortMap::Entry>* PortMap::ports_ = nullptr;
+RcuDomain* PortMap::rcu_ = nullptr;
+AcqRelAtomic<PortMap::Ports*> PortMap::ports_ = {nullptr};
 Random* PortMap::prng_ = nullptr;
 
-Dart_Port PortMap::AllocatePort() {
+Dart_Port PortMap::AllocatePort(Ports* ports) {
   Dart_Port result;
 
   ASSERT(mutex_->IsOwnedByCurrentThread());
@@ -41,31 +42,31 @@ Dart_Port PortMap::AllocatePort() {
 
     // The two special marker ports are used for the hashset implementation and
     // cannot be used as actual ports.
-    if (result == PortSet<Entry>::kFreePort ||
-        result == PortSet<Entry>::kDeletedPort) {
+    if (result == Ports::kFreePort || result == Ports::kDeletedPort) {
       continue;
     }
 
     ASSERT(!static_cast<ObjectPtr>(static_cast<uword>(result))->IsWellFormed());
-  } while (ports_->Contains(result));
+  } while (ports->Contains(result));
 
   ASSERT(result != 0);
-  ASSERT(!ports_->Contains(result));
+  ASSERT(!ports->Contains(result));
   return result;
 }
 
 Dart_Port PortMap::CreatePort(PortHandler* handler) {
   ASSERT(handler != nullptr);
   PortMap::Locker ml;
-  if (ports_ == nullptr) {
+  Ports* ports = ports_.load();
+  if (ports == nullptr) {
     return ILLEGAL_PORT;
   }
 
-  const Dart_Port port = AllocatePort();
-  if (auto ports = handler->ports(ml)) {
-    ports->Insert(PortHandler::PortSetEntry{port});
+  const Dart_Port port = AllocatePort(ports);
+  if (auto handler_ports = handler->ports(ml)) {
+    handler_ports->Insert(PortHandler::PortSetEntry{port});
   }
-  ports_->Insert(Entry{port, handler});
+  ports->Insert(port, handler);
 
   if (FLAG_trace_isolates) {
     OS::PrintErr(
@@ -84,31 +85,30 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
   PortHandler* handler = nullptr;
   {
     PortMap::Locker ml;
-    if (ports_ == nullptr) {
+    Ports* ports = ports_.load();
+    if (ports == nullptr) {
       return false;
     }
-    auto it = ports_->TryLookup(port);
-    if (it == ports_->end()) {
+    handler = ports->Remove(port);
+    if (handler == nullptr) {
       return false;
     }
-    Entry entry = *it;
-    handler = entry.handler;
-    ASSERT(handler != nullptr);
 
 #if defined(DEBUG)
     handler->CheckAccess();
 #endif
 
-    it.Delete();
-    ports_->Rebalance();
-
-    if (auto ports = handler->ports(ml)) {
-      auto isolate_it = ports->TryLookup(port);
-      ASSERT(isolate_it != ports->end());
+    if (auto handler_ports = handler->ports(ml)) {
+      auto isolate_it = handler_ports->TryLookup(port);
+      ASSERT(isolate_it != handler_ports->end());
       isolate_it.Delete();
-      ports->Rebalance();
+      handler_ports->Rebalance();
     }
   }
+  // Wait for messages which are being posted to the closed port. This
+  // doesn't need the lock, so other threads can keep creating and closing
+  // ports meanwhile.
+  rcu_->Synchronize();
   handler->OnPortClosed(port);
   if (port_handler != nullptr) *port_handler = handler;
   return true;
@@ -117,55 +117,77 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
 void PortMap::ClosePorts(MessageHandler* handler) {
   {
     PortMap::Locker ml;
-    if (ports_ == nullptr) {
+    Ports* ports = ports_.load();
+    if (ports == nullptr) {
       return;
     }
 
-    auto ports = handler->ports(ml);
-    ASSERT(ports != nullptr);
+    auto handler_ports = handler->ports(ml);
+    ASSERT(handler_ports != nullptr);
 
-    for (auto isolate_it = ports->begin(); isolate_it != ports->end();
-         ++isolate_it) {
-      auto it = ports_->TryLookup((*isolate_it).port);
-      ASSERT(it != ports_->end());
-      Entry entry = *it;
-      ASSERT(entry.port == (*isolate_it).port);
-      ASSERT(entry.handler == handler);
-      it.Delete();
+    for (auto isolate_it = handler_ports->begin();
+         isolate_it != handler_ports->end(); ++isolate_it) {
+      PortHandler* removed = ports->Remove((*isolate_it).port);
+      ASSERT(removed == handler);
       isolate_it.Delete();
     }
-    ASSERT(ports->IsEmpty());
-    ports_->Rebalance();
+    ASSERT(handler_ports->IsEmpty());
+    handler_ports->Rebalance();
   }
+  // Wait for messages which are being posted to the closed ports, without
+  // holding the lock.
+  rcu_->Synchronize();
   handler->OnAllPortsClosed();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
                           bool before_events) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  RcuDomain::ReadScope rs(rcu_);
+  Ports* ports = ports_.load();
+  if (ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
+  PortHandler* handler = ports->Lookup(message->dest_port());
+  if (handler == nullptr) {
     // Ownership of external data remains with the poster.
     message->DropFinalizers();
     return false;
   }
-  auto handler = (*it).handler;
-  ASSERT(handler != nullptr);
   handler->PostMessage(std::move(message), before_events);
   return true;
 }
 
+bool PortMap::PostMessages(Dart_Port id, MessageQueue* messages) {
+#if defined(DEBUG)
+  MessageQueue::Iterator it(messages);
+  while (it.HasNext()) {
+    ASSERT(it.Next()->dest_port() == id);
+  }
+#endif
+  RcuDomain::ReadScope rs(rcu_);
+  Ports* ports = ports_.load();
+  PortHandler* handler = ports != nullptr ? ports->Lookup(id) : nullptr;
+  if (handler == nullptr) {
+    // Ownership of external data remains with the poster.
+    MessageQueue::Iterator it(messages);
+    while (it.HasNext()) {
+      it.Next()->DropFinalizers();
+    }
+    messages->Clear();
+    return false;
+  }
+  handler->PostMessages(messages);
+  return true;
+}
+
 #if defined(TESTING)
 bool PortMap::PortExists(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  RcuDomain::ReadScope rs(rcu_);
+  Ports* ports = ports_.load();
+  if (ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(id);
-  return it != ports_->end();
+  return ports->Contains(id);
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
@@ -175,31 +197,29 @@ Isolate* PortMap::GetIsolate(Dart_Port id) {
 #endif  // defined(TESTING)
 
 Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
-  if (ports_ == nullptr) {
+  Ports* ports = ports_.load();
+  if (ports == nullptr) {
     return nullptr;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  PortHandler* handler = ports->Lookup(id);
+  if (handler == nullptr) {
     // Port does not exist.
     return nullptr;
   }
-
-  auto handler = (*it).handler;
   return handler->isolate();
 }
 
 Dart_Port PortMap::GetOriginId(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  RcuDomain::ReadScope rs(rcu_);
+  Ports* ports = ports_.load();
+  if (ports == nullptr) {
     return ILLEGAL_PORT;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  PortHandler* handler = ports->Lookup(id);
+  if (handler == nullptr) {
     // Port does not exist.
     return ILLEGAL_PORT;
   }
-
-  auto handler = (*it).handler;
   Isolate* isolate = handler->isolate();
   if (isolate == nullptr) {
     // Message handler is a native port instead of an isolate.
@@ -233,15 +253,14 @@ IsolateAcquireResult PortMap::AcquireIsolateByControlPort(Dart_Port target_port,
                                                           Isolate** p_isolate) {
   ASSERT(p_isolate != nullptr);
   Locker ml;  // isolates are not exiting while we hold this lock
-  if (ports_ == nullptr) {
+  Ports* ports = ports_.load();
+  if (ports == nullptr) {
     return IsolateAcquireResult::ISOLATE_NOT_AVAILABLE;
   }
-  auto it = ports_->TryLookup(target_port);
-  if (it == ports_->end()) {
+  PortHandler* target_handler = ports->Lookup(target_port);
+  if (target_handler == nullptr) {
     return IsolateAcquireResult::ISOLATE_NOT_AVAILABLE;
   }
-  auto target_handler = (*it).handler;
-  ASSERT(target_handler != nullptr);
   auto target_isolate = target_handler->isolate();
 
   if (!target_handler->isolate()->is_acquirable()) {
@@ -261,7 +280,7 @@ IsolateAcquireResult PortMap::AcquireIsolateByControlPort(Dart_Port target_port,
 #if defined(TESTING)
 bool PortMap::HasPorts(MessageHandler* handler) {
   Locker ml;
-  if (ports_ == nullptr) {
+  if (ports_.load() == nullptr) {
     return false;
   }
   // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
@@ -272,17 +291,18 @@ bool PortMap::HasPorts(MessageHandler* handler) {
 
 bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
                                                    IsolateGroup* group) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  RcuDomain::ReadScope rs(rcu_);
+  Ports* ports = ports_.load();
+  if (ports == nullptr) {
     // Port was closed.
     return true;
   }
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) {
+  PortHandler* handler = ports->Lookup(receiver);
+  if (handler == nullptr) {
     // Port was closed.
     return true;
   }
-  auto isolate = (*it).handler->isolate();
+  auto isolate = handler->isolate();
   if (isolate == nullptr) {
     // Port belongs to a native port instead of an isolate.
     return false;
@@ -295,38 +315,40 @@ void PortMap::Init() {
     mutex_ = new Mutex();
   }
   ASSERT(mutex_ != nullptr);
+  if (rcu_ == nullptr) {
+    rcu_ = new RcuDomain();
+  }
   if (prng_ == nullptr) {
     prng_ = new Random();
   }
-  if (ports_ == nullptr) {
-    ports_ = new PortSet<Entry>();
+  if (ports_.load() == nullptr) {
+    ports_.store(new Ports(rcu_));
   }
 }
 
 void PortMap::Shutdown() {
   // Tell all handlers which are running their own thread pools to shutdown.
-  for (auto& entry : *ports_) {
-    entry.handler->Shutdown();
-  }
+  ports_.load()->ForEach(
+      [](Dart_Port port, PortHandler* handler) { handler->Shutdown(); });
 }
 
 void PortMap::Cleanup() {
-  ASSERT(ports_ != nullptr);
-  ASSERT(prng_ != nullptr);
-  for (auto it = ports_->begin(); it != ports_->end(); ++it) {
-    const auto& entry = *it;
-    ASSERT(entry.handler != nullptr);
-    delete entry.handler;
-    it.Delete();
+  Ports* ports;
+  {
+    Locker ml;
+    ports = ports_.load();
+    ASSERT(ports != nullptr);
+    ASSERT(prng_ != nullptr);
+    ports_.store(nullptr);
+    rcu_->Synchronize();
+    delete prng_;
+    prng_ = nullptr;
   }
-  ports_->Rebalance();
-
-  // Grab the mutex and delete the port set.
-  Locker ml;
-  delete prng_;
-  prng_ = nullptr;
-  delete ports_;
-  ports_ = nullptr;
+  ports->ForEach([](Dart_Port port, PortHandler* handler) {
+    ASSERT(handler != nullptr);
+    delete handler;
+  });
+  delete ports;
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -338,24 +360,30 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
   {
     JSONArray ports(&jsobj, "ports");
     SafepointMutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
+    if (ports_.load() == nullptr) {
       return;
     }
-    for (auto& entry : *ports_) {
-      if (entry.handler == handler) {
-        JSONObject port(&ports);
-        port.AddProperty("type", "_Port");
-        port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
-        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-        port.AddProperty("handler", msg_handler);
+    ports_.load()->ForEach([&](Dart_Port port, PortHandler* port_handler) {
+      if (port_handler == handler) {
+        JSONObject port_object(&ports);
+        port_object.AddProperty("type", "_Port");
+        port_object.AddPropertyF("name", "Isolate Port (%" Pd64 ")", port);
+        msg_handler = DartLibraryCalls::LookupHandler(port);
+        port_object.AddProperty("handler", msg_handler);
       }
-    }
+    });
   }
 #endif
 }
 
 PortHandler::~PortHandler() {}
 
+void PortHandler::PostMessages(MessageQueue* messages) {
+  while (std::unique_ptr<Message> message = messages->Dequeue()) {
+    PostMessage(std::move(message));
+  }
+}
+
 #if defined(DEBUG)
 void PortHandler::CheckAccess() const {
   // By default there is no checking.
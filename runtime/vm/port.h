@@ -8,18 +8,21 @@
 #include <memory>
 
 #include "include/dart_api.h"
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/globals.h"
 #include "vm/json_stream.h"
 #include "vm/lockers.h"
 #include "vm/port_set.h"
 #include "vm/random.h"
+#include "vm/rcu.h"
 
 namespace dart {
 
 class Isolate;
 class Message;
 class MessageHandler;
+class MessageQueue;
 class Mutex;
 class PortHandler;
 
@@ -31,6 +34,12 @@ enum class IsolateAcquireResult {
   HAS_MESSAGE_LOOP_OR_UNAVAILABLE,
 };
 
+// Maps ports to the handlers of their messages.
+//
+// Creating and closing ports is serialized by a lock, while message posting
+// and other lookups which don't need to own the port's isolate are lock-free.
+// Closing a port waits for all lock-free lookups which might have seen it, so
+// a handler is not used anymore once all its ports are closed.
 class PortMap : public AllStatic {
  public:
   // Allocate a port for the provided handler and return its VM-global id.
@@ -51,6 +60,13 @@ class PortMap : public AllStatic {
   static bool PostMessage(std::unique_ptr<Message> message,
                           bool before_events = false);
 
+  // Enqueues all messages in [messages], which must be addressed to the port
+  // with id, with a single port lookup. Returns false if the port is not
+  // active any longer, in which case no message was enqueued.
+  //
+  // Claims ownership of the messages.
+  static bool PostMessages(Dart_Port id, MessageQueue* messages);
+
   // Returns the origin id for port 'id'.
   static Dart_Port GetOriginId(Dart_Port id);
 
@@ -88,23 +104,20 @@ class PortMap : public AllStatic {
   };
 
  private:
-  struct Entry : public PortSet<Entry>::Entry {
-    Entry() : handler(nullptr) {}
-    Entry(Dart_Port port, PortHandler* handler)
-        : PortSet<Entry>::Entry(port), handler(handler) {}
-
-    PortHandler* handler;
-  };
+  using Ports = ConcurrentPortSet<PortHandler>;
 
   // Allocate a new unique port.
-  static Dart_Port AllocatePort();
+  static Dart_Port AllocatePort(Ports* ports);
 
   static Isolate* GetIsolateLocked(const Locker& ml, Dart_Port id);
 
-  // Lock protecting access to the port map.
+  // Lock serializing all modifications of the port map.
   static Mutex* mutex_;
 
-  static PortSet<Entry>* ports_;
+  // Tracks the lock-free lookups of the port map.
+  static RcuDomain* rcu_;
+
+  static AcqRelAtomic<Ports*> ports_;
 
   static Random* prng_;
 };
@@ -140,6 +153,10 @@ class PortHandler {
   virtual void PostMessage(std::unique_ptr<Message> message,
                            bool before_events = false) = 0;
 
+  // Posts all messages in [messages] in order, leaving it empty. Handlers can
+  // override this to wake up their receiver only once per batch.
+  virtual void PostMessages(MessageQueue* messages);
+
  protected:
   struct PortSetEntry : public PortSet<PortSetEntry>::Entry {
     PortSetEntry() : Entry() {}
@@ -5,11 +5,14 @@
 #ifndef RUNTIME_VM_PORT_SET_H_
 #define RUNTIME_VM_PORT_SET_H_
 
+#include <atomic>
+
 #include "include/dart_api.h"
 
 #include "platform/allocation.h"
 #include "platform/globals.h"
 #include "platform/utils.h"
+#include "vm/rcu.h"
 
 namespace dart {
 
@@ -232,6 +235,164 @@ class PortSet {
 #endif
 };
 
+// A map from ports to values of type V* which can be read without locks.
+//
+// Lookups must happen inside a RcuDomain::ReadScope of [rcu], or with the
+// writers' lock held. All other operations are writes, which the caller
+// serializes. A slot is never reused until the whole table is rebuilt, so a
+// reader that matched a port always gets the value it was inserted with.
+// Rebuilt tables are published atomically and the old table is freed after
+// a grace period.
+//
+// Values removed from the map may still be in use by readers until the next
+// RcuDomain::Synchronize.
+template <typename V>
+class ConcurrentPortSet : public MallocAllocated {
+ public:
+  static constexpr Dart_Port kFreePort = static_cast<Dart_Port>(0);
+  static constexpr Dart_Port kDeletedPort = static_cast<Dart_Port>(3);
+
+  explicit ConcurrentPortSet(RcuDomain* rcu)
+      : rcu_(rcu), table_(new Table(kInitialCapacity)) {}
+  ~ConcurrentPortSet() { delete table_.load(std::memory_order_relaxed); }
+
+  V* Lookup(Dart_Port port) const {
+    if (port == kFreePort || port == kDeletedPort) {
+      return nullptr;
+    }
+    const Table* table = table_.load(std::memory_order_acquire);
+    const intptr_t mask = table->capacity - 1;
+    for (intptr_t index = Hash(port) & mask;; index = (index + 1) & mask) {
+      const Slot& slot = table->slots[index];
+      const Dart_Port slot_port = slot.port.load(std::memory_order_acquire);
+      if (slot_port == port) {
+        return slot.value.load(std::memory_order_relaxed);
+      }
+      if (slot_port == kFreePort) {
+        return nullptr;
+      }
+    }
+  }
+
+  bool Contains(Dart_Port port) const { return Lookup(port) != nullptr; }
+
+  bool IsEmpty() const { return used_ == 0; }
+
+  void Insert(Dart_Port port, V* value) {
+    ASSERT(port != kFreePort && port != kDeletedPort);
+    ASSERT(value != nullptr);
+    ASSERT(!Contains(port));
+    Table* table = table_.load(std::memory_order_relaxed);
+    if ((used_ + deleted_ + 1) > ((table->capacity / 4) * 3)) {
+      // Grow if the live ports would fill more than half of the table,
+      // otherwise only flush the deleted slots.
+      const intptr_t capacity = (used_ + 1) > (table->capacity / 2)
+                                    ? table->capacity * 2
+                                    : table->capacity;
+      table = Rebuild(capacity);
+    }
+    const intptr_t mask = table->capacity - 1;
+    intptr_t index = Hash(port) & mask;
+    while (table->slots[index].port.load(std::memory_order_relaxed) !=
+           kFreePort) {
+      index = (index + 1) & mask;
+    }
+    table->slots[index].value.store(value, std::memory_order_relaxed);
+    table->slots[index].port.store(port, std::memory_order_release);
+    used_++;
+  }
+
+  // Returns the value of the removed port, or nullptr if the port is not in
+  // the map.
+  V* Remove(Dart_Port port) {
+    if (port == kFreePort || port == kDeletedPort) {
+      return nullptr;
+    }
+    Table* table = table_.load(std::memory_order_relaxed);
+    const intptr_t mask = table->capacity - 1;
+    for (intptr_t index = Hash(port) & mask;; index = (index + 1) & mask) {
+      Slot& slot = table->slots[index];
+      const Dart_Port slot_port = slot.port.load(std::memory_order_relaxed);
+      if (slot_port == port) {
+        slot.port.store(kDeletedPort, std::memory_order_release);
+        used_--;
+        deleted_++;
+        return slot.value.load(std::memory_order_relaxed);
+      }
+      if (slot_port == kFreePort) {
+        return nullptr;
+      }
+    }
+  }
+
+  // Calls [visitor] with the port and value of every entry. Must not modify
+  // the map.
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const {
+    const Table* table = table_.load(std::memory_order_relaxed);
+    for (intptr_t i = 0; i < table->capacity; i++) {
+      const Dart_Port port =
+          table->slots[i].port.load(std::memory_order_relaxed);
+      if (port != kFreePort && port != kDeletedPort) {
+        visitor(port, table->slots[i].value.load(std::memory_order_relaxed));
+      }
+    }
+  }
+
+ private:
+  static constexpr intptr_t kInitialCapacity = 64;
+
+  struct Slot {
+    std::atomic<Dart_Port> port;
+    std::atomic<V*> value;
+  };
+
+  struct Table : public MallocAllocated {
+    explicit Table(intptr_t capacity)
+        : capacity(capacity), slots(new Slot[capacity]) {
+      ASSERT(Utils::IsPowerOfTwo(capacity));
+      for (intptr_t i = 0; i < capacity; i++) {
+        slots[i].port.store(kFreePort, std::memory_order_relaxed);
+        slots[i].value.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    ~Table() { delete[] slots; }
+
+    const intptr_t capacity;
+    Slot* const slots;
+  };
+
+  // The low bits of ports are always set, see PortMap::AllocatePort.
+  static uword Hash(Dart_Port port) { return static_cast<uword>(port) >> 2; }
+
+  Table* Rebuild(intptr_t capacity) {
+    Table* old_table = table_.load(std::memory_order_relaxed);
+    Table* new_table = new Table(capacity);
+    const intptr_t mask = capacity - 1;
+    ForEach([&](Dart_Port port, V* value) {
+      intptr_t index = Hash(port) & mask;
+      while (new_table->slots[index].port.load(std::memory_order_relaxed) !=
+             kFreePort) {
+        index = (index + 1) & mask;
+      }
+      new_table->slots[index].port.store(port, std::memory_order_relaxed);
+      new_table->slots[index].value.store(value, std::memory_order_relaxed);
+    });
+    table_.store(new_table, std::memory_order_release);
+    deleted_ = 0;
+    rcu_->Synchronize();
+    delete old_table;
+    return new_table;
+  }
+
+  RcuDomain* const rcu_;
+  std::atomic<Table*> table_;
+  intptr_t used_ = 0;
+  intptr_t deleted_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentPortSet);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_PORT_SET_H_
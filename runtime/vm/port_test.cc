@@ -3,10 +3,14 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/port.h"
+
+#include <atomic>
+
 #include "platform/assert.h"
 #include "vm/lockers.h"
 #include "vm/message_handler.h"
 #include "vm/os.h"
+#include "vm/thread_pool.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -104,6 +108,31 @@ TEST_CASE(PortMap_PostIntegerMessage) {
   PortMap::ClosePorts(&handler);
 }
 
+TEST_CASE(PortMap_PostMessages) {
+  PortTestMessageHandler handler;
+  Dart_Port port = PortMap::CreatePort(&handler);
+  EXPECT_EQ(0, handler.notify_count);
+
+  MessageQueue batch;
+  for (intptr_t i = 0; i < 3; i++) {
+    batch.Enqueue(Message::New(port, Smi::New(i), Message::kNormalPriority),
+                  /*before_events=*/false);
+  }
+  EXPECT(PortMap::PostMessages(port, &batch));
+  EXPECT(batch.IsEmpty());
+
+  // The handler is notified once for the whole batch.
+  EXPECT_EQ(1, handler.notify_count);
+  PortMap::ClosePort(port);
+
+  batch.Enqueue(Message::New(port, Smi::New(3), Message::kNormalPriority),
+                /*before_events=*/false);
+  EXPECT(!PortMap::PostMessages(port, &batch));
+  EXPECT(batch.IsEmpty());
+  EXPECT_EQ(1, handler.notify_count);
+  PortMap::ClosePorts(&handler);
+}
+
 TEST_CASE(PortMap_PostMessageClosedPort) {
   // Create a port id and make it invalid.
   PortTestMessageHandler handler;
@@ -118,4 +147,81 @@ TEST_CASE(PortMap_PostMessageClosedPort) {
                    message_len, nullptr, Message::kNormalPriority)));
 }
 
+namespace {
+
+class CountingMessageHandler : public MessageHandler {
+ public:
+  void MessageNotify(Message::Priority priority) { notify_count++; }
+
+  MessageStatus HandleMessage(std::unique_ptr<Message> message) { return kOK; }
+
+  std::atomic<intptr_t> notify_count = {0};
+};
+
+struct ConcurrentPostState {
+  Dart_Port port = ILLEGAL_PORT;
+  std::atomic<bool> closed = {false};
+  std::atomic<intptr_t> posted = {0};
+  Monitor monitor;
+  intptr_t posters_finished = 0;
+};
+
+class PosterTask : public ThreadPool::Task {
+ public:
+  explicit PosterTask(ConcurrentPostState* state) : state_(state) {}
+
+  virtual void Run() {
+    while (true) {
+      const bool closed_before = state_->closed.load();
+      if (PortMap::PostMessage(Message::New(state_->port, Smi::New(42),
+                                            Message::kNormalPriority))) {
+        // Posting must fail once ClosePort has returned.
+        EXPECT(!closed_before);
+        state_->posted++;
+      } else if (closed_before) {
+        break;
+      }
+    }
+    MonitorLocker ml(&state_->monitor);
+    state_->posters_finished++;
+    ml.Notify();
+  }
+
+ private:
+  ConcurrentPostState* state_;
+};
+
+}  // namespace
+
+// Posting does not take the port map lock, so messages may be posted while
+// the port is being closed. All of them must reach the handler before
+// ClosePort returns.
+TEST_CASE(PortMap_PostMessageConcurrentClose) {
+  const intptr_t kNumPosters = 4;
+  CountingMessageHandler handler;
+  ConcurrentPostState state;
+  state.port = PortMap::CreatePort(&handler);
+  {
+    ThreadPool pool;
+    for (intptr_t i = 0; i < kNumPosters; i++) {
+      EXPECT(pool.Run<PosterTask>(&state));
+    }
+    while (state.posted.load() < 1000) {
+      OS::SleepMicros(10);
+    }
+    EXPECT(PortMap::ClosePort(state.port));
+    const intptr_t delivered = handler.notify_count.load();
+    state.closed = true;
+    {
+      MonitorLocker ml(&state.monitor);
+      while (state.posters_finished < kNumPosters) {
+        ml.Wait();
+      }
+    }
+    EXPECT_EQ(delivered, state.posted.load());
+    EXPECT_EQ(delivered, handler.notify_count.load());
+  }
+  EXPECT(!PortMap::PortExists(state.port));
+}
+
 }  // namespace dart
@@ -3838,8 +3838,20 @@ class UntaggedRegExp : public UntaggedInstance {
   COMPRESSED_POINTER_FIELD(TypedDataPtr, two_byte)
   COMPRESSED_POINTER_FIELD(TypedDataPtr, one_byte_sticky)
   COMPRESSED_POINTER_FIELD(TypedDataPtr, two_byte_sticky)
-  VISIT_TO(two_byte_sticky)
-  CompressedObjectPtr* to_snapshot(Snapshot::Kind kind) { return to(); }
+  // Machine code for hot patterns, see RegExpStatics::Interpret. Never
+  // written to snapshots.
+  COMPRESSED_POINTER_FIELD(CodePtr, one_byte_code)
+  COMPRESSED_POINTER_FIELD(CodePtr, two_byte_code)
+  COMPRESSED_POINTER_FIELD(CodePtr, one_byte_sticky_code)
+  COMPRESSED_POINTER_FIELD(CodePtr, two_byte_sticky_code)
+  // Programs of the linear-time engine, see ExperimentalRegExp::OneshotExec.
+  // Never written to snapshots.
+  COMPRESSED_POINTER_FIELD(TypedDataPtr, experimental)
+  COMPRESSED_POINTER_FIELD(TypedDataPtr, experimental_sticky)
+  VISIT_TO(experimental_sticky)
+  CompressedObjectPtr* to_snapshot(Snapshot::Kind kind) {
+    return reinterpret_cast<CompressedObjectPtr*>(&two_byte_sticky_);
+  }
 
   std::atomic<intptr_t> num_bracket_expressions_;
 
@@ -3861,6 +3873,21 @@ class UntaggedRegExp : public UntaggedInstance {
 
   // RegExpFlags
   uint32_t flags_;
+
+  // Number of times the bytecode of this pattern was interpreted.
+  int32_t usage_counter_;
+
+  // Whether the pattern is a plain string that is matched by a substring
+  // search instead of irregexp, see RegExpStatics::Interpret.
+  bool is_atom_;
+
+  // One bit per specialization (one-byte/two-byte, sticky/non-sticky) that
+  // failed to compile to machine code and keeps using the bytecode.
+  uint8_t native_code_failures_;
+
+  // Whether the linear-time engine can handle the pattern, one of
+  // RegExp::ExperimentalSupport.
+  uint8_t experimental_support_;
 };
 
 class UntaggedWeakProperty : public UntaggedInstance {
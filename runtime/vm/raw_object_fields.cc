@@ -179,6 +179,12 @@ namespace dart {
   F(RegExp, two_byte_)                                                         \
   F(RegExp, one_byte_sticky_)                                                  \
   F(RegExp, two_byte_sticky_)                                                  \
+  F(RegExp, one_byte_code_)                                                    \
+  F(RegExp, two_byte_code_)                                                    \
+  F(RegExp, one_byte_sticky_code_)                                             \
+  F(RegExp, two_byte_sticky_code_)                                             \
+  F(RegExp, experimental_)                                                     \
+  F(RegExp, experimental_sticky_)                                              \
   F(SuspendState, function_data_)                                              \
   F(SuspendState, then_callback_)                                              \
   F(SuspendState, error_callback_)                                             \
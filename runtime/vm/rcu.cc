@@ -0,0 +1,74 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/rcu.h"
+
+#include "platform/assert.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
+
+namespace dart {
+
+// Stripe of the current thread, assigned round-robin on first use.
+static thread_local intptr_t current_stripe = -1;
+static std::atomic<intptr_t> next_stripe = {0};
+
+RcuDomain::RcuDomain() {
+  for (intptr_t i = 0; i < kNumStripes; i++) {
+    stripes_[i].readers[0].store(0, std::memory_order_relaxed);
+    stripes_[i].readers[1].store(0, std::memory_order_relaxed);
+  }
+}
+
+RcuDomain::~RcuDomain() {
+#if defined(DEBUG)
+  for (intptr_t i = 0; i < kNumStripes; i++) {
+    ASSERT(stripes_[i].readers[0].load() == 0);
+    ASSERT(stripes_[i].readers[1].load() == 0);
+  }
+#endif
+}
+
+std::atomic<intptr_t>* RcuDomain::EnterRead() {
+  intptr_t stripe = current_stripe;
+  if (stripe < 0) {
+    stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % kNumStripes;
+    current_stripe = stripe;
+  }
+  const intptr_t phase = phase_.load(std::memory_order_relaxed);
+  std::atomic<intptr_t>* counter = &stripes_[stripe].readers[phase];
+  counter->fetch_add(1, std::memory_order_relaxed);
+  // Pairs with the fence in Synchronize: either the writer sees this reader,
+  // or this reader sees everything the writer unpublished before it.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return counter;
+}
+
+void RcuDomain::WaitForReaders(intptr_t phase) {
+  for (intptr_t i = 0; i < kNumStripes; i++) {
+    intptr_t spins = 0;
+    while (stripes_[i].readers[phase].load(std::memory_order_acquire) != 0) {
+      if (++spins > 1000) {
+        OS::SleepMicros(1);
+      }
+    }
+  }
+}
+
+void RcuDomain::Synchronize() {
+  MutexLocker ml(&synchronize_mutex_);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // A reader may have read the phase just before a flip and joined the old
+  // phase only after it was drained, so both phases are drained: after the
+  // first flip every new reader joins the other phase, which the second flip
+  // then waits for.
+  for (intptr_t i = 0; i < 2; i++) {
+    const intptr_t phase = phase_.load(std::memory_order_relaxed);
+    phase_.store(1 - phase, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    WaitForReaders(phase);
+  }
+}
+
+}  // namespace dart
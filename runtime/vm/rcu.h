@@ -0,0 +1,70 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_RCU_H_
+#define RUNTIME_VM_RCU_H_
+
+#include <atomic>
+
+#include "platform/allocation.h"
+#include "platform/globals.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+// Read-copy-update: lets readers access a shared data structure without
+// locks while a writer replaces or removes parts of it.
+//
+// Readers wrap their accesses in a ReadScope, which never blocks and only
+// writes to a counter shared with few other threads. A writer first
+// unpublishes the data it wants to free (with an atomic store), then calls
+// Synchronize, which returns once every ReadScope that could still see the
+// unpublished data has ended. Concurrent calls to Synchronize wait for each
+// other, so writers can call it after releasing their own lock.
+//
+// Synchronize must not be called inside a ReadScope on the same thread.
+class RcuDomain : public MallocAllocated {
+ public:
+  RcuDomain();
+  ~RcuDomain();
+
+  class ReadScope : public ValueObject {
+   public:
+    explicit ReadScope(RcuDomain* domain) : counter_(domain->EnterRead()) {}
+    ~ReadScope() { counter_->fetch_sub(1, std::memory_order_release); }
+
+   private:
+    std::atomic<intptr_t>* const counter_;
+
+    DISALLOW_COPY_AND_ASSIGN(ReadScope);
+  };
+
+  // Waits until all ReadScopes that started before the call have ended.
+  void Synchronize();
+
+ private:
+  static constexpr intptr_t kNumStripes = 64;
+
+  // Readers are spread over stripes by thread. Each stripe counts readers
+  // in two phases: new readers join the current phase, and Synchronize
+  // waits for the previous one to drain.
+  struct Stripe {
+    std::atomic<intptr_t> readers[2];
+    uint8_t padding[64 - 2 * sizeof(std::atomic<intptr_t>)];
+  };
+
+  std::atomic<intptr_t>* EnterRead();
+  void WaitForReaders(intptr_t phase);
+
+  // Serializes the phase flips of Synchronize.
+  Mutex synchronize_mutex_;
+  std::atomic<intptr_t> phase_ = {0};
+  Stripe stripes_[kNumStripes];
+
+  DISALLOW_COPY_AND_ASSIGN(RcuDomain);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_RCU_H_
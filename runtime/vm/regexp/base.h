@@ -169,7 +169,6 @@ constexpr bool FLAG_regexp_unroll = false;
 constexpr bool FLAG_regexp_optimization = false;
 constexpr bool FLAG_regexp_quick_check = true;
 constexpr bool FLAG_regexp_tier_up = false;
-constexpr bool FLAG_regexp_peephole_optimization = false;
 
 class JSRegExp {
  public:
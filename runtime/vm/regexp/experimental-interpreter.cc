@@ -0,0 +1,462 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/experimental-interpreter.h"
+
+#include <algorithm>
+
+#include "vm/regexp/char-predicates-inl.h"
+#include "vm/regexp/zone-list-inl.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+namespace {
+
+constexpr int kUndefinedRegisterValue = -1;
+
+template <class Character>
+bool SatisfiesAssertion(RegExpAssertion::Type type,
+                        base::Vector<const Character> context,
+                        int position) {
+  ASSERT(position <= static_cast<int>(context.length()));
+  ASSERT(position >= 0);
+
+  switch (type) {
+    case RegExpAssertion::Type::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::Type::END_OF_INPUT:
+      return position == static_cast<int>(context.length());
+    case RegExpAssertion::Type::START_OF_LINE:
+      if (position == 0) return true;
+      return IsLineTerminator(context[position - 1]);
+    case RegExpAssertion::Type::END_OF_LINE:
+      if (position == static_cast<int>(context.length())) return true;
+      return IsLineTerminator(context[position]);
+    case RegExpAssertion::Type::BOUNDARY:
+      if (context.length() == 0) {
+        return false;
+      } else if (position == 0) {
+        return IsRegExpWord(context[position]);
+      } else if (position == static_cast<int>(context.length())) {
+        return IsRegExpWord(context[position - 1]);
+      } else {
+        return IsRegExpWord(context[position - 1]) !=
+               IsRegExpWord(context[position]);
+      }
+    case RegExpAssertion::Type::NON_BOUNDARY:
+      return !SatisfiesAssertion(RegExpAssertion::Type::BOUNDARY, context,
+                                 position);
+  }
+  UNREACHABLE();
+}
+
+template <class Character, class NByteString>
+class NfaInterpreter {
+  // Executes a bytecode program in breadth-first mode, without backtracking.
+  // `Character` can be instantiated with `uint8_t` or `uint16_t` for one byte
+  // or two byte input strings.
+  //
+  // In contrast to the backtracking implementation, this has linear time
+  // complexity in the length of the input string. Breadth-first mode is
+  // similar to the NFA simulation in Ken Thompson's 1968 regexp paper.
+  // The interpreter emulates an NFA with each state being a `pc` (an index
+  // into the bytecode); the NFA's current set of active states is represented
+  // by the list of active threads.
+  //
+  // Each thread ("InterpreterThread") maintains a `pc` and a set of registers
+  // (capture positions).  Threads run in order of priority, see the comment
+  // in experimental-bytecode.h.  A thread executing a CONSUME_RANGE is
+  // blocked until the next input character is available.  Each `pc` is
+  // executed by at most one thread per input position; the thread with the
+  // highest priority wins.  This bounds the work per input character by the
+  // length of the bytecode.
+ public:
+  NfaInterpreter(Thread* thread,
+                 base::Vector<const RegExpInstruction> bytecode,
+                 int register_count_per_match,
+                 const String& input_string,
+                 int32_t input_index,
+                 Zone* zone)
+      : thread_(thread),
+        bytecode_(bytecode),
+        register_count_per_match_(register_count_per_match),
+        input_string_(input_string),
+        input_index_(input_index),
+        pc_last_input_index_(zone->Alloc<int>(bytecode.length())),
+        active_threads_(0, zone),
+        blocked_threads_(0, zone),
+        free_register_arrays_(0, zone),
+        zone_(zone) {
+    ASSERT(!bytecode_.empty());
+    ASSERT(input_index_ >= 0);
+    ASSERT(input_index_ <= input_string.Length());
+    UpdateInput();
+    std::fill(pc_last_input_index_,
+              pc_last_input_index_ + bytecode_.length(), -1);
+  }
+
+  // Finds matches and writes their concatenated capture registers to
+  // `output_registers`.  `output_registers[i]` has to be valid for all i <
+  // output_register_count`.  The search continues until all remaining matches
+  // have been found or there is no space left in `output_registers`.  Returns
+  // the number of matches found, or kInternalRegExpException.
+  int FindMatches(int32_t* output_registers, int output_register_count) {
+    const int max_match_num = output_register_count / register_count_per_match_;
+
+    int match_num = 0;
+    while (match_num != max_match_num) {
+      int err_code = FindNextMatch();
+      if (err_code != RegExpStatics::kInternalRegExpSuccess) return err_code;
+
+      if (!FoundMatch()) break;
+
+      output_registers =
+          std::copy(best_match_registers_,
+                    best_match_registers_ + register_count_per_match_,
+                    output_registers);
+
+      ++match_num;
+
+      const int match_begin = best_match_registers_[0];
+      const int match_end = best_match_registers_[1];
+      ASSERT(match_begin <= match_end);
+      const int match_length = match_end - match_begin;
+      if (match_length != 0) {
+        SetInputIndex(match_end);
+      } else if (match_end == static_cast<int>(input_.length())) {
+        // Zero-length match, input exhausted.
+        SetInputIndex(match_end);
+        break;
+      } else {
+        // Zero-length match, more input.  We don't want to report more matches
+        // here endlessly, so we advance by 1.
+        SetInputIndex(match_end + 1);
+      }
+    }
+
+    return match_num;
+  }
+
+ private:
+  // The state of a "thread" executing experimental regexp bytecode.  (Not to
+  // be confused with an OS thread.)
+  struct InterpreterThread {
+    // This thread's program counter, i.e. the index within `bytecode_` of the
+    // next instruction to be executed.
+    int pc;
+    // Pointer to the array of registers, which is always size
+    // `register_count_per_match_`.  Should be deallocated with
+    // `FreeRegisterArray`.
+    int32_t* register_array_begin;
+  };
+
+  // Reads the characters of the input, which may have moved while handling an
+  // interrupt.
+  void UpdateInput() {
+    NoSafepointScope no_safepoint(thread_);
+    input_ = {NByteString::DataStart(input_string_),
+              static_cast<size_t>(input_string_.Length())};
+  }
+
+  // Handles an interrupt if one is pending.  Returns
+  // kInternalRegExpException if that resulted in an error.
+  int HandleInterrupts() {
+    if (LIKELY(!thread_->HasScheduledInterrupts())) {
+      return RegExpStatics::kInternalRegExpSuccess;
+    }
+    ErrorPtr error = thread_->HandleInterrupts();
+    if (error != Object::null()) {
+      thread_->set_sticky_error(Error::Handle(error));
+      return RegExpStatics::kInternalRegExpException;
+    }
+    UpdateInput();
+    return RegExpStatics::kInternalRegExpSuccess;
+  }
+
+  // Change the current input index for future calls to `FindNextMatch`.
+  void SetInputIndex(int new_input_index) {
+    ASSERT(input_index_ >= 0);
+    ASSERT(input_index_ <= static_cast<int>(input_.length()));
+
+    input_index_ = new_input_index;
+  }
+
+  // Find the next match and return the corresponding capture registers and
+  // write its capture registers to `best_match_registers_`.  The search
+  // starts at the current `input_index_`.  Returns
+  // kInternalRegExpSuccess if no error occurred (which does not necessarily
+  // mean that a match was found).
+  int FindNextMatch() {
+    ASSERT(active_threads_.is_empty());
+    // TODO(mbid,v8:10765): Can we get around resetting `pc_last_input_index_`
+    // here? As long as
+    //
+    //   pc_last_input_index_[pc] < input_index_
+    //
+    // for all possible program counters pc that are reachable without input
+    // from pc = 0 and
+    //
+    //   pc_last_input_index_[k] <= input_index_
+    //
+    // for all k > 0 hold I think everything should be fine.  Maybe we can do
+    // something about this in `SetInputIndex`.
+    std::fill(pc_last_input_index_,
+              pc_last_input_index_ + bytecode_.length(), -1);
+
+    // Clean up left-over data from a previous call to FindNextMatch.
+    for (InterpreterThread t : blocked_threads_) {
+      DestroyThread(t);
+    }
+    blocked_threads_.Rewind(0);
+
+    for (InterpreterThread t : active_threads_) {
+      DestroyThread(t);
+    }
+    active_threads_.Rewind(0);
+
+    if (best_match_registers_ != nullptr) {
+      FreeRegisterArray(best_match_registers_);
+      best_match_registers_ = nullptr;
+    }
+
+    // All threads start at bytecode 0.
+    active_threads_.Add(
+        InterpreterThread{0, NewRegisterArray(kUndefinedRegisterValue)}, zone_);
+    // Run the initial thread, potentially forking new threads, until every
+    // thread is blocked without further input.
+    RunActiveThreads();
+
+    // We stop if one of the following conditions hold:
+    // - We have exhausted the entire input.
+    // - We have found a match at some point, and there are no remaining
+    //   threads with higher priority than the thread that produced the match.
+    //   Threads with low priority have been aborted earlier, and the remaining
+    //   threads are blocked here, so the latter simply means that
+    //   `blocked_threads_` is empty.
+    while (input_index_ != static_cast<int>(input_.length()) &&
+           !(FoundMatch() && blocked_threads_.is_empty())) {
+      ASSERT(active_threads_.is_empty());
+
+      // Dart: Check for interrupts once per input character, which bounds the
+      // time between checks by the length of the bytecode.
+      int err_code = HandleInterrupts();
+      if (err_code != RegExpStatics::kInternalRegExpSuccess) return err_code;
+
+      base::uc16 input_char = input_[input_index_];
+      ++input_index_;
+
+      // We unblock all blocked_threads_ by feeding them the input char.
+      FlushBlockedThreads(input_char);
+
+      // Run all threads until they block or accept.
+      RunActiveThreads();
+    }
+
+    return RegExpStatics::kInternalRegExpSuccess;
+  }
+
+  // Run an active thread `t` until it executes a CONSUME_RANGE or ACCEPT
+  // instruction, or its PC value was already processed.
+  // - If processing of `t` can't continue because of CONSUME_RANGE, it is
+  //   pushed on `blocked_threads_`.
+  // - If `t` executes ACCEPT, set `best_match` according to `t.match_begin` and
+  //   the current input index. All remaining `active_threads_` are discarded.
+  void RunActiveThread(InterpreterThread t) {
+    while (true) {
+      if (IsPcProcessed(t.pc)) return DestroyThread(t);
+      MarkPcProcessed(t.pc);
+
+      RegExpInstruction inst = bytecode_[t.pc];
+      switch (inst.opcode) {
+        case RegExpInstruction::CONSUME_RANGE: {
+          blocked_threads_.Add(t, zone_);
+          return;
+        }
+        case RegExpInstruction::ASSERTION:
+          if (!SatisfiesAssertion(inst.payload.assertion_type, input_,
+                                  input_index_)) {
+            DestroyThread(t);
+            return;
+          }
+          ++t.pc;
+          break;
+        case RegExpInstruction::FORK: {
+          InterpreterThread fork{inst.payload.pc,
+                                 NewRegisterArrayUninitialized()};
+          std::copy(t.register_array_begin,
+                    t.register_array_begin + register_count_per_match_,
+                    fork.register_array_begin);
+          active_threads_.Add(fork, zone_);
+          ++t.pc;
+          break;
+        }
+        case RegExpInstruction::JMP:
+          t.pc = inst.payload.pc;
+          break;
+        case RegExpInstruction::ACCEPT:
+          if (best_match_registers_ != nullptr) {
+            FreeRegisterArray(best_match_registers_);
+          }
+          best_match_registers_ = t.register_array_begin;
+
+          for (InterpreterThread s : active_threads_) {
+            FreeRegisterArray(s.register_array_begin);
+          }
+          active_threads_.Rewind(0);
+          return;
+        case RegExpInstruction::SET_REGISTER_TO_CP:
+          t.register_array_begin[inst.payload.register_index] = input_index_;
+          ++t.pc;
+          break;
+        case RegExpInstruction::CLEAR_REGISTER:
+          t.register_array_begin[inst.payload.register_index] =
+              kUndefinedRegisterValue;
+          ++t.pc;
+          break;
+      }
+    }
+  }
+
+  // Run each active thread until it can't continue without further input.
+  // `active_threads_` is empty afterwards.  `blocked_threads_` are sorted from
+  // high to low priority.
+  void RunActiveThreads() {
+    while (!active_threads_.is_empty()) {
+      RunActiveThread(active_threads_.RemoveLast());
+    }
+  }
+
+  // Unblock all blocked_threads_ by feeding them an `input_char`.  Should only
+  // be called with `input_index_` pointing to the character *after*
+  // `input_char` so that `pc_last_input_index_` is updated correctly.
+  void FlushBlockedThreads(base::uc16 input_char) {
+    // The threads in blocked_threads_ are sorted from high to low priority,
+    // but active_threads_ needs to be sorted from low to high priority, so we
+    // need to activate blocked threads in reverse order.
+    for (int i = blocked_threads_.length() - 1; i >= 0; --i) {
+      InterpreterThread t = blocked_threads_[i];
+      RegExpInstruction consume_instr = bytecode_[t.pc];
+      ASSERT(consume_instr.opcode == RegExpInstruction::CONSUME_RANGE);
+      RegExpInstruction::Uc16Range range = consume_instr.payload.consume_range;
+      if (input_char >= range.min && input_char <= range.max) {
+        ++t.pc;
+        active_threads_.Add(t, zone_);
+      } else {
+        DestroyThread(t);
+      }
+    }
+    blocked_threads_.Rewind(0);
+  }
+
+  bool FoundMatch() const { return best_match_registers_ != nullptr; }
+
+  int32_t* NewRegisterArrayUninitialized() {
+    if (!free_register_arrays_.is_empty()) {
+      return free_register_arrays_.RemoveLast();
+    }
+    return zone_->Alloc<int32_t>(register_count_per_match_);
+  }
+
+  int32_t* NewRegisterArray(int fill_value) {
+    int32_t* array_begin = NewRegisterArrayUninitialized();
+    std::fill(array_begin, array_begin + register_count_per_match_,
+              fill_value);
+    return array_begin;
+  }
+
+  void FreeRegisterArray(int32_t* register_array_begin) {
+    free_register_arrays_.Add(register_array_begin, zone_);
+  }
+
+  void DestroyThread(InterpreterThread t) {
+    FreeRegisterArray(t.register_array_begin);
+  }
+
+  // It is redundant to have two threads t, t0 execute at the same PC value,
+  // because one of t, t0 matches iff the other does.  We can thus discard
+  // the one with lower priority.  We check whether a thread executed at some
+  // PC value by recording for every possible value of PC what the value of
+  // input_index_ was the last time a thread executed at PC. If a thread
+  // tries to continue execution at a PC value that we have seen before at
+  // the current input index, we abort it.  (We execute threads with higher
+  // priority first, so the second thread is guaranteed to have lower
+  // priority.)
+  //
+  // Check whether we've seen an active thread with a given pc value since the
+  // last increment of `input_index_`.
+  bool IsPcProcessed(int pc) {
+    ASSERT(pc_last_input_index_[pc] <= input_index_);
+    return pc_last_input_index_[pc] == input_index_;
+  }
+
+  // Mark a pc as having been processed since the last increment of
+  // `input_index_`.
+  void MarkPcProcessed(int pc) {
+    ASSERT(pc_last_input_index_[pc] <= input_index_);
+    pc_last_input_index_[pc] = input_index_;
+  }
+
+  Thread* const thread_;
+
+  const base::Vector<const RegExpInstruction> bytecode_;
+
+  // Number of registers used per thread.
+  const int register_count_per_match_;
+
+  const String& input_string_;
+  base::Vector<const Character> input_;
+  int input_index_;
+
+  // pc_last_input_index_[k] records the value of input_index_ the last
+  // time a thread t such that t.pc == k was activated, i.e. put on
+  // active_threads_.  Thus pc_last_input_index.size() == bytecode.size().  See
+  // also `RunActiveThread`.
+  int* const pc_last_input_index_;
+
+  // Active threads can potentially (but not necessarily) continue without
+  // input.  Sorted from low to high priority.
+  ZoneList<InterpreterThread> active_threads_;
+
+  // The pc of a blocked thread points to an instruction that consumes a
+  // character. Sorted from high to low priority (so the opposite of
+  // `active_threads_`).
+  ZoneList<InterpreterThread> blocked_threads_;
+
+  // Register arrays of destroyed threads, reused by new threads.
+  ZoneList<int32_t*> free_register_arrays_;
+
+  // The register array of the best match found so far during the current
+  // search.  If several threads ACCEPTed, then this will be the register array
+  // of the accepting thread with highest priority.  Should be deallocated with
+  // `FreeRegisterArray`.
+  int32_t* best_match_registers_ = nullptr;
+
+  Zone* zone_;
+};
+
+}  // namespace
+
+int ExperimentalRegExpInterpreter::FindMatches(
+    Thread* thread,
+    base::Vector<const RegExpInstruction> bytecode,
+    int register_count_per_match,
+    const String& input,
+    int start_index,
+    int32_t* output_registers,
+    int output_register_count,
+    Zone* zone) {
+  if (input.IsOneByteString()) {
+    NfaInterpreter<uint8_t, OneByteString> interpreter(
+        thread, bytecode, register_count_per_match, input, start_index, zone);
+    return interpreter.FindMatches(output_registers, output_register_count);
+  } else {
+    ASSERT(input.IsTwoByteString());
+    NfaInterpreter<uint16_t, TwoByteString> interpreter(
+        thread, bytecode, register_count_per_match, input, start_index, zone);
+    return interpreter.FindMatches(output_registers, output_register_count);
+  }
+}
+
+}  // namespace dart
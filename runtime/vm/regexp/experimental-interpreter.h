@@ -0,0 +1,37 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
+#define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
+
+#include "vm/regexp/experimental-bytecode.h"
+#include "vm/regexp/regexp.h"
+#include "vm/regexp/vector.h"
+
+namespace dart {
+
+class ExperimentalRegExpInterpreter final : public AllStatic {
+ public:
+  // Executes a bytecode program in breadth-first NFA mode, without
+  // backtracking, to find matching substrings.  Tries to find up to
+  // `max_match_num` matches in `input`, starting at `start_index`.  Returns
+  // the actual number of matches found.  The boundaries of matching subranges
+  // are written to `matches_out`.  Provided in variants for one-byte and
+  // two-byte strings.
+  //
+  // Returns RegExpStatics::kInternalRegExpException if handling an interrupt
+  // resulted in an error, which is then set as the sticky error of the thread.
+  static int FindMatches(Thread* thread,
+                         base::Vector<const RegExpInstruction> bytecode,
+                         int register_count_per_match,
+                         const String& input,
+                         int start_index,
+                         int32_t* output_registers,
+                         int output_register_count,
+                         Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
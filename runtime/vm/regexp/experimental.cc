@@ -0,0 +1,134 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/experimental.h"
+
+#include "vm/regexp/experimental-compiler.h"
+#include "vm/regexp/experimental-interpreter.h"
+#include "vm/regexp/regexp-parser.h"
+
+namespace dart {
+
+bool ExperimentalRegExp::CanBeHandled(RegExpTree* tree,
+                                      RegExpFlags flags,
+                                      int capture_count) {
+  return ExperimentalRegExpCompiler::CanBeHandled(tree, flags, capture_count);
+}
+
+namespace {
+
+// Parses the pattern of the regexp into `compile_data`.
+void Parse(Thread* thread,
+           const RegExp& regexp,
+           RegExpFlags flags,
+           RegExpCompileData* compile_data) {
+  const String& pattern = String::Handle(thread->zone(), regexp.pattern());
+  if (!RegExpParser::ParseRegExpFromHeapString(
+          thread->isolate(), thread->zone(), pattern, flags, compile_data)) {
+    // RegExp was verified at construction.
+    UNREACHABLE();
+  }
+}
+
+RegExpFlags FlagsForExecution(const RegExp& regexp, bool sticky) {
+  RegExpFlags flags = regexp.flags();
+  if (sticky) {
+    flags |= RegExpFlag::kSticky;
+  }
+  return flags;
+}
+
+}  // namespace
+
+bool ExperimentalRegExp::CanBeHandled(Thread* thread,
+                                      const RegExp& regexp,
+                                      bool sticky) {
+  switch (regexp.experimental_support()) {
+    case RegExp::ExperimentalSupport::kSupported:
+      return true;
+    case RegExp::ExperimentalSupport::kUnsupported:
+      return false;
+    case RegExp::ExperimentalSupport::kUnknown:
+      break;
+  }
+  // The sticky flag is supported, so the result is the same for both.
+  const RegExpFlags flags = FlagsForExecution(regexp, sticky);
+  RegExpCompileData compile_data;
+  Parse(thread, regexp, flags, &compile_data);
+  const bool result =
+      CanBeHandled(compile_data.tree, flags, compile_data.capture_count);
+  regexp.set_experimental_support(
+      result ? RegExp::ExperimentalSupport::kSupported
+             : RegExp::ExperimentalSupport::kUnsupported);
+  return result;
+}
+
+namespace {
+
+// Returns the program for the regexp, compiling it on first use. The result
+// is copied into the zone, since handling an interrupt may move the cached
+// program.
+base::Vector<const RegExpInstruction> GetBytecode(Thread* thread,
+                                                  const RegExp& regexp,
+                                                  bool sticky) {
+  Zone* zone = thread->zone();
+  TypedData& bytecode =
+      TypedData::Handle(zone, regexp.experimental_bytecode(sticky));
+  if (bytecode.IsNull()) {
+    const RegExpFlags flags = FlagsForExecution(regexp, sticky);
+    RegExpCompileData compile_data;
+    Parse(thread, regexp, flags, &compile_data);
+    ASSERT(ExperimentalRegExp::CanBeHandled(compile_data.tree, flags,
+                                            compile_data.capture_count));
+    const ZoneList<RegExpInstruction> instructions =
+        ExperimentalRegExpCompiler::Compile(compile_data.tree, flags, zone);
+    const intptr_t size = instructions.length() * sizeof(RegExpInstruction);
+    bytecode = TypedData::New(kTypedDataUint8ArrayCid, size, Heap::kOld);
+    {
+      NoSafepointScope no_safepoint(thread);
+      memcpy(bytecode.DataAddr(0), instructions.ToConstVector().begin(), size);
+    }
+    // Racing mutators store equivalent programs.
+    regexp.set_experimental_bytecode(sticky, bytecode);
+    return instructions.ToConstVector();
+  }
+  const intptr_t length = bytecode.LengthInBytes() / sizeof(RegExpInstruction);
+  RegExpInstruction* instructions = zone->Alloc<RegExpInstruction>(length);
+  {
+    NoSafepointScope no_safepoint(thread);
+    memcpy(instructions, bytecode.DataAddr(0), bytecode.LengthInBytes());
+  }
+  return base::Vector<const RegExpInstruction>(instructions, length);
+}
+
+}  // namespace
+
+int ExperimentalRegExp::OneshotExec(Thread* thread,
+                                    const RegExp& regexp,
+                                    const String& subject,
+                                    int index,
+                                    int32_t* output_registers,
+                                    int output_register_count,
+                                    bool sticky) {
+  const base::Vector<const RegExpInstruction> bytecode =
+      GetBytecode(thread, regexp, sticky);
+
+  // Only ask for a single match, the output may have room for the additional
+  // registers of the backtracking engine. The capture count was set when the
+  // pattern was compiled to bytecode.
+  ASSERT(regexp.num_bracket_expressions() >= 0);
+  const int register_count_per_match = JSRegExp::RegistersForCaptureCount(
+      static_cast<int>(regexp.num_bracket_expressions()));
+  ASSERT(register_count_per_match <= output_register_count);
+  const int result = ExperimentalRegExpInterpreter::FindMatches(
+      thread, bytecode, register_count_per_match, subject, index,
+      output_registers, register_count_per_match, thread->zone());
+  if (result == RegExpStatics::kInternalRegExpException) {
+    return RegExpStatics::RE_EXCEPTION;
+  }
+  ASSERT(result == 0 || result == 1);
+  return result == 0 ? RegExpStatics::RE_FAILURE : RegExpStatics::RE_SUCCESS;
+}
+
+}  // namespace dart
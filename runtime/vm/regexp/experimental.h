@@ -0,0 +1,49 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_H_
+#define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_H_
+
+#include "vm/regexp/regexp-flags.h"
+#include "vm/regexp/regexp.h"
+
+namespace dart {
+
+// Dart: The linear-time engine is not a separate RegExp type. It is used for
+// single executions of patterns that the backtracking engine gave up on, see
+// RegExpStatics::Interpret.
+class ExperimentalRegExp final : public AllStatic {
+ public:
+  // Initialization & Compilation
+  // -------------------------------------------------------------------------
+  // Check whether a parsed regexp pattern can be compiled and executed by the
+  // EXPERIMENTAL engine.
+  // TODO(mbid, v8:10765): This walks the RegExpTree, but it could also be
+  // checked on the fly in the parser.  Not done currently because walking the
+  // AST again is more flexible and less error prone (but less performant).
+  static bool CanBeHandled(RegExpTree* tree,
+                           RegExpFlags flags,
+                           int capture_count);
+  // Parses the pattern and checks whether it can be executed by the
+  // EXPERIMENTAL engine. The result is cached on the regexp.
+  static bool CanBeHandled(Thread* thread, const RegExp& regexp, bool sticky);
+
+  // Execution:
+  // Finds a single match in `subject`, starting at `index`. The pattern is
+  // compiled on first use and the program is cached on the regexp. The
+  // capture registers of the match are written to `output_registers`.
+  // Returns one of the RegExpStatics::IrregexpResult values, but never
+  // RE_RETRY or RE_FALLBACK_TO_EXPERIMENTAL.
+  static int OneshotExec(Thread* thread,
+                         const RegExp& regexp,
+                         const String& subject,
+                         int index,
+                         int32_t* output_registers,
+                         int output_register_count,
+                         bool sticky);
+};
+
+}  // namespace dart
+
+#endif  // V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_H_
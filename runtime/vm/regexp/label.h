@@ -100,6 +100,8 @@ class V8Label {
   friend class Displacement;
   friend class RegExpBytecodeGenerator;
   friend class RegExpBytecodeWriter;
+  friend class RegExpMacroAssemblerARM64;
+  friend class RegExpMacroAssemblerX64;
 };
 
 }  // namespace dart
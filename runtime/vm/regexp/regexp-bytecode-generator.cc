@@ -8,13 +8,21 @@
 #include <tuple>
 #include <type_traits>
 
+#include "vm/flags.h"
 #include "vm/regexp/regexp-bytecode-generator-inl.h"
+#include "vm/regexp/regexp-bytecode-peephole.h"
 #include "vm/regexp/regexp-bytecodes-inl.h"
 #include "vm/regexp/regexp-macro-assembler.h"
 #include "vm/regexp/regexp.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            regexp_peephole_optimization,
+            true,
+            "Replace common sequences of regexp bytecodes by single "
+            "bytecodes.");
+
 // Used to decide whether we use the `Char` or `4Chars` variant of a bytecode.
 static constexpr int kMaxSingleCharValue =
     RegExpOperandTypeTraits<RegExpBytecodeOperandType::kChar>::kMaxValue;
@@ -260,6 +268,9 @@ void RegExpBytecodeGenerator::Bind(V8Label* l) {
     }
   }
   l->bind_to(pc_);
+  // The position is a jump target now, the AdvanceCurrentPosition before it
+  // can't be combined with a GoTo.
+  advance_current_end_ = kInvalidPC;
 }
 
 void RegExpBytecodeGenerator::PopRegister(int register_index) {
@@ -322,7 +333,15 @@ void RegExpBytecodeGenerator::Backtrack() {
 }
 
 void RegExpBytecodeGenerator::GoTo(V8Label* label) {
-  Emit<RegExpBytecode::kGoTo>(label);
+  if (advance_current_end_ == pc_) {
+    // Combine advance current and goto.
+    ResetPc(advance_current_start_);
+    Emit<RegExpBytecode::kAdvanceCpAndGoto>(advance_current_offset_, label);
+    advance_current_end_ = kInvalidPC;
+  } else {
+    // Regular goto.
+    Emit<RegExpBytecode::kGoTo>(label);
+  }
 }
 
 void RegExpBytecodeGenerator::PushBacktrack(V8Label* label) {
@@ -339,7 +358,10 @@ void RegExpBytecodeGenerator::Fail() {
 }
 
 void RegExpBytecodeGenerator::AdvanceCurrentPosition(int by) {
+  advance_current_start_ = pc_;
+  advance_current_offset_ = by;
   Emit<RegExpBytecode::kAdvanceCurrentPosition>(by);
+  advance_current_end_ = pc_;
 }
 
 void RegExpBytecodeGenerator::CheckFixedLengthLoop(
@@ -622,10 +644,7 @@ ObjectPtr RegExpBytecodeGenerator::GetCode(const String& source,
   Backtrack();
 
   if (FLAG_regexp_peephole_optimization) {
-    UNIMPLEMENTED();
-    // return RegExpBytecodePeepholeOptimization::OptimizeBytecode(
-    //     isolate_, zone(), source, this);
-    return TypedData::null();
+    return RegExpBytecodePeepholeOptimization::OptimizeBytecode(zone(), this);
   } else {
     const TypedData& array =
         TypedData::Handle(TypedData::New(kTypedDataUint8ArrayCid, length()));
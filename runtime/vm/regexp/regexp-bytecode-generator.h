@@ -102,6 +102,12 @@ class RegExpBytecodeWriter {
   void ExpandBuffer(size_t new_size);
 };
 
+// Defined in regexp-bytecode-generator.cc, used by the peephole optimizer.
+template <>
+void RegExpBytecodeWriter::EmitOperand<ReBcOpType::kBitTable>(
+    const uint8_t* src,
+    int offset);
+
 // An assembler/generator for the Irregexp byte code.
 class RegExpBytecodeGenerator : public RegExpMacroAssembler,
                                 public RegExpBytecodeWriter {
@@ -260,6 +266,13 @@ class RegExpBytecodeGenerator : public RegExpMacroAssembler,
 
   void EmitSkipTable(const TypedData& table);
 
+  // The buffer offsets of the last emitted AdvanceCurrentPosition, which is
+  // combined with a directly following GoTo into AdvanceCpAndGoto.
+  static constexpr int kInvalidPC = -1;
+  int advance_current_start_ = kInvalidPC;
+  int advance_current_offset_ = 0;
+  int advance_current_end_ = kInvalidPC;
+
   V8Label backtrack_;
 
   Isolate* isolate_;
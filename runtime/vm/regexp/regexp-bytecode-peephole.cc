@@ -0,0 +1,361 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/regexp-bytecode-peephole.h"
+
+#include <tuple>
+
+#include "vm/regexp/regexp-bytecode-generator-inl.h"
+#include "vm/regexp/regexp-bytecodes-inl.h"
+
+namespace dart {
+
+namespace {
+
+using BC = RegExpBytecode;
+
+// Reads all operands of the bytecode at pc, in the order of their
+// definition in regexp-bytecodes.h.
+template <RegExpBytecode bc>
+auto DecodeOperands(const uint8_t* pc) {
+  using Operands = RegExpBytecodeOperands<bc>;
+  DisallowGarbageCollection no_gc;
+  return std::apply(
+      [&](auto... ops) {
+        return std::make_tuple(Operands::template Get<ops.value>(pc, no_gc)...);
+      },
+      Operands::GetOperandsTuple());
+}
+
+// Writes a bytecode with the given operands. Jump targets are offsets in the
+// bytecode the writer was copied from and are fixed up afterwards.
+template <RegExpBytecode bc, typename... Args>
+void EmitBytecode(RegExpBytecodeWriter* writer, Args... args) {
+  using Operands = RegExpBytecodeOperands<bc>;
+  static_assert(sizeof...(Args) == Operands::kCount,
+                "Wrong number of operands");
+  auto arguments_tuple = std::make_tuple(args...);
+  writer->EmitBytecode(bc);
+  Operands::ForEachOperandWithIndex([&]<auto op, size_t index>() {
+    constexpr RegExpBytecodeOperandType type = Operands::Type(op);
+    constexpr int offset = Operands::Offset(op);
+    auto value = std::get<index>(arguments_tuple);
+    if constexpr (type == RegExpBytecodeOperandType::kBitTable) {
+      writer->EmitOperand<type>(static_cast<const uint8_t*>(value), offset);
+    } else {
+      using CType = typename RegExpOperandTypeTraits<type>::kCType;
+      writer->EmitOperand<type>(static_cast<CType>(value), offset);
+    }
+  });
+  writer->Finalize(bc);
+}
+
+class RegExpBytecodePeephole {
+ public:
+  RegExpBytecodePeephole(Zone* zone, const RegExpBytecodeWriter* src);
+
+  // Copies the source bytecode to dst(), replacing the sequences of
+  // PEEPHOLE_BYTECODE_LIST by single bytecodes.
+  void Optimize();
+
+  const RegExpBytecodeWriter& dst() const { return dst_; }
+
+ private:
+  RegExpBytecode BytecodeAt(int pc) const {
+    if (pc >= length_) return BC::kBreak;
+    return RegExpBytecodes::FromPtr(code_ + pc);
+  }
+  int NextPc(int pc) const { return pc + RegExpBytecodes::Size(BytecodeAt(pc)); }
+  int JumpCount(int pc) const {
+    return jump_counts_[pc / kBytecodeAlignment];
+  }
+  // Only the first bytecode of a sequence may be targeted by jumps from
+  // outside the sequence.
+  bool IsJumpTarget(int pc) const { return JumpCount(pc) > 0; }
+
+  // Each of these replaces the sequence starting at pc if there is one, and
+  // returns the offset after it. Returns pc otherwise.
+  int TrySkipUntilChar(int pc);
+  int TrySkipUntilCharPosChecked(int pc);
+  int TrySkipUntilCharAnd(int pc);
+  int TrySkipUntilCharOrChar(int pc);
+  int TrySkipUntilGtOrNotBitInTable(int pc);
+  int TrySkipUntilBitInTable(int pc);
+  int TryReplaceSequence(int pc);
+
+  // Maps the jump targets in dst_ from offsets in the source bytecode to
+  // offsets in dst_.
+  void FixJumps();
+
+  const RegExpBytecodeWriter* const src_;
+  const uint8_t* const code_;
+  const int length_;
+  RegExpBytecodeWriter dst_;
+  // Number of jumps to each offset of the source, indexed by offset divided
+  // by kBytecodeAlignment.
+  ZoneVector<int> jump_counts_;
+  // Offset in dst_ of each bytecode boundary of the source, indexed like
+  // jump_counts_. -1 for bytecodes removed by a replacement.
+  ZoneVector<int> pc_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegExpBytecodePeephole);
+};
+
+RegExpBytecodePeephole::RegExpBytecodePeephole(Zone* zone,
+                                               const RegExpBytecodeWriter* src)
+    : src_(src),
+      code_(src->buffer().data()),
+      length_(src->length()),
+      dst_(zone),
+      jump_counts_(length_ / kBytecodeAlignment + 1, 0, zone),
+      pc_map_(length_ / kBytecodeAlignment + 1, -1, zone) {
+  for (const auto& [source, target] : src->jump_edges()) {
+    ASSERT(Utils::IsAligned(target, kBytecodeAlignment));
+    ASSERT(target <= length_);
+    jump_counts_[target / kBytecodeAlignment]++;
+  }
+}
+
+// Sequence:
+//   loop: LoadCurrentCharacter cp_offset, on_failure
+//         CheckCharacter character, on_equal
+//         AdvanceCpAndGoto by, loop
+int RegExpBytecodePeephole::TrySkipUntilChar(int pc) {
+  const int load = pc;
+  const int check = NextPc(load);
+  const int advance = NextPc(check);
+  if (BytecodeAt(load) != BC::kLoadCurrentCharacter ||
+      BytecodeAt(check) != BC::kCheckCharacter || IsJumpTarget(check) ||
+      BytecodeAt(advance) != BC::kAdvanceCpAndGoto || IsJumpTarget(advance)) {
+    return pc;
+  }
+  auto [cp_offset, on_failure] =
+      DecodeOperands<BC::kLoadCurrentCharacter>(code_ + load);
+  auto [character, on_equal] = DecodeOperands<BC::kCheckCharacter>(code_ + check);
+  auto [by, on_goto] = DecodeOperands<BC::kAdvanceCpAndGoto>(code_ + advance);
+  if (static_cast<int>(on_goto) != load) return pc;
+
+  EmitBytecode<BC::kSkipUntilChar>(&dst_, cp_offset, by, character, on_equal,
+                                   on_failure);
+  return NextPc(advance);
+}
+
+// Sequence:
+//   loop: CheckPosition eats_at_least, on_failure
+//         LoadCurrentCharacterUnchecked cp_offset
+//         CheckCharacter character, on_equal
+//         AdvanceCpAndGoto by, loop
+int RegExpBytecodePeephole::TrySkipUntilCharPosChecked(int pc) {
+  const int check_position = pc;
+  const int load = NextPc(check_position);
+  const int check = NextPc(load);
+  const int advance = NextPc(check);
+  if (BytecodeAt(check_position) != BC::kCheckPosition ||
+      BytecodeAt(load) != BC::kLoadCurrentCharacterUnchecked ||
+      IsJumpTarget(load) || BytecodeAt(check) != BC::kCheckCharacter ||
+      IsJumpTarget(check) || BytecodeAt(advance) != BC::kAdvanceCpAndGoto ||
+      IsJumpTarget(advance)) {
+    return pc;
+  }
+  auto [eats_at_least, on_failure] =
+      DecodeOperands<BC::kCheckPosition>(code_ + check_position);
+  auto [cp_offset] =
+      DecodeOperands<BC::kLoadCurrentCharacterUnchecked>(code_ + load);
+  auto [character, on_equal] = DecodeOperands<BC::kCheckCharacter>(code_ + check);
+  auto [by, on_goto] = DecodeOperands<BC::kAdvanceCpAndGoto>(code_ + advance);
+  if (static_cast<int>(on_goto) != check_position) return pc;
+
+  EmitBytecode<BC::kSkipUntilCharPosChecked>(
+      &dst_, cp_offset, by, character, eats_at_least, on_equal, on_failure);
+  return NextPc(advance);
+}
+
+// Sequence:
+//   loop: CheckPosition eats_at_least, on_failure
+//         LoadCurrentCharacterUnchecked cp_offset
+//         CheckCharacterAfterAnd character, mask, on_equal
+//         AdvanceCpAndGoto by, loop
+int RegExpBytecodePeephole::TrySkipUntilCharAnd(int pc) {
+  const int check_position = pc;
+  const int load = NextPc(check_position);
+  const int check = NextPc(load);
+  const int advance = NextPc(check);
+  if (BytecodeAt(check_position) != BC::kCheckPosition ||
+      BytecodeAt(load) != BC::kLoadCurrentCharacterUnchecked ||
+      IsJumpTarget(load) || BytecodeAt(check) != BC::kCheckCharacterAfterAnd ||
+      IsJumpTarget(check) || BytecodeAt(advance) != BC::kAdvanceCpAndGoto ||
+      IsJumpTarget(advance)) {
+    return pc;
+  }
+  auto [eats_at_least, on_failure] =
+      DecodeOperands<BC::kCheckPosition>(code_ + check_position);
+  auto [cp_offset] =
+      DecodeOperands<BC::kLoadCurrentCharacterUnchecked>(code_ + load);
+  auto [character, mask, on_equal] =
+      DecodeOperands<BC::kCheckCharacterAfterAnd>(code_ + check);
+  auto [by, on_goto] = DecodeOperands<BC::kAdvanceCpAndGoto>(code_ + advance);
+  if (static_cast<int>(on_goto) != check_position) return pc;
+
+  EmitBytecode<BC::kSkipUntilCharAnd>(&dst_, cp_offset, by, character, mask,
+                                      eats_at_least, on_equal, on_failure);
+  return NextPc(advance);
+}
+
+// Sequence:
+//   loop: LoadCurrentCharacter cp_offset, on_failure
+//         CheckCharacter char1, on_equal
+//         CheckCharacter char2, on_equal
+//         AdvanceCpAndGoto by, loop
+int RegExpBytecodePeephole::TrySkipUntilCharOrChar(int pc) {
+  const int load = pc;
+  const int check1 = NextPc(load);
+  const int check2 = NextPc(check1);
+  const int advance = NextPc(check2);
+  if (BytecodeAt(load) != BC::kLoadCurrentCharacter ||
+      BytecodeAt(check1) != BC::kCheckCharacter || IsJumpTarget(check1) ||
+      BytecodeAt(check2) != BC::kCheckCharacter || IsJumpTarget(check2) ||
+      BytecodeAt(advance) != BC::kAdvanceCpAndGoto || IsJumpTarget(advance)) {
+    return pc;
+  }
+  auto [cp_offset, on_failure] =
+      DecodeOperands<BC::kLoadCurrentCharacter>(code_ + load);
+  auto [char1, on_equal1] = DecodeOperands<BC::kCheckCharacter>(code_ + check1);
+  auto [char2, on_equal2] = DecodeOperands<BC::kCheckCharacter>(code_ + check2);
+  auto [by, on_goto] = DecodeOperands<BC::kAdvanceCpAndGoto>(code_ + advance);
+  if (on_equal1 != on_equal2 || static_cast<int>(on_goto) != load) return pc;
+
+  EmitBytecode<BC::kSkipUntilCharOrChar>(&dst_, cp_offset, by, char1, char2,
+                                         on_equal1, on_failure);
+  return NextPc(advance);
+}
+
+// Sequence:
+//   loop:    LoadCurrentCharacter cp_offset, on_failure
+//            CheckCharacterGT character, on_match
+//            CheckBitInTable advance, table
+//            GoTo on_match
+//   advance: AdvanceCpAndGoto by, loop
+int RegExpBytecodePeephole::TrySkipUntilGtOrNotBitInTable(int pc) {
+  const int load = pc;
+  const int check_gt = NextPc(load);
+  const int check_bit = NextPc(check_gt);
+  const int go_to = NextPc(check_bit);
+  const int advance = NextPc(go_to);
+  // The advance is only reached from the bit table check.
+  if (BytecodeAt(load) != BC::kLoadCurrentCharacter ||
+      BytecodeAt(check_gt) != BC::kCheckCharacterGT || IsJumpTarget(check_gt) ||
+      BytecodeAt(check_bit) != BC::kCheckBitInTable ||
+      IsJumpTarget(check_bit) || BytecodeAt(go_to) != BC::kGoTo ||
+      IsJumpTarget(go_to) || BytecodeAt(advance) != BC::kAdvanceCpAndGoto ||
+      JumpCount(advance) != 1) {
+    return pc;
+  }
+  auto [cp_offset, on_failure] =
+      DecodeOperands<BC::kLoadCurrentCharacter>(code_ + load);
+  auto [character, on_greater] =
+      DecodeOperands<BC::kCheckCharacterGT>(code_ + check_gt);
+  auto [on_bit_set, table] =
+      DecodeOperands<BC::kCheckBitInTable>(code_ + check_bit);
+  auto [label] = DecodeOperands<BC::kGoTo>(code_ + go_to);
+  auto [by, on_goto] = DecodeOperands<BC::kAdvanceCpAndGoto>(code_ + advance);
+  if (on_greater != label || static_cast<int>(on_bit_set) != advance ||
+      static_cast<int>(on_goto) != load) {
+    return pc;
+  }
+
+  EmitBytecode<BC::kSkipUntilGtOrNotBitInTable>(&dst_, cp_offset, by,
+                                                character, table, on_greater,
+                                                on_failure);
+  return NextPc(advance);
+}
+
+// Sequence:
+//   loop: LoadCurrentCharacter cp_offset, on_failure
+//         CheckBitInTable on_bit_set, table
+//         AdvanceCpAndGoto by, loop
+int RegExpBytecodePeephole::TrySkipUntilBitInTable(int pc) {
+  const int load = pc;
+  const int check = NextPc(load);
+  const int advance = NextPc(check);
+  if (BytecodeAt(load) != BC::kLoadCurrentCharacter ||
+      BytecodeAt(check) != BC::kCheckBitInTable || IsJumpTarget(check) ||
+      BytecodeAt(advance) != BC::kAdvanceCpAndGoto || IsJumpTarget(advance)) {
+    return pc;
+  }
+  auto [cp_offset, on_failure] =
+      DecodeOperands<BC::kLoadCurrentCharacter>(code_ + load);
+  auto [on_bit_set, table] = DecodeOperands<BC::kCheckBitInTable>(code_ + check);
+  auto [by, on_goto] = DecodeOperands<BC::kAdvanceCpAndGoto>(code_ + advance);
+  if (static_cast<int>(on_goto) != load) return pc;
+
+  EmitBytecode<BC::kSkipUntilBitInTable>(&dst_, cp_offset, by, table,
+                                         on_bit_set, on_failure);
+  return NextPc(advance);
+}
+
+int RegExpBytecodePeephole::TryReplaceSequence(int pc) {
+  int next_pc = pc;
+  switch (BytecodeAt(pc)) {
+    case BC::kLoadCurrentCharacter:
+      if ((next_pc = TrySkipUntilChar(pc)) != pc) break;
+      if ((next_pc = TrySkipUntilCharOrChar(pc)) != pc) break;
+      if ((next_pc = TrySkipUntilGtOrNotBitInTable(pc)) != pc) break;
+      next_pc = TrySkipUntilBitInTable(pc);
+      break;
+    case BC::kCheckPosition:
+      if ((next_pc = TrySkipUntilCharPosChecked(pc)) != pc) break;
+      next_pc = TrySkipUntilCharAnd(pc);
+      break;
+    default:
+      break;
+  }
+  return next_pc;
+}
+
+void RegExpBytecodePeephole::Optimize() {
+  int pc = 0;
+  while (pc < length_) {
+    pc_map_[pc / kBytecodeAlignment] = dst_.pc();
+    const int next_pc = TryReplaceSequence(pc);
+    if (next_pc != pc) {
+      pc = next_pc;
+      continue;
+    }
+    const int size = RegExpBytecodes::Size(BytecodeAt(pc));
+    dst_.EmitRawBytecodeStream(src_, pc, size);
+    pc += size;
+  }
+  ASSERT(pc == length_);
+  pc_map_[length_ / kBytecodeAlignment] = dst_.pc();
+  FixJumps();
+}
+
+void RegExpBytecodePeephole::FixJumps() {
+  for (auto& [source, target] : dst_.jump_edges()) {
+    const int new_target = pc_map_[target / kBytecodeAlignment];
+    // Jumps only target the first bytecode of replaced sequences.
+    ASSERT(new_target >= 0);
+    dst_.OverwriteValue<uint32_t>(new_target, source);
+    target = new_target;
+  }
+}
+
+}  // namespace
+
+// static
+TypedDataPtr RegExpBytecodePeepholeOptimization::OptimizeBytecode(
+    Zone* zone,
+    const RegExpBytecodeWriter* writer) {
+  RegExpBytecodePeephole peephole(zone, writer);
+  peephole.Optimize();
+
+  const RegExpBytecodeWriter& dst = peephole.dst();
+  const TypedData& array =
+      TypedData::Handle(TypedData::New(kTypedDataUint8ArrayCid, dst.length()));
+  NoSafepointScope no_safepoint;
+  dst.CopyBufferTo(reinterpret_cast<uint8_t*>(array.DataAddr(0)));
+  return array.ptr();
+}
+
+}  // namespace dart
@@ -0,0 +1,31 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_REGEXP_BYTECODE_PEEPHOLE_H_
+#define V8_REGEXP_REGEXP_BYTECODE_PEEPHOLE_H_
+
+#include "vm/object.h"
+#include "vm/regexp/base.h"
+
+namespace dart {
+
+class RegExpBytecodeWriter;
+
+// Peephole optimization for regexp interpreter bytecode.
+// Pre-defined bytecode sequences occurring in bytecode generated by the
+// RegExpBytecodeGenerator can be optimized into a single bytecode (see
+// PEEPHOLE_BYTECODE_LIST in regexp-bytecodes.h). The interpreter then
+// dispatches once per input character instead of once per bytecode of the
+// sequence.
+class RegExpBytecodePeepholeOptimization : public AllStatic {
+ public:
+  // Performs peephole optimization on the bytecode of the given writer and
+  // returns the optimized bytecode.
+  static TypedDataPtr OptimizeBytecode(Zone* zone,
+                                       const RegExpBytecodeWriter* writer);
+};
+
+}  // namespace dart
+
+#endif  // V8_REGEXP_REGEXP_BYTECODE_PEEPHOLE_H_
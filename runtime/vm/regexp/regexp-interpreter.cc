@@ -9,6 +9,7 @@
 #include <limits>
 
 #include "vm/exceptions.h"
+#include "vm/flags.h"
 #include "vm/regexp/regexp-bytecodes-inl.h"
 #include "vm/regexp/regexp-bytecodes.h"
 #include "vm/regexp/regexp-macro-assembler.h"
@@ -28,6 +29,9 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, enable_experimental_regexp_engine_on_excessive_backtracks);
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+
 namespace {
 
 bool BackRefMatchesNoCase(Thread* thread,
@@ -576,7 +580,8 @@ IrregexpInterpreter::Result RawMatch(Thread* thread,
     }
     BYTECODE(Backtrack, return_code) {
       static_assert(JSRegExp::kNoBacktrackLimit == 0);
-      if (++backtrack_count == backtrack_limit) {
+      if (return_code == IrregexpInterpreter::FALLBACK_TO_EXPERIMENTAL &&
+          ++backtrack_count == backtrack_limit) {
         return static_cast<IrregexpInterpreter::Result>(return_code);
       }
 
@@ -1131,7 +1136,12 @@ int IrregexpInterpreter::Match(Thread* thread,
   // int number_of_matches_in_output_registers =
   // output_register_count / registers_per_match;
 
-  int backtrack_limit = JSRegExp::kNoBacktrackLimit;
+  // Dart: Only bytecode generated for patterns that can fall back to the
+  // experimental engine is limited, see the Backtrack bytecode.
+  int backtrack_limit =
+      FLAG_enable_experimental_regexp_engine_on_excessive_backtracks
+          ? FLAG_regexp_backtracks_before_fallback
+          : JSRegExp::kNoBacktrackLimit;
 
 #ifdef ENABLE_DISASSEMBLER
   if (v8_flags.trace_regexp_bytecodes) {
@@ -0,0 +1,1084 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/regexp-macro-assembler-arm64.h"
+
+#if defined(DART_REGEXP_NATIVE_CODE) && defined(TARGET_ARCH_ARM64)
+
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+/*
+ * This assembler uses the following register assignment convention
+ * - x19 : Pointer to the top of the backtrack stack. The stack grows
+ *         downwards and holds 32 bit values.
+ * - x20 : Current position in input, as negative offset from end of string.
+ *         Please notice that this is the byte offset, not the character
+ *         offset!
+ * - x21 : Currently loaded character. Must be loaded using
+ *         LoadCurrentCharacter before using any of the dispatch methods.
+ * - x22 : End of input (points to byte after last character in input).
+ * - x23 : Start of the generated code. Backtrack targets are pushed as
+ *         offsets relative to it.
+ * - x24 : Return address of the out-of-line code for backtrack stack
+ *         overflows and interrupts.
+ * - fp  : Frame pointer. Used to access the match state and local variables.
+ * - csp : Points to the RegExp registers.
+ *
+ * All of the above registers are callee saved. x0-x15 are used as scratch
+ * registers, x16 and x17 are the scratch registers of the assembler, and
+ * x18 is the platform register.
+ *
+ * The stack will have the following structure:
+ *    - saved lr
+ *    - saved fp                    <- fp
+ *    - saved x19, x20
+ *    - saved x21, x22
+ *    - saved x23, x24
+ *    - MatchState*                 (kMatchState)
+ *    - Thread*                     (kThread)
+ *    - string start minus one      (kStringStartMinusOne)
+ *    - backtrack stack top         (kBacktrackStackTop)
+ *    - backtrack stack limit       (kBacktrackStackLimit)
+ *    - backtrack count             (kBacktrackCount)
+ *    - register num_registers-1
+ *    ...
+ *    - register 1
+ *    - register 0                  <- csp (rounded to 16 bytes)
+ *
+ * The first num_saved_registers_ registers are initialized to point to
+ * "character -1" in the string (i.e., char_size() bytes before the first
+ * character of the string). The remaining registers start out uninitialized.
+ *
+ * The generated code is called as
+ *   int32_t matcher(NativeRegExpMacroAssembler::MatchState* state)
+ * and returns one of the NativeRegExpMacroAssembler::Result values.
+ */
+
+#define __ masm_.
+
+RegExpMacroAssemblerARM64::RegExpMacroAssemblerARM64(Isolate* isolate,
+                                                     Zone* zone,
+                                                     Mode mode,
+                                                     int registers_to_save)
+    : NativeRegExpMacroAssembler(isolate, zone, mode),
+      // Dart: Conditional branches only reach 1MB. Far branches are used for
+      // large patterns instead of V8's veneers, the ones that end up in range
+      // are turned into a branch and a nop.
+      masm_(/*object_pool_builder=*/nullptr, /*far_branch_level=*/1),
+      labels_(zone, 16),
+      backtrack_fixups_(zone, 16),
+      num_registers_(registers_to_save),
+      num_saved_registers_(registers_to_save),
+      entry_label_(new (zone) compiler::Label()),
+      start_label_(new (zone) compiler::Label()),
+      success_label_(new (zone) compiler::Label()),
+      backtrack_label_(new (zone) compiler::Label()),
+      exit_label_(new (zone) compiler::Label()),
+      check_preempt_label_(new (zone) compiler::Label()),
+      stack_overflow_label_(new (zone) compiler::Label()),
+      exit_with_exception_label_(new (zone) compiler::Label()),
+      fallback_label_(new (zone) compiler::Label()) {
+  DCHECK_EQ(0, registers_to_save % 2);
+  // Take the start of the code, which backtrack targets are relative to,
+  // before jumping to the entry code: adr can't reach back more than 1MB.
+  __ adr(R9, compiler::Immediate(0));
+  __ b(entry_label_);  // We'll write the entry code when we know more.
+  // The code below runs in the frame set up by the entry code, which saved
+  // LR.
+  __ set_lr_state(compiler::LRState::OnEntry().EnterFrame());
+  __ Bind(start_label_);  // And then continue from here.
+}
+
+RegExpMacroAssemblerARM64::~RegExpMacroAssemblerARM64() = default;
+
+int RegExpMacroAssemblerARM64::FrameSize() const {
+  // Everything below the saved registers.
+  return Utils::RoundUp(kLocalsSize + num_registers_ * kWordSize,
+                        2 * kWordSize);
+}
+
+compiler::Label* RegExpMacroAssemblerARM64::LabelFor(V8Label* label) {
+  if (label == nullptr) return backtrack_label_;
+  if (label->is_unused()) {
+    // The position of a V8Label is the index of its assembler label.
+    label->link_to(labels_.length());
+    labels_.Add(new (zone()) compiler::Label());
+  }
+  return labels_[label->pos()];
+}
+
+void RegExpMacroAssemblerARM64::AdvanceCurrentPosition(int by) {
+  if (by != 0) {
+    __ AddImmediate(current_input_offset(), by * char_size());
+  }
+}
+
+void RegExpMacroAssemblerARM64::AdvanceRegister(int reg, int by) {
+  DCHECK_LE(0, reg);
+  DCHECK_GT(num_registers_, reg);
+  if (by != 0) {
+    __ ldr(R0, register_location(reg));
+    __ AddImmediate(R0, by);
+    __ str(R0, register_location(reg));
+  }
+}
+
+void RegExpMacroAssemblerARM64::Backtrack() {
+  EmitBacktrack();
+}
+
+void RegExpMacroAssemblerARM64::EmitBacktrack() {
+  CheckPreemption();
+  if (has_backtrack_limit()) {
+    compiler::Label next;
+    __ ldr(R0, compiler::Address(FP, kBacktrackCount));
+    __ AddImmediate(R0, 1);
+    __ str(R0, compiler::Address(FP, kBacktrackCount));
+    __ CompareImmediate(R0, backtrack_limit());
+    __ b(&next, NOT_EQUAL);
+
+    // Backtrack limit exceeded.
+    if (can_fallback()) {
+      __ b(fallback_label_);
+    } else {
+      // Can't fallback, so we treat it as a failed match.
+      Fail();
+    }
+
+    __ Bind(&next);
+  }
+  // Pop the code offset from the backtrack stack, add the code start and jump
+  // to the location.
+  Pop(R0);
+  __ add(R0, R0, compiler::Operand(code_object_pointer()));
+  __ br(R0);
+}
+
+void RegExpMacroAssemblerARM64::Bind(V8Label* label) {
+  ASSERT(!label->is_bound());
+  compiler::Label* target = LabelFor(label);
+  const int index = label->pos();
+  __ Bind(target);
+  label->bind_to(index);
+}
+
+void RegExpMacroAssemblerARM64::CheckCharacter(unsigned c, V8Label* on_equal) {
+  __ CompareImmediate(current_character(), c, compiler::kFourBytes);
+  BranchOrBacktrack(EQUAL, on_equal);
+}
+
+void RegExpMacroAssemblerARM64::CheckCharacterGT(uint16_t limit,
+                                                 V8Label* on_greater) {
+  __ CompareImmediate(current_character(), limit, compiler::kFourBytes);
+  BranchOrBacktrack(GREATER, on_greater);
+}
+
+void RegExpMacroAssemblerARM64::CheckAtStart(int cp_offset,
+                                             V8Label* on_at_start) {
+  __ AddImmediate(R0, current_input_offset(),
+                  -char_size() + cp_offset * char_size());
+  __ ldr(R1, compiler::Address(FP, kStringStartMinusOne));
+  __ cmp(R0, compiler::Operand(R1));
+  BranchOrBacktrack(EQUAL, on_at_start);
+}
+
+void RegExpMacroAssemblerARM64::CheckNotAtStart(int cp_offset,
+                                                V8Label* on_not_at_start) {
+  __ AddImmediate(R0, current_input_offset(),
+                  -char_size() + cp_offset * char_size());
+  __ ldr(R1, compiler::Address(FP, kStringStartMinusOne));
+  __ cmp(R0, compiler::Operand(R1));
+  BranchOrBacktrack(NOT_EQUAL, on_not_at_start);
+}
+
+void RegExpMacroAssemblerARM64::CheckCharacterLT(uint16_t limit,
+                                                 V8Label* on_less) {
+  __ CompareImmediate(current_character(), limit, compiler::kFourBytes);
+  BranchOrBacktrack(LESS, on_less);
+}
+
+void RegExpMacroAssemblerARM64::CheckFixedLengthLoop(
+    V8Label* on_tos_equals_current_position) {
+  compiler::Label fallthrough;
+  __ ldr(R0, compiler::Address(backtrack_stackpointer(), 0),
+         compiler::kFourBytes);
+  __ cmp(current_input_offset(), compiler::Operand(R0));
+  __ b(&fallthrough, NOT_EQUAL);
+  Drop();
+  BranchOrBacktrack(on_tos_equals_current_position);
+  __ Bind(&fallthrough);
+}
+
+void RegExpMacroAssemblerARM64::CheckNotBackReferenceIgnoreCase(
+    int start_reg,
+    bool read_backward,
+    bool unicode,
+    V8Label* on_no_match) {
+  compiler::Label fallthrough;
+  __ ldr(R1, register_location(start_reg));      // Offset of start of capture
+  __ ldr(R2, register_location(start_reg + 1));  // Offset of end of capture
+  // Dart: Like the interpreter, only compare captures that have been set and
+  // are not empty.
+  __ ldr(R0, compiler::Address(FP, kStringStartMinusOne));
+  __ cmp(R1, compiler::Operand(R0));
+  __ b(&fallthrough, EQUAL);
+  __ subs(R2, R2, compiler::Operand(R1));  // Length of capture.
+  __ b(&fallthrough, LESS_EQUAL);
+
+  // Check that there are sufficient characters left in the input.
+  if (read_backward) {
+    __ add(R0, R0, compiler::Operand(R2));
+    __ cmp(current_input_offset(), compiler::Operand(R0));
+    BranchOrBacktrack(LESS_EQUAL, on_no_match);
+  } else {
+    __ cmn(current_input_offset(), compiler::Operand(R2));
+    BranchOrBacktrack(GREATER, on_no_match);
+  }
+
+  // R3 - Address of start of the match in the input.
+  // R1 - Address of start of the capture.
+  __ add(R3, end_of_input_address(), compiler::Operand(current_input_offset()));
+  if (read_backward) {
+    __ sub(R3, R3, compiler::Operand(R2));  // Offset by length when matching
+                                            // backwards.
+  }
+  __ add(R1, R1, compiler::Operand(end_of_input_address()));
+
+  if (mode() == LATIN1) {
+    compiler::Label loop;
+    compiler::Label loop_increment;
+    // R4 - Address of end of the capture.
+    __ add(R4, R1, compiler::Operand(R2));
+
+    __ Bind(&loop);
+    __ ldr(R0, compiler::Address(R3, 1, compiler::Address::PostIndex),
+           compiler::kUnsignedByte);
+    __ ldr(R5, compiler::Address(R1, 1, compiler::Address::PostIndex),
+           compiler::kUnsignedByte);
+    // R0 - input character
+    // R5 - capture character
+    __ cmp(R0, compiler::Operand(R5), compiler::kFourBytes);
+    __ b(&loop_increment, EQUAL);
+
+    // Mismatch, try case-insensitive match (converting letters to lower-case).
+    __ OrImmediate(R0, R0, 0x20, compiler::kFourBytes);
+    __ OrImmediate(R5, R5, 0x20, compiler::kFourBytes);
+    __ cmp(R0, compiler::Operand(R5), compiler::kFourBytes);
+    BranchOrBacktrack(NOT_EQUAL, on_no_match);
+    __ AddImmediate(R0, R0, -'a', compiler::kFourBytes);
+    __ CompareImmediate(R0, 'z' - 'a', compiler::kFourBytes);
+    __ b(&loop_increment, UNSIGNED_LESS_EQUAL);
+    // Latin-1: Check for values in range [224,254] but not 247.
+    __ AddImmediate(R0, R0, -(224 - 'a'), compiler::kFourBytes);
+    __ CompareImmediate(R0, 254 - 224, compiler::kFourBytes);
+    // Weren't Latin-1 letters.
+    BranchOrBacktrack(UNSIGNED_GREATER, on_no_match);
+    __ CompareImmediate(R0, 247 - 224, compiler::kFourBytes);  // Check for 247.
+    BranchOrBacktrack(EQUAL, on_no_match);
+
+    __ Bind(&loop_increment);
+    // Compare to end of capture, and loop if not done. The pointers were
+    // incremented by the loads.
+    __ cmp(R1, compiler::Operand(R4));
+    __ b(&loop, UNSIGNED_LESS);
+  } else {
+    DCHECK(mode() == UC16);
+    // Compare with the runtime function, which doesn't allocate:
+    //   int CaseInsensitiveCompare(Address byte_offset1,
+    //                              Address byte_offset2,
+    //                              size_t byte_length,
+    //                              Isolate* isolate);
+    __ mov(R0, R1);
+    __ mov(R1, R3);
+    // The length is already in R2.
+    __ ldr(R3, compiler::Address(FP, kMatchState));
+    __ ldr(R3, compiler::Address(R3, offsetof(MatchState, isolate)));
+    const auto compare = unicode ? &CaseInsensitiveCompareUnicode
+                                 : &CaseInsensitiveCompareNonUnicode;
+    __ LoadImmediate(R4, reinterpret_cast<int64_t>(compare));
+    __ CallCFunction(R4);
+    // Check if function returned non-zero for success or zero for failure.
+    __ cmp(R0, compiler::Operand(0), compiler::kFourBytes);
+    BranchOrBacktrack(EQUAL, on_no_match);
+  }
+
+  // On success, advance position by length of capture.
+  __ ldr(R0, register_location(start_reg + 1));
+  __ ldr(R1, register_location(start_reg));
+  __ sub(R0, R0, compiler::Operand(R1));
+  if (read_backward) {
+    __ sub(current_input_offset(), current_input_offset(),
+           compiler::Operand(R0));
+  } else {
+    __ add(current_input_offset(), current_input_offset(),
+           compiler::Operand(R0));
+  }
+
+  __ Bind(&fallthrough);
+}
+
+void RegExpMacroAssemblerARM64::CheckNotBackReference(int start_reg,
+                                                      bool read_backward,
+                                                      V8Label* on_no_match) {
+  compiler::Label fallthrough;
+
+  // Find length of back-referenced capture.
+  __ ldr(R1, register_location(start_reg));
+  __ ldr(R2, register_location(start_reg + 1));
+  // Dart: Like the interpreter, only compare captures that have been set and
+  // are not empty.
+  __ ldr(R0, compiler::Address(FP, kStringStartMinusOne));
+  __ cmp(R1, compiler::Operand(R0));
+  __ b(&fallthrough, EQUAL);
+  __ subs(R2, R2, compiler::Operand(R1));  // Length to check.
+  __ b(&fallthrough, LESS_EQUAL);
+
+  // Check that there are sufficient characters left in the input.
+  if (read_backward) {
+    __ add(R0, R0, compiler::Operand(R2));
+    __ cmp(current_input_offset(), compiler::Operand(R0));
+    BranchOrBacktrack(LESS_EQUAL, on_no_match);
+  } else {
+    __ cmn(current_input_offset(), compiler::Operand(R2));
+    BranchOrBacktrack(GREATER, on_no_match);
+  }
+
+  // Compute pointers to match string and capture string.
+  __ add(R3, end_of_input_address(),
+         compiler::Operand(current_input_offset()));  // Start of match.
+  if (read_backward) {
+    __ sub(R3, R3, compiler::Operand(R2));  // Offset by length when matching
+                                            // backwards.
+  }
+  __ add(R1, R1, compiler::Operand(end_of_input_address()));  // Start of
+                                                              // capture.
+  __ add(R4, R1, compiler::Operand(R2));  // End of capture.
+
+  compiler::Label loop;
+  __ Bind(&loop);
+  const compiler::OperandSize size = mode() == LATIN1
+                                         ? compiler::kUnsignedByte
+                                         : compiler::kUnsignedTwoBytes;
+  __ ldr(R0, compiler::Address(R1, char_size(), compiler::Address::PostIndex),
+         size);
+  __ ldr(R5, compiler::Address(R3, char_size(), compiler::Address::PostIndex),
+         size);
+  __ cmp(R0, compiler::Operand(R5), compiler::kFourBytes);
+  BranchOrBacktrack(NOT_EQUAL, on_no_match);
+  // Check if we have reached end of match area. The pointers into capture
+  // and match string were incremented by the loads.
+  __ cmp(R1, compiler::Operand(R4));
+  __ b(&loop, UNSIGNED_LESS);
+
+  // Success. Advance the current position by the length of the capture.
+  if (read_backward) {
+    __ sub(current_input_offset(), current_input_offset(),
+           compiler::Operand(R2));
+  } else {
+    __ add(current_input_offset(), current_input_offset(),
+           compiler::Operand(R2));
+  }
+
+  __ Bind(&fallthrough);
+}
+
+void RegExpMacroAssemblerARM64::CheckNotCharacter(unsigned c,
+                                                  V8Label* on_not_equal) {
+  __ CompareImmediate(current_character(), c, compiler::kFourBytes);
+  BranchOrBacktrack(NOT_EQUAL, on_not_equal);
+}
+
+void RegExpMacroAssemblerARM64::CheckCharacterAfterAnd(unsigned c,
+                                                       unsigned mask,
+                                                       V8Label* on_equal) {
+  if (c == 0) {
+    __ TestImmediate(current_character(), mask, compiler::kFourBytes);
+  } else {
+    __ AndImmediate(R0, current_character(), mask, compiler::kFourBytes);
+    __ CompareImmediate(R0, c, compiler::kFourBytes);
+  }
+  BranchOrBacktrack(EQUAL, on_equal);
+}
+
+void RegExpMacroAssemblerARM64::CheckNotCharacterAfterAnd(
+    unsigned c,
+    unsigned mask,
+    V8Label* on_not_equal) {
+  if (c == 0) {
+    __ TestImmediate(current_character(), mask, compiler::kFourBytes);
+  } else {
+    __ AndImmediate(R0, current_character(), mask, compiler::kFourBytes);
+    __ CompareImmediate(R0, c, compiler::kFourBytes);
+  }
+  BranchOrBacktrack(NOT_EQUAL, on_not_equal);
+}
+
+void RegExpMacroAssemblerARM64::CheckNotCharacterAfterMinusAnd(
+    uint16_t c,
+    uint16_t minus,
+    uint16_t mask,
+    V8Label* on_not_equal) {
+  DCHECK_GT(String::kMaxUtf16CodeUnit, minus);
+  __ AddImmediate(R0, current_character(), -minus, compiler::kFourBytes);
+  __ AndImmediate(R0, R0, mask, compiler::kFourBytes);
+  __ CompareImmediate(R0, c, compiler::kFourBytes);
+  BranchOrBacktrack(NOT_EQUAL, on_not_equal);
+}
+
+void RegExpMacroAssemblerARM64::CheckCharacterInRange(uint16_t from,
+                                                      uint16_t to,
+                                                      V8Label* on_in_range) {
+  __ AddImmediate(R0, current_character(), -from, compiler::kFourBytes);
+  __ CompareImmediate(R0, to - from, compiler::kFourBytes);
+  BranchOrBacktrack(UNSIGNED_LESS_EQUAL, on_in_range);
+}
+
+void RegExpMacroAssemblerARM64::CheckCharacterNotInRange(
+    uint16_t from,
+    uint16_t to,
+    V8Label* on_not_in_range) {
+  __ AddImmediate(R0, current_character(), -from, compiler::kFourBytes);
+  __ CompareImmediate(R0, to - from, compiler::kFourBytes);
+  BranchOrBacktrack(UNSIGNED_GREATER, on_not_in_range);
+}
+
+void RegExpMacroAssemblerARM64::CheckBitInTable(const TypedData& table,
+                                                V8Label* on_bit_set) {
+  // Dart: The table has kTableSize entries, which are folded into two 64 bit
+  // immediates so that the code doesn't refer to the heap.
+  static_assert(kTableSize == 2 * kBitsPerInt64);
+  uint64_t low = 0;
+  uint64_t high = 0;
+  for (intptr_t i = 0; i < kTableSize; i++) {
+    if (table.GetUint8(i) == 0) continue;
+    if (i < kBitsPerInt64) {
+      low |= uint64_t{1} << i;
+    } else {
+      high |= uint64_t{1} << (i - kBitsPerInt64);
+    }
+  }
+  __ AndImmediate(R1, current_character(), kTableMask, compiler::kFourBytes);
+  __ LoadImmediate(R0, static_cast<int64_t>(low));
+  if (high != low) {
+    __ LoadImmediate(R2, static_cast<int64_t>(high));
+    __ TestImmediate(R1, kBitsPerInt64);
+    __ csel(R0, R2, R0, NOT_ZERO);
+  }
+  // lsrv only uses the low six bits of the shift.
+  __ lsrv(R0, R0, R1);
+  __ tbnz(LabelFor(on_bit_set), R0, 0);
+}
+
+void RegExpMacroAssemblerARM64::SkipUntilBitInTable(
+    int cp_offset,
+    const TypedData& table,
+    const TypedData& nibble_table,
+    int advance_by,
+    V8Label* on_match,
+    V8Label* on_no_match) {
+  V8Label loop;
+  Bind(&loop);
+  LoadCurrentCharacter(cp_offset, on_no_match, true);
+  CheckBitInTable(table, on_match);
+  AdvanceCurrentPosition(advance_by);
+  GoTo(&loop);
+}
+
+void RegExpMacroAssemblerARM64::CheckWordCharacter(Condition condition,
+                                                   V8Label* on_condition) {
+  __ LoadImmediate(R0, reinterpret_cast<int64_t>(word_character_map_));
+  __ ldr(R0, compiler::Address(R0, current_character()),
+         compiler::kUnsignedByte);
+  __ cmp(R0, compiler::Operand(0), compiler::kFourBytes);
+  BranchOrBacktrack(condition, on_condition);
+}
+
+void RegExpMacroAssemblerARM64::CheckSpecialClassRanges(
+    StandardCharacterSet type,
+    V8Label* on_no_match) {
+  // Range checks (c in min..max) are generally implemented by an unsigned
+  // (c - min) <= (max - min) check, using the sequence:
+  //   sub(w0, current_character(), min)
+  //   cmp(w0, max - min)
+  switch (type) {
+    case StandardCharacterSet::kWhitespace: {
+      // Match space-characters.
+      DCHECK(mode() == LATIN1);
+      // One byte space characters are '\t'..'\r', ' ' and  .
+      compiler::Label success;
+      __ CompareImmediate(current_character(), ' ', compiler::kFourBytes);
+      __ b(&success, EQUAL);
+      // Check range 0x09..0x0D.
+      __ AddImmediate(R0, current_character(), -'\t', compiler::kFourBytes);
+      __ CompareImmediate(R0, '\r' - '\t', compiler::kFourBytes);
+      __ b(&success, UNSIGNED_LESS_EQUAL);
+      //   (NBSP).
+      __ CompareImmediate(R0, 0x00A0 - '\t', compiler::kFourBytes);
+      BranchOrBacktrack(NOT_EQUAL, on_no_match);
+      __ Bind(&success);
+      return;
+    }
+    case StandardCharacterSet::kNotWhitespace:
+      // The emitted code for generic character classes is good enough.
+      UNREACHABLE();
+    case StandardCharacterSet::kDigit:
+      // Match ASCII digits ('0'..'9').
+      __ AddImmediate(R0, current_character(), -'0', compiler::kFourBytes);
+      __ CompareImmediate(R0, '9' - '0', compiler::kFourBytes);
+      BranchOrBacktrack(UNSIGNED_GREATER, on_no_match);
+      return;
+    case StandardCharacterSet::kNotDigit:
+      // Match non ASCII-digits.
+      __ AddImmediate(R0, current_character(), -'0', compiler::kFourBytes);
+      __ CompareImmediate(R0, '9' - '0', compiler::kFourBytes);
+      BranchOrBacktrack(UNSIGNED_LESS_EQUAL, on_no_match);
+      return;
+    case StandardCharacterSet::kNotLineTerminator: {
+      // Match non-newlines (not 0x0A('\n'), 0x0D('\r'), 0x2028 and 0x2029).
+      __ XorImmediate(R0, current_character(), 0x01, compiler::kFourBytes);
+      // See if current character is '\n'^1 or '\r'^1, i.e., 0x0B or 0x0C.
+      __ AddImmediate(R0, R0, -0x0B, compiler::kFourBytes);
+      __ CompareImmediate(R0, 0x0C - 0x0B, compiler::kFourBytes);
+      BranchOrBacktrack(UNSIGNED_LESS_EQUAL, on_no_match);
+      if (mode() == UC16) {
+        // Compare original value to 0x2028 and 0x2029, using the already
+        // computed (current_char ^ 0x01 - 0x0B). I.e., check for
+        // 0x201D (0x2028 - 0x0B) or 0x201E.
+        __ AddImmediate(R0, R0, -(0x2028 - 0x0B), compiler::kFourBytes);
+        __ CompareImmediate(R0, 0x2029 - 0x2028, compiler::kFourBytes);
+        BranchOrBacktrack(UNSIGNED_LESS_EQUAL, on_no_match);
+      }
+      return;
+    }
+    case StandardCharacterSet::kWord: {
+      if (mode() != LATIN1) {
+        __ CompareImmediate(current_character(), 'z', compiler::kFourBytes);
+        BranchOrBacktrack(UNSIGNED_GREATER, on_no_match);
+      }
+      CheckWordCharacter(EQUAL, on_no_match);
+      return;
+    }
+    case StandardCharacterSet::kNotWord: {
+      compiler::Label done;
+      if (mode() != LATIN1) {
+        __ CompareImmediate(current_character(), 'z', compiler::kFourBytes);
+        __ b(&done, UNSIGNED_GREATER);
+      }
+      CheckWordCharacter(NOT_EQUAL, on_no_match);
+      __ Bind(&done);
+      return;
+    }
+    case StandardCharacterSet::kLineTerminator: {
+      // Match newlines (0x0A('\n'), 0x0D('\r'), 0x2028 or 0x2029).
+      // The opposite of '.'.
+      __ XorImmediate(R0, current_character(), 0x01, compiler::kFourBytes);
+      // See if current character is '\n'^1 or '\r'^1, i.e., 0x0B or 0x0C.
+      __ AddImmediate(R0, R0, -0x0B, compiler::kFourBytes);
+      __ CompareImmediate(R0, 0x0C - 0x0B, compiler::kFourBytes);
+      if (mode() == LATIN1) {
+        BranchOrBacktrack(UNSIGNED_GREATER, on_no_match);
+      } else {
+        compiler::Label done;
+        __ b(&done, UNSIGNED_LESS_EQUAL);
+        DCHECK(mode() == UC16);
+        // Compare original value to 0x2028 and 0x2029, using the already
+        // computed (current_char ^ 0x01 - 0x0B). I.e., check for
+        // 0x201D (0x2028 - 0x0B) or 0x201E.
+        __ AddImmediate(R0, R0, -(0x2028 - 0x0B), compiler::kFourBytes);
+        __ CompareImmediate(R0, 0x2029 - 0x2028, compiler::kFourBytes);
+        BranchOrBacktrack(UNSIGNED_GREATER, on_no_match);
+        __ Bind(&done);
+      }
+      return;
+    }
+    case StandardCharacterSet::kEverything:
+      // Match all characters.
+      return;
+  }
+}
+
+void RegExpMacroAssemblerARM64::Fail() {
+  static_assert(FAILURE == 0);  // Return value for failure is zero.
+  __ LoadImmediate(R0, FAILURE);
+  __ b(exit_label_);
+}
+
+ObjectPtr RegExpMacroAssemblerARM64::GetCode(const String& source,
+                                             RegExpFlags flags) {
+  // Dart: The registers live in the frame on the C++ stack, keep patterns
+  // using a lot of them in the interpreter.
+  if (num_registers_ > kMaxRegisterCountForNativeCode) {
+    return Code::null();
+  }
+
+  // Finalize code - write the entry point code now we know how many
+  // registers we need. It is reached from the start of the code, with the
+  // return address in LR.
+  __ set_lr_state(compiler::LRState::OnEntry());
+  __ Bind(entry_label_);
+
+  // Actually emit code to start a new stack frame.
+  SPILLS_LR_TO_FRAME(
+      __ stp(FP, LR,
+             compiler::Address(CSP, -2 * kWordSize,
+                               compiler::Address::PairPreIndex)));
+  __ mov(FP, CSP);
+  // Save callee-save registers.
+  const compiler::Address push_pair(CSP, -2 * kWordSize,
+                                    compiler::Address::PairPreIndex);
+  __ stp(R19, R20, push_pair);
+  __ stp(R21, R22, push_pair);
+  __ stp(R23, R24, push_pair);
+  __ AddImmediate(CSP, CSP, -FrameSize());
+
+  // The start of the code was loaded into R9 before jumping here.
+  __ mov(code_object_pointer(), R9);
+
+  // Copy the match state into the frame and registers.
+  __ str(R0, compiler::Address(FP, kMatchState));
+  __ ldr(R1, compiler::Address(R0, offsetof(MatchState, thread)));
+  __ str(R1, compiler::Address(FP, kThread));
+  __ ldr(backtrack_stackpointer(),
+         compiler::Address(R0, offsetof(MatchState, backtrack_stack_top)));
+  __ str(backtrack_stackpointer(), compiler::Address(FP, kBacktrackStackTop));
+  __ ldr(R1,
+         compiler::Address(R0, offsetof(MatchState, backtrack_stack_limit)));
+  __ str(R1, compiler::Address(FP, kBacktrackStackLimit));
+  __ str(ZR, compiler::Address(FP, kBacktrackCount));
+  __ ldr(end_of_input_address(),
+         compiler::Address(R0, offsetof(MatchState, input_end)));
+  __ ldr(current_input_offset(),
+         compiler::Address(R0, offsetof(MatchState, input_start)));
+  __ sub(current_input_offset(), current_input_offset(),
+         compiler::Operand(end_of_input_address()));
+  // Set R1 to the address of char before start of the string
+  // (effectively string position -1) and store it in a local variable, for
+  // use when clearing position registers.
+  __ AddImmediate(R1, current_input_offset(), -char_size());
+  __ str(R1, compiler::Address(FP, kStringStartMinusOne));
+  // Move the current position to the start index.
+  __ ldr(R1, compiler::Address(R0, offsetof(MatchState, start_index)));
+  __ add(current_input_offset(), current_input_offset(),
+         compiler::Operand(R1, LSL, mode() == LATIN1 ? 0 : 1));
+
+  {
+    compiler::Label load_char_start_regexp;
+    compiler::Label start_regexp;
+    // Load newline if index is at start, previous character otherwise.
+    __ cbnz(&load_char_start_regexp, R1);
+    __ LoadImmediate(current_character(), '\n');
+    __ b(&start_regexp);
+    __ Bind(&load_char_start_regexp);
+    // Load previous char as initial value of current character register.
+    LoadCurrentCharacterUnchecked(-1, 1);
+    __ Bind(&start_regexp);
+  }
+
+  // Initialize on-stack registers.
+  if (num_saved_registers_ > 0) {
+    // Fill saved registers with initial value = start offset - 1.
+    __ ldr(R0, compiler::Address(FP, kStringStartMinusOne));
+    if (num_saved_registers_ > 8) {
+      compiler::Label init_loop;
+      __ mov(R1, CSP);
+      __ AddImmediate(R2, R1, num_saved_registers_ * kWordSize);
+      __ Bind(&init_loop);
+      __ str(R0, compiler::Address(R1, kWordSize,
+                                   compiler::Address::PostIndex));
+      __ cmp(R1, compiler::Operand(R2));
+      __ b(&init_loop, UNSIGNED_LESS);
+    } else {  // Unroll the loop.
+      for (int i = 0; i < num_saved_registers_; i++) {
+        __ str(R0, register_location(i));
+      }
+    }
+  }
+
+  __ b(start_label_);
+
+  // Exit code:
+  if (success_label_->IsLinked()) {
+    // Save captures when successful.
+    __ Bind(success_label_);
+    if (num_saved_registers_ > 0) {
+      // Copy captures to the output array, converting the offsets from the end
+      // of the string to character indices.
+      __ ldr(R2, compiler::Address(FP, kMatchState));
+      __ ldr(R2, compiler::Address(R2, offsetof(MatchState, output)));
+      // R1 = byte length of the string.
+      __ ldr(R1, compiler::Address(FP, kStringStartMinusOne));
+      __ neg(R1, R1);
+      __ AddImmediate(R1, -char_size());
+      for (int i = 0; i < num_saved_registers_; i++) {
+        __ ldr(R0, register_location(i));
+        __ add(R0, R0, compiler::Operand(R1));  // Convert to index from start,
+                                                // not end.
+        if (mode() == UC16) {
+          __ AsrImmediate(R0, R0, 1);  // Convert byte index to character
+                                       // index.
+        }
+        __ str(R0, compiler::Address(R2, i * kInt32Size),
+               compiler::kFourBytes);
+      }
+    }
+    __ LoadImmediate(R0, SUCCESS);
+  }
+
+  __ Bind(exit_label_);
+  // Restore the callee saved registers and return R0.
+  __ ldp(R19, R20,
+         compiler::Address(FP, -2 * kWordSize,
+                           compiler::Address::PairOffset));
+  __ ldp(R21, R22,
+         compiler::Address(FP, -4 * kWordSize,
+                           compiler::Address::PairOffset));
+  __ ldp(R23, R24,
+         compiler::Address(FP, -6 * kWordSize,
+                           compiler::Address::PairOffset));
+  __ mov(CSP, FP);
+  RESTORES_LR_FROM_FRAME(
+      __ ldp(FP, LR,
+             compiler::Address(CSP, 2 * kWordSize,
+                               compiler::Address::PairPostIndex)));
+  __ ret();
+  // The out-of-line code below runs in the frame.
+  __ set_lr_state(compiler::LRState::OnEntry().EnterFrame());
+
+  // Backtrack code (branch target for conditional backtracks).
+  if (backtrack_label_->IsLinked()) {
+    __ Bind(backtrack_label_);
+    EmitBacktrack();
+  }
+
+  // Preempt-code.
+  if (check_preempt_label_->IsLinked()) {
+    // Reached from CheckPreemption. Dart: the interrupt is handled in C++,
+    // which may move the subject.
+    __ Bind(check_preempt_label_);
+    __ ldr(R0, compiler::Address(FP, kMatchState));
+    __ LoadImmediate(R1, reinterpret_cast<int64_t>(&HandleInterrupts));
+    __ CallCFunction(R1);
+    // If the interrupt produced an error, return EXCEPTION.
+    __ cbz(exit_with_exception_label_, R0);
+    // Otherwise continue with the (possibly moved) input.
+    __ mov(end_of_input_address(), R0);
+    __ br(return_address());
+  }
+
+  // Backtrack stack overflow code.
+  if (stack_overflow_label_->IsLinked()) {
+    // Reached from CheckStackLimit.
+    __ Bind(stack_overflow_label_);
+    __ ldr(R0, compiler::Address(FP, kMatchState));
+    __ mov(R1, backtrack_stackpointer());
+    __ LoadImmediate(R2, reinterpret_cast<int64_t>(&GrowBacktrackStack));
+    __ CallCFunction(R2);
+    // If the stack could not be grown, return EXCEPTION.
+    __ cbz(exit_with_exception_label_, R0);
+    // Otherwise use the new stack and its bounds.
+    __ mov(backtrack_stackpointer(), R0);
+    __ ldr(R0, compiler::Address(FP, kMatchState));
+    __ ldr(R1,
+           compiler::Address(R0, offsetof(MatchState, backtrack_stack_top)));
+    __ str(R1, compiler::Address(FP, kBacktrackStackTop));
+    __ ldr(R1,
+           compiler::Address(R0, offsetof(MatchState, backtrack_stack_limit)));
+    __ str(R1, compiler::Address(FP, kBacktrackStackLimit));
+    __ br(return_address());
+  }
+
+  if (exit_with_exception_label_->IsLinked()) {
+    __ Bind(exit_with_exception_label_);
+    __ LoadImmediate(R0, EXCEPTION);
+    __ b(exit_label_);
+  }
+
+  if (fallback_label_->IsLinked()) {
+    __ Bind(fallback_label_);
+    __ LoadImmediate(R0, FALLBACK_TO_EXPERIMENTAL);
+    __ b(exit_label_);
+  }
+
+  // Patch the code offsets pushed for labels that were not bound yet.
+  for (intptr_t i = 0; i < backtrack_fixups_.length(); i++) {
+    const BacktrackFixup& fixup = backtrack_fixups_[i];
+    const compiler::Label* target = labels_[fixup.label_index];
+    ASSERT(target->IsBound());
+    const uint32_t offset = static_cast<uint32_t>(target->Position());
+    int32_t* movz =
+        reinterpret_cast<int32_t*>(__ CodeAddress(fixup.position));
+    int32_t* movk = reinterpret_cast<int32_t*>(
+        __ CodeAddress(fixup.position + Instr::kInstrSize));
+    *movz = (*movz & ~kImm16Mask) | ((offset & 0xffff) << kImm16Shift);
+    *movk = (*movk & ~kImm16Mask) | ((offset >> 16) << kImm16Shift);
+  }
+
+  Thread* thread = Thread::Current();
+  const char* name =
+      OS::SCreate(zone(), "[RegExp] %s", source.ToCString());
+  SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+  return Code::FinalizeCodeAndNotify(name, nullptr, &masm_,
+                                     Code::PoolAttachment::kNotAttachPool,
+                                     /*optimized=*/false);
+}
+
+void RegExpMacroAssemblerARM64::GoTo(V8Label* to) {
+  BranchOrBacktrack(to);
+}
+
+void RegExpMacroAssemblerARM64::IfRegisterGE(int reg,
+                                             int comparand,
+                                             V8Label* if_ge) {
+  __ ldr(R0, register_location(reg));
+  __ CompareImmediate(R0, comparand);
+  BranchOrBacktrack(GREATER_EQUAL, if_ge);
+}
+
+void RegExpMacroAssemblerARM64::IfRegisterLT(int reg,
+                                             int comparand,
+                                             V8Label* if_lt) {
+  __ ldr(R0, register_location(reg));
+  __ CompareImmediate(R0, comparand);
+  BranchOrBacktrack(LESS, if_lt);
+}
+
+void RegExpMacroAssemblerARM64::IfRegisterEqPos(int reg, V8Label* if_eq) {
+  __ ldr(R0, register_location(reg));
+  __ cmp(current_input_offset(), compiler::Operand(R0));
+  BranchOrBacktrack(EQUAL, if_eq);
+}
+
+RegExpMacroAssembler::IrregexpImplementation
+RegExpMacroAssemblerARM64::Implementation() {
+  return kARM64Implementation;
+}
+
+void RegExpMacroAssemblerARM64::PopCurrentPosition() {
+  Pop(current_input_offset());
+}
+
+void RegExpMacroAssemblerARM64::PopRegister(int register_index) {
+  Pop(R0);
+  __ str(R0, register_location(register_index));
+}
+
+void RegExpMacroAssemblerARM64::PushBacktrack(V8Label* label) {
+  Push(label);
+  CheckStackLimit();
+}
+
+void RegExpMacroAssemblerARM64::PushCurrentPosition() {
+  Push(current_input_offset());
+  CheckStackLimit();
+}
+
+void RegExpMacroAssemblerARM64::PushRegister(int register_index,
+                                             StackCheckFlag check_stack_limit) {
+  __ ldr(R0, register_location(register_index));
+  Push(R0);
+  if (check_stack_limit == StackCheckFlag::kCheckStackLimit) {
+    CheckStackLimit();
+  }
+}
+
+void RegExpMacroAssemblerARM64::ReadCurrentPositionFromRegister(int reg) {
+  __ ldr(current_input_offset(), register_location(reg));
+}
+
+void RegExpMacroAssemblerARM64::ReadStackPointerFromRegister(int reg) {
+  __ ldr(backtrack_stackpointer(), register_location(reg));
+  __ ldr(R0, compiler::Address(FP, kBacktrackStackTop));
+  __ add(backtrack_stackpointer(), backtrack_stackpointer(),
+         compiler::Operand(R0));
+}
+
+void RegExpMacroAssemblerARM64::SetCurrentPositionFromEnd(int by) {
+  compiler::Label after_position;
+  __ CompareImmediate(current_input_offset(), -by * char_size());
+  __ b(&after_position, GREATER_EQUAL);
+  __ LoadImmediate(current_input_offset(), -by * char_size());
+  // On RegExp code entry (where this operation is used), the character before
+  // the current position is expected to be already loaded.
+  // We have advanced the position, so it's safe to read backwards.
+  LoadCurrentCharacterUnchecked(-1, 1);
+  __ Bind(&after_position);
+}
+
+void RegExpMacroAssemblerARM64::SetRegister(int register_index, int to) {
+  DCHECK(register_index >= num_saved_registers_);  // Reserved for positions!
+  __ LoadImmediate(R0, to);
+  __ str(R0, register_location(register_index));
+}
+
+bool RegExpMacroAssemblerARM64::Succeed() {
+  __ b(success_label_);
+  // Dart: Global regexps are restarted by the caller, like in the
+  // interpreter.
+  return false;
+}
+
+void RegExpMacroAssemblerARM64::WriteCurrentPositionToRegister(int reg,
+                                                               int cp_offset) {
+  if (cp_offset == 0) {
+    __ str(current_input_offset(), register_location(reg));
+  } else {
+    __ AddImmediate(R0, current_input_offset(), cp_offset * char_size());
+    __ str(R0, register_location(reg));
+  }
+}
+
+void RegExpMacroAssemblerARM64::ClearRegisters(int reg_from, int reg_to) {
+  DCHECK(reg_from <= reg_to);
+  __ ldr(R0, compiler::Address(FP, kStringStartMinusOne));
+  for (int reg = reg_from; reg <= reg_to; reg++) {
+    __ str(R0, register_location(reg));
+  }
+}
+
+void RegExpMacroAssemblerARM64::WriteStackPointerToRegister(int reg) {
+  __ ldr(R1, compiler::Address(FP, kBacktrackStackTop));
+  __ sub(R0, backtrack_stackpointer(), compiler::Operand(R1));
+  __ str(R0, register_location(reg));
+}
+
+void RegExpMacroAssemblerARM64::RecordComment(std::string_view comment) {
+  __ Comment("%.*s", static_cast<int>(comment.size()), comment.data());
+}
+
+// Private methods:
+
+compiler::Address RegExpMacroAssemblerARM64::register_location(
+    int register_index) {
+  DCHECK(register_index < (1 << 30));
+  if (num_registers_ <= register_index) {
+    num_registers_ = register_index + 1;
+  }
+  // Dart: GetCode discards the code of patterns with more registers, don't
+  // emit offsets that can't be encoded.
+  if (register_index >= kMaxRegisterCountForNativeCode) {
+    return compiler::Address(CSP, 0);
+  }
+  return compiler::Address(CSP, register_index * kWordSize);
+}
+
+void RegExpMacroAssemblerARM64::CheckPosition(int cp_offset,
+                                              V8Label* on_outside_input) {
+  if (cp_offset >= 0) {
+    __ CompareImmediate(current_input_offset(), -cp_offset * char_size());
+    BranchOrBacktrack(GREATER_EQUAL, on_outside_input);
+  } else {
+    __ AddImmediate(R0, current_input_offset(), cp_offset * char_size());
+    __ ldr(R1, compiler::Address(FP, kStringStartMinusOne));
+    __ cmp(R0, compiler::Operand(R1));
+    BranchOrBacktrack(LESS_EQUAL, on_outside_input);
+  }
+}
+
+void RegExpMacroAssemblerARM64::BranchOrBacktrack(Condition condition,
+                                                  V8Label* to) {
+  __ b(LabelFor(to), condition);
+}
+
+void RegExpMacroAssemblerARM64::BranchOrBacktrack(V8Label* to) {
+  __ b(LabelFor(to));
+}
+
+void RegExpMacroAssemblerARM64::CallOutOfLine(compiler::Label* label) {
+  __ adr(return_address(), compiler::Immediate(2 * Instr::kInstrSize));
+  __ b(label);
+}
+
+void RegExpMacroAssemblerARM64::Push(Register source) {
+  DCHECK(source != backtrack_stackpointer());
+  __ str(source,
+         compiler::Address(backtrack_stackpointer(), -kInt32Size,
+                           compiler::Address::PreIndex),
+         compiler::kFourBytes);
+}
+
+void RegExpMacroAssemblerARM64::Push(V8Label* label) {
+  compiler::Label* target = LabelFor(label);
+  if (target->IsBound()) {
+    __ LoadImmediate(R0, target->Position());
+  } else {
+    // The immediates are patched in GetCode.
+    backtrack_fixups_.Add({__ CodeSize(), label->pos()});
+    __ movz(R0, compiler::Immediate(0), 0);
+    __ movk(R0, compiler::Immediate(0), 1);
+  }
+  Push(R0);
+}
+
+void RegExpMacroAssemblerARM64::Pop(Register target) {
+  DCHECK(target != backtrack_stackpointer());
+  // Sign extends the 32 bit value.
+  __ ldr(target,
+         compiler::Address(backtrack_stackpointer(), kInt32Size,
+                           compiler::Address::PostIndex),
+         compiler::kFourBytes);
+}
+
+void RegExpMacroAssemblerARM64::Drop() {
+  __ AddImmediate(backtrack_stackpointer(), kInt32Size);
+}
+
+void RegExpMacroAssemblerARM64::CheckPreemption() {
+  // Check for preemption. Like in the interpreter, only interrupts are
+  // checked, the C++ stack doesn't grow while backtracking.
+  compiler::Label no_preempt;
+  __ ldr(R0, compiler::Address(FP, kThread));
+  __ ldr(R0, compiler::Address(R0, Thread::stack_limit_offset()));
+  __ TestImmediate(R0, Thread::kInterruptsMask);
+  __ b(&no_preempt, ZERO);
+  CallOutOfLine(check_preempt_label_);
+  __ Bind(&no_preempt);
+}
+
+void RegExpMacroAssemblerARM64::CheckStackLimit() {
+  compiler::Label no_stack_overflow;
+  __ ldr(R0, compiler::Address(FP, kBacktrackStackLimit));
+  __ cmp(backtrack_stackpointer(), compiler::Operand(R0));
+  __ b(&no_stack_overflow, UNSIGNED_GREATER);
+  CallOutOfLine(stack_overflow_label_);
+  __ Bind(&no_stack_overflow);
+}
+
+void RegExpMacroAssemblerARM64::LoadCurrentCharacterUnchecked(int cp_offset,
+                                                              int characters) {
+  Register offset = current_input_offset();
+  if (cp_offset != 0) {
+    __ AddImmediate(TMP, current_input_offset(), cp_offset * char_size());
+    offset = TMP;
+  }
+  const compiler::Address address(end_of_input_address(), offset);
+  if (mode() == LATIN1) {
+    if (characters == 4) {
+      __ ldr(current_character(), address, compiler::kUnsignedFourBytes);
+    } else if (characters == 2) {
+      __ ldr(current_character(), address, compiler::kUnsignedTwoBytes);
+    } else {
+      DCHECK_EQ(1, characters);
+      __ ldr(current_character(), address, compiler::kUnsignedByte);
+    }
+  } else {
+    DCHECK(mode() == UC16);
+    if (characters == 2) {
+      __ ldr(current_character(), address, compiler::kUnsignedFourBytes);
+    } else {
+      DCHECK_EQ(1, characters);
+      __ ldr(current_character(), address, compiler::kUnsignedTwoBytes);
+    }
+  }
+}
+
+#undef __
+
+}  // namespace dart
+
+#endif  // defined(DART_REGEXP_NATIVE_CODE) && defined(TARGET_ARCH_ARM64)
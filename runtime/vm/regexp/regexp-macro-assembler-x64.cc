@@ -0,0 +1,1061 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/regexp-macro-assembler-x64.h"
+
+#if defined(DART_REGEXP_NATIVE_CODE) && defined(TARGET_ARCH_X64)
+
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+/*
+ * This assembler uses the following register assignment convention
+ * - rbx : Pointer to the top of the backtrack stack. The stack grows
+ *         downwards and holds 32 bit values.
+ * - r12 : Current position in input, as negative offset from end of string.
+ *         Please notice that this is the byte offset, not the character
+ *         offset!
+ * - r13 : Start of the generated code. Backtrack targets are pushed as
+ *         offsets relative to it.
+ * - r14 : End of input (points to byte after last character in input).
+ * - r15 : Currently loaded character. Must be loaded using
+ *         LoadCurrentCharacter before using any of the dispatch methods.
+ * - rbp : Frame pointer. Used to access the match state, local variables and
+ *         RegExp registers.
+ * - rsp : Points to tip of C stack.
+ *
+ * All of the above registers are callee saved in both the System V and the
+ * Windows calling convention. rax, rcx, rdx and r8-r10 are used as scratch
+ * registers, r11 is the scratch register of the assembler. rsi and rdi are
+ * only used to pass arguments on System V.
+ *
+ * The stack will have the following structure:
+ *    - return address
+ *    - saved rbp                   <- rbp
+ *    - saved rbx
+ *    - saved r12
+ *    - saved r13
+ *    - saved r14
+ *    - saved r15
+ *    - MatchState*                 (kMatchState)
+ *    - Thread*                     (kThread)
+ *    - string start minus one      (kStringStartMinusOne)
+ *    - backtrack stack top         (kBacktrackStackTop)
+ *    - backtrack stack limit       (kBacktrackStackLimit)
+ *    - backtrack count             (kBacktrackCount)
+ *    - register 0                  (kRegisterZero)
+ *    - register 1
+ *    ...
+ *    - register num_registers-1    <- rsp (rounded to 16 bytes)
+ *
+ * The first num_saved_registers_ registers are initialized to point to
+ * "character -1" in the string (i.e., char_size() bytes before the first
+ * character of the string). The remaining registers start out uninitialized.
+ *
+ * The generated code is called as
+ *   int32_t matcher(NativeRegExpMacroAssembler::MatchState* state)
+ * and returns one of the NativeRegExpMacroAssembler::Result values.
+ */
+
+#define __ masm_.
+
+namespace {
+
+// The x64 assembler only accepts signed 32 bit immediates for 32 bit
+// operations.
+compiler::Immediate Imm32(uint32_t value) {
+  return compiler::Immediate(static_cast<int32_t>(value));
+}
+
+}  // namespace
+
+RegExpMacroAssemblerX64::RegExpMacroAssemblerX64(Isolate* isolate,
+                                                 Zone* zone,
+                                                 Mode mode,
+                                                 int registers_to_save)
+    : NativeRegExpMacroAssembler(isolate, zone, mode),
+      masm_(/*object_pool_builder=*/nullptr),
+      labels_(zone, 16),
+      backtrack_fixups_(zone, 16),
+      num_registers_(registers_to_save),
+      num_saved_registers_(registers_to_save),
+      entry_label_(new (zone) compiler::Label()),
+      start_label_(new (zone) compiler::Label()),
+      success_label_(new (zone) compiler::Label()),
+      backtrack_label_(new (zone) compiler::Label()),
+      exit_label_(new (zone) compiler::Label()),
+      check_preempt_label_(new (zone) compiler::Label()),
+      stack_overflow_label_(new (zone) compiler::Label()),
+      exit_with_exception_label_(new (zone) compiler::Label()),
+      fallback_label_(new (zone) compiler::Label()) {
+  DCHECK_EQ(0, registers_to_save % 2);
+  __ jmp(entry_label_);  // We'll write the entry code when we know more.
+  __ Bind(start_label_);  // And then continue from here.
+}
+
+RegExpMacroAssemblerX64::~RegExpMacroAssemblerX64() = default;
+
+int RegExpMacroAssemblerX64::FrameSize() const {
+  // Everything below the saved rbp, including the callee saved registers.
+  const int frame_size = -kRegisterZero + (num_registers_ - 1) * kWordSize;
+  return Utils::RoundUp(frame_size, 2 * kWordSize) - kSavedRegistersSize;
+}
+
+compiler::Label* RegExpMacroAssemblerX64::LabelFor(V8Label* label) {
+  if (label == nullptr) return backtrack_label_;
+  if (label->is_unused()) {
+    // The position of a V8Label is the index of its assembler label.
+    label->link_to(labels_.length());
+    labels_.Add(new (zone()) compiler::Label());
+  }
+  return labels_[label->pos()];
+}
+
+void RegExpMacroAssemblerX64::AdvanceCurrentPosition(int by) {
+  if (by != 0) {
+    __ addq(current_input_offset(), compiler::Immediate(by * char_size()));
+  }
+}
+
+void RegExpMacroAssemblerX64::AdvanceRegister(int reg, int by) {
+  DCHECK_LE(0, reg);
+  DCHECK_GT(num_registers_, reg);
+  if (by != 0) {
+    __ addq(register_location(reg), compiler::Immediate(by));
+  }
+}
+
+void RegExpMacroAssemblerX64::Backtrack() {
+  EmitBacktrack();
+}
+
+void RegExpMacroAssemblerX64::EmitBacktrack() {
+  CheckPreemption();
+  if (has_backtrack_limit()) {
+    compiler::Label next;
+    __ incq(compiler::Address(RBP, kBacktrackCount));
+    __ cmpq(compiler::Address(RBP, kBacktrackCount),
+            Imm32(backtrack_limit()));
+    __ j(NOT_EQUAL, &next, compiler::Assembler::kNearJump);
+
+    // Backtrack limit exceeded.
+    if (can_fallback()) {
+      __ jmp(fallback_label_);
+    } else {
+      // Can't fallback, so we treat it as a failed match.
+      Fail();
+    }
+
+    __ Bind(&next);
+  }
+  // Pop the code offset from the backtrack stack, add the code start and jump
+  // to the location.
+  Pop(RAX);
+  __ addq(RAX, code_object_pointer());
+  __ jmp(RAX);
+}
+
+void RegExpMacroAssemblerX64::Bind(V8Label* label) {
+  ASSERT(!label->is_bound());
+  compiler::Label* target = LabelFor(label);
+  const int index = label->pos();
+  __ Bind(target);
+  label->bind_to(index);
+}
+
+void RegExpMacroAssemblerX64::CheckCharacter(unsigned c, V8Label* on_equal) {
+  __ cmpl(current_character(), Imm32(c));
+  BranchOrBacktrack(EQUAL, on_equal);
+}
+
+void RegExpMacroAssemblerX64::CheckCharacterGT(uint16_t limit,
+                                               V8Label* on_greater) {
+  __ cmpl(current_character(), compiler::Immediate(limit));
+  BranchOrBacktrack(GREATER, on_greater);
+}
+
+void RegExpMacroAssemblerX64::CheckAtStart(int cp_offset,
+                                           V8Label* on_at_start) {
+  __ leaq(RAX, compiler::Address(current_input_offset(),
+                                 -char_size() + cp_offset * char_size()));
+  __ cmpq(RAX, compiler::Address(RBP, kStringStartMinusOne));
+  BranchOrBacktrack(EQUAL, on_at_start);
+}
+
+void RegExpMacroAssemblerX64::CheckNotAtStart(int cp_offset,
+                                              V8Label* on_not_at_start) {
+  __ leaq(RAX, compiler::Address(current_input_offset(),
+                                 -char_size() + cp_offset * char_size()));
+  __ cmpq(RAX, compiler::Address(RBP, kStringStartMinusOne));
+  BranchOrBacktrack(NOT_EQUAL, on_not_at_start);
+}
+
+void RegExpMacroAssemblerX64::CheckCharacterLT(uint16_t limit,
+                                               V8Label* on_less) {
+  __ cmpl(current_character(), compiler::Immediate(limit));
+  BranchOrBacktrack(LESS, on_less);
+}
+
+void RegExpMacroAssemblerX64::CheckFixedLengthLoop(
+    V8Label* on_tos_equals_current_position) {
+  compiler::Label fallthrough;
+  __ cmpl(current_input_offset(),
+          compiler::Address(backtrack_stackpointer(), 0));
+  __ j(NOT_EQUAL, &fallthrough, compiler::Assembler::kNearJump);
+  Drop();
+  BranchOrBacktrack(on_tos_equals_current_position);
+  __ Bind(&fallthrough);
+}
+
+void RegExpMacroAssemblerX64::CheckNotBackReferenceIgnoreCase(
+    int start_reg,
+    bool read_backward,
+    bool unicode,
+    V8Label* on_no_match) {
+  compiler::Label fallthrough;
+  __ movq(RDX, register_location(start_reg));      // Offset of start of capture
+  __ movq(R10, register_location(start_reg + 1));  // Offset of end of capture
+  // Dart: Like the interpreter, only compare captures that have been set and
+  // are not empty.
+  __ cmpq(RDX, compiler::Address(RBP, kStringStartMinusOne));
+  __ j(EQUAL, &fallthrough);
+  __ subq(R10, RDX);  // Length of capture.
+  __ j(LESS_EQUAL, &fallthrough);
+
+  // Check that there are sufficient characters left in the input.
+  if (read_backward) {
+    __ movq(RAX, compiler::Address(RBP, kStringStartMinusOne));
+    __ addq(RAX, R10);
+    __ cmpq(current_input_offset(), RAX);
+    BranchOrBacktrack(LESS_EQUAL, on_no_match);
+  } else {
+    __ movq(RAX, current_input_offset());
+    __ addq(RAX, R10);
+    BranchOrBacktrack(GREATER, on_no_match);
+  }
+
+  // R8 - Address of start of the match in the input.
+  // RDX - Address of start of the capture.
+  __ leaq(R8, compiler::Address(end_of_input_address(), current_input_offset(),
+                                TIMES_1, 0));
+  if (read_backward) {
+    __ subq(R8, R10);  // Offset by length when matching backwards.
+  }
+  __ addq(RDX, end_of_input_address());
+
+  if (mode() == LATIN1) {
+    compiler::Label loop;
+    compiler::Label loop_increment;
+    // R9 - Address of end of the capture.
+    __ leaq(R9, compiler::Address(RDX, R10, TIMES_1, 0));
+
+    __ Bind(&loop);
+    __ movzxb(RAX, compiler::Address(R8, 0));
+    __ movzxb(RCX, compiler::Address(RDX, 0));
+    // RAX - input character
+    // RCX - capture character
+    __ cmpl(RAX, RCX);
+    __ j(EQUAL, &loop_increment, compiler::Assembler::kNearJump);
+
+    // Mismatch, try case-insensitive match (converting letters to lower-case).
+    __ orl(RAX, compiler::Immediate(0x20));
+    __ orl(RCX, compiler::Immediate(0x20));
+    __ cmpl(RAX, RCX);
+    BranchOrBacktrack(NOT_EQUAL, on_no_match);
+    __ subl(RAX, compiler::Immediate('a'));
+    __ cmpl(RAX, compiler::Immediate('z' - 'a'));
+    __ j(BELOW_EQUAL, &loop_increment, compiler::Assembler::kNearJump);
+    // Latin-1: Check for values in range [224,254] but not 247.
+    __ subl(RAX, compiler::Immediate(224 - 'a'));
+    __ cmpl(RAX, compiler::Immediate(254 - 224));
+    BranchOrBacktrack(ABOVE, on_no_match);  // Weren't Latin-1 letters.
+    __ cmpl(RAX, compiler::Immediate(247 - 224));  // Check for 247.
+    BranchOrBacktrack(EQUAL, on_no_match);
+
+    __ Bind(&loop_increment);
+    // Increment pointers into match and capture strings.
+    __ addq(R8, compiler::Immediate(1));
+    __ addq(RDX, compiler::Immediate(1));
+    // Compare to end of capture, and loop if not done.
+    __ cmpq(RDX, R9);
+    __ j(BELOW, &loop);
+  } else {
+    DCHECK(mode() == UC16);
+    // Compare with the runtime function, which doesn't allocate:
+    //   int CaseInsensitiveCompare(Address byte_offset1,
+    //                              Address byte_offset2,
+    //                              size_t byte_length,
+    //                              Isolate* isolate);
+    // The moves are ordered such that no argument register is overwritten
+    // before it was read, in both calling conventions.
+    __ movq(CallingConventions::kArg1Reg, RDX);
+    __ movq(CallingConventions::kArg2Reg, R8);
+    __ movq(CallingConventions::kArg3Reg, R10);
+    __ movq(CallingConventions::kArg4Reg, compiler::Address(RBP, kMatchState));
+    __ movq(CallingConventions::kArg4Reg,
+            compiler::Address(CallingConventions::kArg4Reg,
+                              offsetof(MatchState, isolate)));
+    const auto compare = unicode ? &CaseInsensitiveCompareUnicode
+                                 : &CaseInsensitiveCompareNonUnicode;
+    __ movq(RAX, compiler::Immediate(reinterpret_cast<int64_t>(compare)));
+    __ CallCFunction(RAX, /*restore_rsp=*/true);
+    // Check if function returned non-zero for success or zero for failure.
+    __ testl(RAX, RAX);
+    BranchOrBacktrack(ZERO, on_no_match);
+  }
+
+  // On success, advance position by length of capture.
+  __ movq(RAX, register_location(start_reg + 1));
+  __ subq(RAX, register_location(start_reg));
+  if (read_backward) {
+    __ subq(current_input_offset(), RAX);
+  } else {
+    __ addq(current_input_offset(), RAX);
+  }
+
+  __ Bind(&fallthrough);
+}
+
+void RegExpMacroAssemblerX64::CheckNotBackReference(int start_reg,
+                                                    bool read_backward,
+                                                    V8Label* on_no_match) {
+  compiler::Label fallthrough;
+
+  // Find length of back-referenced capture.
+  __ movq(RDX, register_location(start_reg));
+  __ movq(R10, register_location(start_reg + 1));
+  // Dart: Like the interpreter, only compare captures that have been set and
+  // are not empty.
+  __ cmpq(RDX, compiler::Address(RBP, kStringStartMinusOne));
+  __ j(EQUAL, &fallthrough);
+  __ subq(R10, RDX);  // Length to check.
+  __ j(LESS_EQUAL, &fallthrough);
+
+  // Check that there are sufficient characters left in the input.
+  if (read_backward) {
+    __ movq(RAX, compiler::Address(RBP, kStringStartMinusOne));
+    __ addq(RAX, R10);
+    __ cmpq(current_input_offset(), RAX);
+    BranchOrBacktrack(LESS_EQUAL, on_no_match);
+  } else {
+    __ movq(RAX, current_input_offset());
+    __ addq(RAX, R10);
+    BranchOrBacktrack(GREATER, on_no_match);
+  }
+
+  // Compute pointers to match string and capture string.
+  __ leaq(R8, compiler::Address(end_of_input_address(), current_input_offset(),
+                                TIMES_1, 0));  // Start of match.
+  if (read_backward) {
+    __ subq(R8, R10);  // Offset by length when matching backwards.
+  }
+  __ addq(RDX, end_of_input_address());  // Start of capture.
+  __ leaq(R9, compiler::Address(RDX, R10, TIMES_1, 0));  // End of capture.
+
+  compiler::Label loop;
+  __ Bind(&loop);
+  if (mode() == LATIN1) {
+    __ movzxb(RAX, compiler::Address(RDX, 0));
+    __ movzxb(RCX, compiler::Address(R8, 0));
+  } else {
+    DCHECK(mode() == UC16);
+    __ movzxw(RAX, compiler::Address(RDX, 0));
+    __ movzxw(RCX, compiler::Address(R8, 0));
+  }
+  __ cmpl(RAX, RCX);
+  BranchOrBacktrack(NOT_EQUAL, on_no_match);
+  // Increment pointers into capture and match string.
+  __ addq(R8, compiler::Immediate(char_size()));
+  __ addq(RDX, compiler::Immediate(char_size()));
+  // Check if we have reached end of match area.
+  __ cmpq(RDX, R9);
+  __ j(BELOW, &loop);
+
+  // Success. Advance the current position by the length of the capture.
+  if (read_backward) {
+    __ subq(current_input_offset(), R10);
+  } else {
+    __ addq(current_input_offset(), R10);
+  }
+
+  __ Bind(&fallthrough);
+}
+
+void RegExpMacroAssemblerX64::CheckNotCharacter(unsigned c,
+                                                V8Label* on_not_equal) {
+  __ cmpl(current_character(), Imm32(c));
+  BranchOrBacktrack(NOT_EQUAL, on_not_equal);
+}
+
+void RegExpMacroAssemblerX64::CheckCharacterAfterAnd(unsigned c,
+                                                     unsigned mask,
+                                                     V8Label* on_equal) {
+  if (c == 0) {
+    __ testl(current_character(), Imm32(mask));
+  } else {
+    __ movl(RAX, Imm32(mask));
+    __ andl(RAX, current_character());
+    __ cmpl(RAX, Imm32(c));
+  }
+  BranchOrBacktrack(EQUAL, on_equal);
+}
+
+void RegExpMacroAssemblerX64::CheckNotCharacterAfterAnd(unsigned c,
+                                                        unsigned mask,
+                                                        V8Label* on_not_equal) {
+  if (c == 0) {
+    __ testl(current_character(), Imm32(mask));
+  } else {
+    __ movl(RAX, Imm32(mask));
+    __ andl(RAX, current_character());
+    __ cmpl(RAX, Imm32(c));
+  }
+  BranchOrBacktrack(NOT_EQUAL, on_not_equal);
+}
+
+void RegExpMacroAssemblerX64::CheckNotCharacterAfterMinusAnd(
+    uint16_t c,
+    uint16_t minus,
+    uint16_t mask,
+    V8Label* on_not_equal) {
+  DCHECK_GT(String::kMaxUtf16CodeUnit, minus);
+  __ leal(RAX, compiler::Address(current_character(), -minus));
+  __ andl(RAX, compiler::Immediate(mask));
+  __ cmpl(RAX, compiler::Immediate(c));
+  BranchOrBacktrack(NOT_EQUAL, on_not_equal);
+}
+
+void RegExpMacroAssemblerX64::CheckCharacterInRange(uint16_t from,
+                                                    uint16_t to,
+                                                    V8Label* on_in_range) {
+  __ leal(RAX, compiler::Address(current_character(), -from));
+  __ cmpl(RAX, compiler::Immediate(to - from));
+  BranchOrBacktrack(BELOW_EQUAL, on_in_range);
+}
+
+void RegExpMacroAssemblerX64::CheckCharacterNotInRange(
+    uint16_t from,
+    uint16_t to,
+    V8Label* on_not_in_range) {
+  __ leal(RAX, compiler::Address(current_character(), -from));
+  __ cmpl(RAX, compiler::Immediate(to - from));
+  BranchOrBacktrack(ABOVE, on_not_in_range);
+}
+
+void RegExpMacroAssemblerX64::CheckBitInTable(const TypedData& table,
+                                              V8Label* on_bit_set) {
+  // Dart: The table has kTableSize entries, which are folded into two 64 bit
+  // immediates so that the code doesn't refer to the heap.
+  static_assert(kTableSize == 2 * kBitsPerInt64);
+  uint64_t low = 0;
+  uint64_t high = 0;
+  for (intptr_t i = 0; i < kTableSize; i++) {
+    if (table.GetUint8(i) == 0) continue;
+    if (i < kBitsPerInt64) {
+      low |= uint64_t{1} << i;
+    } else {
+      high |= uint64_t{1} << (i - kBitsPerInt64);
+    }
+  }
+  __ movl(RCX, current_character());
+  __ andl(RCX, compiler::Immediate(kTableMask));
+  __ movq(RAX, compiler::Immediate(static_cast<int64_t>(low)));
+  if (high != low) {
+    __ movq(RDX, compiler::Immediate(static_cast<int64_t>(high)));
+    __ testl(RCX, compiler::Immediate(kBitsPerInt64));
+    __ cmovnzq(RAX, RDX);
+  }
+  // bt only uses the low six bits of the index.
+  __ btq(RAX, RCX);
+  BranchOrBacktrack(CARRY, on_bit_set);
+}
+
+void RegExpMacroAssemblerX64::SkipUntilBitInTable(int cp_offset,
+                                                  const TypedData& table,
+                                                  const TypedData& nibble_table,
+                                                  int advance_by,
+                                                  V8Label* on_match,
+                                                  V8Label* on_no_match) {
+  V8Label loop;
+  Bind(&loop);
+  LoadCurrentCharacter(cp_offset, on_no_match, true);
+  CheckBitInTable(table, on_match);
+  AdvanceCurrentPosition(advance_by);
+  GoTo(&loop);
+}
+
+void RegExpMacroAssemblerX64::CheckWordCharacter(Condition condition,
+                                                 V8Label* on_condition) {
+  __ movq(RAX,
+          compiler::Immediate(reinterpret_cast<int64_t>(word_character_map_)));
+  __ cmpb(compiler::Address(RAX, current_character(), TIMES_1, 0),
+          compiler::Immediate(0));
+  BranchOrBacktrack(condition, on_condition);
+}
+
+void RegExpMacroAssemblerX64::CheckSpecialClassRanges(StandardCharacterSet type,
+                                                      V8Label* on_no_match) {
+  // Range checks (c in min..max) are generally implemented by an unsigned
+  // (c - min) <= (max - min) check, using the sequence:
+  //   leal(rax, Operand(current_character(), -min)) or sub(rax, Immediate(min))
+  //   cmpl(rax, Immediate(max - min))
+  switch (type) {
+    case StandardCharacterSet::kWhitespace: {
+      // Match space-characters.
+      DCHECK(mode() == LATIN1);
+      // One byte space characters are '\t'..'\r', ' ' and  .
+      compiler::Label success;
+      __ cmpl(current_character(), compiler::Immediate(' '));
+      __ j(EQUAL, &success, compiler::Assembler::kNearJump);
+      // Check range 0x09..0x0D.
+      __ leal(RAX, compiler::Address(current_character(), -'\t'));
+      __ cmpl(RAX, compiler::Immediate('\r' - '\t'));
+      __ j(BELOW_EQUAL, &success, compiler::Assembler::kNearJump);
+      //   (NBSP).
+      __ cmpl(RAX, compiler::Immediate(0x00A0 - '\t'));
+      BranchOrBacktrack(NOT_EQUAL, on_no_match);
+      __ Bind(&success);
+      return;
+    }
+    case StandardCharacterSet::kNotWhitespace:
+      // The emitted code for generic character classes is good enough.
+      UNREACHABLE();
+    case StandardCharacterSet::kDigit:
+      // Match ASCII digits ('0'..'9').
+      __ leal(RAX, compiler::Address(current_character(), -'0'));
+      __ cmpl(RAX, compiler::Immediate('9' - '0'));
+      BranchOrBacktrack(ABOVE, on_no_match);
+      return;
+    case StandardCharacterSet::kNotDigit:
+      // Match non ASCII-digits.
+      __ leal(RAX, compiler::Address(current_character(), -'0'));
+      __ cmpl(RAX, compiler::Immediate('9' - '0'));
+      BranchOrBacktrack(BELOW_EQUAL, on_no_match);
+      return;
+    case StandardCharacterSet::kNotLineTerminator: {
+      // Match non-newlines (not 0x0A('\n'), 0x0D('\r'), 0x2028 and 0x2029).
+      __ movl(RAX, current_character());
+      __ xorl(RAX, compiler::Immediate(0x01));
+      // See if current character is '\n'^1 or '\r'^1, i.e., 0x0B or 0x0C.
+      __ subl(RAX, compiler::Immediate(0x0B));
+      __ cmpl(RAX, compiler::Immediate(0x0C - 0x0B));
+      BranchOrBacktrack(BELOW_EQUAL, on_no_match);
+      if (mode() == UC16) {
+        // Compare original value to 0x2028 and 0x2029, using the already
+        // computed (current_char ^ 0x01 - 0x0B). I.e., check for
+        // 0x201D (0x2028 - 0x0B) or 0x201E.
+        __ subl(RAX, compiler::Immediate(0x2028 - 0x0B));
+        __ cmpl(RAX, compiler::Immediate(0x2029 - 0x2028));
+        BranchOrBacktrack(BELOW_EQUAL, on_no_match);
+      }
+      return;
+    }
+    case StandardCharacterSet::kWord: {
+      if (mode() != LATIN1) {
+        __ cmpl(current_character(), compiler::Immediate('z'));
+        BranchOrBacktrack(ABOVE, on_no_match);
+      }
+      CheckWordCharacter(EQUAL, on_no_match);
+      return;
+    }
+    case StandardCharacterSet::kNotWord: {
+      compiler::Label done;
+      if (mode() != LATIN1) {
+        __ cmpl(current_character(), compiler::Immediate('z'));
+        __ j(ABOVE, &done);
+      }
+      CheckWordCharacter(NOT_EQUAL, on_no_match);
+      __ Bind(&done);
+      return;
+    }
+    case StandardCharacterSet::kLineTerminator: {
+      // Match newlines (0x0A('\n'), 0x0D('\r'), 0x2028 or 0x2029).
+      // The opposite of '.'.
+      __ movl(RAX, current_character());
+      __ xorl(RAX, compiler::Immediate(0x01));
+      // See if current character is '\n'^1 or '\r'^1, i.e., 0x0B or 0x0C.
+      __ subl(RAX, compiler::Immediate(0x0B));
+      __ cmpl(RAX, compiler::Immediate(0x0C - 0x0B));
+      if (mode() == LATIN1) {
+        BranchOrBacktrack(ABOVE, on_no_match);
+      } else {
+        compiler::Label done;
+        __ j(BELOW_EQUAL, &done, compiler::Assembler::kNearJump);
+        DCHECK(mode() == UC16);
+        // Compare original value to 0x2028 and 0x2029, using the already
+        // computed (current_char ^ 0x01 - 0x0B). I.e., check for
+        // 0x201D (0x2028 - 0x0B) or 0x201E.
+        __ subl(RAX, compiler::Immediate(0x2028 - 0x0B));
+        __ cmpl(RAX, compiler::Immediate(0x2029 - 0x2028));
+        BranchOrBacktrack(ABOVE, on_no_match);
+        __ Bind(&done);
+      }
+      return;
+    }
+    case StandardCharacterSet::kEverything:
+      // Match all characters.
+      return;
+  }
+}
+
+void RegExpMacroAssemblerX64::Fail() {
+  static_assert(FAILURE == 0);  // Return value for failure is zero.
+  __ xorl(RAX, RAX);
+  __ jmp(exit_label_);
+}
+
+ObjectPtr RegExpMacroAssemblerX64::GetCode(const String& source,
+                                           RegExpFlags flags) {
+  // Dart: The registers live in the frame on the C++ stack, keep patterns
+  // using a lot of them in the interpreter.
+  if (num_registers_ > kMaxRegisterCountForNativeCode) {
+    return Code::null();
+  }
+
+  // Finalize code - write the entry point code now we know how many
+  // registers we need.
+  __ Bind(entry_label_);
+
+  // Actually emit code to start a new stack frame.
+  __ pushq(RBP);
+  __ movq(RBP, RSP);
+  // Save callee-save registers.
+  __ pushq(RBX);
+  __ pushq(R12);
+  __ pushq(R13);
+  __ pushq(R14);
+  __ pushq(R15);
+  __ subq(RSP, compiler::Immediate(FrameSize()));
+
+  // Load the start of the code, which backtrack targets are relative to.
+  {
+    const intptr_t kRIPRelativeLeaqSize = 7;
+    const intptr_t rip_offset = __ CodeSize() + kRIPRelativeLeaqSize;
+    __ leaq(code_object_pointer(),
+            compiler::Address::AddressRIPRelative(-rip_offset));
+    ASSERT(__ CodeSize() == rip_offset);
+  }
+
+  // Copy the match state into the frame and registers.
+  __ movq(RAX, CallingConventions::kArg1Reg);
+  __ movq(compiler::Address(RBP, kMatchState), RAX);
+  __ movq(RCX, compiler::Address(RAX, offsetof(MatchState, thread)));
+  __ movq(compiler::Address(RBP, kThread), RCX);
+  __ movq(backtrack_stackpointer(),
+          compiler::Address(RAX, offsetof(MatchState, backtrack_stack_top)));
+  __ movq(compiler::Address(RBP, kBacktrackStackTop), backtrack_stackpointer());
+  __ movq(RCX,
+          compiler::Address(RAX, offsetof(MatchState, backtrack_stack_limit)));
+  __ movq(compiler::Address(RBP, kBacktrackStackLimit), RCX);
+  __ movq(compiler::Address(RBP, kBacktrackCount), compiler::Immediate(0));
+  __ movq(end_of_input_address(),
+          compiler::Address(RAX, offsetof(MatchState, input_end)));
+  __ movq(current_input_offset(),
+          compiler::Address(RAX, offsetof(MatchState, input_start)));
+  __ subq(current_input_offset(), end_of_input_address());
+  // Set RCX to the address of char before start of the string
+  // (effectively string position -1) and store it in a local variable, for
+  // use when clearing position registers.
+  __ leaq(RCX, compiler::Address(current_input_offset(), -char_size()));
+  __ movq(compiler::Address(RBP, kStringStartMinusOne), RCX);
+  // Move the current position to the start index.
+  __ movq(RCX, compiler::Address(RAX, offsetof(MatchState, start_index)));
+  __ leaq(current_input_offset(),
+          compiler::Address(current_input_offset(), RCX,
+                            mode() == LATIN1 ? TIMES_1 : TIMES_2, 0));
+
+  {
+    compiler::Label load_char_start_regexp;
+    compiler::Label start_regexp;
+    // Load newline if index is at start, previous character otherwise.
+    __ cmpq(RCX, compiler::Immediate(0));
+    __ j(NOT_EQUAL, &load_char_start_regexp, compiler::Assembler::kNearJump);
+    __ movl(current_character(), compiler::Immediate('\n'));
+    __ jmp(&start_regexp, compiler::Assembler::kNearJump);
+    __ Bind(&load_char_start_regexp);
+    // Load previous char as initial value of current character register.
+    LoadCurrentCharacterUnchecked(-1, 1);
+    __ Bind(&start_regexp);
+  }
+
+  // Initialize on-stack registers.
+  if (num_saved_registers_ > 0) {
+    // Fill saved registers with initial value = start offset - 1.
+    __ movq(RAX, compiler::Address(RBP, kStringStartMinusOne));
+    if (num_saved_registers_ > 8) {
+      compiler::Label init_loop;
+      __ movq(RCX, compiler::Immediate(kRegisterZero));
+      __ Bind(&init_loop);
+      __ movq(compiler::Address(RBP, RCX, TIMES_1, 0), RAX);
+      __ subq(RCX, compiler::Immediate(kWordSize));
+      __ cmpq(RCX, compiler::Immediate(kRegisterZero -
+                                       num_saved_registers_ * kWordSize));
+      __ j(GREATER, &init_loop, compiler::Assembler::kNearJump);
+    } else {  // Unroll the loop.
+      for (int i = 0; i < num_saved_registers_; i++) {
+        __ movq(register_location(i), RAX);
+      }
+    }
+  }
+
+  __ jmp(start_label_);
+
+  // Exit code:
+  if (success_label_->IsLinked()) {
+    // Save captures when successful.
+    __ Bind(success_label_);
+    if (num_saved_registers_ > 0) {
+      // Copy captures to the output array, converting the offsets from the end
+      // of the string to character indices.
+      __ movq(RDX, compiler::Address(RBP, kMatchState));
+      __ movq(RDX, compiler::Address(RDX, offsetof(MatchState, output)));
+      // RCX = byte length of the string.
+      __ movq(RCX, compiler::Address(RBP, kStringStartMinusOne));
+      __ negq(RCX);
+      __ subq(RCX, compiler::Immediate(char_size()));
+      for (int i = 0; i < num_saved_registers_; i++) {
+        __ movq(RAX, register_location(i));
+        __ addq(RAX, RCX);  // Convert to index from start, not end.
+        if (mode() == UC16) {
+          __ sarq(RAX, compiler::Immediate(1));  // Convert byte index to
+                                                 // character index.
+        }
+        __ movl(compiler::Address(RDX, i * kInt32Size), RAX);
+      }
+    }
+    __ movl(RAX, compiler::Immediate(SUCCESS));
+  }
+
+  __ Bind(exit_label_);
+  // Restore the callee saved registers and return RAX.
+  __ leaq(RSP, compiler::Address(RBP, -kSavedRegistersSize));
+  __ popq(R15);
+  __ popq(R14);
+  __ popq(R13);
+  __ popq(R12);
+  __ popq(RBX);
+  __ popq(RBP);
+  __ ret();
+
+  // Backtrack code (branch target for conditional backtracks).
+  if (backtrack_label_->IsLinked()) {
+    __ Bind(backtrack_label_);
+    EmitBacktrack();
+  }
+
+  // Preempt-code.
+  if (check_preempt_label_->IsLinked()) {
+    // Reached with a call from CheckPreemption. Dart: the interrupt is
+    // handled in C++, which may move the subject.
+    __ Bind(check_preempt_label_);
+    __ subq(RSP, compiler::Immediate(kWordSize));
+    __ movq(CallingConventions::kArg1Reg, compiler::Address(RBP, kMatchState));
+    __ movq(RAX, compiler::Immediate(
+                     reinterpret_cast<int64_t>(&HandleInterrupts)));
+    __ CallCFunction(RAX, /*restore_rsp=*/true);
+    __ addq(RSP, compiler::Immediate(kWordSize));
+    // If the interrupt produced an error, return EXCEPTION.
+    __ testq(RAX, RAX);
+    __ j(ZERO, exit_with_exception_label_);
+    // Otherwise continue with the (possibly moved) input.
+    __ movq(end_of_input_address(), RAX);
+    __ ret();
+  }
+
+  // Backtrack stack overflow code.
+  if (stack_overflow_label_->IsLinked()) {
+    // Reached with a call from CheckStackLimit. Realign the C stack, which
+    // holds the return address.
+    __ Bind(stack_overflow_label_);
+    __ subq(RSP, compiler::Immediate(kWordSize));
+    __ movq(CallingConventions::kArg1Reg, compiler::Address(RBP, kMatchState));
+    __ movq(CallingConventions::kArg2Reg, backtrack_stackpointer());
+    __ movq(RAX, compiler::Immediate(
+                     reinterpret_cast<int64_t>(&GrowBacktrackStack)));
+    __ CallCFunction(RAX, /*restore_rsp=*/true);
+    __ addq(RSP, compiler::Immediate(kWordSize));
+    // If the stack could not be grown, return EXCEPTION.
+    __ testq(RAX, RAX);
+    __ j(ZERO, exit_with_exception_label_);
+    // Otherwise use the new stack and its bounds.
+    __ movq(backtrack_stackpointer(), RAX);
+    __ movq(RAX, compiler::Address(RBP, kMatchState));
+    __ movq(RCX,
+            compiler::Address(RAX, offsetof(MatchState, backtrack_stack_top)));
+    __ movq(compiler::Address(RBP, kBacktrackStackTop), RCX);
+    __ movq(RCX, compiler::Address(RAX,
+                                   offsetof(MatchState, backtrack_stack_limit)));
+    __ movq(compiler::Address(RBP, kBacktrackStackLimit), RCX);
+    __ ret();
+  }
+
+  if (exit_with_exception_label_->IsLinked()) {
+    __ Bind(exit_with_exception_label_);
+    __ movl(RAX, compiler::Immediate(EXCEPTION));
+    __ jmp(exit_label_);
+  }
+
+  if (fallback_label_->IsLinked()) {
+    __ Bind(fallback_label_);
+    __ movl(RAX, compiler::Immediate(FALLBACK_TO_EXPERIMENTAL));
+    __ jmp(exit_label_);
+  }
+
+  // Patch the code offsets pushed for labels that were not bound yet.
+  for (intptr_t i = 0; i < backtrack_fixups_.length(); i++) {
+    const BacktrackFixup& fixup = backtrack_fixups_[i];
+    const compiler::Label* target = labels_[fixup.label_index];
+    ASSERT(target->IsBound());
+    *reinterpret_cast<int32_t*>(__ CodeAddress(fixup.position)) =
+        static_cast<int32_t>(target->Position());
+  }
+
+  Thread* thread = Thread::Current();
+  const char* name =
+      OS::SCreate(zone(), "[RegExp] %s", source.ToCString());
+  SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+  return Code::FinalizeCodeAndNotify(name, nullptr, &masm_,
+                                     Code::PoolAttachment::kNotAttachPool,
+                                     /*optimized=*/false);
+}
+
+void RegExpMacroAssemblerX64::GoTo(V8Label* to) {
+  BranchOrBacktrack(to);
+}
+
+void RegExpMacroAssemblerX64::IfRegisterGE(int reg,
+                                           int comparand,
+                                           V8Label* if_ge) {
+  __ cmpq(register_location(reg), compiler::Immediate(comparand));
+  BranchOrBacktrack(GREATER_EQUAL, if_ge);
+}
+
+void RegExpMacroAssemblerX64::IfRegisterLT(int reg,
+                                           int comparand,
+                                           V8Label* if_lt) {
+  __ cmpq(register_location(reg), compiler::Immediate(comparand));
+  BranchOrBacktrack(LESS, if_lt);
+}
+
+void RegExpMacroAssemblerX64::IfRegisterEqPos(int reg, V8Label* if_eq) {
+  __ cmpq(current_input_offset(), register_location(reg));
+  BranchOrBacktrack(EQUAL, if_eq);
+}
+
+RegExpMacroAssembler::IrregexpImplementation
+RegExpMacroAssemblerX64::Implementation() {
+  return kX64Implementation;
+}
+
+void RegExpMacroAssemblerX64::PopCurrentPosition() {
+  Pop(current_input_offset());
+}
+
+void RegExpMacroAssemblerX64::PopRegister(int register_index) {
+  Pop(RAX);
+  __ movq(register_location(register_index), RAX);
+}
+
+void RegExpMacroAssemblerX64::PushBacktrack(V8Label* label) {
+  Push(label);
+  CheckStackLimit();
+}
+
+void RegExpMacroAssemblerX64::PushCurrentPosition() {
+  Push(current_input_offset());
+  CheckStackLimit();
+}
+
+void RegExpMacroAssemblerX64::PushRegister(int register_index,
+                                           StackCheckFlag check_stack_limit) {
+  __ movq(RAX, register_location(register_index));
+  Push(RAX);
+  if (check_stack_limit == StackCheckFlag::kCheckStackLimit) {
+    CheckStackLimit();
+  }
+}
+
+void RegExpMacroAssemblerX64::ReadCurrentPositionFromRegister(int reg) {
+  __ movq(current_input_offset(), register_location(reg));
+}
+
+void RegExpMacroAssemblerX64::ReadStackPointerFromRegister(int reg) {
+  __ movq(backtrack_stackpointer(), register_location(reg));
+  __ addq(backtrack_stackpointer(),
+          compiler::Address(RBP, kBacktrackStackTop));
+}
+
+void RegExpMacroAssemblerX64::SetCurrentPositionFromEnd(int by) {
+  compiler::Label after_position;
+  __ cmpq(current_input_offset(), compiler::Immediate(-by * char_size()));
+  __ j(GREATER_EQUAL, &after_position, compiler::Assembler::kNearJump);
+  __ movq(current_input_offset(), compiler::Immediate(-by * char_size()));
+  // On RegExp code entry (where this operation is used), the character before
+  // the current position is expected to be already loaded.
+  // We have advanced the position, so it's safe to read backwards.
+  LoadCurrentCharacterUnchecked(-1, 1);
+  __ Bind(&after_position);
+}
+
+void RegExpMacroAssemblerX64::SetRegister(int register_index, int to) {
+  DCHECK(register_index >= num_saved_registers_);  // Reserved for positions!
+  __ movq(register_location(register_index), compiler::Immediate(to));
+}
+
+bool RegExpMacroAssemblerX64::Succeed() {
+  __ jmp(success_label_);
+  // Dart: Global regexps are restarted by the caller, like in the
+  // interpreter.
+  return false;
+}
+
+void RegExpMacroAssemblerX64::WriteCurrentPositionToRegister(int reg,
+                                                             int cp_offset) {
+  if (cp_offset == 0) {
+    __ movq(register_location(reg), current_input_offset());
+  } else {
+    __ leaq(RAX, compiler::Address(current_input_offset(),
+                                   cp_offset * char_size()));
+    __ movq(register_location(reg), RAX);
+  }
+}
+
+void RegExpMacroAssemblerX64::ClearRegisters(int reg_from, int reg_to) {
+  DCHECK(reg_from <= reg_to);
+  __ movq(RAX, compiler::Address(RBP, kStringStartMinusOne));
+  for (int reg = reg_from; reg <= reg_to; reg++) {
+    __ movq(register_location(reg), RAX);
+  }
+}
+
+void RegExpMacroAssemblerX64::WriteStackPointerToRegister(int reg) {
+  __ movq(RAX, backtrack_stackpointer());
+  __ subq(RAX, compiler::Address(RBP, kBacktrackStackTop));
+  __ movq(register_location(reg), RAX);
+}
+
+void RegExpMacroAssemblerX64::RecordComment(std::string_view comment) {
+  __ Comment("%.*s", static_cast<int>(comment.size()), comment.data());
+}
+
+// Private methods:
+
+compiler::Address RegExpMacroAssemblerX64::register_location(
+    int register_index) {
+  DCHECK(register_index < (1 << 30));
+  if (num_registers_ <= register_index) {
+    num_registers_ = register_index + 1;
+  }
+  return compiler::Address(RBP, kRegisterZero - register_index * kWordSize);
+}
+
+void RegExpMacroAssemblerX64::CheckPosition(int cp_offset,
+                                            V8Label* on_outside_input) {
+  if (cp_offset >= 0) {
+    __ cmpq(current_input_offset(),
+            compiler::Immediate(-cp_offset * char_size()));
+    BranchOrBacktrack(GREATER_EQUAL, on_outside_input);
+  } else {
+    __ leaq(RAX, compiler::Address(current_input_offset(),
+                                   cp_offset * char_size()));
+    __ cmpq(RAX, compiler::Address(RBP, kStringStartMinusOne));
+    BranchOrBacktrack(LESS_EQUAL, on_outside_input);
+  }
+}
+
+void RegExpMacroAssemblerX64::BranchOrBacktrack(Condition condition,
+                                                V8Label* to) {
+  __ j(condition, LabelFor(to));
+}
+
+void RegExpMacroAssemblerX64::BranchOrBacktrack(V8Label* to) {
+  __ jmp(LabelFor(to));
+}
+
+void RegExpMacroAssemblerX64::Push(Register source) {
+  DCHECK(source != backtrack_stackpointer());
+  // Notice: This updates flags, unlike normal Push.
+  __ subq(backtrack_stackpointer(), compiler::Immediate(kInt32Size));
+  __ movl(compiler::Address(backtrack_stackpointer(), 0), source);
+}
+
+void RegExpMacroAssemblerX64::Push(V8Label* label) {
+  compiler::Label* target = LabelFor(label);
+  if (target->IsBound()) {
+    __ movl(RAX, compiler::Immediate(target->Position()));
+  } else {
+    // The immediate is the last four bytes of the instruction, and is
+    // patched in GetCode.
+    __ movl(RAX, compiler::Immediate(0));
+    backtrack_fixups_.Add({__ CodeSize() - kInt32Size, label->pos()});
+  }
+  Push(RAX);
+}
+
+void RegExpMacroAssemblerX64::Pop(Register target) {
+  DCHECK(target != backtrack_stackpointer());
+  __ movsxd(target, compiler::Address(backtrack_stackpointer(), 0));
+  // Notice: This updates flags, unlike normal Pop.
+  __ addq(backtrack_stackpointer(), compiler::Immediate(kInt32Size));
+}
+
+void RegExpMacroAssemblerX64::Drop() {
+  __ addq(backtrack_stackpointer(), compiler::Immediate(kInt32Size));
+}
+
+void RegExpMacroAssemblerX64::CheckPreemption() {
+  // Check for preemption. Like in the interpreter, only interrupts are
+  // checked, the C++ stack doesn't grow while backtracking.
+  __ movq(RAX, compiler::Address(RBP, kThread));
+  compiler::Label no_preempt;
+  __ testb(compiler::Address(RAX, Thread::stack_limit_offset()),
+           compiler::Immediate(Thread::kInterruptsMask));
+  __ j(ZERO, &no_preempt, compiler::Assembler::kNearJump);
+  __ call(check_preempt_label_);
+  __ Bind(&no_preempt);
+}
+
+void RegExpMacroAssemblerX64::CheckStackLimit() {
+  compiler::Label no_stack_overflow;
+  __ cmpq(backtrack_stackpointer(),
+          compiler::Address(RBP, kBacktrackStackLimit));
+  __ j(ABOVE, &no_stack_overflow, compiler::Assembler::kNearJump);
+  __ call(stack_overflow_label_);
+  __ Bind(&no_stack_overflow);
+}
+
+void RegExpMacroAssemblerX64::LoadCurrentCharacterUnchecked(int cp_offset,
+                                                            int characters) {
+  const compiler::Address address(end_of_input_address(),
+                                  current_input_offset(), TIMES_1,
+                                  cp_offset * char_size());
+  if (mode() == LATIN1) {
+    if (characters == 4) {
+      __ movl(current_character(), address);
+    } else if (characters == 2) {
+      __ movzxw(current_character(), address);
+    } else {
+      DCHECK_EQ(1, characters);
+      __ movzxb(current_character(), address);
+    }
+  } else {
+    DCHECK(mode() == UC16);
+    if (characters == 2) {
+      __ movl(current_character(), address);
+    } else {
+      DCHECK_EQ(1, characters);
+      __ movzxw(current_character(), address);
+    }
+  }
+}
+
+#undef __
+
+}  // namespace dart
+
+#endif  // defined(DART_REGEXP_NATIVE_CODE) && defined(TARGET_ARCH_X64)
@@ -0,0 +1,224 @@
+// Copyright 2012 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_X64_REGEXP_MACRO_ASSEMBLER_X64_H_
+#define V8_REGEXP_X64_REGEXP_MACRO_ASSEMBLER_X64_H_
+
+#include "vm/regexp/regexp-macro-assembler.h"
+
+#if defined(DART_REGEXP_NATIVE_CODE) && defined(TARGET_ARCH_X64)
+
+#include "vm/compiler/assembler/assembler.h"
+#include "vm/growable_array.h"
+
+namespace dart {
+
+// Dart: Generates x64 machine code with the VM's assembler. The generated code
+// is called by NativeRegExpMacroAssembler::Match with a pointer to a
+// MatchState as its only argument.
+class RegExpMacroAssemblerX64 : public NativeRegExpMacroAssembler {
+ public:
+  RegExpMacroAssemblerX64(Isolate* isolate,
+                          Zone* zone,
+                          Mode mode,
+                          int registers_to_save);
+  ~RegExpMacroAssemblerX64() override;
+  void AdvanceCurrentPosition(int by) override;
+  void AdvanceRegister(int reg, int by) override;
+  void Backtrack() override;
+  void Bind(V8Label* label) override;
+  void CheckAtStart(int cp_offset, V8Label* on_at_start) override;
+  void CheckCharacter(unsigned c, V8Label* on_equal) override;
+  void CheckCharacterAfterAnd(unsigned c,
+                              unsigned mask,
+                              V8Label* on_equal) override;
+  void CheckCharacterGT(uint16_t limit, V8Label* on_greater) override;
+  void CheckCharacterLT(uint16_t limit, V8Label* on_less) override;
+  // A "fixed length loop" is a loop that is both greedy and with a simple
+  // body. It has a particularly simple implementation.
+  void CheckFixedLengthLoop(V8Label* on_tos_equals_current_position) override;
+  void CheckNotAtStart(int cp_offset, V8Label* on_not_at_start) override;
+  void CheckNotBackReference(int start_reg,
+                             bool read_backward,
+                             V8Label* on_no_match) override;
+  void CheckNotBackReferenceIgnoreCase(int start_reg,
+                                       bool read_backward,
+                                       bool unicode,
+                                       V8Label* on_no_match) override;
+  void CheckNotCharacter(unsigned c, V8Label* on_not_equal) override;
+  void CheckNotCharacterAfterAnd(unsigned c,
+                                 unsigned mask,
+                                 V8Label* on_not_equal) override;
+  void CheckNotCharacterAfterMinusAnd(uint16_t c,
+                                      uint16_t minus,
+                                      uint16_t mask,
+                                      V8Label* on_not_equal) override;
+  void CheckCharacterInRange(uint16_t from,
+                             uint16_t to,
+                             V8Label* on_in_range) override;
+  void CheckCharacterNotInRange(uint16_t from,
+                                uint16_t to,
+                                V8Label* on_not_in_range) override;
+  // Dart: The range arrays would have to be kept alive by the generated code,
+  // which has no object pool. The compiler falls back to inline comparisons.
+  bool CheckCharacterInRangeArray(const ZoneList<CharacterRange>* ranges,
+                                  V8Label* on_in_range) override {
+    return false;
+  }
+  bool CheckCharacterNotInRangeArray(const ZoneList<CharacterRange>* ranges,
+                                     V8Label* on_not_in_range) override {
+    return false;
+  }
+  void CheckBitInTable(const TypedData& table, V8Label* on_bit_set) override;
+  void SkipUntilBitInTable(int cp_offset,
+                           const TypedData& table,
+                           const TypedData& nibble_table,
+                           int advance_by,
+                           V8Label* on_match,
+                           V8Label* on_no_match) override;
+
+  // Checks whether the given offset from the current position is before
+  // the end of the string.
+  void CheckPosition(int cp_offset, V8Label* on_outside_input) override;
+  void CheckSpecialClassRanges(StandardCharacterSet type,
+                               V8Label* on_no_match) override;
+
+  void Fail() override;
+  ObjectPtr GetCode(const String& source, RegExpFlags flags) override;
+  void GoTo(V8Label* label) override;
+  void IfRegisterGE(int reg, int comparand, V8Label* if_ge) override;
+  void IfRegisterLT(int reg, int comparand, V8Label* if_lt) override;
+  void IfRegisterEqPos(int reg, V8Label* if_eq) override;
+  IrregexpImplementation Implementation() override;
+  void LoadCurrentCharacterUnchecked(int cp_offset,
+                                     int character_count) override;
+  void PopCurrentPosition() override;
+  void PopRegister(int register_index) override;
+  void PushBacktrack(V8Label* label) override;
+  void PushCurrentPosition() override;
+  void PushRegister(int register_index,
+                    StackCheckFlag check_stack_limit) override;
+  void ReadCurrentPositionFromRegister(int reg) override;
+  void ReadStackPointerFromRegister(int reg) override;
+  void SetCurrentPositionFromEnd(int by) override;
+  void SetRegister(int register_index, int to) override;
+  bool Succeed() override;
+  void WriteCurrentPositionToRegister(int reg, int cp_offset) override;
+  void ClearRegisters(int reg_from, int reg_to) override;
+  void WriteStackPointerToRegister(int reg) override;
+  void RecordComment(std::string_view comment) override;
+
+ private:
+  // Offsets from rbp of the callee saved registers, the locals and the
+  // registers of the regexp. The stack pointer is kept 16 byte aligned.
+  static constexpr int kSavedRegistersSize = 5 * kWordSize;
+  static constexpr int kMatchState = -kSavedRegistersSize - kWordSize;
+  static constexpr int kThread = kMatchState - kWordSize;
+  static constexpr int kStringStartMinusOne = kThread - kWordSize;
+  static constexpr int kBacktrackStackTop = kStringStartMinusOne - kWordSize;
+  static constexpr int kBacktrackStackLimit = kBacktrackStackTop - kWordSize;
+  static constexpr int kBacktrackCount = kBacktrackStackLimit - kWordSize;
+  // First register address. Following registers are below it on the stack.
+  static constexpr int kRegisterZero = kBacktrackCount - kWordSize;
+
+  // Dart: The frame holding the registers lives on the C++ stack of the
+  // mutator, so patterns with more registers stay in the interpreter.
+  static constexpr int kMaxRegisterCountForNativeCode = 1 * KB;
+
+  // Byte size of the frame below the saved registers.
+  int FrameSize() const;
+
+  // The rbp-relative location of a regexp register.
+  compiler::Address register_location(int register_index);
+
+  // Returns the label of the assembler bound to `label`, allocating it on
+  // first use. A nullptr label means backtracking.
+  compiler::Label* LabelFor(V8Label* label);
+
+  // Equivalent to a conditional branch to the label, unless the label
+  // is nullptr, in which case it is a conditional Backtrack.
+  void BranchOrBacktrack(Condition condition, V8Label* to);
+  void BranchOrBacktrack(V8Label* to);
+
+  // Check whether preemption has been requested.
+  void CheckPreemption();
+
+  // Check whether we are exceeding the stack limit on the backtrack stack.
+  void CheckStackLimit();
+
+  // Pushes the low 32 bits of a register on the backtrack stack. Decrements
+  // the stack pointer by four bytes and stores the register's value there.
+  void Push(Register source);
+
+  // Pushes the code offset of the label on the backtrack stack. The offset
+  // is patched in GetCode once the label is bound.
+  void Push(V8Label* label);
+
+  // Pops a value from the backtrack stack. Sign extends the 32 bits at the
+  // stack pointer into the register and increments the pointer by four bytes.
+  void Pop(Register target);
+
+  // Drops the top value from the backtrack stack without reading it.
+  // Increments the stack pointer by four bytes.
+  void Drop();
+
+  // Loads the current character through the word character map and branches
+  // on the result.
+  void CheckWordCharacter(Condition condition, V8Label* on_condition);
+
+  // Emits the body of Backtrack.
+  void EmitBacktrack();
+
+  // Register holding the current input position as a negative offset from
+  // the end of the string.
+  static constexpr Register current_input_offset() { return R12; }
+  // The register containing the current character after LoadCurrentCharacter.
+  static constexpr Register current_character() { return R15; }
+  // The register containing the end of the input.
+  static constexpr Register end_of_input_address() { return R14; }
+  // The register containing the start of the code, which the backtrack
+  // stack entries are relative to.
+  static constexpr Register code_object_pointer() { return R13; }
+  // The register containing the backtrack stack top. Provides a meaningful
+  // name to the register.
+  static constexpr Register backtrack_stackpointer() { return RBX; }
+
+  compiler::Assembler masm_;
+
+  // Assembler labels of V8Labels, indexed by the position stored in the
+  // V8Label.
+  GrowableArray<compiler::Label*> labels_;
+  // Buffer offsets of the immediates written by Push(V8Label*), and the
+  // indices of the labels they refer to.
+  struct BacktrackFixup {
+    intptr_t position;
+    intptr_t label_index;
+  };
+  GrowableArray<BacktrackFixup> backtrack_fixups_;
+
+  // One greater than maximal register index actually used.
+  int num_registers_;
+
+  // Number of registers to output at the end (the saved registers
+  // are always 0..num_saved_registers_-1).
+  const int num_saved_registers_;
+
+  // Labels used internally. Zone allocated like the labels in labels_, as
+  // they may still be linked when code generation is aborted.
+  compiler::Label* const entry_label_;
+  compiler::Label* const start_label_;
+  compiler::Label* const success_label_;
+  compiler::Label* const backtrack_label_;
+  compiler::Label* const exit_label_;
+  compiler::Label* const check_preempt_label_;
+  compiler::Label* const stack_overflow_label_;
+  compiler::Label* const exit_with_exception_label_;
+  compiler::Label* const fallback_label_;
+};
+
+}  // namespace dart
+
+#endif  // defined(DART_REGEXP_NATIVE_CODE) && defined(TARGET_ARCH_X64)
+
+#endif  // V8_REGEXP_X64_REGEXP_MACRO_ASSEMBLER_X64_H_
@@ -10,6 +10,11 @@
 #include "vm/regexp/label.h"
 #include "vm/regexp/special-case.h"
 
+#if defined(DART_REGEXP_NATIVE_CODE)
+#include "vm/exceptions.h"
+#include "vm/thread.h"
+#endif  // defined(DART_REGEXP_NATIVE_CODE)
+
 #ifdef V8_INTL_SUPPORT
 #include "unicode/uchar.h"
 #include "unicode/unistr.h"
@@ -433,6 +438,100 @@ void RegExpMacroAssembler::SkipUntilOneOfMasked3(
   GoTo(args.fallthrough_jump_target);
 }
 
+#if defined(DART_REGEXP_NATIVE_CODE)
+
+// static
+uword NativeRegExpMacroAssembler::GrowBacktrackStack(MatchState* state,
+                                                     uword stack_pointer) {
+  const intptr_t size =
+      state->backtrack_stack_top - state->backtrack_stack_base;
+  const intptr_t new_size = 2 * size;
+  if (new_size > kMaxBacktrackStackSize) {
+    return 0;
+  }
+  uint8_t* new_base = reinterpret_cast<uint8_t*>(malloc(new_size));
+  if (new_base == nullptr) {
+    return 0;
+  }
+  // The stack grows downwards, move the used part to the top of the new one.
+  const intptr_t used =
+      state->backtrack_stack_top - reinterpret_cast<uint8_t*>(stack_pointer);
+  uint8_t* new_top = new_base + new_size;
+  memmove(new_top - used, reinterpret_cast<uint8_t*>(stack_pointer), used);
+  free(state->backtrack_stack_memory);
+  state->backtrack_stack_memory = new_base;
+  state->backtrack_stack_base = new_base;
+  state->backtrack_stack_top = new_top;
+  state->backtrack_stack_limit = new_base + kBacktrackStackSlackSize;
+  return reinterpret_cast<uword>(new_top - used);
+}
+
+// static
+void NativeRegExpMacroAssembler::SetInput(MatchState* state) {
+  const String& subject = *state->subject;
+  const intptr_t char_size = subject.IsOneByteString() ? 1 : 2;
+  const uint8_t* input_start =
+      subject.IsOneByteString()
+          ? OneByteString::DataStart(subject)
+          : reinterpret_cast<const uint8_t*>(TwoByteString::DataStart(subject));
+  state->input_start = input_start;
+  state->input_end = input_start + subject.Length() * char_size;
+}
+
+// static
+uword NativeRegExpMacroAssembler::HandleInterrupts(MatchState* state) {
+  Thread* thread = state->thread;
+  const Error& error =
+      Error::Handle(thread->zone(), thread->HandleInterrupts());
+  if (!error.IsNull()) {
+    thread->set_sticky_error(error);
+    return 0;
+  }
+  // The subject may have been moved by a GC while handling the interrupt.
+  NoSafepointScope no_safepoint(thread);
+  SetInput(state);
+  return reinterpret_cast<uword>(state->input_end);
+}
+
+// static
+int NativeRegExpMacroAssembler::Match(Thread* thread,
+                                      const Code& code,
+                                      const String& subject,
+                                      int32_t* output,
+                                      int start_index) {
+  ASSERT(start_index >= 0 && start_index <= subject.Length());
+  using RegExpMatcher = int32_t (*)(MatchState*);
+  const auto matcher = reinterpret_cast<RegExpMatcher>(code.EntryPoint());
+
+  uint8_t initial_stack[kInitialBacktrackStackSize];
+  MatchState state;
+  state.subject = &subject;
+  state.start_index = start_index;
+  state.output = output;
+  state.thread = thread;
+  state.isolate = thread->isolate();
+  state.backtrack_stack_base = initial_stack;
+  state.backtrack_stack_top = initial_stack + kInitialBacktrackStackSize;
+  state.backtrack_stack_limit = initial_stack + kBacktrackStackSlackSize;
+  state.backtrack_stack_memory = nullptr;
+  {
+    NoSafepointScope no_safepoint(thread);
+    SetInput(&state);
+  }
+  // The generated code reads the string without handles. The only safepoint
+  // it reaches is HandleInterrupts, which updates the input pointers.
+  const int result = matcher(&state);
+  free(state.backtrack_stack_memory);
+
+  if (result == EXCEPTION && thread->sticky_error() == Error::null()) {
+    // Like the interpreter, throw when the backtrack stack overflows.
+    Exceptions::ThrowStackOverflow();
+  }
+  return result;
+}
+
+#endif  // defined(DART_REGEXP_NATIVE_CODE)
+
 #ifndef COMPILING_IRREGEXP_FOR_EXTERNAL_EMBEDDER
 
 // Returns a {Result} sentinel, or the number of successful matches.
@@ -11,6 +11,13 @@
 #include "vm/regexp/regexp-ast.h"
 #include "vm/regexp/regexp.h"
 
+// Dart: Generating machine code for regexps is supported in JIT mode on x64
+// and arm64.
+#if !defined(DART_PRECOMPILED_RUNTIME) && !defined(USING_SIMULATOR) &&        \
+    (defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64))
+#define DART_REGEXP_NATIVE_CODE 1
+#endif
+
 namespace dart {
 
 class ByteArray;
@@ -391,7 +398,8 @@ class NativeRegExpMacroAssembler : public RegExpMacroAssembler {
  public:
   // Result of calling generated native RegExp code.
   // RETRY: Something significant changed during execution, and the matching
-  //        should be retried from scratch.
+  //        should be retried from scratch. Dart: never returned, interrupts
+  //        are handled by HandleInterrupts.
   // EXCEPTION: Something failed during execution. If no exception has been
   //            thrown, it's an internal out-of-memory, and the caller should
   //            throw the exception.
@@ -414,22 +422,47 @@ class NativeRegExpMacroAssembler : public RegExpMacroAssembler {
       : RegExpMacroAssembler(isolate, zone, mode), range_array_cache_(zone) {}
   ~NativeRegExpMacroAssembler() override = default;
 
-  // Returns a {Result} sentinel, or the number of successful matches.
-  static int Match(const Object& regexp_data,
+  // Dart: State shared between Match and the generated code. The generated
+  // code is called with a pointer to it as its only argument.
+  struct MatchState {
+    // The subject's characters. They are updated by HandleInterrupts if the
+    // subject was moved.
+    const String* subject;
+    const uint8_t* input_start;
+    const uint8_t* input_end;
+    intptr_t start_index;
+    int32_t* output;
+    Thread* thread;
+    Isolate* isolate;
+    // The backtrack stack grows downwards from backtrack_stack_top. The
+    // generated code calls GrowBacktrackStack when the stack pointer reaches
+    // backtrack_stack_limit.
+    uint8_t* backtrack_stack_base;
+    uint8_t* backtrack_stack_top;
+    uint8_t* backtrack_stack_limit;
+    // Heap allocated backtrack stack, if the initial one was too small.
+    uint8_t* backtrack_stack_memory;
+  };
+
+  // Runs the code generated for the subject's representation. Fills the
+  // capture registers in output and returns a {Result} sentinel.
+  static int Match(Thread* thread,
+                   const Code& code,
                    const String& subject,
-                   int* offsets_vector,
-                   int offsets_vector_length,
-                   int previous_index,
-                   Isolate* isolate);
-
-  static int ExecuteForTesting(const String& input,
-                               int start_offset,
-                               const uint8_t* input_start,
-                               const uint8_t* input_end,
-                               int* output,
-                               int output_size,
-                               Isolate* isolate,
-                               const RegExp& regexp);
+                   int32_t* output,
+                   int start_index);
+
+  // Called from the generated code. Doubles the size of the backtrack stack
+  // and returns the new stack pointer, or 0 if the stack would exceed
+  // kMaxBacktrackStackSize.
+  static uword GrowBacktrackStack(MatchState* state, uword stack_pointer);
+
+  // Called from the generated code when an interrupt is pending. Handles it
+  // and returns the new end of the input, or 0 if the match has to be
+  // aborted, in which case the error is set as the thread's sticky error.
+  // Positions are relative to the end of the input, so the match resumes
+  // where it was interrupted.
+  static uword HandleInterrupts(MatchState* state);
 
   void LoadCurrentCharacterImpl(int cp_offset,
                                 V8Label* on_end_of_input,
@@ -445,15 +478,14 @@ class NativeRegExpMacroAssembler : public RegExpMacroAssembler {
   TypedDataPtr GetOrAddRangeArray(const ZoneList<CharacterRange>* ranges);
 
  private:
-  // Returns a {Result} sentinel, or the number of successful matches.
-  static int Execute(const String& input,
-                     int start_offset,
-                     const uint8_t* input_start,
-                     const uint8_t* input_end,
-                     int* output,
-                     int output_size,
-                     Isolate* isolate,
-                     const Object& regexp_data);
+  static void SetInput(MatchState* state);
+
+  static constexpr intptr_t kInitialBacktrackStackSize = 1 * KB;
+  // Same limit as the interpreter's backtrack stack.
+  static constexpr intptr_t kMaxBacktrackStackSize = 64 * MB;
+  // The generated code checks the limit once per push, reserve space for the
+  // entries pushed without a check (see stack_limit_slack_slot_count()).
+  static constexpr intptr_t kBacktrackStackSlackSize = 32 * kInt32Size;
 
   ZoneUnorderedMap<uint32_t, TypedData*> range_array_cache_;
 };
@@ -9,16 +9,51 @@
 #include <memory>
 #include <utility>
 
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+#include "vm/hash.h"
+#include "vm/object_store.h"
+#include "vm/regexp/experimental.h"
 #include "vm/regexp/regexp-bytecode-generator.h"
 #include "vm/regexp/regexp-bytecodes.h"
 #include "vm/regexp/regexp-compiler.h"
 #include "vm/regexp/regexp-interpreter.h"
+#include "vm/regexp/regexp-macro-assembler-arm64.h"
+#include "vm/regexp/regexp-macro-assembler-x64.h"
 #include "vm/regexp/regexp-macro-assembler.h"
 #include "vm/regexp/regexp-parser.h"
+#include "vm/regexp/string-search.h"
 #include "vm/symbols.h"
 
 namespace dart {
 
+#if defined(DART_REGEXP_NATIVE_CODE)
+DEFINE_FLAG(int,
+            regexp_tier_up_threshold,
+            100,
+            "Number of matches after which a regexp is compiled to machine "
+            "code. Negative values disable the compilation.");
+#endif
+DEFINE_FLAG(bool,
+            enable_experimental_regexp_engine_on_excessive_backtracks,
+            true,
+            "Fall back to a breadth-first regexp engine on excessive "
+            "backtracking.");
+DEFINE_FLAG(int,
+            regexp_backtracks_before_fallback,
+            50000,
+            "Number of backtracks during regexp execution before falling back "
+            "to the experimental engine if "
+            "enable_experimental_regexp_engine_on_excessive_backtracks is set.");
+DEFINE_FLAG(bool,
+            default_to_experimental_regexp_engine,
+            false,
+            "Run regexps with the experimental engine where possible.");
+DEFINE_FLAG(bool,
+            regexp_match_cache,
+            true,
+            "Cache the results of the most recent regexp matches.");
+
 using namespace regexp_compiler_constants;  // NOLINT(build/namespaces)
 
 class RegExpImpl final : public AllStatic {
@@ -83,12 +118,46 @@ class RegExpImpl final : public AllStatic {
                                           const RegExp& re_data,
                                           const String& sample_subject,
                                           bool is_one_byte);
+#if defined(DART_REGEXP_NATIVE_CODE)
+  // Compiles the regexp to machine code for the given representation of the
+  // subject. Unlike CompileIrregexpFromSource, doesn't throw and returns
+  // false if the pattern can't be compiled to machine code.
+  static bool CompileIrregexpNative(Thread* thread,
+                                    const RegExp& re_data,
+                                    const String& sample_subject,
+                                    bool is_one_byte,
+                                    bool sticky);
+  // Returns the machine code of the regexp once it has been used often
+  // enough, compiling it if needed. Returns null while the bytecode should
+  // be interpreted.
+  static CodePtr NativeCodeIfHot(Thread* thread,
+                                 const RegExp& re_data,
+                                 const String& subject,
+                                 bool is_one_byte,
+                                 bool sticky);
+#endif  // defined(DART_REGEXP_NATIVE_CODE)
   static inline bool EnsureCompiledIrregexp(Thread* thread,
                                             const RegExp& re_data,
                                             const String& sample_subject,
                                             bool is_one_byte,
                                             bool sticky);
 
+  // Matches an atom regexp, see RegExpStatics::IsAtom, by searching for the
+  // pattern in the subject.
+  static ObjectPtr AtomExec(Thread* thread,
+                            const RegExp& regexp,
+                            const String& subject,
+                            int start_index,
+                            bool sticky);
+
+  // Matches the regexp with irregexp (bytecode or machine code), falling back
+  // to the experimental engine if needed.
+  static ObjectPtr IrregexpInterpret(Thread* thread,
+                                     const RegExp& regexp,
+                                     const String& subject,
+                                     int start_index,
+                                     bool sticky);
+
   // Returns true on success, false on failure.
   static bool Compile(Isolate* isolate,
                       Zone* zone,
@@ -286,6 +355,7 @@ bool RegExpImpl::CompileIrregexpFromSource(
   re_data.set_capture_name_map(capture_name_map);
   re_data.set_num_bracket_expressions<std::memory_order_release>(
       compile_data.capture_count);
+  re_data.set_is_atom(RegExpStatics::IsAtom(compile_data, flags));
 
   // Set bytecode after setting num_registers. RegExpStatics::Interpret will
   // read bytecode first and assume num_register is available if bytecode is not
@@ -299,13 +369,87 @@ bool RegExpImpl::CompileIrregexpFromSource(
   return true;
 }
 
+#if defined(DART_REGEXP_NATIVE_CODE)
+bool RegExpImpl::CompileIrregexpNative(Thread* thread,
+                                       const RegExp& re_data,
+                                       const String& sample_subject,
+                                       bool is_one_byte,
+                                       bool sticky) {
+  if (!OSThread::Current()->HasStackHeadroom()) {
+    return false;
+  }
+
+  RegExpFlags flags = re_data.flags();
+  if (sticky) {
+    flags |= RegExpFlag::kSticky;
+  }
+  Zone* zone = thread->zone();
+  const String& pattern = String::Handle(zone, re_data.pattern());
+
+  RegExpCompileData compile_data;
+  if (!RegExpParser::ParseRegExpFromHeapString(thread->isolate(), zone, pattern,
+                                               flags, &compile_data)) {
+    return false;
+  }
+  compile_data.compilation_target = RegExpCompilationTarget::kNative;
+  CompilerState state(thread, /*is_aot=*/false, /*is_optimizing=*/false);
+  if (!Compile(thread->isolate(), zone, &compile_data, flags, pattern,
+               sample_subject, re_data, is_one_byte) ||
+      compile_data.code->IsNull()) {
+    return false;
+  }
+  // The interpreter's register count is used to size the output, make sure
+  // the machine code doesn't write more.
+  ASSERT(JSRegExp::RegistersForCaptureCount(compile_data.capture_count) <=
+         re_data.num_registers(is_one_byte));
+  re_data.set_native_code(is_one_byte, sticky, Code::Cast(*compile_data.code));
+  return true;
+}
+
+CodePtr RegExpImpl::NativeCodeIfHot(Thread* thread,
+                                    const RegExp& re_data,
+                                    const String& subject,
+                                    bool is_one_byte,
+                                    bool sticky) {
+  const CodePtr code = re_data.native_code(is_one_byte, sticky);
+  if (code != Code::null()) {
+    return code;
+  }
+  if (FLAG_regexp_tier_up_threshold < 0 ||
+      re_data.native_code_failed(is_one_byte, sticky)) {
+    return Code::null();
+  }
+  if (re_data.usage_counter() < FLAG_regexp_tier_up_threshold) {
+    re_data.IncrementUsageCounter();
+    return Code::null();
+  }
+  if (!CompileIrregexpNative(thread, re_data, subject, is_one_byte, sticky)) {
+    // Don't try again, keep interpreting the bytecode. The other
+    // specializations may still be compiled.
+    re_data.set_native_code_failed(is_one_byte, sticky);
+    return Code::null();
+  }
+  return re_data.native_code(is_one_byte, sticky);
+}
+#endif  // defined(DART_REGEXP_NATIVE_CODE)
+
 namespace {
 
+// Dart: RegExps have no backtrack limit of their own, so a limit is only
+// set for patterns that can fall back to the experimental engine.
 void SetBacktrackAndExperimentalFallback(RegExpMacroAssembler* macro_assembler,
-                                         const RegExp& re_data) {
+                                         RegExpCompileData* data,
+                                         RegExpFlags flags) {
   uint32_t backtrack_limit = JSRegExp::kNoBacktrackLimit;
+  const bool can_fallback =
+      FLAG_enable_experimental_regexp_engine_on_excessive_backtracks &&
+      FLAG_regexp_backtracks_before_fallback > 0 &&
+      ExperimentalRegExp::CanBeHandled(data->tree, flags, data->capture_count);
+  if (can_fallback) {
+    backtrack_limit = FLAG_regexp_backtracks_before_fallback;
+  }
   macro_assembler->set_backtrack_limit(backtrack_limit);
-  macro_assembler->set_can_fallback(false);
+  macro_assembler->set_can_fallback(can_fallback);
 }
 
 }  // namespace
@@ -398,7 +542,21 @@ bool RegExpImpl::Compile(Isolate* isolate,
 
   std::unique_ptr<RegExpMacroAssembler> macro_assembler;
   if (data->compilation_target == RegExpCompilationTarget::kNative) {
+#if defined(DART_REGEXP_NATIVE_CODE)
+    const RegExpMacroAssembler::Mode mode =
+        is_one_byte ? RegExpMacroAssembler::LATIN1 : RegExpMacroAssembler::UC16;
+    const int output_register_count =
+        JSRegExp::RegistersForCaptureCount(data->capture_count);
+#if defined(TARGET_ARCH_X64)
+    macro_assembler.reset(new RegExpMacroAssemblerX64(isolate, zone, mode,
+                                                      output_register_count));
+#elif defined(TARGET_ARCH_ARM64)
+    macro_assembler.reset(new RegExpMacroAssemblerARM64(
+        isolate, zone, mode, output_register_count));
+#endif
+#else
     UNREACHABLE();
+#endif
   } else {
     DCHECK_EQ(data->compilation_target, RegExpCompilationTarget::kBytecode);
     // Interpreted regexp implementation.
@@ -417,7 +575,7 @@ bool RegExpImpl::Compile(Isolate* isolate,
   }
 
   macro_assembler->set_slow_safe(TooMuchRegExpCode(isolate, pattern));
-  SetBacktrackAndExperimentalFallback(macro_assembler.get(), re_data);
+  SetBacktrackAndExperimentalFallback(macro_assembler.get(), data, flags);
 
   // Inserted here, instead of in Assembler, because it depends on information
   // in the AST that isn't replicated in the Node structure.
@@ -489,11 +647,170 @@ std::ostream& operator<<(std::ostream& os, RegExpFlags flags) {
   return os;
 }
 
+// static
+bool RegExpStatics::IsAtom(const RegExpCompileData& data, RegExpFlags flags) {
+  // Unicode patterns are excluded so that a lone surrogate in the pattern
+  // never matches half of a surrogate pair in the subject.
+  return data.simple && !IsIgnoreCase(flags) && !IsEitherUnicode(flags);
+}
+
+namespace {
+
+// A small direct-mapped cache of the most recent match results of the
+// isolate, keyed on the identity of the RegExp and the subject, so that
+// repeatedly matching the same subject (e.g. with allMatches or replaceAll)
+// doesn't rerun the matcher. Entries are held weakly and are dropped when the
+// RegExp, the subject or the result is collected. The results are never
+// modified by the Dart side, so they can be shared.
+class RegExpMatchCache : public ValueObject {
+ public:
+  RegExpMatchCache(Thread* thread,
+                   const RegExp& regexp,
+                   const String& subject,
+                   int start_index,
+                   bool sticky)
+      : thread_(thread),
+        regexp_(regexp),
+        subject_(subject),
+        key_(Smi::New(start_index * 2 + (sticky ? 1 : 0))),
+        cache_(WeakArray::Handle(
+            thread->zone(),
+            thread->isolate()->isolate_object_store()->regexp_match_cache())),
+        entry_(0) {
+    const String& pattern = String::Handle(thread->zone(), regexp.pattern());
+    const uint32_t hash = FinalizeHash(
+        CombineHashes(pattern.Hash(), static_cast<uint32_t>(start_index)));
+    entry_ = (hash & (kNumEntries - 1)) * kEntrySize;
+  }
+
+  // Returns true and sets `result` if the match is in the cache.
+  bool Lookup(Object* result) const {
+    if (cache_.IsNull() || cache_.At(entry_ + kRegExpIndex) != regexp_.ptr() ||
+        cache_.At(entry_ + kSubjectIndex) != subject_.ptr() ||
+        cache_.At(entry_ + kKeyIndex) != key_) {
+      return false;
+    }
+    *result = cache_.At(entry_ + kResultIndex);
+    if (result->IsNull()) {
+      // The result was collected.
+      return false;
+    }
+    if (result->ptr() == Bool::False().ptr()) {
+      *result = Instance::null();
+    }
+    return true;
+  }
+
+  void Update(const Object& result) {
+    if (cache_.IsNull()) {
+      cache_ = WeakArray::New(kNumEntries * kEntrySize, Heap::kOld);
+      thread_->isolate()->isolate_object_store()->set_regexp_match_cache(
+          cache_);
+    }
+    cache_.SetAt(entry_ + kRegExpIndex, regexp_);
+    cache_.SetAt(entry_ + kSubjectIndex, subject_);
+    cache_.SetAt(entry_ + kKeyIndex, Smi::Handle(thread_->zone(), key_));
+    cache_.SetAt(entry_ + kResultIndex,
+                 result.IsNull() ? Bool::False() : result);
+  }
+
+ private:
+  static constexpr intptr_t kRegExpIndex = 0;
+  static constexpr intptr_t kSubjectIndex = 1;
+  static constexpr intptr_t kKeyIndex = 2;
+  static constexpr intptr_t kResultIndex = 3;
+  static constexpr intptr_t kEntrySize = 4;
+  static constexpr intptr_t kNumEntries = 32;
+
+  Thread* thread_;
+  const RegExp& regexp_;
+  const String& subject_;
+  SmiPtr key_;
+  WeakArray& cache_;
+  intptr_t entry_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegExpMatchCache);
+};
+
+}  // namespace
+
 ObjectPtr RegExpStatics::Interpret(Thread* thread,
                                    const RegExp& regexp,
                                    const String& subject,
                                    int start_index,
                                    bool sticky) {
+  if (!FLAG_regexp_match_cache) {
+    return regexp.is_atom() ? RegExpImpl::AtomExec(thread, regexp, subject,
+                                                   start_index, sticky)
+                            : RegExpImpl::IrregexpInterpret(
+                                  thread, regexp, subject, start_index, sticky);
+  }
+  RegExpMatchCache cache(thread, regexp, subject, start_index, sticky);
+  Object& result = Object::Handle(thread->zone());
+  if (cache.Lookup(&result)) {
+    return result.ptr();
+  }
+  if (regexp.is_atom()) {
+    result =
+        RegExpImpl::AtomExec(thread, regexp, subject, start_index, sticky);
+  } else {
+    result = RegExpImpl::IrregexpInterpret(thread, regexp, subject,
+                                           start_index, sticky);
+  }
+  cache.Update(result);
+  return result.ptr();
+}
+
+ObjectPtr RegExpImpl::AtomExec(Thread* thread,
+                               const RegExp& regexp,
+                               const String& subject,
+                               int start_index,
+                               bool sticky) {
+  const String& pattern = String::Handle(thread->zone(), regexp.pattern());
+  const intptr_t pattern_length = pattern.Length();
+  // A sticky match can only start at `start_index`, so don't look further.
+  const intptr_t subject_length =
+      sticky ? Utils::Minimum(subject.Length(), start_index + pattern_length)
+             : subject.Length();
+  intptr_t index;
+  {
+    NoSafepointScope no_safepoint(thread);
+    if (pattern.IsOneByteString()) {
+      const uint8_t* pattern_data = OneByteString::DataStart(pattern);
+      index = subject.IsOneByteString()
+                  ? StringSearch::IndexOf(pattern_data, pattern_length,
+                                          OneByteString::DataStart(subject),
+                                          subject_length, start_index)
+                  : StringSearch::IndexOf(pattern_data, pattern_length,
+                                          TwoByteString::DataStart(subject),
+                                          subject_length, start_index);
+    } else {
+      const uint16_t* pattern_data = TwoByteString::DataStart(pattern);
+      index = subject.IsOneByteString()
+                  ? StringSearch::IndexOf(pattern_data, pattern_length,
+                                          OneByteString::DataStart(subject),
+                                          subject_length, start_index)
+                  : StringSearch::IndexOf(pattern_data, pattern_length,
+                                          TwoByteString::DataStart(subject),
+                                          subject_length, start_index);
+    }
+  }
+  if (index < 0) {
+    return Instance::null();
+  }
+  const TypedData& result = TypedData::Handle(
+      thread->zone(), TypedData::New(kTypedDataInt32ArrayCid, 2));
+  result.SetInt32(0, static_cast<int32_t>(index));
+  result.SetInt32(sizeof(int32_t),
+                  static_cast<int32_t>(index + pattern_length));
+  return result.ptr();
+}
+
+ObjectPtr RegExpImpl::IrregexpInterpret(Thread* thread,
+                                        const RegExp& regexp,
+                                        const String& subject,
+                                        int start_index,
+                                        bool sticky) {
   bool is_one_byte = subject.IsOneByteString();
   if (regexp.bytecode(is_one_byte, sticky) == TypedData::null()) {
     if (!RegExpImpl::CompileIrregexpFromSource(
@@ -512,8 +829,35 @@ ObjectPtr RegExpStatics::Interpret(Thread* thread,
     registers[i] = -1;
   }
 
-  int r = IrregexpInterpreter::MatchForCallFromRuntime(
-      thread, regexp, subject, registers, register_count, start_index, sticky);
+  int r;
+  if (FLAG_default_to_experimental_regexp_engine &&
+      ExperimentalRegExp::CanBeHandled(thread, regexp, sticky)) {
+    r = IrregexpInterpreter::FALLBACK_TO_EXPERIMENTAL;
+  } else {
+#if defined(DART_REGEXP_NATIVE_CODE)
+    const Code& code = Code::Handle(
+        thread->zone(), RegExpImpl::NativeCodeIfHot(thread, regexp, subject,
+                                                    is_one_byte, sticky));
+    if (!code.IsNull()) {
+      r = NativeRegExpMacroAssembler::Match(thread, code, subject, registers,
+                                            start_index);
+    } else {
+      r = IrregexpInterpreter::MatchForCallFromRuntime(
+          thread, regexp, subject, registers, register_count, start_index,
+          sticky);
+    }
+#else
+    r = IrregexpInterpreter::MatchForCallFromRuntime(
+        thread, regexp, subject, registers, register_count, start_index,
+        sticky);
+#endif
+  }
+  if (r == IrregexpInterpreter::FALLBACK_TO_EXPERIMENTAL) {
+    // The backtracking engine gave up, which it only does for patterns the
+    // experimental engine can handle. Run the match again in linear time.
+    r = ExperimentalRegExp::OneshotExec(thread, regexp, subject, start_index,
+                                        registers, register_count, sticky);
+  }
   if (r == IrregexpInterpreter::SUCCESS) {
     const TypedData& result = TypedData::Handle(
         thread->zone(),
@@ -541,9 +885,7 @@ ObjectPtr RegExpStatics::Interpret(Thread* thread,
     Exceptions::PropagateError(error);
     UNREACHABLE();
   } else if (r == IrregexpInterpreter::RETRY) {
-    UNREACHABLE();  // No tier up in Dart.
-  } else if (r == IrregexpInterpreter::FALLBACK_TO_EXPERIMENTAL) {
-    UNREACHABLE();  // No alt implementation for Dart.
+    UNREACHABLE();  // Interrupts are handled by the matchers.
   } else {
     UNREACHABLE();
   }
@@ -192,6 +192,10 @@ class RegExpStatics final : public AllStatic {
       Isolate* isolate,
       ZoneVector<RegExpCapture*>* named_captures);
 
+  // Whether a parsed pattern is a plain string that can be matched by a
+  // substring search instead of irregexp.
+  static bool IsAtom(const RegExpCompileData& data, RegExpFlags flags);
+
   static ObjectPtr Interpret(Thread* thread,
                              const RegExp& regexp,
                              const String& subject,
@@ -4,6 +4,7 @@
 
 #include "platform/globals.h"
 
+#include "vm/flags.h"
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp/regexp.h"
@@ -48,4 +49,321 @@ ISOLATE_UNIT_TEST_CASE(RegExp_TwoByteString) {
   EXPECT_EQ(3, res.GetInt32(1 * sizeof(int32_t)));
 }
 
+static void ExpectSameMatch(const Object& expected, const Object& actual) {
+  EXPECT_EQ(expected.IsNull(), actual.IsNull());
+  if (expected.IsNull() || actual.IsNull()) return;
+  const TypedData& expected_data = TypedData::Cast(expected);
+  const TypedData& actual_data = TypedData::Cast(actual);
+  EXPECT_EQ(expected_data.Length(), actual_data.Length());
+  for (intptr_t i = 0; i < expected_data.Length(); i++) {
+    EXPECT_EQ(expected_data.GetInt32(i * sizeof(int32_t)),
+              actual_data.GetInt32(i * sizeof(int32_t)));
+  }
+}
+
+DECLARE_FLAG(bool, regexp_peephole_optimization);
+
+static ObjectPtr MatchWithPeephole(const char* pattern,
+                                   const String& subject,
+                                   bool peephole) {
+  SetFlagScope<bool> sfs(&FLAG_regexp_peephole_optimization, peephole);
+  return Match(String::Handle(String::New(pattern)), subject);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_PeepholeOptimization) {
+  // Patterns whose bytecode contains the character-skipping loops replaced by
+  // the peephole optimization.
+  const char* patterns[] = {"[^,]*,", ".*?x", "a.*?(b|c)", "[a-f]+g",
+                            "[^a-z]*z", "(?:x|y)*?q"};
+  const char* subjects[] = {"abc,def", "aaaaaaaaax", "xxaxxxxc", "abcdefg",
+                            "0123z",   "xyxyxq",     "no match here"};
+  Object& expected = Object::Handle();
+  Object& actual = Object::Handle();
+  String& subject = String::Handle();
+  for (const char* pattern : patterns) {
+    for (const char* subject_chars : subjects) {
+      subject = String::New(subject_chars);
+      expected = MatchWithPeephole(pattern, subject, /*peephole=*/false);
+      actual = MatchWithPeephole(pattern, subject, /*peephole=*/true);
+      ExpectSameMatch(expected, actual);
+    }
+  }
+}
+
+DECLARE_FLAG(bool, default_to_experimental_regexp_engine);
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+DECLARE_FLAG(bool, regexp_match_cache);
+
+ISOLATE_UNIT_TEST_CASE(RegExp_ExperimentalEngine) {
+  const char* patterns[] = {"a(b|bc)c",     "(a*)*b",    "^(?:x|y)+?z",
+                            "(\\w+)\\s(\\w+)$", "a{2,3}?",   "\\bfoo\\B",
+                            "(a)|(b)",      "[^a-c]+d",  "x(?:y(z)?)*"};
+  const char* subjects[] = {"abcc", "aaab", "xyxz", "hello world", "aaaa",
+                            "foox foo", "b", "xxd", "xyzyy", ""};
+  Object& expected = Object::Handle();
+  Object& actual = Object::Handle();
+  String& subject = String::Handle();
+  for (const char* pattern : patterns) {
+    const String& pat = String::Handle(String::New(pattern));
+    for (const char* subject_chars : subjects) {
+      subject = String::New(subject_chars);
+      for (intptr_t start = 0; start <= subject.Length(); start++) {
+        {
+          SetFlagScope<bool> sfs(&FLAG_default_to_experimental_regexp_engine,
+                                 false);
+          const RegExp& regexp =
+              RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+          expected = RegExpStatics::Interpret(thread, regexp, subject, start,
+                                              /*sticky=*/false);
+        }
+        {
+          SetFlagScope<bool> sfs(&FLAG_default_to_experimental_regexp_engine,
+                                 true);
+          const RegExp& regexp =
+              RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+          actual = RegExpStatics::Interpret(thread, regexp, subject, start,
+                                            /*sticky=*/false);
+          // The check is cached on the regexp.
+          EXPECT(regexp.experimental_support() !=
+                 RegExp::ExperimentalSupport::kUnknown);
+        }
+        ExpectSameMatch(expected, actual);
+      }
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_FallbackOnExcessiveBacktracking) {
+  SetFlagScope<int> sfs(&FLAG_regexp_backtracks_before_fallback, 1000);
+  // Backtracking takes time exponential in the number of 'a's to fail at
+  // every start position before the match.
+  const String& pat = String::Handle(String::New("(a+)+b"));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+  const intptr_t length = 40;
+  uint8_t* chars = thread->zone()->Alloc<uint8_t>(length + 3);
+  for (intptr_t i = 0; i < length; i++) {
+    chars[i] = 'a';
+  }
+  chars[length] = 'c';
+  chars[length + 1] = 'a';
+  chars[length + 2] = 'b';
+  String& subject =
+      String::Handle(OneByteString::New(chars, length + 3, Heap::kNew));
+  TypedData& res = TypedData::Handle();
+  res ^= RegExpStatics::Interpret(thread, regexp, subject, 0,
+                                  /*sticky=*/false);
+  EXPECT(!res.IsNull());
+  if (!res.IsNull()) {
+    EXPECT_EQ(length + 1, res.GetInt32(0 * sizeof(int32_t)));
+    EXPECT_EQ(length + 3, res.GetInt32(1 * sizeof(int32_t)));
+    EXPECT_EQ(length + 1, res.GetInt32(2 * sizeof(int32_t)));
+    EXPECT_EQ(length + 2, res.GetInt32(3 * sizeof(int32_t)));
+  }
+  // The linear-time program is cached on the regexp.
+  const TypedData& program = TypedData::Handle(
+      regexp.experimental_bytecode(/*sticky=*/false));
+  EXPECT(!program.IsNull());
+  EXPECT(regexp.experimental_bytecode(/*sticky=*/true) == TypedData::null());
+
+  // Without a match.
+  subject = OneByteString::New(chars, length + 1, Heap::kNew);
+  EXPECT(RegExpStatics::Interpret(thread, regexp, subject, 0,
+                                  /*sticky=*/false) == Object::null());
+  EXPECT(regexp.experimental_bytecode(/*sticky=*/false) == program.ptr());
+}
+
+static StringPtr NewTwoByteString(const char* chars) {
+  // Starts with a character that doesn't fit in a one-byte string.
+  const intptr_t length = strlen(chars) + 1;
+  uint16_t* two_byte_chars = Thread::Current()->zone()->Alloc<uint16_t>(length);
+  two_byte_chars[0] = 0x100;
+  for (intptr_t i = 1; i < length; i++) {
+    two_byte_chars[i] = chars[i - 1];
+  }
+  return TwoByteString::New(two_byte_chars, length, Heap::kNew);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_AtomMatch) {
+  SetFlagScope<bool> sfs(&FLAG_regexp_match_cache, false);
+  const char* patterns[] = {"bc", "abcabd", "x", "zzzzzzzzzzzzzzzzzzzz"};
+  const char* subjects[] = {
+      "abcbd",
+      "abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabdabcabd",
+      "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx",
+      "no match in this rather long subject string, abcab abcabc",
+      "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz",
+      ""};
+  Object& expected = Object::Handle();
+  Object& actual = Object::Handle();
+  String& subject = String::Handle();
+  for (const char* pattern : patterns) {
+    const String& pat = String::Handle(String::New(pattern));
+    for (const char* subject_chars : subjects) {
+      for (bool two_byte : {false, true}) {
+        subject = two_byte ? NewTwoByteString(subject_chars)
+                           : String::New(subject_chars);
+        for (intptr_t start = 0; start <= subject.Length(); start++) {
+          for (bool sticky : {false, true}) {
+            // The first match of a new RegExp runs irregexp.
+            const RegExp& irregexp =
+                RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+            expected = RegExpStatics::Interpret(thread, irregexp, subject,
+                                                start, sticky);
+            EXPECT(irregexp.is_atom());
+            const RegExp& atom =
+                RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+            atom.set_is_atom(true);
+            actual =
+                RegExpStatics::Interpret(thread, atom, subject, start, sticky);
+            EXPECT_EQ(expected.IsNull(), actual.IsNull());
+            if (expected.IsNull() || actual.IsNull()) continue;
+            for (intptr_t i = 0; i < 2; i++) {
+              EXPECT_EQ(TypedData::Cast(expected).GetInt32(i * sizeof(int32_t)),
+                        TypedData::Cast(actual).GetInt32(i * sizeof(int32_t)));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Patterns that aren't plain strings, or are matched ignoring case, are
+  // not atoms.
+  const String& subject_abc = String::Handle(String::New("abc"));
+  const RegExp& dot = RegExp::Handle(
+      RegExp::New(String::Handle(String::New("a.c")), RegExpFlags()));
+  EXPECT(RegExpStatics::Interpret(thread, dot, subject_abc, 0, false) !=
+         Object::null());
+  EXPECT(!dot.is_atom());
+  const RegExp& ignore_case =
+      RegExp::Handle(RegExp::New(String::Handle(String::New("ABC")),
+                                 RegExpFlags(RegExpFlag::kIgnoreCase)));
+  EXPECT(RegExpStatics::Interpret(thread, ignore_case, subject_abc, 0, false) !=
+         Object::null());
+  EXPECT(!ignore_case.is_atom());
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_MatchCache) {
+  SetFlagScope<bool> sfs(&FLAG_regexp_match_cache, true);
+  const RegExp& regexp = RegExp::Handle(
+      RegExp::New(String::Handle(String::New("(a)b")), RegExpFlags()));
+  const String& subject = String::Handle(String::New("xxabab"));
+  Object& first = Object::Handle();
+  Object& second = Object::Handle();
+
+  // Repeating a match returns the cached result.
+  first = RegExpStatics::Interpret(thread, regexp, subject, 0, false);
+  second = RegExpStatics::Interpret(thread, regexp, subject, 0, false);
+  EXPECT(!first.IsNull());
+  EXPECT(first.ptr() == second.ptr());
+
+  // The subject is compared by identity.
+  const String& same_chars = String::Handle(String::New("xxabab"));
+  second = RegExpStatics::Interpret(thread, regexp, same_chars, 0, false);
+  EXPECT(first.ptr() != second.ptr());
+  ExpectSameMatch(first, second);
+
+  // Different start indices and stickiness are different entries.
+  second = RegExpStatics::Interpret(thread, regexp, subject, 3, false);
+  EXPECT_EQ(4, TypedData::Cast(second).GetInt32(0));
+  EXPECT(RegExpStatics::Interpret(thread, regexp, subject, 0, true) ==
+         Object::null());
+  second = RegExpStatics::Interpret(thread, regexp, subject, 2, true);
+  EXPECT_EQ(2, TypedData::Cast(second).GetInt32(0));
+
+  // Failed matches are cached too.
+  EXPECT(RegExpStatics::Interpret(thread, regexp, subject, 5, false) ==
+         Object::null());
+  EXPECT(RegExpStatics::Interpret(thread, regexp, subject, 5, false) ==
+         Object::null());
+}
+
+#if defined(DART_REGEXP_NATIVE_CODE)
+DECLARE_FLAG(int, regexp_tier_up_threshold);
+
+static void ExpectMatch(const RegExp& regexp,
+                        const String& subject,
+                        intptr_t start_index,
+                        const int32_t* expected,
+                        intptr_t expected_length) {
+  TypedData& res = TypedData::Handle();
+  res ^= RegExpStatics::Interpret(Thread::Current(), regexp, subject,
+                                  start_index, /*sticky=*/false);
+  EXPECT(!res.IsNull());
+  if (res.IsNull()) return;
+  EXPECT_LE(expected_length, res.Length());
+  for (intptr_t i = 0; i < expected_length; i++) {
+    EXPECT_EQ(expected[i], res.GetInt32(i * sizeof(int32_t)));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_TierUpToNativeCode) {
+  SetFlagScope<int> sfs(&FLAG_regexp_tier_up_threshold, 1);
+  // Repeated matches must not be answered by the match cache.
+  SetFlagScope<bool> sfs_cache(&FLAG_regexp_match_cache, false);
+  const String& pat = String::Handle(String::New("(a|b)+(c)\\1"));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+  const String& one_byte = String::Handle(String::New("xxababcbd"));
+  const uint16_t chars[] = {'x', 0x100, 'a', 'b', 'c', 'b', 'd'};
+  const String& two_byte =
+      String::Handle(TwoByteString::New(chars, ARRAY_SIZE(chars), Heap::kNew));
+  const int32_t expected_one_byte[] = {2, 8, 5, 6, 6, 7};
+  const int32_t expected_two_byte[] = {2, 6, 3, 4, 4, 5};
+
+  // The first match is interpreted, the later ones run the machine code.
+  for (intptr_t i = 0; i < 3; i++) {
+    ExpectMatch(regexp, one_byte, 0, expected_one_byte,
+                ARRAY_SIZE(expected_one_byte));
+    ExpectMatch(regexp, two_byte, 0, expected_two_byte,
+                ARRAY_SIZE(expected_two_byte));
+  }
+  EXPECT(regexp.native_code(/*is_one_byte=*/true, /*sticky=*/false) !=
+         Code::null());
+  EXPECT(regexp.native_code(/*is_one_byte=*/false, /*sticky=*/false) !=
+         Code::null());
+
+  // Matches starting in the middle of the string, and failing matches.
+  const int32_t expected_from_three[] = {3, 8, 5, 6, 6, 7};
+  ExpectMatch(regexp, one_byte, 3, expected_from_three,
+              ARRAY_SIZE(expected_from_three));
+  EXPECT(RegExpStatics::Interpret(thread, regexp, one_byte, 7,
+                                  /*sticky=*/false) == Object::null());
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_NativeCodeGrowsBacktrackStack) {
+  SetFlagScope<int> sfs(&FLAG_regexp_tier_up_threshold, 0);
+  // Every repetition of the group pushes to the backtrack stack, which
+  // overflows the initial stack of the generated code.
+  const String& pat = String::Handle(String::New("^(?:a|b)*c$"));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+  const intptr_t length = 10000;
+  uint8_t* chars = thread->zone()->Alloc<uint8_t>(length);
+  for (intptr_t i = 0; i < length - 1; i++) {
+    chars[i] = (i % 2) == 0 ? 'a' : 'b';
+  }
+  chars[length - 1] = 'c';
+  const String& subject =
+      String::Handle(OneByteString::New(chars, length, Heap::kNew));
+  const int32_t expected[] = {0, static_cast<int32_t>(length)};
+  ExpectMatch(regexp, subject, 0, expected, ARRAY_SIZE(expected));
+  EXPECT(regexp.native_code(/*is_one_byte=*/true, /*sticky=*/false) !=
+         Code::null());
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_NativeCodeHandlesInterrupts) {
+  SetFlagScope<int> sfs(&FLAG_regexp_tier_up_threshold, 0);
+  const String& pat = String::Handle(String::New("(a|b)+(c)\\1"));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+  const String& subject = String::Handle(String::New("xxababcbd"));
+  const int32_t expected[] = {2, 8, 5, 6, 6, 7};
+  // The generated code handles the interrupt when it backtracks and then
+  // resumes the match.
+  thread->ScheduleInterrupts(Thread::kVMInterrupt);
+  ExpectMatch(regexp, subject, 0, expected, ARRAY_SIZE(expected));
+  EXPECT(regexp.native_code(/*is_one_byte=*/true, /*sticky=*/false) !=
+         Code::null());
+  EXPECT(!thread->HasScheduledInterrupts());
+}
+#endif  // defined(DART_REGEXP_NATIVE_CODE)
+
 }  // namespace dart
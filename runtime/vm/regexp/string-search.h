@@ -0,0 +1,145 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_REGEXP_STRING_SEARCH_H_
+#define RUNTIME_VM_REGEXP_STRING_SEARCH_H_
+
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "platform/utils.h"
+#include "vm/allocation.h"
+
+#if defined(HOST_ARCH_X64)
+#include <emmintrin.h>
+#endif
+
+namespace dart {
+
+// Substring search used to match atom regexps, i.e. patterns that are plain
+// strings. Candidate positions are found by comparing the first and the last
+// character of the pattern against a whole block of the subject at a time,
+// using SSE2 on x64, and are then verified character by character.
+class StringSearch : public AllStatic {
+ public:
+  // Returns the index of the first occurrence of `pattern` in `subject` at or
+  // after `start_index`, or -1 if there is none.
+  template <typename PatternChar, typename SubjectChar>
+  static intptr_t IndexOf(const PatternChar* pattern,
+                          intptr_t pattern_length,
+                          const SubjectChar* subject,
+                          intptr_t subject_length,
+                          intptr_t start_index) {
+    ASSERT(start_index >= 0);
+    if (pattern_length == 0) {
+      return start_index <= subject_length ? start_index : -1;
+    }
+    if (start_index > subject_length - pattern_length) {
+      return -1;
+    }
+    if constexpr (sizeof(PatternChar) > sizeof(SubjectChar)) {
+      // A one-byte subject can't contain a pattern with wider characters.
+      for (intptr_t i = 0; i < pattern_length; i++) {
+        if (pattern[i] > 0xFF) return -1;
+      }
+    }
+    intptr_t index = start_index;
+#if defined(HOST_ARCH_X64)
+    if (BlockSearch(pattern, pattern_length, subject, subject_length, &index)) {
+      return index;
+    }
+#endif
+    return LinearSearch(pattern, pattern_length, subject, subject_length,
+                        index);
+  }
+
+ private:
+  template <typename PatternChar, typename SubjectChar>
+  static bool MatchesAt(const PatternChar* pattern,
+                        intptr_t pattern_length,
+                        const SubjectChar* subject,
+                        intptr_t index) {
+    for (intptr_t i = 0; i < pattern_length; i++) {
+      if (static_cast<uint32_t>(pattern[i]) !=
+          static_cast<uint32_t>(subject[index + i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename PatternChar, typename SubjectChar>
+  static intptr_t LinearSearch(const PatternChar* pattern,
+                               intptr_t pattern_length,
+                               const SubjectChar* subject,
+                               intptr_t subject_length,
+                               intptr_t start_index) {
+    const uint32_t first = pattern[0];
+    for (intptr_t i = start_index; i <= subject_length - pattern_length; i++) {
+      if (static_cast<uint32_t>(subject[i]) == first &&
+          MatchesAt(pattern + 1, pattern_length - 1, subject, i + 1)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+#if defined(HOST_ARCH_X64)
+  static constexpr intptr_t kBlockSize = 16;
+
+  static __m128i Splat(uint8_t c) { return _mm_set1_epi8(c); }
+  static __m128i Splat(uint16_t c) { return _mm_set1_epi16(c); }
+  static __m128i Equal(uint8_t, __m128i a, __m128i b) {
+    return _mm_cmpeq_epi8(a, b);
+  }
+  static __m128i Equal(uint16_t, __m128i a, __m128i b) {
+    return _mm_cmpeq_epi16(a, b);
+  }
+
+  // Searches whole blocks of the subject starting at `*index`. Returns true
+  // and sets `*index` to the match if one is found. Otherwise sets `*index`
+  // to the start of the remaining tail of the subject, which is shorter than
+  // a block and has to be searched linearly.
+  template <typename PatternChar, typename SubjectChar>
+  static bool BlockSearch(const PatternChar* pattern,
+                          intptr_t pattern_length,
+                          const SubjectChar* subject,
+                          intptr_t subject_length,
+                          intptr_t* index) {
+    constexpr intptr_t kCharsPerBlock = kBlockSize / sizeof(SubjectChar);
+    // movemask yields one bit per byte, keep one bit per character.
+    constexpr uint32_t kLaneMask = sizeof(SubjectChar) == 1 ? 0xFFFF : 0x5555;
+    const __m128i first = Splat(static_cast<SubjectChar>(pattern[0]));
+    const __m128i last =
+        Splat(static_cast<SubjectChar>(pattern[pattern_length - 1]));
+    intptr_t i = *index;
+    for (; i + pattern_length - 1 + kCharsPerBlock <= subject_length;
+         i += kCharsPerBlock) {
+      const __m128i block_first =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(subject + i));
+      const __m128i block_last = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(subject + i + pattern_length - 1));
+      const __m128i candidates =
+          _mm_and_si128(Equal(SubjectChar(), first, block_first),
+                        Equal(SubjectChar(), last, block_last));
+      uint32_t mask = _mm_movemask_epi8(candidates) & kLaneMask;
+      while (mask != 0) {
+        const intptr_t offset =
+            Utils::CountTrailingZeros32(mask) / sizeof(SubjectChar);
+        if (MatchesAt(pattern + 1, pattern_length - 2, subject,
+                      i + offset + 1)) {
+          *index = i + offset;
+          return true;
+        }
+        mask &= mask - 1;
+      }
+    }
+    *index = i;
+    return false;
+  }
+#endif  // defined(HOST_ARCH_X64)
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_STRING_SEARCH_H_
@@ -86,6 +86,16 @@ DECLARE_FLAG(bool, trace_optimizing_compiler);
 DECLARE_FLAG(int, max_polymorphic_checks);
 
 DEFINE_FLAG(bool, trace_osr, false, "Trace attempts at on-stack replacement.");
+DEFINE_FLAG(bool,
+            background_osr,
+            false,
+            "Compile OSR code on the background compiler and keep running "
+            "unoptimized code until it is ready.");
+DEFINE_FLAG(int,
+            background_osr_poll_interval,
+            1000,
+            "Number of loop iterations between checks for OSR code compiled "
+            "in the background.");
 
 DEFINE_FLAG(int, gc_every, 0, "Run major GC on every N stack overflow checks");
 DEFINE_FLAG(int,
@@ -493,6 +503,17 @@ static Heap::Space SpaceForRuntimeAllocation() {
   }
 }
 
+// Generated code calls the runtime when inline allocation fails or is
+// disabled. The heap decides whether the class is pretenured, in which case
+// the instance is allocated in old space.
+static Heap::Space SpaceForRuntimeAllocation(Thread* thread, intptr_t cid) {
+  if (FLAG_runtime_allocate_old) [[unlikely]] {
+    return Heap::kOld;
+  } else {
+    return thread->heap()->SpaceForAllocation(cid);
+  }
+}
+
 static void RuntimeAllocationEpilogue(Thread* thread) {
   if (FLAG_runtime_allocate_spill_tlab) [[unlikely]] {
     static RelaxedAtomic<uword> count = 0;
@@ -697,7 +718,8 @@ DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
 #endif
   ASSERT(cls.is_allocate_finalized());
   const Instance& instance = Instance::Handle(
-      zone, Instance::NewAlreadyFinalized(cls, SpaceForRuntimeAllocation()));
+      zone, Instance::NewAlreadyFinalized(
+                cls, SpaceForRuntimeAllocation(thread, cls.id())));
   if (cls.NumTypeArguments() == 0) {
     // No type arguments required for a non-parameterized type.
     ASSERT(Instance::CheckedHandle(zone, arguments.ArgAt(1)).IsNull());
@@ -758,6 +780,38 @@ DEFINE_LEAF_RUNTIME_ENTRY(EnsureRememberedAndMarkingDeferred,
                           2,
                           DLRT_EnsureRememberedAndMarkingDeferred);
 
+// Called by the allocation stubs when the allocation state of a class is set.
+// Allocates instances of a pretenured class in old space, unless allocations
+// of the class are traced or a GC is needed. Returns 0 in that case, and the
+// stub calls the runtime instead.
+//
+// Like objects allocated by the runtime, the instance is added to the
+// remembered set and the deferred marking stack, so generated code may
+// initialize it without write barriers.
+extern "C" uword /*ObjectPtr*/ DLRT_AllocatePretenured(intptr_t cid,
+                                                       intptr_t size,
+                                                       Thread* thread) {
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  if (!class_table->ShouldPretenure(cid)) {
+    return 0;
+  }
+#if !defined(PRODUCT)
+  if (class_table->ShouldTraceAllocationFor(cid)) {
+    return 0;
+  }
+#endif  // !defined(PRODUCT)
+  ObjectPtr object = Object::TryAllocatePretenured(thread, cid, size);
+  if (object == Object::null()) {
+    return 0;
+  }
+  object->untag()->EnsureInRememberedSet(thread);
+  if (thread->is_marking()) {
+    thread->DeferredMarkingStackAddObject(object);
+  }
+  return static_cast<uword>(object);
+}
+DEFINE_LEAF_RUNTIME_ENTRY(AllocatePretenured, 3, DLRT_AllocatePretenured);
+
 extern "C" void DLRT_StoreBufferBlockProcess(Thread* thread) {
   thread->StoreBufferBlockProcess(StoreBuffer::kCheckThreshold);
 }
@@ -4713,11 +4767,35 @@ static void HandleOSRRequest(Thread* thread) {
                  function.usage_counter());
   }
 
+  Object& result = Object::Handle();
+  if (FLAG_background_compilation && FLAG_background_osr) {
+    auto background_compiler = isolate_group->background_compiler();
+    result = background_compiler->TakeOsrCode(function, osr_id);
+    // Code compiled in the background is disabled if its assumptions were
+    // invalidated in the meantime.
+    if (!result.IsNull() && Code::Cast(result).IsDisabled()) {
+      result = Code::null();
+    }
+    if (result.IsNull() &&
+        background_compiler->EnqueueCompilation(function, osr_id)) {
+      // Keep running unoptimized code and poll for the OSR code again after
+      // a few more iterations of this loop.
+      if (FLAG_trace_osr) {
+        OS::PrintErr("Enqueued OSR for %s at id=%" Pd "\n",
+                     function.ToFullyQualifiedCString(), osr_id);
+      }
+      function.SetUsageCounter(function.usage_counter() -
+                               FLAG_background_osr_poll_interval);
+      return;
+    }
+  }
+
   // Since the code is referenced from the frame and the ZoneHandle,
   // it cannot have been removed from the function.
-  const Object& result = Object::Handle(
-      Compiler::CompileOptimizedFunction(thread, function, osr_id));
-  ThrowIfError(result);
+  if (result.IsNull()) {
+    result = Compiler::CompileOptimizedFunction(thread, function, osr_id);
+    ThrowIfError(result);
+  }
 
   if (!result.IsNull()) {
     const Code& code = Code::Cast(result);
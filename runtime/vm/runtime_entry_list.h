@@ -108,6 +108,8 @@ namespace dart {
   V(void, NewMarkingStackBlockProcess, Thread*)                                \
   V(uword /*ObjectPtr*/, EnsureRememberedAndMarkingDeferred,                   \
     uword /*ObjectPtr*/ object, Thread* thread)                                \
+  V(uword /*ObjectPtr*/, AllocatePretenured, intptr_t cid, intptr_t size,      \
+    Thread* thread)                                                            \
   V(double, LibcPow, double, double)                                           \
   V(double, DartModulo, double, double)                                        \
   V(double, LibcFmod, double, double)                                          \
@@ -409,6 +409,54 @@ ISOLATE_UNIT_TEST_CASE(SerializeString) {
   // TODO(sgjesse): Add tests with non-BMP characters.
 }
 
+ISOLATE_UNIT_TEST_CASE(SerializeWithMessageStream) {
+  const char* kSymbol = "A canonical string sent with every message";
+  const char* kTwoByteSymbol = "A canonical string with \xC3\xA6 and \xE2\x82\xAC";
+  const char* kString = "Not canonical";
+  const Array& array = Array::Handle(Array::New(3));
+  array.SetAt(0, String::Handle(Symbols::New(thread, kSymbol)));
+  array.SetAt(1, String::Handle(Symbols::New(thread, kTwoByteSymbol)));
+  array.SetAt(2, String::Handle(String::New(kString)));
+
+  std::unique_ptr<Message> inline_message = WriteMessage(
+      /* same_group */ false, array, ILLEGAL_PORT, Message::kNormalPriority);
+  EXPECT(inline_message->stream() == nullptr);
+
+  // Any port other than ILLEGAL_PORT gets a stream, whether it exists or not.
+  const Dart_Port kPort = 42;
+  std::unique_ptr<Message> first = WriteMessage(
+      /* same_group */ false, array, kPort, Message::kNormalPriority);
+  std::unique_ptr<Message> second = WriteMessage(
+      /* same_group */ false, array, kPort, Message::kNormalPriority);
+  EXPECT(first->stream() != nullptr);
+  EXPECT(first->stream() == second->stream());
+  // The characters of canonical strings are not part of the snapshot.
+  EXPECT_LT(second->snapshot_length(), inline_message->snapshot_length());
+  EXPECT_EQ(first->snapshot_length(), second->snapshot_length());
+
+  // Messages refer to the stream's tables irrespective of the order they are
+  // read in.
+  Array& serialized_array = Array::Handle();
+  String& str = String::Handle();
+  for (Message* message : {second.get(), first.get()}) {
+    serialized_array ^= ReadMessage(thread, message);
+    EXPECT_EQ(3, serialized_array.Length());
+    EXPECT_EQ(array.At(0), serialized_array.At(0));
+    EXPECT_EQ(array.At(1), serialized_array.At(1));
+    str ^= serialized_array.At(2);
+    EXPECT(str.Equals(kString));
+
+    ApiNativeScope scope;
+    Dart_CObject* root = ReadApiMessage(scope.zone(), message);
+    EXPECT_EQ(Dart_CObject_kArray, root->type);
+    EXPECT_EQ(3, root->value.as_array.length);
+    EXPECT_STREQ(kSymbol, root->value.as_array.values[0]->value.as_string);
+    EXPECT_STREQ(kTwoByteSymbol,
+                 root->value.as_array.values[1]->value.as_string);
+    EXPECT_STREQ(kString, root->value.as_array.values[2]->value.as_string);
+  }
+}
+
 ISOLATE_UNIT_TEST_CASE(SerializeArray) {
   // Write snapshot with object content.
   const int kArrayLength = 10;
@@ -2044,6 +2092,57 @@ VM_UNIT_TEST_CASE(PostCObject) {
   Dart_ExitScope();
 }
 
+VM_UNIT_TEST_CASE(PostCObjectBatch) {
+  TestIsolateScope __test_isolate__;
+  const char* kScriptChars =
+      "import 'dart:isolate';\n"
+      "main() {\n"
+      "  var messageCount = 0;\n"
+      "  var exception = '';\n"
+      "  var port = new RawReceivePort();\n"
+      "  var sendPort = port.sendPort;\n"
+      "  port.handler = (message) {\n"
+      "    exception = '$exception${message}';\n"
+      "    messageCount++;\n"
+      "    if (messageCount == 4) throw new Exception(exception);\n"
+      "  };\n"
+      "  return sendPort;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_EnterScope();
+
+  Dart_Handle send_port = Dart_Invoke(lib, NewString("main"), 0, nullptr);
+  EXPECT_VALID(send_port);
+  Dart_Port port_id;
+  Dart_Handle result = Dart_SendPortGetId(send_port, &port_id);
+  ASSERT(!Dart_IsError(result));
+
+  Dart_CObject objects[4];
+  Dart_CObject* messages[4];
+  for (intptr_t i = 0; i < 4; i++) {
+    objects[i].type = Dart_CObject_kInt32;
+    objects[i].value.as_int32 = i;
+    messages[i] = &objects[i];
+  }
+  EXPECT(Dart_PostCObjectBatch(port_id, 0, nullptr));
+
+  // Nothing is posted if a message cannot be serialized.
+  objects[3].type = Dart_CObject_kUnsupported;
+  EXPECT(!Dart_PostCObjectBatch(port_id, 4, messages));
+  objects[3].type = Dart_CObject_kInt32;
+
+  EXPECT(Dart_PostCObjectBatch(port_id, 2, messages));
+  EXPECT(Dart_PostCObjectBatch(port_id, 2, messages + 2));
+  EXPECT(!Dart_PostCObjectBatch(ILLEGAL_PORT, 4, messages));
+
+  result = Dart_RunLoop();
+  EXPECT(Dart_IsError(result));
+  EXPECT(Dart_ErrorHasException(result));
+  EXPECT_SUBSTRING("Exception: 0123\n", Dart_GetError(result));
+
+  Dart_ExitScope();
+}
+
 TEST_CASE(IsKernelNegative) {
   EXPECT(!Dart_IsKernel(nullptr, 0));
 
@@ -39,6 +39,9 @@ ThreadPool::ThreadPool(uintptr_t max_pool_size)
 
 ThreadPool::~ThreadPool() {
   Shutdown();
+  for (intptr_t i = 0; i < kMaxDeques; i++) {
+    delete deques_[i].load(std::memory_order_relaxed);
+  }
 }
 
 void ThreadPool::RequestWorkersToShutdown() {
@@ -117,14 +120,40 @@ void ThreadPool::DeleteLastDeadWorker() {
   last_dead_worker_ = nullptr;
 }
 
-bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
+bool ThreadPool::RunImpl(std::unique_ptr<Task> task, Placement placement) {
+  auto worker =
+      static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
   Worker* new_worker = nullptr;
-  {
+  if (worker != nullptr && worker->pool_ == this) {
+    // The pool can't finish shutting down while one of its workers is
+    // running, and that worker will drain its own deque before exiting, so
+    // the task can be scheduled without holding the pool lock.
+    if (shutting_down_) {
+      return false;
+    }
+    const intptr_t pending = ++pending_tasks_;
+    if (placement != kAnyQueue || worker->deque_ == nullptr ||
+        !worker->deque_->Push(task.get())) {
+      InjectTask(task.get(), placement);
+    }
+    task.release();
+    // Workers only go to sleep after checking there are no pending tasks, so
+    // if there are enough of them searching they will pick the task up.
+    if (count_searching_ >= pending) {
+      return true;
+    }
+    MutexLocker ml(&pool_mutex_);
+    new_worker = ScheduleTaskLocked();
+  } else {
     MutexLocker ml(&pool_mutex_);
     if (shutting_down_) {
       return false;
     }
-    new_worker = ScheduleTaskLocked(std::move(task));
+    const intptr_t pending = ++pending_tasks_;
+    InjectTask(task.release(), placement);
+    if (count_searching_ < pending) {
+      new_worker = ScheduleTaskLocked();
+    }
   }
   if (new_worker != nullptr) {
     new_worker->StartThread();
@@ -132,6 +161,58 @@ bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
   return true;
 }
 
+void ThreadPool::InjectTask(Task* task, Placement placement) {
+  MutexLocker ml(&tasks_mutex_);
+  if (placement == kInjectFront) {
+    tasks_.Prepend(task);
+  } else {
+    tasks_.Append(task);
+  }
+  ++count_injected_;
+}
+
+ThreadPool::Task* ThreadPool::FindTask(Worker* worker) {
+  if (worker->deque_ != nullptr) {
+    if (Task* task = worker->deque_->Pop()) {
+      return task;
+    }
+  }
+  if (count_injected_ > 0) {
+    MutexLocker ml(&tasks_mutex_);
+    if (!tasks_.IsEmpty()) {
+      --count_injected_;
+      return tasks_.RemoveFirst();
+    }
+  }
+  return StealTask(worker);
+}
+
+ThreadPool::Task* ThreadPool::StealTask(Worker* worker) {
+  const intptr_t count = deque_count_;
+  // Start with the worker after this one to spread out the thieves.
+  const intptr_t start = worker->deque_index_ + 1;
+  for (intptr_t i = 0; i < count; i++) {
+    TaskDeque* deque = deques_[(start + i) % count].load();
+    if (deque == nullptr || deque == worker->deque_) continue;
+    if (Task* task = deque->Steal()) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void ThreadPool::RunAvailableTasks(Worker* worker) {
+  while (Task* found = FindTask(worker)) {
+    --pending_tasks_;
+    --count_searching_;
+    std::unique_ptr<Task> task(found);
+    task->Run();
+    ASSERT(Isolate::Current() == nullptr);
+    task.reset();
+    ++count_searching_;
+  }
+}
+
 bool ThreadPool::CurrentThreadIsWorker() {
   auto worker =
       static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
@@ -152,13 +233,12 @@ void ThreadPool::MarkWorkerAsBlocked(OSThread* thread) {
     if (max_pool_size_ > 0) {
       ++max_pool_size_;
       // This thread is blocked and therefore no longer usable as a worker.
-      // If we have pending tasks and there are no idle workers, we will spawn a
-      // new thread (temporarily allow exceeding the maximum pool size) to
-      // handle the pending tasks.
-      if (pending_tasks_ > count_idle_) {
-        new_worker = new Worker(this);
-        idle_workers_.Append(new_worker);
-        count_idle_++;
+      // If we have pending tasks and there are no idle or searching workers,
+      // we will spawn a new thread (temporarily allow exceeding the maximum
+      // pool size) to handle the pending tasks.
+      if (pending_tasks_ >
+          static_cast<intptr_t>(count_idle_) + count_searching_) {
+        new_worker = NewWorkerLocked();
       }
     }
   }
@@ -183,43 +263,43 @@ void ThreadPool::MarkCurrentWorkerAsUnBlocked() {
   }
 }
 
-std::unique_ptr<ThreadPool::Task> ThreadPool::TakeNextAvailableTaskLocked() {
-  std::unique_ptr<Task> task(tasks_.RemoveFirst());
-  pending_tasks_--;
-  if (pending_tasks_ > 0 && !idle_workers_.IsEmpty()) {
-    // Wake up one more worker if more tasks are left.
-    idle_workers_.Last()->Wakeup();
-  }
-  return task;
-}
-
 void ThreadPool::WorkerLoop(Worker* worker) {
   Worker* previous_dead_worker = nullptr;
 
+  // A worker starts out running and searching for tasks.
   while (true) {
+    RunAvailableTasks(worker);
+
     MutexLocker ml(&pool_mutex_);
 
-    if (!tasks_.IsEmpty()) {
-      IdleToRunningLocked(worker);
-      while (!tasks_.IsEmpty()) {
-        auto task = TakeNextAvailableTaskLocked();
-        MutexUnlocker mls(&ml);
-        task->Run();
-        ASSERT(Isolate::Current() == nullptr);
-        task.reset();  // Delete the task while unlocked.
-      }
-      RunningToIdleLocked(worker);
+    // Stop searching. A task scheduled concurrently either sees that there
+    // are not enough searching workers and wakes one up, or is seen here.
+    --count_searching_;
+    if (TasksWaitingToRunLocked()) {
+      ++count_searching_;
+      continue;
     }
+    RunningToIdleLocked(worker);
 
     if (running_workers_.IsEmpty()) {
-      ASSERT(tasks_.IsEmpty());
       OnEnterIdleLocked(&ml, worker);
-      if (!tasks_.IsEmpty()) {
+      if (worker->wakeup_requested_) {
+        worker->wakeup_requested_ = false;
+        continue;
+      }
+      if (TasksWaitingToRunLocked()) {
+        IdleToRunningLocked(worker);
         continue;
       }
     }
 
     if (shutting_down_) {
+      // Tasks are counted as pending before the shutdown flag is checked when
+      // scheduling them, so look at them again after seeing the flag.
+      if (TasksWaitingToRunLocked()) {
+        IdleToRunningLocked(worker);
+        continue;
+      }
       previous_dead_worker = IdleToDeadLocked(worker);
       break;
     }
@@ -227,13 +307,25 @@ void ThreadPool::WorkerLoop(Worker* worker) {
     // Sleep until we get a new task, we time out or we're shutdown.
     const int64_t idle_start = OS::GetCurrentMonotonicMicros();
     bool done = false;
-    while (!done) {
+    while (true) {
       const auto result = worker->Sleep(ComputeTimeout(idle_start));
 
+      // Woken up to run a new task, already moved to running.
+      if (worker->wakeup_requested_) {
+        worker->wakeup_requested_ = false;
+        break;
+      }
+
+      // Check the shutdown flag before the pending tasks, see above.
+      const bool exit = shutting_down_ || result == ConditionVariable::kTimedOut;
+
       // We have to drain all pending tasks.
-      if (!tasks_.IsEmpty()) break;
+      if (TasksWaitingToRunLocked()) {
+        IdleToRunningLocked(worker);
+        break;
+      }
 
-      if (shutting_down_ || result == ConditionVariable::kTimedOut) {
+      if (exit) {
         done = true;
         break;
       }
@@ -257,11 +349,18 @@ void ThreadPool::IdleToRunningLocked(Worker* worker) {
   running_workers_.Append(worker);
   count_idle_--;
   count_running_++;
+  ++count_searching_;
 }
 
-void ThreadPool::RunningToIdleLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
+void ThreadPool::WakeupLocked(Worker* worker) {
+  // Move the worker to running before waking it up, so that a concurrently
+  // scheduled task wakes up a different one.
+  IdleToRunningLocked(worker);
+  worker->wakeup_requested_ = true;
+  worker->Wakeup();
+}
 
+void ThreadPool::RunningToIdleLocked(Worker* worker) {
   ASSERT(running_workers_.ContainsForDebugging(worker));
   running_workers_.Remove(worker);
   idle_workers_.Append(worker);
@@ -270,7 +369,6 @@ void ThreadPool::RunningToIdleLocked(Worker* worker) {
 }
 
 ThreadPool::Worker* ThreadPool::IdleToDeadLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
   Worker* previous_dead = last_dead_worker_;
 
   ASSERT(idle_workers_.ContainsForDebugging(worker));
@@ -278,6 +376,15 @@ ThreadPool::Worker* ThreadPool::IdleToDeadLocked(Worker* worker) {
   last_dead_worker_ = worker;
   count_idle_--;
 
+  // Only the owner pushes to the deque and it has drained it, so it can be
+  // handed to a new worker.
+  if (worker->deque_ != nullptr) {
+    ASSERT(worker->deque_->IsEmpty());
+    deque_in_use_[worker->deque_index_] = false;
+    worker->deque_ = nullptr;
+    worker->deque_index_ = -1;
+  }
+
   // Notify shutdown thread that the worker thread is about to finish.
   if (shutting_down_) {
     if (running_workers_.IsEmpty() && idle_workers_.IsEmpty()) {
@@ -297,36 +404,45 @@ void ThreadPool::JoinDeadWorker(Worker* worker) {
   }
 }
 
-ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task) {
-  // Enqueue the new task.
-  tasks_.Append(task.release());
-  pending_tasks_++;
-  ASSERT(pending_tasks_ >= 1);
-
+ThreadPool::Worker* ThreadPool::ScheduleTaskLocked() {
   // Notify existing idle worker (if available).
-  if (count_idle_ >= pending_tasks_) {
-    ASSERT(!idle_workers_.IsEmpty());
-    // We always notify only the last worker which became idle. It will wake up
-    // more workers if needed.
-    idle_workers_.Last()->Wakeup();
+  if (!idle_workers_.IsEmpty()) {
+    // We always notify the last worker which became idle.
+    WakeupLocked(idle_workers_.Last());
     return nullptr;
   }
 
   // If we have maxed out the number of threads running, we will not start a
-  // new one.
+  // new one. One of the running workers will pick up the task.
   if (max_pool_size_ > 0 && (count_idle_ + count_running_) >= max_pool_size_) {
-    if (!idle_workers_.IsEmpty()) {
-      // We always notify only the last worker which became idle. It will
-      // wake up more workers if needed.
-      idle_workers_.Last()->Wakeup();
-    }
     return nullptr;
   }
 
   // Otherwise start a new worker.
+  return NewWorkerLocked();
+}
+
+ThreadPool::Worker* ThreadPool::NewWorkerLocked() {
   auto new_worker = new Worker(this);
-  idle_workers_.Append(new_worker);
-  count_idle_++;
+  running_workers_.Append(new_worker);
+  count_running_++;
+  ++count_searching_;
+
+  for (intptr_t i = 0; i < kMaxDeques; i++) {
+    if (deque_in_use_[i]) continue;
+    TaskDeque* deque = deques_[i].load(std::memory_order_relaxed);
+    if (deque == nullptr) {
+      deque = new TaskDeque();
+      deques_[i] = deque;
+    }
+    deque_in_use_[i] = true;
+    if (i >= deque_count_) {
+      deque_count_ = i + 1;
+    }
+    new_worker->deque_ = deque;
+    new_worker->deque_index_ = i;
+    break;
+  }
   return new_worker;
 }
 
@@ -360,7 +476,7 @@ void ThreadPool::Worker::Main(uword args) {
 #if defined(DEBUG)
   {
     MutexLocker ml(&pool->pool_mutex_);
-    ASSERT(pool->idle_workers_.ContainsForDebugging(worker));
+    ASSERT(pool->running_workers_.ContainsForDebugging(worker));
   }
 #endif
 
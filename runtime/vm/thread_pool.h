@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_THREAD_POOL_H_
 #define RUNTIME_VM_THREAD_POOL_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -14,11 +15,26 @@
 #include "vm/intrusive_dlist.h"
 #include "vm/lockers.h"
 #include "vm/os_thread.h"
+#include "vm/work_stealing_deque.h"
 
 namespace dart {
 
 class MutexLocker;
 
+// Tasks are scheduled onto per-worker work-stealing deques when they are
+// run from a worker of the pool, and onto a shared injection queue
+// otherwise. Idle workers take tasks from their own deque first, then from
+// the injection queue, and finally steal from other workers.
+//
+// Tasks run from outside the pool are started in the order they were run.
+// A worker pops the tasks it scheduled itself in reverse order though (most
+// recent first, while thieves take the oldest ones), so tasks which need to
+// start in order must not be run from a worker of the pool.
+//
+// The pool ensures there is a thread for every pending task (up to the
+// maximum pool size), because tasks may block waiting for each other.
+// Scheduling a task only takes the pool lock if there are not enough workers
+// searching for tasks and one has to be woken up or started.
 class ThreadPool {
  public:
   // Subclasses of Task are able to run on a ThreadPool.
@@ -49,6 +65,16 @@ class ThreadPool {
   }
   bool Run(Task* task) { return RunImpl(std::unique_ptr<Task>(task)); }
 
+  // Runs a task on the thread pool, always scheduling it onto the injection
+  // queue, even from a worker: at its front if [urgent], so it is picked up
+  // before all other waiting tasks, otherwise at its back, so the tasks that
+  // are already waiting get to run first.
+  template <typename T, typename... Args>
+  bool RunShared(bool urgent, Args&&... args) {
+    return RunImpl(std::unique_ptr<Task>(new T(std::forward<Args>(args)...)),
+                   urgent ? kInjectFront : kInjectBack);
+  }
+
   // Returns `true` if the current thread is running on the [this] thread pool.
   bool CurrentThreadIsWorker();
 
@@ -104,6 +130,8 @@ class ThreadPool {
    private:
     friend class ThreadPool;
 
+    using TaskDeque = WorkStealingDeque<Task>;
+
     void Wakeup() { wakeup_cv_.Notify(); }
 
     // The main entry point for new worker threads.
@@ -117,6 +145,15 @@ class ThreadPool {
     bool is_blocked_ = false;
     ConditionVariable wakeup_cv_;
 
+    // Set when the worker was moved from idle to running by a thread that
+    // scheduled a task, before waking it up.
+    bool wakeup_requested_ = false;
+
+    // The deque this worker pushes the tasks it schedules to, or nullptr if
+    // the pool ran out of deques.
+    TaskDeque* deque_ = nullptr;
+    intptr_t deque_index_ = -1;
+
     DISALLOW_COPY_AND_ASSIGN(Worker);
   };
 
@@ -130,21 +167,38 @@ class ThreadPool {
   bool ShuttingDownLocked() { return shutting_down_; }
 
   // Whether new tasks are ready to be run.
-  bool TasksWaitingToRunLocked() { return !tasks_.IsEmpty(); }
+  bool TasksWaitingToRunLocked() { return pending_tasks_ > 0; }
 
  private:
   static void WorkerThreadExit(ThreadPool* pool, ThreadPool::Worker* worker);
 
   using TaskList = IntrusiveDList<Task>;
   using WorkerList = IntrusiveDList<Worker>;
+  using TaskDeque = Worker::TaskDeque;
 
-  bool RunImpl(std::unique_ptr<Task> task);
+  static constexpr intptr_t kMaxDeques = 256;
+
+  enum Placement {
+    kAnyQueue,
+    kInjectFront,
+    kInjectBack,
+  };
+
+  bool RunImpl(std::unique_ptr<Task> task, Placement placement = kAnyQueue);
   void WorkerLoop(Worker* worker);
+  void InjectTask(Task* task, Placement placement);
 
-  Worker* ScheduleTaskLocked(std::unique_ptr<Task> task);
+  // Makes sure a worker will pick up a newly scheduled task, by waking up an
+  // idle worker or by creating a new one. The new worker, if any, has to be
+  // started after releasing the pool lock.
+  Worker* ScheduleTaskLocked();
 
-  std::unique_ptr<Task> TakeNextAvailableTaskLocked();
+  Task* FindTask(Worker* worker);
+  Task* StealTask(Worker* worker);
+  void RunAvailableTasks(Worker* worker);
 
+  Worker* NewWorkerLocked();
+  void WakeupLocked(Worker* worker);
   void IdleToRunningLocked(Worker* worker);
   void RunningToIdleLocked(Worker* worker);
   DART_WARN_UNUSED_RESULT Worker* IdleToDeadLocked(Worker* worker);
@@ -157,7 +211,9 @@ class ThreadPool {
   void DeleteLastDeadWorker();
 
   mutable Mutex pool_mutex_;
-  bool shutting_down_ = false;
+  std::atomic<bool> shutting_down_ = {false};
+  // Running workers are executing tasks or searching for them, idle workers
+  // are sleeping.
   uint64_t count_running_ = 0;
   uint64_t count_idle_ = 0;
   uint64_t count_dead_ = 0;
@@ -166,8 +222,22 @@ class ThreadPool {
 
   Worker* last_dead_worker_ = nullptr;
 
-  uint64_t pending_tasks_ = 0;
+  // Tasks that were scheduled but not yet taken by a worker.
+  std::atomic<intptr_t> pending_tasks_ = {0};
+  // Running workers that are not executing a task.
+  std::atomic<intptr_t> count_searching_ = {0};
+
+  // Injection queue for tasks scheduled from outside of the pool, or by a
+  // worker whose deque is full.
+  Mutex tasks_mutex_;
   TaskList tasks_;
+  std::atomic<intptr_t> count_injected_ = {0};
+
+  // Deques are assigned to workers under the pool lock and are only deleted
+  // with the pool, so they can be stolen from without holding a lock.
+  std::atomic<TaskDeque*> deques_[kMaxDeques] = {};
+  bool deque_in_use_[kMaxDeques] = {};
+  std::atomic<intptr_t> deque_count_ = {0};
 
   Monitor exit_monitor_;
   std::atomic<bool> all_workers_dead_;
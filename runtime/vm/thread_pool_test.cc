@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/thread_pool.h"
+#include "vm/growable_array.h"
 #include "vm/lockers.h"
 #include "vm/os.h"
 #include "vm/unit_test.h"
@@ -257,4 +258,103 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+class ChildTask : public ThreadPool::Task {
+ public:
+  ChildTask(Monitor* sync, int* done) : sync_(sync), done_(done) {}
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    (*done_)++;
+    ml.NotifyAll();
+  }
+
+ private:
+  Monitor* sync_;
+  int* done_;
+};
+
+class ParentTask : public ThreadPool::Task {
+ public:
+  ParentTask(ThreadPool* pool, Monitor* sync, int children, int* done)
+      : pool_(pool), sync_(sync), children_(children), done_(done) {}
+
+  // The children are pushed onto this worker's own deque. As the parent then
+  // blocks without running them, they have to be stolen by other workers.
+  virtual void Run() {
+    for (int i = 0; i < children_; i++) {
+      EXPECT(pool_->Run<ChildTask>(sync_, done_));
+    }
+    MonitorLocker ml(sync_);
+    while (*done_ < children_) {
+      ml.Wait();
+    }
+    (*done_)++;
+    ml.NotifyAll();
+  }
+
+ private:
+  ThreadPool* pool_;
+  Monitor* sync_;
+  int children_;
+  int* done_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_StealFromBlockedWorker) {
+  ThreadPool thread_pool;
+  Monitor sync;
+  const int kChildren = 100;
+  int done = 0;
+  thread_pool.Run<ParentTask>(&thread_pool, &sync, kChildren, &done);
+  {
+    MonitorLocker ml(&sync);
+    while (done < kChildren + 1) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(kChildren + 1, done);
+}
+
+class OrderTask : public ThreadPool::Task {
+ public:
+  OrderTask(Monitor* sync,
+            MallocGrowableArray<intptr_t>* order,
+            intptr_t index)
+      : sync_(sync), order_(order), index_(index) {}
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    order_->Add(index_);
+    ml.Notify();
+  }
+
+ private:
+  Monitor* sync_;
+  MallocGrowableArray<intptr_t>* order_;
+  intptr_t index_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_ExternalTasksRunInOrder) {
+  ThreadPool thread_pool(/*max_pool_size=*/1);
+  Monitor sync;
+  bool done = true;
+  // Keep the only worker busy until all the tasks are scheduled.
+  thread_pool.Run<TestTask>(&sync, &done);
+  const intptr_t kTaskCount = 50;
+  MallocGrowableArray<intptr_t> order;
+  for (intptr_t i = 0; i < kTaskCount; i++) {
+    thread_pool.Run<OrderTask>(&sync, &order, i);
+  }
+  {
+    MonitorLocker ml(&sync);
+    done = false;
+    ml.Notify();
+    while (order.length() < kTaskCount) {
+      ml.Wait();
+    }
+  }
+  for (intptr_t i = 0; i < kTaskCount; i++) {
+    EXPECT_EQ(i, order[i]);
+  }
+}
+
 }  // namespace dart
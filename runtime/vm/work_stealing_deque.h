@@ -0,0 +1,105 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_WORK_STEALING_DEQUE_H_
+#define RUNTIME_VM_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "platform/utils.h"
+
+namespace dart {
+
+// A bounded Chase-Lev work-stealing deque of pointers.
+//
+// The owning thread pushes and pops at the bottom, other threads steal from
+// the top. Push fails when the deque is full, which lets the caller fall back
+// to a shared queue instead of growing the buffer (growing would require
+// keeping old buffers alive while thieves may still read them).
+//
+// See "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê,
+// Pop, Cohen and Zappa Nardelli. All accesses to the indices are sequentially
+// consistent instead of using standalone fences, which keeps the
+// implementation simple to reason about and understood by TSAN.
+template <typename T, intptr_t kCapacity = 256>
+class WorkStealingDeque {
+ public:
+  static_assert(Utils::IsPowerOfTwo(kCapacity), "Capacity must be 2^n");
+
+  WorkStealingDeque() {
+    for (intptr_t i = 0; i < kCapacity; i++) {
+      buffer_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  // Owner only. Returns false if the deque is full.
+  bool Push(T* item) {
+    ASSERT(item != nullptr);
+    const intptr_t bottom = bottom_.load(std::memory_order_relaxed);
+    const intptr_t top = top_.load();
+    if (bottom - top >= kCapacity) {
+      return false;
+    }
+    buffer_[bottom & kMask].store(item, std::memory_order_relaxed);
+    bottom_.store(bottom + 1);
+    return true;
+  }
+
+  // Owner only. Returns the most recently pushed item, or nullptr if the
+  // deque is empty or the last item was stolen concurrently.
+  T* Pop() {
+    const intptr_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom);
+    intptr_t top = top_.load();
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1);
+      return nullptr;
+    }
+    T* item = buffer_[bottom & kMask].load(std::memory_order_relaxed);
+    if (top == bottom) {
+      // Last item, race against thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1);
+    }
+    return item;
+  }
+
+  // Any thread. Returns the least recently pushed item, or nullptr if the
+  // deque is empty or the steal lost a race with the owner or another thief.
+  T* Steal() {
+    intptr_t top = top_.load();
+    const intptr_t bottom = bottom_.load();
+    if (top >= bottom) {
+      return nullptr;
+    }
+    T* item = buffer_[top & kMask].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  // Approximate when called concurrently with Push/Pop/Steal.
+  bool IsEmpty() const { return top_.load() >= bottom_.load(); }
+
+ private:
+  static constexpr intptr_t kMask = kCapacity - 1;
+
+  // Separate the indices written by thieves and by the owner to avoid false
+  // sharing between them.
+  alignas(64) std::atomic<intptr_t> top_ = {0};
+  alignas(64) std::atomic<intptr_t> bottom_ = {0};
+  alignas(64) std::atomic<T*> buffer_[kCapacity];
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_WORK_STEALING_DEQUE_H_
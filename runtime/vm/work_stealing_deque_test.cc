@@ -0,0 +1,140 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/work_stealing_deque.h"
+
+#include <atomic>
+
+#include "platform/assert.h"
+#include "vm/lockers.h"
+#include "vm/thread_pool.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+UNIT_TEST_CASE(WorkStealingDeque_PushPopSteal) {
+  WorkStealingDeque<intptr_t, 4> deque;
+  intptr_t items[5] = {0, 1, 2, 3, 4};
+  EXPECT(deque.IsEmpty());
+  EXPECT(deque.Pop() == nullptr);
+  EXPECT(deque.Steal() == nullptr);
+
+  for (intptr_t i = 0; i < 4; i++) {
+    EXPECT(deque.Push(&items[i]));
+  }
+  // Full.
+  EXPECT(!deque.Push(&items[4]));
+  EXPECT(!deque.IsEmpty());
+
+  // The owner takes the most recent item, thieves take the oldest.
+  EXPECT_EQ(&items[3], deque.Pop());
+  EXPECT_EQ(&items[0], deque.Steal());
+  EXPECT_EQ(&items[1], deque.Steal());
+  EXPECT_EQ(&items[2], deque.Pop());
+  EXPECT(deque.IsEmpty());
+  EXPECT(deque.Pop() == nullptr);
+  EXPECT(deque.Steal() == nullptr);
+
+  // The indices wrap around the buffer.
+  for (intptr_t round = 0; round < 10; round++) {
+    for (intptr_t i = 0; i < 3; i++) {
+      EXPECT(deque.Push(&items[i]));
+    }
+    EXPECT_EQ(&items[0], deque.Steal());
+    EXPECT_EQ(&items[2], deque.Pop());
+    EXPECT_EQ(&items[1], deque.Pop());
+    EXPECT(deque.IsEmpty());
+  }
+}
+
+namespace {
+
+const intptr_t kStressItems = 100000;
+const intptr_t kStressThieves = 4;
+
+struct StressState {
+  WorkStealingDeque<intptr_t, 64> deque;
+  intptr_t items[kStressItems];
+  std::atomic<intptr_t> taken[kStressItems];
+  std::atomic<intptr_t> taken_count = {0};
+  std::atomic<bool> done = {false};
+  Monitor monitor;
+  intptr_t thieves_finished = 0;
+
+  void Take(intptr_t* item) {
+    EXPECT_EQ(0, taken[*item].fetch_add(1));
+    taken_count++;
+  }
+};
+
+class ThiefTask : public ThreadPool::Task {
+ public:
+  explicit ThiefTask(StressState* state) : state_(state) {}
+
+  virtual void Run() {
+    while (!state_->done) {
+      if (intptr_t* item = state_->deque.Steal()) {
+        state_->Take(item);
+      }
+    }
+    MonitorLocker ml(&state_->monitor);
+    state_->thieves_finished++;
+    ml.Notify();
+  }
+
+ private:
+  StressState* state_;
+};
+
+}  // namespace
+
+// The owner pushes and pops while other threads steal concurrently. Every
+// item must be taken exactly once.
+UNIT_TEST_CASE(WorkStealingDeque_ConcurrentSteal) {
+  OSThread::Init();
+  {
+    auto state = new StressState();
+    for (intptr_t i = 0; i < kStressItems; i++) {
+      state->items[i] = i;
+      state->taken[i] = 0;
+    }
+    ThreadPool pool;
+    for (intptr_t i = 0; i < kStressThieves; i++) {
+      pool.Run<ThiefTask>(state);
+    }
+    intptr_t next = 0;
+    while (next < kStressItems) {
+      // Push a few items, then pop about half of them back.
+      for (intptr_t i = 0; i < 8 && next < kStressItems; i++) {
+        if (!state->deque.Push(&state->items[next])) break;
+        next++;
+      }
+      for (intptr_t i = 0; i < 4; i++) {
+        if (intptr_t* item = state->deque.Pop()) {
+          state->Take(item);
+        }
+      }
+    }
+    while (intptr_t* item = state->deque.Pop()) {
+      state->Take(item);
+    }
+    state->done = true;
+    {
+      MonitorLocker ml(&state->monitor);
+      while (state->thieves_finished < kStressThieves) {
+        ml.Wait();
+      }
+    }
+    EXPECT_EQ(kStressItems, state->taken_count.load());
+    for (intptr_t i = 0; i < kStressItems; i++) {
+      EXPECT_EQ(1, state->taken[i].load());
+    }
+    delete state;
+  }
+  OSThread* os_thread = OSThread::Current();
+  OSThread::SetCurrent(nullptr);
+  delete os_thread;
+}
+
+}  // namespace dart
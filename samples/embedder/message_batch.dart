@@ -0,0 +1,35 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'dart:isolate';
+
+void main(List<String> args) {
+  throw 'Unimplemented';
+}
+
+final List<int> received = <int>[];
+
+@pragma('vm:entry-point', 'call')
+void sendMessages(int count) {
+  final port = RawReceivePort();
+  port.handler = (int value) {
+    received.add(value);
+    if (received.length == count) {
+      port.close();
+    }
+  };
+  for (var i = 0; i < count; i++) {
+    port.sendPort.send(i);
+  }
+}
+
+// Returns the number of received messages, or -1 if they were received out of
+// order.
+@pragma('vm:entry-point', 'call')
+int receivedInOrder() {
+  for (var i = 0; i < received.length; i++) {
+    if (received[i] != i) return -1;
+  }
+  return received.length;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Checks that batched message handling (see DartEngine_SetMessageBatchSize)
+// schedules a single DartEngine_HandleMessage call for several messages, and
+// that this call delivers all of them in order.
+
+#include <atomic>
+#include <iostream>
+
+#include "helpers.h"
+#include "include/dart_api.h"
+#include "include/dart_engine.h"
+
+constexpr int64_t kMessageCount = 16;
+
+// Only counts the calls. The messages are handled by main below.
+void CountScheduledMessages(Dart_Isolate isolate, void* context) {
+  reinterpret_cast<std::atomic<intptr_t>*>(context)->fetch_add(1);
+}
+
+void CheckScheduled(const std::atomic<intptr_t>& scheduled,
+                    std::string_view context) {
+  if (scheduled != 1) {
+    std::cerr << "Expected a single scheduled call " << context << ", got "
+              << scheduled << std::endl;
+    std::exit(1);
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc == 1) {
+    std::cerr << "Must specify snapshot path" << std::endl;
+    std::exit(1);
+  }
+  char* error = nullptr;
+
+  DartEngine_SnapshotData snapshot_data = AutoSnapshotFromFile(argv[1], &error);
+  CheckError(error, "reading snapshot");
+  Dart_Isolate isolate = DartEngine_CreateIsolate(snapshot_data, &error);
+  CheckError(error, "creating isolate");
+
+  std::atomic<intptr_t> scheduled = 0;
+  DartEngine_MessageScheduler scheduler{CountScheduledMessages, &scheduled};
+  DartEngine_SetMessageScheduler(scheduler, isolate);
+  DartEngine_SetMessageBatchSize(kMessageCount, isolate);
+
+  // Post all messages before any of them is handled.
+  WithIsolate<void>(isolate, [] {
+    Dart_Handle args[] = {Dart_NewInteger(kMessageCount)};
+    CheckError(Dart_Invoke(Dart_RootLibrary(),
+                           Dart_NewStringFromCString("sendMessages"), 1, args));
+  });
+  CheckScheduled(scheduled, "after posting the messages");
+
+  // One call handles the whole batch, and nothing is left to schedule.
+  DartEngine_HandleMessage(isolate);
+  CheckScheduled(scheduled, "after handling the batch");
+
+  const int64_t received = WithIsolate<int64_t>(isolate, [] {
+    return IntFromHandle(Dart_Invoke(
+        Dart_RootLibrary(), Dart_NewStringFromCString("receivedInOrder"), 0,
+        nullptr));
+  });
+  std::cout << "Received in order: " << received << std::endl;
+  if (received != kMessageCount) {
+    std::cerr << "Expected " << kMessageCount << " messages in order"
+              << std::endl;
+    std::exit(1);
+  }
+
+  DartEngine_Shutdown();
+}
@@ -97,6 +97,9 @@ class Isolate {
   @patch
   static Isolate create({String? debugName}) => _unsupported();
 
+  @patch
+  static T freeze<T>(T value) => _unsupported();
+
   @patch
   void shutdownSync() => _unsupported();
 
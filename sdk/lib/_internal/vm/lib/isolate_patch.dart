@@ -228,7 +228,7 @@ final class _RawReceivePort implements RawReceivePort {
 }
 
 @pragma("vm:entry-point")
-final class _SendPort implements SendPort {
+final class _SendPort implements SendPort, _BatchSendPort {
   factory _SendPort._uninstantiable() {
     throw "Unreachable";
   }
@@ -256,6 +256,13 @@ final class _SendPort implements SendPort {
   // Forward the implementation of sending messages to the VM.
   @pragma("vm:external-name", "SendPort_sendInternal_")
   external void _sendInternal(message);
+
+  void _sendAll(Iterable<Object?> messages) {
+    _sendAllInternal(messages.toList(growable: false));
+  }
+
+  @pragma("vm:external-name", "SendPort_sendAllInternal_")
+  external void _sendAllInternal(List<Object?> messages);
 }
 
 typedef _UnaryFunction(Never args);
@@ -732,6 +739,12 @@ final class Isolate {
     _exit(finalMessagePort, message);
   }
 
+  @patch
+  static T freeze<T>(T value) => _freeze(value) as T;
+
+  @pragma("vm:external-name", "Isolate_freeze")
+  external static Object? _freeze(Object? value);
+
   @patch
   static Isolate create({String? debugName}) {
     final List created = _create(debugName);
@@ -131,6 +131,11 @@ class Isolate {
     throw UnsupportedError("Isolate.create");
   }
 
+  @patch
+  static T freeze<T>(T value) {
+    throw UnsupportedError("Isolate.freeze");
+  }
+
   @patch
   void shutdownSync() {
     throw UnsupportedError("Isolate.shutdownSync");
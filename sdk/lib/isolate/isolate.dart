@@ -866,6 +866,28 @@ final class Isolate {
   @Since("3.13")
   external static Isolate create({String? debugName});
 
+  /// Creates a deeply immutable copy of [value] which all isolates of the
+  /// current isolate group can share.
+  ///
+  /// Sending the result, or anything referring only to it, to another isolate
+  /// in the same group passes it by reference instead of copying it, which
+  /// makes it cheap to hand out large lookup tables or configuration to many
+  /// isolates.
+  ///
+  /// Lists become unmodifiable lists, maps and sets become constant maps and
+  /// sets, typed data becomes an unmodifiable view of an immutable copy of its
+  /// bytes, and records are copied with frozen fields. Objects that are
+  /// already deeply immutable, such as strings, numbers and constants, are
+  /// used as they are.
+  ///
+  /// Keys of frozen maps and elements of frozen sets are compared like the
+  /// ones of constant maps and sets, so they must be numbers, strings,
+  /// booleans, `null` or constants.
+  ///
+  /// Throws an [ArgumentError] if [value] refers to any other object.
+  @Since("3.14")
+  external static T freeze<T>(T value);
+
   /// Shut down target isolate.
   ///
   /// Shutting down the isolate stops its event loop without processing
@@ -1016,6 +1038,10 @@ abstract interface class SendPort implements Capability {
   /// port can receive the message as soon as its isolate's event loop is ready
   /// to deliver it, independently of what the sending isolate is doing.
   ///
+  /// Typed data in [message] is copied like other mutable objects. To move
+  /// large byte buffers to another isolate without copying them, send a
+  /// [TransferableTypedData] instead.
+  ///
   /// Note: Due to an implementation choice the Dart VM made for how closures
   /// represent captured state, closures can currently capture more state than
   /// they need, which can cause the transitive closure to be larger than
@@ -1030,6 +1056,35 @@ abstract interface class SendPort implements Capability {
   int get hashCode;
 }
 
+/// Sends several messages through a [SendPort] at once.
+extension SendPortSendAll on SendPort {
+  /// Sends each of the [messages] through this send port, in iteration order.
+  ///
+  /// Has the same effect as calling [send] for each message, and the same
+  /// restrictions on what can be sent apply to each of them.
+  ///
+  /// If this is the [ReceivePort.sendPort] or [RawReceivePort.sendPort] of a
+  /// port created by the platform, the corresponding receive port is only
+  /// notified once for all of the [messages], and if any of them cannot be
+  /// sent, an error is thrown and none of them are sent. For other
+  /// implementations of [SendPort], [send] is called for each message.
+  void sendAll(Iterable<Object?> messages) {
+    final port = this;
+    if (port is _BatchSendPort) {
+      port._sendAll(messages);
+    } else {
+      for (final message in messages) {
+        send(message);
+      }
+    }
+  }
+}
+
+/// A [SendPort] of the platform which can send several messages at once.
+abstract interface class _BatchSendPort {
+  void _sendAll(Iterable<Object?> messages);
+}
+
 /// Together with [SendPort], the only means of communication between isolates.
 ///
 /// [ReceivePort]s have a `sendPort` getter which returns a [SendPort].
@@ -0,0 +1,88 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-enable-fast-object-copy
+// VMOptions=--enable-fast-object-copy
+
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+class Mutable {
+  int value = 0;
+}
+
+Map<String, Object?> buildTable() {
+  final shared = <int>[1, 2, 3];
+  final table = <String, Object?>{
+    "list": shared,
+    "alias": shared,
+    "growable": <Object?>[
+      "a",
+      1.5,
+      null,
+      {"nested": true},
+    ],
+    "set": <Object>{1, "two", 3.0},
+    "bytes": Uint8List.fromList([1, 2, 3, 4]),
+    "record": (1, named: <String>["x"]),
+    "removed": 0,
+  };
+  table.remove("removed");
+  return table;
+}
+
+void verifyTable(Map<String, Object?> table) {
+  Expect.equals(7, table.length);
+  Expect.isFalse(table.containsKey("removed"));
+  final list = table["list"] as List<int>;
+  Expect.listEquals([1, 2, 3], list);
+  Expect.identical(list, table["alias"]);
+  Expect.throws<UnsupportedError>(() => list[0] = 0);
+  final growable = table["growable"] as List<Object?>;
+  Expect.equals(4, growable.length);
+  Expect.throws<UnsupportedError>(() => growable.add(0));
+  Expect.equals(true, (growable[3] as Map)["nested"]);
+  final set = table["set"] as Set<Object>;
+  Expect.isTrue(set.contains("two"));
+  Expect.isTrue(set.contains(3.0));
+  Expect.throws<UnsupportedError>(() => set.add(4));
+  final bytes = table["bytes"] as Uint8List;
+  Expect.listEquals([1, 2, 3, 4], bytes);
+  Expect.throws<UnsupportedError>(() => bytes[0] = 0);
+  final record = table["record"] as (int, {List<String> named});
+  Expect.equals(1, record.$1);
+  Expect.listEquals(["x"], record.named);
+  Expect.throws<UnsupportedError>(() => table["list"] = null);
+}
+
+void entry(List<Object?> message) {
+  final replyTo = message[0] as SendPort;
+  verifyTable(message[1] as Map<String, Object?>);
+  // Sending the table back passes it by reference as well.
+  replyTo.send(message[1]);
+}
+
+main() {
+  final frozen = Isolate.freeze(buildTable());
+  verifyTable(frozen);
+
+  // Frozen values are left as they are.
+  Expect.identical(frozen, Isolate.freeze(frozen));
+  Expect.identical("string", Isolate.freeze("string"));
+
+  Expect.throws<ArgumentError>(() => Isolate.freeze([Mutable()]));
+  Expect.throws<ArgumentError>(() => Isolate.freeze({<int>[]: 1}));
+
+  asyncStart();
+  final port = ReceivePort();
+  port.listen((message) {
+    Expect.identical(frozen, message);
+    port.close();
+    asyncEnd();
+  });
+  Isolate.spawn(entry, [port.sendPort, frozen]);
+}
@@ -0,0 +1,36 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--isolate-pool-size=2
+
+// Checks that the VM shuts down while the isolate group still has idle
+// isolates in its pool and a running isolate that is killed on shutdown.
+
+import 'dart:isolate';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+void child(SendPort replyTo) {
+  // The open port keeps this isolate alive until the VM shuts down.
+  final port = ReceivePort();
+  replyTo.send(port.sendPort);
+}
+
+void exitingChild(SendPort replyTo) {
+  Isolate.exit(replyTo, "exited");
+}
+
+main() async {
+  asyncStart();
+  final port = ReceivePort();
+  await Isolate.spawn(child, port.sendPort);
+  Expect.type<SendPort>(await port.first);
+
+  // The isolate leaving through Isolate.exit is replaced in the pool.
+  final exitPort = ReceivePort();
+  await Isolate.spawn(exitingChild, exitPort.sendPort);
+  Expect.equals("exited", await exitPort.first);
+  asyncEnd();
+}
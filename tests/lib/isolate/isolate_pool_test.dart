@@ -0,0 +1,50 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--isolate-pool-size=0
+// VMOptions=--isolate-pool-size=1
+// VMOptions=--isolate-pool-size=4
+
+import 'dart:isolate';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+int counter = 0;
+
+void entry(SendPort replyTo) {
+  // Every spawned isolate starts with fresh static state, whether or not it
+  // was taken from the pool.
+  counter++;
+  replyTo.send([Isolate.current.debugName, counter]);
+}
+
+Future<void> testSpawn() async {
+  for (int i = 0; i < 10; i++) {
+    final port = ReceivePort();
+    await Isolate.spawn(entry, port.sendPort, debugName: "spawn-$i");
+    final reply = await port.first as List;
+    Expect.equals("spawn-$i", reply[0]);
+    Expect.equals(1, reply[1]);
+  }
+}
+
+Future<void> testRun() async {
+  final results = await Future.wait([
+    for (int i = 0; i < 10; i++)
+      Isolate.run(() {
+        counter += i;
+        return counter;
+      }),
+  ]);
+  Expect.listEquals([for (int i = 0; i < 10; i++) i], results);
+  Expect.equals(0, counter);
+}
+
+main() async {
+  asyncStart();
+  await testSpawn();
+  await testRun();
+  asyncEnd();
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--object-copy-tasks=0
+// VMOptions=--object-copy-tasks=3 --parallel-object-copy-threshold=100
+// VMOptions=--object-copy-tasks=3 --parallel-object-copy-threshold=100 --no-enable-fast-object-copy
+
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+class Node {
+  final int id;
+  final Object? shared;
+  Node? next;
+
+  Node(this.id, this.shared);
+}
+
+const int length = 20000;
+
+List<Object?> buildGraph() {
+  final shared = <String, int>{"shared": 1};
+  final nodes = <Node>[];
+  for (int i = 0; i < length; i++) {
+    nodes.add(Node(i, shared));
+  }
+  // Link the nodes in a cycle so workers race to forward the same objects.
+  for (int i = 0; i < length; i++) {
+    nodes[i].next = nodes[(i * 7 + 1) % length];
+  }
+  return [
+    nodes,
+    {for (int i = 0; i < length; i++) i: Uint8List(4)..[0] = i & 0xff},
+    {for (int i = 0; i < length; i++) "s$i"},
+    shared,
+  ];
+}
+
+void verifyGraph(List<Object?> graph) {
+  final nodes = graph[0] as List<Node>;
+  final bytes = graph[1] as Map<int, Uint8List>;
+  final strings = graph[2] as Set<String>;
+  final shared = graph[3] as Map<String, int>;
+  Expect.equals(length, nodes.length);
+  for (int i = 0; i < length; i++) {
+    final node = nodes[i];
+    Expect.equals(i, node.id);
+    Expect.identical(shared, node.shared);
+    Expect.identical(nodes[(i * 7 + 1) % length], node.next);
+  }
+  // Maps and sets are rehashed after the copy.
+  Expect.equals(length, bytes.length);
+  for (int i = 0; i < length; i++) {
+    Expect.equals(i & 0xff, bytes[i]![0]);
+    Expect.isTrue(strings.contains("s$i"));
+  }
+  Expect.equals(1, shared["shared"]);
+}
+
+main() {
+  asyncStart();
+  final graph = buildGraph();
+  final port = ReceivePort();
+  port.listen((message) {
+    final copy = message as List<Object?>;
+    Expect.notIdentical(graph[0], copy[0]);
+    verifyGraph(copy);
+    port.close();
+    asyncEnd();
+  });
+  port.sendPort.send(graph);
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-enable-fast-object-copy
+// VMOptions=--enable-fast-object-copy
+
+import 'dart:isolate';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+void entry(SendPort replyTo) {
+  replyTo.sendAll([1, "two", null]);
+  replyTo.sendAll(Iterable.generate(100, (i) => [i]));
+  replyTo.sendAll(const []);
+  // Nothing is sent if any message cannot be sent.
+  final unsendable = ReceivePort();
+  Expect.throws(() => replyTo.sendAll([4, unsendable]));
+  unsendable.close();
+  replyTo.send("done");
+}
+
+// Implementations of SendPort outside of the platform send the messages one
+// by one.
+class RecordingSendPort implements SendPort {
+  final sent = <Object?>[];
+
+  @override
+  void send(Object? message) {
+    sent.add(message);
+  }
+}
+
+main() {
+  final recording = RecordingSendPort();
+  recording.sendAll([1, "two", null]);
+  Expect.listEquals([1, "two", null], recording.sent);
+
+  asyncStart();
+  final response = ReceivePort();
+  final messages = <Object?>[];
+  response.listen((message) {
+    if (message != "done") {
+      messages.add(message);
+      return;
+    }
+    response.close();
+    Expect.equals(103, messages.length);
+    Expect.listEquals([1, "two", null], messages.sublist(0, 3));
+    for (int i = 0; i < 100; i++) {
+      Expect.listEquals([i], messages[3 + i] as List);
+    }
+    asyncEnd();
+  });
+  Isolate.spawn(entry, response.sendPort);
+}
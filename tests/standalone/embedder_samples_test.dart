@@ -57,6 +57,9 @@ void main() {
   checkSamples('$out/run_timer_async_kernel', [
     '$out/gen/timer_kernel.dart.snapshot',
   ]);
+  checkSamples('$out/run_message_batch_kernel', [
+    '$out/gen/message_batch_kernel.dart.snapshot',
+  ]);
   // FFI samples aren't built on some platforms.
   checkSamples('$out/run_futures_kernel', [
     '$out/gen/futures_kernel.dart.snapshot',
@@ -76,6 +79,9 @@ void main() {
   checkSamples('$out/run_timer_async_aot', [
     '$out/timer_aot.snapshot',
   ], skipIfNotBuilt: true);
+  checkSamples('$out/run_message_batch_aot', [
+    '$out/message_batch_aot.snapshot',
+  ], skipIfNotBuilt: true);
   checkSamples('$out/run_futures_aot', [
     '$out/futures_aot.snapshot',
   ], skipIfNotBuilt: true);